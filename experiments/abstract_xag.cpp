@@ -0,0 +1,113 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/abstract_xag.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* random linear layer with `n` inputs and outputs, each output is the XOR of
+ * about half of the inputs */
+mockturtle::xag_network linear_layer( uint32_t n )
+{
+  using namespace mockturtle;
+
+  xag_network xag;
+  std::vector<xag_network::signal> pis( n );
+  std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+
+  std::mt19937 rng( 1u );
+  for ( auto i = 0u; i < n; ++i )
+  {
+    std::vector<xag_network::signal> row;
+    for ( auto j = 0u; j < n; ++j )
+    {
+      if ( rng() % 2u )
+      {
+        row.push_back( pis[j] );
+      }
+    }
+    xag.create_po( xag.create_nary_xor( row ) );
+  }
+  return xag;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double> exp( "abstract_xag", "benchmark", "gates", "abstract gates", "t_build (ms)", "t_traverse (ms)", "t_destroy (ms)" );
+
+  const auto run = [&]( std::string const& name, xag_network const& xag ) {
+    stopwatch<>::duration time_build{0}, time_traverse{0}, time_destroy{0};
+
+    auto axag = call_with_stopwatch( time_build, [&]() { return cleanup_dangling<xag_network, abstract_xag_network>( xag ); } );
+
+    uint64_t checksum{0u};
+    call_with_stopwatch( time_traverse, [&]() {
+      axag.foreach_gate( [&]( auto const& n ) {
+        axag.foreach_fanin( n, [&]( auto const& f ) {
+          checksum += axag.get_node( f );
+        } );
+      } );
+    } );
+
+    const auto num_gates = axag.num_gates();
+    call_with_stopwatch( time_destroy, [&]() { axag._storage.reset(); } );
+
+    fmt::print( "[i] {} checksum = {}\n", name, checksum );
+    exp( name, xag.num_gates(), num_gates, to_seconds( time_build ) * 1000.0, to_seconds( time_traverse ) * 1000.0, to_seconds( time_destroy ) * 1000.0 );
+  };
+
+  for ( auto const& benchmark : epfl_benchmarks( ~hyp ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    xag_network xag;
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( xag ) );
+    run( benchmark, xag );
+  }
+
+  for ( auto n : {256u, 512u, 1024u} )
+  {
+    fmt::print( "[i] processing linear layer {}\n", n );
+    run( fmt::format( "linear{}", n ), linear_layer( n ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
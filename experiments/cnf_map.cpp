@@ -28,23 +28,40 @@
 #include <vector>
 
 #include <fmt/format.h>
-#include <mockturtle/algorithms/collapse_mapped.hpp>
-#include <mockturtle/algorithms/cut_enumeration/cnf_cut.hpp>
+#include <mockturtle/algorithms/cnf_map.hpp>
 #include <mockturtle/algorithms/equivalence_checking.hpp>
-#include <mockturtle/algorithms/lut_mapping.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
-#include <mockturtle/networks/klut.hpp>
-#include <mockturtle/views/mapping_view.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/cnf_view.hpp>
 
 #include <experiments.hpp>
 
+template<class Ntk>
+void create_assoc_miter( Ntk& ntk, uint32_t bitwidth )
+{
+  using namespace mockturtle;
+
+  std::vector<typename Ntk::signal> as( bitwidth ), bs( bitwidth ), cs( bitwidth );
+  std::generate( as.begin(), as.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( cs.begin(), cs.end(), [&]() { return ntk.create_pi(); } );
+
+  auto o1 = carry_ripple_multiplier( ntk, carry_ripple_multiplier( ntk, as, bs ), cs );
+  auto o2 = carry_ripple_multiplier( ntk, as, carry_ripple_multiplier( ntk, bs, cs ) );
+  std::vector<typename Ntk::signal> xors( o1.size() );
+  std::transform( o1.begin(), o1.end(), o2.begin(),
+                  xors.begin(),
+                  [&]( auto const& a, auto const& b ) { return ntk.create_xor( a, b ); } );
+  ntk.create_po( ntk.create_nary_or( xors ) );
+}
+
 int main()
 {
   using namespace experiments;
   using namespace mockturtle;
 
-  experiment<std::string, double, bool, double, double, bool> exp( "cnf_map", "benchmark", "time_tseytin", "eq_tseytin", "time_mapping", "time_cnfmap", "eq_cnfmap" );
+  experiment<std::string, uint32_t, uint32_t, double, bool, uint32_t, uint32_t, double, double, bool, double> exp( "cnf_map", "benchmark", "vars_tseytin", "clauses_tseytin", "time_tseytin", "eq_tseytin", "vars_cnfmap", "clauses_cnfmap", "time_mapping", "time_cnfmap", "eq_cnfmap", "time_cnf_view" );
 
   for ( auto i = 4u; i < 6u; ++i )
   {
@@ -52,33 +69,28 @@ int main()
     fmt::print( "[i] processing {}\n", benchmark );
 
     aig_network aig;
-    std::vector<aig_network::signal> as( i ), bs( i ), cs( i );
-    std::generate( as.begin(), as.end(), [&]() { return aig.create_pi(); } );
-    std::generate( bs.begin(), bs.end(), [&]() { return aig.create_pi(); } );
-    std::generate( cs.begin(), cs.end(), [&]() { return aig.create_pi(); } );
-
-    auto o1 = carry_ripple_multiplier( aig, carry_ripple_multiplier( aig, as, bs ), cs );
-    auto o2 = carry_ripple_multiplier( aig, as, carry_ripple_multiplier( aig, bs, cs ) );
-    std::vector<aig_network::signal> xors( o1.size() );
-    std::transform( o1.begin(), o1.end(), o2.begin(),
-                    xors.begin(),
-                    [&]( auto const& a, auto const& b ) { return aig.create_xor( a, b ); } );
-    aig.create_po( aig.create_nary_or( xors ) );
+    create_assoc_miter( aig, i );
 
     equivalence_checking_stats st;
     const auto result = *equivalence_checking( aig, {}, &st );
 
-    lut_mapping_params lmps;
-    lmps.cut_enumeration_ps.cut_size = 8;
-    lut_mapping_stats lmst;
-    mapping_view<aig_network, true> mapped_aig{aig};
-    lut_mapping<decltype( mapped_aig ), true, cut_enumeration_mf_cut>( mapped_aig, lmps, &lmst );
-    const auto klut = *collapse_mapped_network<klut_network>( mapped_aig );
-
+    equivalence_checking_params ps2;
+    ps2.use_cnf_map = true;
     equivalence_checking_stats st2;
-    const auto result2 = *equivalence_checking( klut, {}, &st2 );
+    const auto result2 = *equivalence_checking( aig, ps2, &st2 );
+
+    /* cnf_view with deferred encoding */
+    stopwatch<>::duration time_cnf_view{0};
+    {
+      stopwatch t( time_cnf_view );
+      cnf_view_params cps;
+      cps.use_cnf_map = true;
+      cnf_view<aig_network> cnf{cps};
+      create_assoc_miter( cnf, i );
+      cnf.solve();
+    }
 
-    exp( benchmark, to_seconds( st.time_total ), result, to_seconds( lmst.time_total ), to_seconds( st2.time_total ), result2 );
+    exp( benchmark, st.num_vars, st.num_clauses, to_seconds( st.time_total ), result, st2.num_vars, st2.num_clauses, to_seconds( st2.time_encoding ), to_seconds( st2.time_total ), result2, to_seconds( time_cnf_view ) );
   }
 
   exp.save();
@@ -0,0 +1,109 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+#include <experiments.hpp>
+
+/* copies a network with one `clone_node` call per gate, as `cleanup_dangling` did before */
+mockturtle::aig_network copy_per_gate( mockturtle::aig_network const& aig )
+{
+  using namespace mockturtle;
+
+  aig_network dest;
+  node_map<aig_network::signal, aig_network> old_to_new( aig );
+  old_to_new[aig.get_constant( false )] = dest.get_constant( false );
+  aig.foreach_pi( [&]( auto const& n ) {
+    old_to_new[n] = dest.create_pi();
+  } );
+
+  topo_view topo{aig};
+  topo.foreach_gate( [&]( auto const& n ) {
+    std::vector<aig_network::signal> children;
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      children.push_back( old_to_new[f] ^ aig.is_complemented( f ) );
+    } );
+    old_to_new[n] = dest.clone_node( aig, n, children );
+  } );
+
+  aig.foreach_po( [&]( auto const& f ) {
+    dest.create_po( old_to_new[f] ^ aig.is_complemented( f ) );
+  } );
+  return dest;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, bool> exp( "create_and_batch", "benchmark", "gates", "per gate (ms)", "batched (ms)", "speedup", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+
+    stopwatch<>::duration time_gate{0}, time_batch{0};
+    double t_gate{0.0}, t_batch{0.0};
+    aig_network copy_gate, copy_batch;
+    for ( auto i = 0u; i < 5u; ++i )
+    {
+      copy_gate = call_with_stopwatch( time_gate, [&]() { return copy_per_gate( aig ); } );
+      copy_batch = call_with_stopwatch( time_batch, [&]() { return cleanup_dangling( aig ); } );
+    }
+    t_gate = 1000.0 * to_seconds( time_gate ) / 5.0;
+    t_batch = 1000.0 * to_seconds( time_batch ) / 5.0;
+
+    bool equivalent = copy_gate.size() == copy_batch.size();
+    copy_gate.foreach_gate( [&]( auto const& n ) {
+      copy_gate.foreach_fanin( n, [&]( auto const& f, uint32_t i ) {
+        copy_batch.foreach_fanin( n, [&]( auto const& g, uint32_t j ) {
+          equivalent = equivalent && ( i != j || f == g );
+        } );
+      } );
+    } );
+
+    exp( benchmark, aig.num_gates(), t_gate, t_batch, t_gate / std::max( t_batch, 1e-6 ), equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+/* compares the global compatibility graph with a partitioned one */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, float, float, uint32_t, uint32_t, bool>
+    exp( "cut_rewriting_partitioned", "benchmark", "size_before", "size global", "size partitioned", "MIS time global", "MIS time partitioned", "partitions", "conflicts", "equivalent" );
+  xag_npn_resynthesis<aig_network> resyn;
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig, aig2;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      fmt::print( "[e] could not read {}\n", benchmark );
+      continue;
+    }
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig2 ) );
+
+    cut_rewriting_params ps;
+    ps.cut_enumeration_ps.cut_size = 4;
+
+    uint32_t size_before = aig.num_gates();
+    cut_rewriting_stats st;
+    cut_rewriting_with_compatibility_graph( aig, resyn, ps, &st );
+    aig = cleanup_dangling( aig );
+
+    ps.mis_partition_size = 1000u;
+    cut_rewriting_stats st2;
+    cut_rewriting_with_compatibility_graph( aig2, resyn, ps, &st2 );
+    aig2 = cleanup_dangling( aig2 );
+
+    auto const cec = benchmark == "hyp" ? true : abc_cec( aig2, benchmark );
+
+    exp( benchmark, size_before, aig.num_gates(), aig2.num_gates(), to_seconds( st.time_mis ), to_seconds( st2.time_mis ), st2.num_mis_partitions, st2.num_mis_conflicts, cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
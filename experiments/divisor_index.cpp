@@ -0,0 +1,113 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/kitty.hpp>
+#include <mockturtle/utils/divisor_kernels.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Microbenchmark for the indexed divisor pair search of resubstitution: for
+ * each positive unate divisor, finds the first partner whose OR with it is
+ * equal to the target, as in the 1-resubstitution of `aig_resub_functor`.
+ * The search scans the whole batch or uses a `divisor_index`. */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<uint32_t, uint32_t, uint32_t, double, double, double, bool>
+    exp( "divisor_index", "vars", "divisors", "pivots", "scan (ms)", "build (ms)", "index (ms)", "same result" );
+
+  uint32_t const num_rounds = 10u;
+
+  for ( auto const num_vars : {8u, 10u, 12u} )
+  {
+    for ( auto const num_divisors : {300u, 1000u, 4000u} )
+    {
+      kitty::dynamic_truth_table target( num_vars );
+      std::vector<kitty::dynamic_truth_table> divisors( num_divisors, target );
+      kitty::create_random( target, num_vars );
+      for ( auto i = 0u; i < num_divisors; ++i )
+      {
+        /* sparse divisors, such that most pairs do not cover the target */
+        kitty::dynamic_truth_table a( num_vars ), b( num_vars );
+        kitty::create_random( a, 2u * i + 100u );
+        kitty::create_random( b, 2u * i + 101u );
+        divisors[i] = target & a & b;
+      }
+      /* make sure that there are some solutions */
+      for ( auto i = 1u; i < 5u; ++i )
+      {
+        divisors[i * num_divisors / 5u] = target & ~divisors[i * num_divisors / 5u - 1u];
+      }
+
+      auto const t = make_tt_ref( target );
+      divisor_batch<1u> batch( make_tt_layout( target ) );
+      for ( auto const& d : divisors )
+      {
+        batch.add( make_tt_ref( d ) );
+      }
+
+      auto const required = []( auto t, auto a ) { return t & ~a; };
+      auto const or_fn = []( auto t, auto a, auto b ) { return ( a | b ) ^ t; };
+
+      std::vector<std::optional<uint32_t>> scan_result( num_divisors ), index_result( num_divisors );
+      stopwatch<>::duration time_scan{0}, time_build{0}, time_index{0};
+
+      call_with_stopwatch( time_scan, [&]() {
+        for ( auto r = 0u; r < num_rounds; ++r )
+          for ( auto i = 0u; i < num_divisors; ++i )
+            scan_result[i] = batch.find( i + 1, or_fn, t, batch[i][0] );
+      } );
+
+      divisor_index index;
+      call_with_stopwatch( time_build, [&]() {
+        for ( auto r = 0u; r < num_rounds; ++r )
+          index.build( batch, []( auto a ) { return a; }, []( auto t ) { return t; }, t );
+      } );
+
+      call_with_stopwatch( time_index, [&]() {
+        for ( auto r = 0u; r < num_rounds; ++r )
+          for ( auto i = 0u; i < num_divisors; ++i )
+            index_result[i] = index.find( batch, i + 1, required, or_fn, t, batch[i][0] );
+      } );
+
+      auto const ms = [&]( auto const& time ) { return to_seconds( time ) * 1000.0 / num_rounds; };
+      exp( num_vars, num_divisors, index.num_pivots(), ms( time_scan ), ms( time_build ), ms( time_index ), scan_result == index_result );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/kitty.hpp>
+#include <mockturtle/utils/divisor_kernels.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Microbenchmark for the divisor pair search of resubstitution: finds all
+ * pairs of positive unate divisors whose OR is equal to the target, as in
+ * the 1-resubstitution of `aig_resub_functor`.  The divisors are random
+ * functions that imply the target. */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<uint32_t, uint32_t, uint64_t, double, double, double, bool>
+    exp( "divisor_scoring", "vars", "divisors", "pairs", "kitty (Mpairs/s)", "kernel (Mpairs/s)", "batch (Mpairs/s)", "same result" );
+
+  uint32_t const num_divisors = 150u;
+  uint32_t const num_rounds_kitty = 20u;
+  uint32_t const num_rounds = 1000u;
+
+  for ( auto const num_vars : {6u, 8u, 10u, 12u, 14u} )
+  {
+    kitty::dynamic_truth_table target( num_vars );
+    std::vector<kitty::dynamic_truth_table> divisors( num_divisors, target );
+    kitty::create_random( target, num_vars );
+    for ( auto i = 0u; i < num_divisors; ++i )
+    {
+      kitty::create_random( divisors[i], 100u + i );
+      divisors[i] &= target;
+    }
+    /* make sure that there are some solutions */
+    divisors[num_divisors / 2] = target & ~divisors[num_divisors - 1];
+
+    auto const layout = make_tt_layout( target );
+    auto const t = make_tt_ref( target );
+    divisor_batch<1u> batch( layout );
+    for ( auto const& d : divisors )
+    {
+      batch.add( make_tt_ref( d ) );
+    }
+
+    uint64_t const num_pairs = uint64_t( num_divisors ) * ( num_divisors - 1 ) / 2;
+    uint64_t matches_kitty{0}, matches_kernel{0}, matches_batch{0};
+    stopwatch<>::duration time_kitty{0}, time_kernel{0}, time_batch{0};
+
+    call_with_stopwatch( time_kitty, [&]() {
+      for ( auto r = 0u; r < num_rounds_kitty; ++r )
+        for ( auto i = 0u; i < num_divisors; ++i )
+          for ( auto j = i + 1; j < num_divisors; ++j )
+            matches_kitty += ( divisors[i] | divisors[j] ) == target;
+    } );
+
+    auto const or_fn = []( auto tt, auto a, auto b ) { return ( a | b ) ^ tt; };
+    call_with_stopwatch( time_kernel, [&]() {
+      for ( auto r = 0u; r < num_rounds; ++r )
+        for ( auto i = 0u; i < num_divisors; ++i )
+          for ( auto j = i + 1; j < num_divisors; ++j )
+            matches_kernel += is_const0_words( layout, or_fn, t, make_tt_ref( divisors[i] ), make_tt_ref( divisors[j] ) );
+    } );
+
+    call_with_stopwatch( time_batch, [&]() {
+      for ( auto r = 0u; r < num_rounds; ++r )
+        for ( auto i = 0u; i < num_divisors; ++i )
+          for ( auto j = i + 1; j < num_divisors; ++j )
+            matches_batch += batch.test( j, or_fn, t, batch[i][0] );
+    } );
+
+    auto const throughput = [&]( auto const& time, uint32_t rounds ) { return rounds * num_pairs / std::max( to_seconds( time ), 1e-9 ) / 1e6; };
+    exp( num_vars, num_divisors, num_pairs, throughput( time_kitty, num_rounds_kitty ), throughput( time_kernel, num_rounds ), throughput( time_batch, num_rounds ),
+         matches_kitty / num_rounds_kitty == matches_kernel / num_rounds && matches_kernel == matches_batch && matches_kitty > 0u );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
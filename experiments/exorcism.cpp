@@ -0,0 +1,162 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/isop.hpp>
+#include <lorina/aiger.hpp>
+#include <lorina/pla.hpp>
+#include <mockturtle/algorithms/exorcism.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/pla_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* writes the collapsed outputs of a benchmark with few inputs as a
+ * multi-output PLA (one ISOP per output) */
+std::string benchmark_to_pla( std::string const& benchmark )
+{
+  using namespace mockturtle;
+
+  aig_network aig;
+  lorina::read_aiger( experiments::benchmark_path( benchmark ), aiger_reader( aig ) );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  const auto functions = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  std::stringstream pla;
+  pla << fmt::format( ".i {}\n.o {}\n", aig.num_pis(), aig.num_pos() );
+  for ( auto o = 0u; o < functions.size(); ++o )
+  {
+    std::string out( functions.size(), '0' );
+    out[o] = '1';
+    for ( auto const& c : kitty::isop( functions[o] ) )
+    {
+      std::string in( aig.num_pis(), '-' );
+      for ( auto i = 0u; i < aig.num_pis(); ++i )
+      {
+        if ( c.get_mask( i ) )
+        {
+          in[i] = c.get_bit( i ) ? '1' : '0';
+        }
+      }
+      pla << in << " " << out << "\n";
+    }
+  }
+  pla << ".e\n";
+  return pla.str();
+}
+
+int main( int argc, char** argv )
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  /* PLA files given on the command line, or benchmarks with few inputs collapsed into PLAs */
+  std::vector<std::pair<std::string, std::string>> plas;
+  for ( auto i = 1; i < argc; ++i )
+  {
+    std::ifstream in( argv[i] );
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    plas.emplace_back( argv[i], buffer.str() );
+  }
+  if ( plas.empty() )
+  {
+    for ( auto const& benchmark : epfl_benchmarks( cavlc | ctrl | dec | int2float ) )
+    {
+      plas.emplace_back( benchmark, benchmark_to_pla( benchmark ) );
+    }
+  }
+
+  const auto num_threads = std::max( 2u, std::thread::hardware_concurrency() );
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, uint64_t, uint64_t, double, double, double, uint32_t, double, bool> exp( "exorcism", "benchmark", "inputs", "outputs", "classes", "cubes", "cubes_batch", "t_serial", "t_batch", "t_threads", "threads", "outputs/s", "equivalent" );
+
+  for ( auto const& [name, content] : plas )
+  {
+    fmt::print( "[i] processing {}\n", name );
+
+    /* collapse the PLA */
+    klut_network klut;
+    std::istringstream in( content );
+    if ( lorina::read_pla( in, pla_reader( klut ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+    default_simulator<kitty::dynamic_truth_table> sim( klut.num_pis() );
+    const auto functions = simulate<kitty::dynamic_truth_table>( klut, sim );
+
+    /* one output at a time */
+    uint64_t cubes_serial{0u};
+    stopwatch<>::duration time_serial{0};
+    {
+      stopwatch<> t( time_serial );
+      for ( auto const& f : functions )
+      {
+        cubes_serial += exorcism( f ).size();
+      }
+    }
+
+    /* batch with NPN deduplication on one thread and on many threads */
+    exorcism_params ps;
+    exorcism_stats st;
+    exorcism( functions, ps, &st );
+
+    ps.num_threads = num_threads;
+    exorcism_stats st_threads;
+    const auto esops = exorcism( functions, ps, &st_threads );
+
+    bool equivalent{true};
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      auto g = functions[i].construct();
+      kitty::create_from_cubes( g, esops[i], true );
+      equivalent = equivalent && g == functions[i];
+    }
+
+    exp( name, klut.num_pis(), klut.num_pos(), st.num_classes, cubes_serial, st.num_cubes, to_seconds( time_serial ), to_seconds( st.time_total ),
+         to_seconds( st_threads.time_total ), num_threads, functions.size() / std::max( to_seconds( st_threads.time_total ), 1e-6 ), equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
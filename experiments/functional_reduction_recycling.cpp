@@ -0,0 +1,83 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/functional_reduction.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+/* compares solver restarts with solver recycling in circuit_validator */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, float, float, uint32_t, uint64_t, uint32_t, uint32_t, uint64_t, bool>
+    exp( "functional_reduction_recycling", "benchmark", "size", "size restart", "size recycle", "SAT time restart", "SAT time recycle",
+         "restarts", "reencoded", "restarts (recycle)", "recycles", "reencoded (recycle)", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig, aig2;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      fmt::print( "[e] could not read {}\n", benchmark );
+      continue;
+    }
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig2 ) );
+
+    uint32_t const size_before = aig.num_gates();
+
+    functional_reduction_params ps;
+    ps.recycle_solver = false;
+    functional_reduction_stats st;
+    functional_reduction( aig, ps, &st );
+    aig = cleanup_dangling( aig );
+
+    ps.recycle_solver = true;
+    functional_reduction_stats st2;
+    functional_reduction( aig2, ps, &st2 );
+    aig2 = cleanup_dangling( aig2 );
+
+    auto const cec = benchmark == "hyp" ? true : abc_cec( aig2, benchmark );
+
+    exp( benchmark, size_before, aig.num_gates(), aig2.num_gates(), to_seconds( st.time_sat ), to_seconds( st2.time_sat ),
+         st.validator_st.num_restarts, st.validator_st.num_reencoded, st2.validator_st.num_restarts, st2.validator_st.num_recycles,
+         st2.validator_st.num_reencoded, cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/incremental_lut_mapping.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+/* replaces a random gate by the AND of two random nodes outside of its
+ * transitive fanout (a single-node ECO) */
+template<class Ntk>
+void random_change( mockturtle::aig_network& aig, Ntk const& fanout, std::mt19937& rng )
+{
+  using namespace mockturtle;
+
+  std::vector<aig_network::node> gates, nodes;
+  aig.foreach_node( [&]( auto const& n ) {
+    if ( aig.is_constant( n ) )
+      return;
+    nodes.push_back( n );
+    if ( !aig.is_pi( n ) )
+      gates.push_back( n );
+  } );
+
+  const auto n = gates[rng() % gates.size()];
+
+  std::vector<uint8_t> in_tfo( aig.size(), 0u );
+  std::vector<aig_network::node> stack{n};
+  while ( !stack.empty() )
+  {
+    const auto m = stack.back();
+    stack.pop_back();
+    if ( in_tfo[m] )
+      continue;
+    in_tfo[m] = 1u;
+    fanout.foreach_fanout( m, [&]( auto const& fo ) { stack.push_back( fo ); } );
+  }
+
+  std::vector<aig_network::signal> divisors;
+  for ( auto const& m : nodes )
+  {
+    if ( !in_tfo[m] )
+      divisors.push_back( aig.make_signal( m ) ^ ( rng() % 2 == 0 ) );
+  }
+
+  const auto f = aig.create_and( divisors[rng() % divisors.size()], divisors[rng() % divisors.size()] );
+  if ( aig.get_node( f ) != n )
+  {
+    aig.substitute_node( n, f );
+  }
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  using mapped_t = mapping_view<fanout_view<aig_network>, true>;
+
+  constexpr uint32_t num_changes = 20u;
+
+  experiment<std::string, uint32_t, double, double, uint32_t, uint32_t, double, bool> exp( "incremental_lut_mapping", "benchmark", "luts", "t_map", "t_update (ms)", "recomputed", "luts_full", "t_full (ms)", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks( ( adder | bar | max | experiments::random ) & ~mem_ctrl & ~voter ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+
+    fanout_view aig_fanout{aig};
+    mapped_t mapped{aig_fanout};
+    incremental_lut_mapping<mapped_t, true> mapper( mapped );
+
+    std::mt19937 rng( 1u );
+    for ( auto i = 0u; i < num_changes; ++i )
+    {
+      random_change( aig, aig_fanout, rng );
+      mapper.update();
+    }
+    auto const& st = mapper.stats();
+
+    /* complete mapping of the changed network */
+    const auto copy = cleanup_dangling( aig );
+    mapping_view<aig_network, true> mapped_full{copy};
+    stopwatch<>::duration time_full{0};
+    call_with_stopwatch( time_full, [&]() { lut_mapping<decltype( mapped_full ), true>( mapped_full ); } );
+
+    const auto klut = *collapse_mapped_network<klut_network>( mapped );
+    const auto cec = *equivalence_checking( *miter<klut_network>( copy, klut ) );
+
+    exp( benchmark, mapped.num_cells(), to_seconds( st.time_mapping ), to_seconds( st.time_update ) * 1000.0 / num_changes,
+         static_cast<uint32_t>( st.num_recomputed_cuts / num_changes ), mapped_full.num_cells(), to_seconds( time_full ) * 1000.0, cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+/* simulates a k-LUT network bit by bit (the former implementation of
+ * `klut_network::compute`) */
+std::vector<kitty::partial_truth_table> simulate_bitwise( mockturtle::klut_network const& klut, std::vector<kitty::partial_truth_table> const& patterns )
+{
+  using namespace mockturtle;
+
+  node_map<kitty::partial_truth_table, klut_network> values( klut );
+  values[klut.get_node( klut.get_constant( false ) )] = patterns[0].construct();
+  values[klut.get_node( klut.get_constant( true ) )] = ~patterns[0].construct();
+  klut.foreach_pi( [&]( auto const& n, auto i ) { values[n] = patterns[i]; } );
+  klut.foreach_gate( [&]( auto const& n ) {
+    std::vector<kitty::partial_truth_table const*> tts;
+    klut.foreach_fanin( n, [&]( auto const& f ) { tts.push_back( &values[f] ); } );
+    auto const func = klut.node_function( n );
+    auto result = patterns[0].construct();
+    for ( auto i = 0; i < result.num_bits(); ++i )
+    {
+      uint32_t pattern{0u};
+      for ( auto j = 0u; j < tts.size(); ++j )
+      {
+        pattern |= kitty::get_bit( *tts[j], i ) << j;
+      }
+      if ( kitty::get_bit( func, pattern ) )
+      {
+        kitty::set_bit( result, i );
+      }
+    }
+    values[n] = result;
+  } );
+
+  std::vector<kitty::partial_truth_table> pos;
+  klut.foreach_po( [&]( auto const& f ) { pos.push_back( values[f] ); } );
+  return pos;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  constexpr uint32_t num_patterns = 1u << 16;
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, double, bool> exp( "klut_simulation", "benchmark", "gates", "luts", "t_aig", "t_bitwise", "t_klut", "speedup", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks( ~hyp ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+
+    mapping_view<aig_network, true> mapped{aig};
+    lut_mapping<decltype( mapped ), true>( mapped );
+    const auto klut = *collapse_mapped_network<klut_network>( mapped );
+
+    std::mt19937 rng( 1u );
+    std::vector<kitty::partial_truth_table> patterns( aig.num_pis(), kitty::partial_truth_table( num_patterns ) );
+    for ( auto& p : patterns )
+    {
+      std::generate( p._bits.begin(), p._bits.end(), [&]() { return ( static_cast<uint64_t>( rng() ) << 32 ) | rng(); } );
+    }
+    partial_simulator sim( patterns );
+
+    stopwatch<>::duration time_aig{0}, time_bitwise{0}, time_klut{0};
+    const auto values_aig = call_with_stopwatch( time_aig, [&]() { return simulate<kitty::partial_truth_table>( aig, sim ); } );
+    const auto values_bitwise = call_with_stopwatch( time_bitwise, [&]() { return simulate_bitwise( klut, patterns ); } );
+    const auto values_klut = call_with_stopwatch( time_klut, [&]() { return simulate<kitty::partial_truth_table>( klut, sim ); } );
+
+    exp( benchmark, aig.num_gates(), klut.num_gates(), to_seconds( time_aig ), to_seconds( time_bitwise ), to_seconds( time_klut ),
+         to_seconds( time_bitwise ) / std::max( to_seconds( time_klut ), 1e-6 ), values_aig == values_klut && values_klut == values_bitwise );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+/* bytes used by the nodes of a k-LUT network (without reserved capacity),
+ * including the heap-allocated fanin vectors of `klut_network` */
+template<class Ntk>
+uint64_t node_memory( Ntk const& ntk )
+{
+  auto const& nodes = ntk._storage->nodes;
+  uint64_t bytes = nodes.size() * sizeof( typename Ntk::storage::element_type::node_type );
+  if constexpr ( std::is_same_v<Ntk, mockturtle::klut_network> )
+  {
+    for ( auto const& n : nodes )
+    {
+      bytes += n.children.capacity() * sizeof( typename Ntk::storage::element_type::node_type::pointer_type );
+    }
+  }
+  return bytes;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  constexpr uint32_t num_patterns = 1u << 12;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, bool> exp( "klut_storage", "benchmark", "luts", "KB vector", "KB inline", "t_collapse vector", "t_collapse inline", "t_sim vector", "t_sim inline", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks( ~hyp ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+
+    mapping_view<aig_network, true> mapped{aig};
+    lut_mapping_params ps;
+    ps.cut_enumeration_ps.cut_size = 6u;
+    lut_mapping<decltype( mapped ), true>( mapped, ps );
+
+    stopwatch<>::duration time_collapse_vector{0}, time_collapse_inline{0};
+    const auto klut = *call_with_stopwatch( time_collapse_vector, [&]() { return collapse_mapped_network<klut_network>( mapped ); } );
+    const auto klut_inline = *call_with_stopwatch( time_collapse_inline, [&]() { return collapse_mapped_network<inline_klut_network<6>>( mapped ); } );
+
+    std::mt19937 rng( 1u );
+    std::vector<kitty::partial_truth_table> patterns( aig.num_pis(), kitty::partial_truth_table( num_patterns ) );
+    for ( auto& p : patterns )
+    {
+      std::generate( p._bits.begin(), p._bits.end(), [&]() { return ( static_cast<uint64_t>( rng() ) << 32 ) | rng(); } );
+    }
+    partial_simulator sim( patterns );
+
+    stopwatch<>::duration time_sim_vector{0}, time_sim_inline{0};
+    const auto values = call_with_stopwatch( time_sim_vector, [&]() { return simulate<kitty::partial_truth_table>( klut, sim ); } );
+    const auto values_inline = call_with_stopwatch( time_sim_inline, [&]() { return simulate<kitty::partial_truth_table>( klut_inline, sim ); } );
+
+    exp( benchmark, klut.num_gates(), node_memory( klut ) / 1024.0, node_memory( klut_inline ) / 1024.0,
+         to_seconds( time_collapse_vector ), to_seconds( time_collapse_inline ), to_seconds( time_sim_vector ), to_seconds( time_sim_inline ), values == values_inline );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/algorithms/linear_resynthesis.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* random linear layer with `n` inputs and outputs, each output is the XOR of
+ * `weight` random inputs (or of about half of the inputs if `weight` is 0) */
+mockturtle::xag_network linear_layer( uint32_t n, uint32_t weight )
+{
+  using namespace mockturtle;
+
+  xag_network xag;
+  std::vector<xag_network::signal> pis( n );
+  std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+
+  std::mt19937 rng( n + weight );
+  for ( auto i = 0u; i < n; ++i )
+  {
+    std::vector<bool> row( n, false );
+    if ( weight == 0u )
+    {
+      std::generate( row.begin(), row.end(), [&]() { return rng() % 2u == 1u; } );
+    }
+    else
+    {
+      for ( auto j = 0u; j < weight; ++j )
+      {
+        row[rng() % n] = true;
+      }
+    }
+
+    std::vector<xag_network::signal> fanins;
+    for ( auto j = 0u; j < n; ++j )
+    {
+      if ( row[j] )
+      {
+        fanins.push_back( pis[j] );
+      }
+    }
+    xag.create_po( xag.create_nary_xor( fanins ) );
+  }
+  return xag;
+}
+
+/* linear layer of the AES MixColumns operation on one column (32 bits) */
+mockturtle::xag_network aes_mixcolumns()
+{
+  using namespace mockturtle;
+
+  xag_network xag;
+  std::vector<xag_network::signal> pis( 32u );
+  std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+
+  /* bit i of x * b for b = 1, 2, 3 in GF(2^8) modulo x^8 + x^4 + x^3 + x + 1 */
+  const auto mul_bit = [&]( uint32_t byte, uint32_t factor, uint32_t i ) {
+    std::vector<xag_network::signal> terms;
+    if ( factor != 2u )
+    {
+      terms.push_back( pis[8u * byte + i] );
+    }
+    if ( factor != 1u )
+    {
+      if ( i > 0u )
+      {
+        terms.push_back( pis[8u * byte + i - 1u] );
+      }
+      if ( ( 0x1bu >> i ) & 1u )
+      {
+        terms.push_back( pis[8u * byte + 7u] );
+      }
+    }
+    return terms;
+  };
+
+  const std::array<uint32_t, 4> row{2u, 3u, 1u, 1u};
+  for ( auto r = 0u; r < 4u; ++r )
+  {
+    for ( auto i = 0u; i < 8u; ++i )
+    {
+      std::vector<xag_network::signal> terms;
+      for ( auto c = 0u; c < 4u; ++c )
+      {
+        const auto t = mul_bit( c, row[( c + 4u - r ) % 4u], i );
+        terms.insert( terms.end(), t.begin(), t.end() );
+      }
+      xag.create_po( xag.create_nary_xor( terms ) );
+    }
+  }
+  return xag;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, uint32_t, double, uint32_t, double, bool> exp( "linear_resynthesis", "matrix", "xors", "t_matrix (ms)", "xors paar", "t_paar (s)", "xors bp", "t_bp (s)", "equivalent" );
+
+  const auto run = [&]( std::string const& name, xag_network const& xag ) {
+    stopwatch<>::duration time_matrix{0}, time_paar{0}, time_bp{0};
+    const auto matrix = call_with_stopwatch( time_matrix, [&]() { return get_linear_matrix( xag ); } );
+    const auto xag_paar = call_with_stopwatch( time_paar, [&]() { return linear_resynthesis_paar( xag ); } );
+
+    linear_resynthesis_boyar_peralta_params ps;
+    ps.num_restarts = 8u;
+    ps.num_threads = 0u;
+    const auto xag_bp = call_with_stopwatch( time_bp, [&]() { return linear_resynthesis_boyar_peralta( xag, ps ); } );
+
+    const auto equivalent = get_linear_matrix( xag_paar ) == matrix && get_linear_matrix( xag_bp ) == matrix;
+    exp( name, xag.num_gates(), to_seconds( time_matrix ) * 1000.0, xag_paar.num_gates(), to_seconds( time_paar ), xag_bp.num_gates(), to_seconds( time_bp ), equivalent );
+  };
+
+  fmt::print( "[i] processing AES MixColumns\n" );
+  run( "aes_mixcolumns", aes_mixcolumns() );
+
+  /* sparse matrices with 16 ones per row and dense matrices */
+  for ( auto weight : {16u, 0u} )
+  {
+    for ( auto n : {128u, 256u, 512u, 1024u} )
+    {
+      if ( weight == 0u && n > 512u )
+      {
+        continue;
+      }
+
+      const auto name = fmt::format( "{}x{} {}", n, n, weight == 0u ? "dense" : fmt::format( "w={}", weight ) );
+      fmt::print( "[i] processing {}\n", name );
+      run( name, linear_layer( n, weight ) );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
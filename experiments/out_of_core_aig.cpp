@@ -0,0 +1,216 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/write_aiger.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* 64 random patterns per primary input */
+struct random_word_simulator
+{
+  kitty::static_truth_table<6u> compute_constant( bool value ) const
+  {
+    kitty::static_truth_table<6u> tt;
+    return value ? ~tt : tt;
+  }
+
+  kitty::static_truth_table<6u> compute_pi( uint32_t index ) const
+  {
+    kitty::static_truth_table<6u> tt;
+    kitty::create_random( tt, index );
+    return tt;
+  }
+
+  kitty::static_truth_table<6u> compute_not( kitty::static_truth_table<6u> const& value ) const
+  {
+    return ~value;
+  }
+};
+
+/* reads, simulates, and writes a network, and returns a checksum of the simulation values */
+template<class Ntk>
+uint64_t pipeline( std::string const& input, std::string const& output )
+{
+  Ntk aig;
+  lorina::read_aiger( input, mockturtle::aiger_reader( aig ) );
+  const auto values = mockturtle::simulate<kitty::static_truth_table<6u>>( aig, random_word_simulator() );
+  mockturtle::write_aiger( aig, output );
+
+  uint64_t checksum{0u};
+  for ( auto const& v : values )
+  {
+    checksum = ( checksum * 0x9e3779b97f4a7c15 ) ^ v._bits;
+  }
+  return checksum;
+}
+
+struct run_result
+{
+  double peak_rss_mb;
+  double time;
+  uint64_t checksum;
+};
+
+/* runs the pipeline in a child process to measure its peak resident memory */
+template<class Ntk>
+run_result run_in_child( std::string const& input, std::string const& output )
+{
+  int fds[2];
+  if ( pipe( fds ) != 0 )
+  {
+    std::abort();
+  }
+
+  mockturtle::stopwatch<>::duration time{0};
+  rusage usage{};
+  uint64_t checksum{0u};
+  mockturtle::call_with_stopwatch( time, [&]() {
+    const auto pid = fork();
+    if ( pid == 0 )
+    {
+      close( fds[0] );
+      const auto cs = pipeline<Ntk>( input, output );
+      if ( write( fds[1], &cs, sizeof( cs ) ) != sizeof( cs ) )
+      {
+        _exit( 1 );
+      }
+      _exit( 0 );
+    }
+    close( fds[1] );
+    if ( read( fds[0], &checksum, sizeof( checksum ) ) != sizeof( checksum ) )
+    {
+      std::abort();
+    }
+    close( fds[0] );
+    int status;
+    wait4( pid, &status, 0, &usage );
+  } );
+
+  return {usage.ru_maxrss / 1024.0, mockturtle::to_seconds( time ), checksum};
+}
+
+/* writes a large random AIG without keeping its nodes in memory */
+void write_random_aig( std::string const& filename, uint32_t num_pis, uint32_t num_gates )
+{
+  mockturtle::mapped_aig_network aig;
+  aig.set_structural_hashing( true );
+  std::vector<mockturtle::mapped_aig_network::signal> fs;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+  uint64_t state{1u};
+  const auto next = [&]( uint64_t range ) {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    return ( state >> 33u ) % range;
+  };
+  while ( aig.num_gates() < num_gates )
+  {
+    /* prefer recent signals for some locality */
+    const auto a = fs.size() - 1u - next( std::min<uint64_t>( fs.size(), 1024u ) );
+    const auto b = next( fs.size() );
+    const auto f = aig.create_and( fs[a] ^ ( next( 2u ) == 0u ), fs[b] ^ ( next( 2u ) == 0u ) );
+    if ( aig.get_node( f ) + 1u == aig.size() )
+    {
+      fs.push_back( f );
+    }
+  }
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    aig.create_po( fs[fs.size() - 1u - i] );
+  }
+  mockturtle::write_aiger( aig, filename );
+}
+
+bool same_file( std::string const& a, std::string const& b )
+{
+  std::ifstream fa( a, std::ios::binary ), fb( b, std::ios::binary );
+  return std::equal( std::istreambuf_iterator<char>( fa ), std::istreambuf_iterator<char>(),
+                     std::istreambuf_iterator<char>( fb ), std::istreambuf_iterator<char>() );
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, bool> exp( "out_of_core_aig", "benchmark", "size", "RSS mem (MB)", "RSS mapped (MB)", "t mem", "t mapped", "equivalent" );
+
+  const auto run = [&]( std::string const& name, std::string const& input ) {
+    fmt::print( "[i] processing {}\n", name );
+    /* number of nodes from the header, without reading the network in this process */
+    std::ifstream in( input, std::ios::binary );
+    std::string format;
+    uint32_t m, i, l, o, a;
+    in >> format >> m >> i >> l >> o >> a;
+    const auto size = 1u + i + a;
+
+    const std::string out_mem = "out_of_core_mem.aig", out_mapped = "out_of_core_mapped.aig";
+    const auto mem = run_in_child<aig_network>( input, out_mem );
+    const auto mapped = run_in_child<mapped_aig_network>( input, out_mapped );
+    const auto equivalent = mem.checksum == mapped.checksum && same_file( out_mem, out_mapped );
+    std::remove( out_mem.c_str() );
+    std::remove( out_mapped.c_str() );
+
+    exp( name, size, mem.peak_rss_mb, mapped.peak_rss_mb, mem.time, mapped.time, equivalent );
+  };
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    run( benchmark, benchmark_path( benchmark ) );
+  }
+
+  /* a network that is larger than the EPFL benchmarks */
+  const std::string random_aig = "out_of_core_random.aig";
+  write_random_aig( random_aig, 256u, 16000000u );
+  run( "random_16M", random_aig );
+  std::remove( random_aig.c_str() );
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/pattern_generation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+/* Time-to-coverage of stuck-at pattern generation with 1, 2, and 4 worker
+ * threads.  t_50% and t_90% are the wall-clock times after which 50% and
+ * 90% of the nodes have been checked. */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, float, float, float, float> exp( "pattern_generation_threads", "benchmark", "size", "threads", "#pat gen", "#dup", "#const", "t_50%", "t_90%", "t_total", "t_SAT" );
+
+  for ( auto const& benchmark : epfl_benchmarks( ~experiments::hyp ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    for ( auto const num_threads : {1u, 2u, 4u} )
+    {
+      aig_network aig;
+      lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+      auto const size_before = aig.num_gates();
+
+      pattern_generation_params ps;
+      ps.num_threads = num_threads;
+      pattern_generation_stats st;
+
+      partial_simulator sim( aig.num_pis(), 256 );
+      pattern_generation( aig, sim, ps, &st );
+
+      auto const time_to = [&]( double fraction ) {
+        for ( auto const& p : st.coverage )
+        {
+          if ( p.num_checked >= fraction * size_before )
+          {
+            return to_seconds( p.time );
+          }
+        }
+        return to_seconds( st.time_total );
+      };
+
+      exp( benchmark, size_before, num_threads, st.num_generated_patterns, st.num_duplicate_patterns, st.num_constant, time_to( 0.5 ), time_to( 0.9 ), to_seconds( st.time_total ), to_seconds( st.time_sat ) );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/refactoring.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/utils/window_index_arena.hpp>
+#include <mockturtle/views/mffc_view.hpp>
+
+#include <experiments.hpp>
+
+/* constructs the MFFC view of every gate, with or without index arena */
+template<class Ntk>
+uint64_t construct_mffc_views( Ntk& ntk, mockturtle::window_index_arena* arena )
+{
+  uint64_t num_gates{0};
+
+  ntk.clear_values();
+  ntk.foreach_node( [&]( auto const& n ) {
+    ntk.set_value( n, ntk.fanout_size( n ) );
+  } );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    mockturtle::mffc_view mffc{ntk, n, arena};
+    num_gates += mffc.num_gates();
+  } );
+  return num_gates;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, float, float, float, float, bool>
+    exp( "refactoring", "benchmark", "size_before", "size_after", "runtime", "mffc time", "views (hash)", "views (arena)", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      fmt::print( "[e] could not read {}\n", benchmark );
+      continue;
+    }
+
+    /* isolated view construction */
+    stopwatch<>::duration time_hash{0}, time_arena{0};
+    call_with_stopwatch( time_hash, [&]() { return construct_mffc_views( aig, nullptr ); } );
+    window_index_arena arena( aig.size() );
+    call_with_stopwatch( time_arena, [&]() { return construct_mffc_views( aig, &arena ); } );
+
+    uint32_t const size_before = aig.num_gates();
+
+    xag_npn_resynthesis<aig_network> resyn;
+    refactoring_params ps;
+    ps.max_pis = 4;
+    refactoring_stats st;
+    refactoring( aig, resyn, ps, &st );
+    aig = cleanup_dangling( aig );
+
+    auto const cec = benchmark == "hyp" ? true : abc_cec( aig, benchmark );
+
+    exp( benchmark, size_before, aig.num_gates(), to_seconds( st.time_total ), to_seconds( st.time_mffc ),
+         to_seconds( time_hash ), to_seconds( time_arena ), cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
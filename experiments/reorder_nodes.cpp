@@ -0,0 +1,136 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/reorder_nodes.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* renumbers the gates in a random topological order, which scatters the
+ * fanins of a gate in memory as many rewriting passes do */
+void scramble( mockturtle::aig_network& aig, std::mt19937& rng )
+{
+  using node = mockturtle::aig_network::node;
+
+  std::vector<uint32_t> num_pending( aig.size(), 0u );
+  std::vector<std::vector<node>> fanouts( aig.size() );
+  std::vector<node> ready;
+  aig.foreach_gate( [&]( auto const& n ) {
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      if ( aig.is_constant( aig.get_node( f ) ) || aig.is_ci( aig.get_node( f ) ) )
+      {
+        return;
+      }
+      ++num_pending[n];
+      fanouts[aig.get_node( f )].push_back( n );
+    } );
+    if ( num_pending[n] == 0u )
+    {
+      ready.push_back( n );
+    }
+  } );
+
+  std::vector<node> gates;
+  while ( !ready.empty() )
+  {
+    std::swap( ready[std::uniform_int_distribution<std::size_t>( 0u, ready.size() - 1u )( rng )], ready.back() );
+    const auto n = ready.back();
+    ready.pop_back();
+    gates.push_back( n );
+    for ( auto const& p : fanouts[n] )
+    {
+      if ( --num_pending[p] == 0u )
+      {
+        ready.push_back( p );
+      }
+    }
+  }
+  aig.renumber_nodes( gates );
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, double, bool> exp( "reorder_nodes", "benchmark", "gates", "far before", "far after", "sim before (ms)", "sim after (ms)", "cuts before (ms)", "cuts after (ms)", "reorder (ms)", "equivalent" );
+
+  std::mt19937 rng( 1u );
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+    cleanup_dangling_inplace( aig );
+    scramble( aig, rng );
+
+    std::vector<kitty::partial_truth_table> patterns( aig.num_pis(), kitty::partial_truth_table( 1024u ) );
+    for ( auto& p : patterns )
+    {
+      std::generate( p._bits.begin(), p._bits.end(), [&]() { return ( static_cast<uint64_t>( rng() ) << 32 ) | rng(); } );
+    }
+    partial_simulator sim( patterns );
+
+    /* simulation and cut enumeration before and after reordering */
+    const auto run = [&]( auto& time_sim, auto& time_cuts ) {
+      const auto values = call_with_stopwatch( time_sim, [&]() { return simulate<kitty::partial_truth_table>( aig, sim ); } );
+      cut_enumeration_stats st;
+      cut_enumeration( aig, {}, &st );
+      time_cuts = st.time_total;
+      return values;
+    };
+
+    stopwatch<>::duration time_sim_before{0}, time_sim_after{0}, time_cuts_before{0}, time_cuts_after{0};
+    const auto values_before = run( time_sim_before, time_cuts_before );
+
+    reorder_nodes_stats st;
+    reorder_nodes( aig, {}, &st );
+
+    const auto values_after = run( time_sim_after, time_cuts_after );
+
+    const auto ms = []( auto const& time ) { return 1000.0 * to_seconds( time ); };
+    exp( benchmark, aig.num_gates(), st.far_fanins_before, st.far_fanins_after, ms( time_sim_before ), ms( time_sim_after ),
+         ms( time_cuts_before ), ms( time_cuts_after ), ms( st.time_total ), values_before == values_after );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/satlut_mapping.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  using mapped_t = mapping_view<aig_network, true>;
+
+  const auto num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  experiment<std::string, uint32_t, uint32_t, float, uint32_t, uint32_t, float, uint32_t, uint32_t, bool> exp( "satlut_parallel", "benchmark", "cells_init", "cells_seq", "time_seq", "threads", "cells_par", "time_par", "windows", "batches", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks( ~hyp & ~experiments::div ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+
+    lut_mapping_params ps;
+    ps.cut_enumeration_ps.cut_size = 6;
+    ps.cut_enumeration_ps.cut_limit = 16;
+
+    satlut_mapping_params slps;
+    slps.cut_enumeration_ps.cut_size = 6;
+    slps.cut_enumeration_ps.cut_limit = 16;
+    slps.conflict_limit = 100;
+
+    /* sequential windows */
+    mapped_t mapped_seq{aig};
+    lut_mapping<mapped_t, true>( mapped_seq, ps );
+    const auto cells_init = mapped_seq.num_cells();
+
+    satlut_mapping_stats st_seq;
+    satlut_mapping<mapped_t, true>( mapped_seq, 32u, slps, &st_seq );
+
+    /* parallel windows */
+    mapped_t mapped_par{aig};
+    lut_mapping<mapped_t, true>( mapped_par, ps );
+
+    slps.num_threads = 0u; /* hardware concurrency */
+    slps.window_timeout = 1.0;
+    satlut_mapping_stats st_par;
+    satlut_mapping<mapped_t, true>( mapped_par, 32u, slps, &st_par );
+
+    const auto klut = *collapse_mapped_network<klut_network>( mapped_par );
+    const auto cec = abc_cec( klut, benchmark );
+
+    exp( benchmark, cells_init, mapped_seq.num_cells(), to_seconds( st_seq.time_total ), num_threads, mapped_par.num_cells(), to_seconds( st_par.time_total ), st_par.num_windows, st_par.num_batches, cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
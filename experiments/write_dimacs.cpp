@@ -0,0 +1,119 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/algorithms/cut_enumeration/cnf_cut.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/io/write_dimacs.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/cnf_view.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+/* same miters as in the `cnf_map` experiment */
+template<class Ntk>
+void create_assoc_miter( Ntk& ntk, uint32_t bitwidth )
+{
+  using namespace mockturtle;
+
+  std::vector<typename Ntk::signal> as( bitwidth ), bs( bitwidth ), cs( bitwidth );
+  std::generate( as.begin(), as.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( cs.begin(), cs.end(), [&]() { return ntk.create_pi(); } );
+
+  auto o1 = carry_ripple_multiplier( ntk, carry_ripple_multiplier( ntk, as, bs ), cs );
+  auto o2 = carry_ripple_multiplier( ntk, as, carry_ripple_multiplier( ntk, bs, cs ) );
+  std::vector<typename Ntk::signal> xors( o1.size() );
+  std::transform( o1.begin(), o1.end(), o2.begin(),
+                  xors.begin(),
+                  [&]( auto const& a, auto const& b ) { return ntk.create_xor( a, b ); } );
+  ntk.create_po( ntk.create_nary_or( xors ) );
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, uint32_t, double> exp( "write_dimacs", "benchmark", "gates", "clauses", "time_cnf_view", "time_stream", "time_gzip", "clauses_mapped", "time_mapped" );
+
+  const std::string filename = "write_dimacs.cnf";
+
+  for ( auto i = 4u; i < 9u; ++i )
+  {
+    const auto benchmark = fmt::format( "assoc-{}", i );
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    /* export through cnf_view, which collects the clauses and writes them on solve */
+    stopwatch<>::duration time_cnf_view{0};
+    {
+      stopwatch t( time_cnf_view );
+      cnf_view_params cps;
+      cps.write_dimacs = filename;
+      cnf_view<aig_network> cnf{cps};
+      create_assoc_miter( cnf, i );
+      cnf.solve( 1 );
+    }
+
+    aig_network aig;
+    create_assoc_miter( aig, i );
+
+    write_dimacs_stats st;
+    write_dimacs( aig, filename, {}, &st );
+
+    write_dimacs_params gps;
+    gps.compress = true;
+    write_dimacs_stats gst;
+    write_dimacs( aig, filename + ".gz", gps, &gst );
+
+    lut_mapping_params lmps;
+    lmps.cut_enumeration_ps.cut_size = 4;
+    mapping_view<aig_network, true> mapped_aig{aig};
+    lut_mapping<decltype( mapped_aig ), true, cut_enumeration_cnf_cut>( mapped_aig, lmps );
+
+    write_dimacs_params mps;
+    mps.use_mapping = true;
+    write_dimacs_stats mst;
+    write_dimacs( mapped_aig, filename, mps, &mst );
+
+    exp( benchmark, aig.num_gates(), st.num_clauses, to_seconds( time_cnf_view ), to_seconds( st.time_total ), to_seconds( gst.time_total ), mst.num_clauses, to_seconds( mst.time_total ) );
+  }
+
+  std::remove( filename.c_str() );
+  std::remove( ( filename + ".gz" ).c_str() );
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
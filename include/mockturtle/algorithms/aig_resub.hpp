@@ -144,11 +144,21 @@ public:
     std::vector<signal> negative_divisors;
     std::vector<signal> next_candidates;
 
-    void clear()
+    divisor_batch<1u> positive_batch;
+    divisor_batch<1u> negative_batch;
+
+    divisor_index positive_index;
+    divisor_index negative_index;
+
+    void clear( tt_layout const& layout )
     {
       positive_divisors.clear();
       negative_divisors.clear();
       next_candidates.clear();
+      positive_batch.reset( layout );
+      negative_batch.reset( layout );
+      positive_index.clear();
+      negative_index.clear();
     }
   };
 
@@ -161,12 +171,22 @@ public:
     std::vector<signal> negative_divisors0;
     std::vector<signal> negative_divisors1;
 
-    void clear()
+    divisor_batch<2u> positive_batch;
+    divisor_batch<2u> negative_batch;
+
+    divisor_index positive_index;
+    divisor_index negative_index;
+
+    void clear( tt_layout const& layout )
     {
       positive_divisors0.clear();
       positive_divisors1.clear();
       negative_divisors0.clear();
       negative_divisors1.clear();
+      positive_batch.reset( layout );
+      negative_batch.reset( layout );
+      positive_index.clear();
+      negative_index.clear();
     }
   };
 
@@ -284,11 +304,12 @@ public:
   std::optional<signal> resub_div0( node const& root, uint32_t required ) const
   {
     (void)required;
-    auto const tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const layout = sim.get_tt_layout();
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
     for ( auto i = 0u; i < num_divs; ++i )
     {
       auto const d = divs.at( i );
-      if ( tt != sim.get_tt( ntk.make_signal( d ) ) )
+      if ( !is_const0_words( layout, []( auto a, auto b ) { return a ^ b; }, tt, sim.get_tt_ref( ntk.make_signal( d ) ) ) )
         continue; /* next */
 
       return ( sim.get_phase( d ) ^ sim.get_phase( root ) ) ? !ntk.make_signal( d ) : ntk.make_signal( d );
@@ -299,9 +320,11 @@ public:
 
   void collect_unate_divisors( node const& root, uint32_t required )
   {
-    udivs.clear();
+    auto const layout = sim.get_tt_layout();
+    udivs.clear( layout );
 
-    auto const& tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const implies = []( auto a, auto b ) { return a & ~b; };
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
     for ( auto i = 0u; i < num_divs; ++i )
     {
       auto const d = divs.at( i );
@@ -309,86 +332,84 @@ public:
       if ( ntk.level( d ) > required - 1 )
         continue;
 
-      auto const& tt_d = sim.get_tt( ntk.make_signal( d ) );
+      auto const tt_d = sim.get_tt_ref( ntk.make_signal( d ) );
 
       /* check positive containment */
-      if ( kitty::implies( tt_d, tt ) )
+      if ( is_const0_words( layout, implies, tt_d, tt ) )
       {
         udivs.positive_divisors.emplace_back( ntk.make_signal( d ) );
+        udivs.positive_batch.add( tt_d );
         continue;
       }
 
       /* check negative containment */
-      if ( kitty::implies( tt, tt_d ) )
+      if ( is_const0_words( layout, implies, tt, tt_d ) )
       {
         udivs.negative_divisors.emplace_back( ntk.make_signal( d ) );
+        udivs.negative_batch.add( tt_d );
         continue;
       }
 
       if ( true ) // ( ps.fix_bug )
       {
-        if ( kitty::implies( ~tt_d, tt ) )
+        if ( is_const0_words( layout, implies, ~tt_d, tt ) )
         {
           udivs.positive_divisors.emplace_back( !ntk.make_signal( d ) );
+          udivs.positive_batch.add( ~tt_d );
           continue;
         }
-        if ( kitty::implies( tt, ~tt_d ) )
+        if ( is_const0_words( layout, implies, tt, ~tt_d ) )
         {
           udivs.negative_divisors.emplace_back( !ntk.make_signal( d ) );
+          udivs.negative_batch.add( ~tt_d );
           continue;
         }
       }
 
       udivs.next_candidates.emplace_back( ntk.make_signal( d ) );
     }
+
+    /* index the divisors by the onset (positive) and offset (negative) minterms that they cover */
+    udivs.positive_index.build( udivs.positive_batch, []( auto a ) { return a; }, []( auto t ) { return t; }, tt );
+    udivs.negative_index.build( udivs.negative_batch, []( auto a ) { return ~a; }, []( auto t ) { return ~t; }, tt );
   }
 
   std::optional<signal> resub_div1( node const& root, uint32_t required )
   {
     (void)required;
-    auto const& tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
 
     /* check for positive unate divisors */
+    auto const& positive = udivs.positive_batch;
     for ( auto i = 0u; i < udivs.positive_divisors.size(); ++i )
     {
       auto const& s0 = udivs.positive_divisors.at( i );
 
-      for ( auto j = i + 1; j < udivs.positive_divisors.size(); ++j )
+      if ( auto const j = udivs.positive_index.find( positive, i + 1, []( auto t, auto a ) { return t & ~a; }, []( auto t, auto a, auto b ) { return ( a | b ) ^ t; }, tt, positive[i][0] ) )
       {
-        auto const& s1 = udivs.positive_divisors.at( j );
+        auto const& s1 = udivs.positive_divisors.at( *j );
 
-        auto const& tt_s0 = sim.get_tt( s0 );
-        auto const& tt_s1 = sim.get_tt( s1 );
-
-        if ( ( tt_s0 | tt_s1 ) == tt )
-        {
-          ++st.num_div1_or_accepts;
-          auto const l = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
-          auto const r = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
-          return sim.get_phase( root ) ? !ntk.create_or( l, r ) : ntk.create_or( l, r );
-        }
+        ++st.num_div1_or_accepts;
+        auto const l = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
+        auto const r = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
+        return sim.get_phase( root ) ? !ntk.create_or( l, r ) : ntk.create_or( l, r );
       }
     }
 
     /* check for negative unate divisors */
+    auto const& negative = udivs.negative_batch;
     for ( auto i = 0u; i < udivs.negative_divisors.size(); ++i )
     {
       auto const& s0 = udivs.negative_divisors.at( i );
 
-      for ( auto j = i + 1; j < udivs.negative_divisors.size(); ++j )
+      if ( auto const j = udivs.negative_index.find( negative, i + 1, []( auto t, auto a ) { return ~t & a; }, []( auto t, auto a, auto b ) { return ( a & b ) ^ t; }, tt, negative[i][0] ) )
       {
-        auto const& s1 = udivs.negative_divisors.at( j );
+        auto const& s1 = udivs.negative_divisors.at( *j );
 
-        auto const& tt_s0 = sim.get_tt( s0 );
-        auto const& tt_s1 = sim.get_tt( s1 );
-
-        if ( ( tt_s0 & tt_s1 ) == tt )
-        {
-          ++st.num_div1_and_accepts;
-          auto const l = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
-          auto const r = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
-          return sim.get_phase( root ) ? !ntk.create_and( l, r ) : ntk.create_and( l, r );
-        }
+        ++st.num_div1_and_accepts;
+        auto const l = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
+        auto const r = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
+        return sim.get_phase( root ) ? !ntk.create_and( l, r ) : ntk.create_and( l, r );
       }
     }
 
@@ -399,7 +420,8 @@ public:
   {
     (void)required;
     auto const s = ntk.make_signal( root );
-    auto const& tt = sim.get_tt( s );
+    auto const tt = sim.get_tt_ref( s );
+    auto const& positive = udivs.positive_batch;
 
     /* check positive unate divisors */
     for ( auto i = 0u; i < udivs.positive_divisors.size(); ++i )
@@ -410,46 +432,39 @@ public:
       {
         auto const s1 = udivs.positive_divisors.at( j );
 
-        for ( auto k = j + 1; k < udivs.positive_divisors.size(); ++k )
+        if ( auto const k = udivs.positive_index.find( positive, j + 1, []( auto t, auto a, auto b ) { return t & ~( a | b ); }, []( auto t, auto a, auto b, auto c ) { return ( a | b | c ) ^ t; }, tt, positive[i][0], positive[j][0] ) )
         {
-          auto const s2 = udivs.positive_divisors.at( k );
-
-          auto const& tt_s0 = sim.get_tt( s0 );
-          auto const& tt_s1 = sim.get_tt( s1 );
-          auto const& tt_s2 = sim.get_tt( s2 );
-
-          if ( ( tt_s0 | tt_s1 | tt_s2 ) == tt )
+          auto const s2 = udivs.positive_divisors.at( *k );
+
+          auto const max_level = std::max({
+              ntk.level( ntk.get_node( s0 ) ),
+              ntk.level( ntk.get_node( s1 ) ),
+              ntk.level( ntk.get_node( s2 ) )
+            });
+          assert( max_level <= required - 1 );
+
+          signal max = s0;
+          signal min0 = s1;
+          signal min1 = s2;
+          if ( ntk.level( ntk.get_node( s1 ) ) == max_level )
+          {
+            max = s1;
+            min0 = s0;
+            min1 = s2;
+          }
+          else if ( ntk.level( ntk.get_node( s2 ) ) == max_level )
           {
-            auto const max_level = std::max({
-                ntk.level( ntk.get_node( s0 ) ),
-                ntk.level( ntk.get_node( s1 ) ),
-                ntk.level( ntk.get_node( s2 ) )
-              });
-            assert( max_level <= required - 1 );
-
-            signal max = s0;
-            signal min0 = s1;
-            signal min1 = s2;
-            if ( ntk.level( ntk.get_node( s1 ) ) == max_level )
-            {
-              max = s1;
-              min0 = s0;
-              min1 = s2;
-            }
-            else if ( ntk.level( ntk.get_node( s2 ) ) == max_level )
-            {
-              max = s2;
-              min0 = s0;
-              min1 = s1;
-            }
-
-            auto const a = sim.get_phase( ntk.get_node( max  ) ) ? !max  : max;
-            auto const b = sim.get_phase( ntk.get_node( min0 ) ) ? !min0 : min0;
-            auto const c = sim.get_phase( ntk.get_node( min1 ) ) ? !min1 : min1;
-
-            ++st.num_div12_2or_accepts;
-            return sim.get_phase( root ) ? !ntk.create_or( a, ntk.create_or( b, c ) ) : ntk.create_or( a, ntk.create_or( b, c ) );
+            max = s2;
+            min0 = s0;
+            min1 = s1;
           }
+
+          auto const a = sim.get_phase( ntk.get_node( max  ) ) ? !max  : max;
+          auto const b = sim.get_phase( ntk.get_node( min0 ) ) ? !min0 : min0;
+          auto const c = sim.get_phase( ntk.get_node( min1 ) ) ? !min1 : min1;
+
+          ++st.num_div12_2or_accepts;
+          return sim.get_phase( root ) ? !ntk.create_or( a, ntk.create_or( b, c ) ) : ntk.create_or( a, ntk.create_or( b, c ) );
         }
       }
     }
@@ -463,46 +478,39 @@ public:
       {
         auto const s1 = udivs.positive_divisors.at( j );
 
-        for ( auto k = j + 1; k < udivs.positive_divisors.size(); ++k )
+        if ( auto const k = udivs.positive_index.find( positive, j + 1, []( auto t, auto a, auto b ) { (void)a; (void)b; return t; }, []( auto t, auto a, auto b, auto c ) { return ( a & b & c ) ^ t; }, tt, positive[i][0], positive[j][0] ) )
         {
-          auto const s2 = udivs.positive_divisors.at( k );
-
-          auto const& tt_s0 = sim.get_tt( s0 );
-          auto const& tt_s1 = sim.get_tt( s1 );
-          auto const& tt_s2 = sim.get_tt( s2 );
-
-          if ( ( tt_s0 & tt_s1 & tt_s2 ) == tt )
+          auto const s2 = udivs.positive_divisors.at( *k );
+
+          auto const max_level = std::max({
+              ntk.level( ntk.get_node( s0 ) ),
+              ntk.level( ntk.get_node( s1 ) ),
+              ntk.level( ntk.get_node( s2 ) )
+            });
+          assert( max_level <= required - 1 );
+
+          signal max = s0;
+          signal min0 = s1;
+          signal min1 = s2;
+          if ( ntk.level( ntk.get_node( s1 ) ) == max_level )
+          {
+            max = s1;
+            min0 = s0;
+            min1 = s2;
+          }
+          else if ( ntk.level( ntk.get_node( s2 ) ) == max_level )
           {
-            auto const max_level = std::max({
-                ntk.level( ntk.get_node( s0 ) ),
-                ntk.level( ntk.get_node( s1 ) ),
-                ntk.level( ntk.get_node( s2 ) )
-              });
-            assert( max_level <= required - 1 );
-
-            signal max = s0;
-            signal min0 = s1;
-            signal min1 = s2;
-            if ( ntk.level( ntk.get_node( s1 ) ) == max_level )
-            {
-              max = s1;
-              min0 = s0;
-              min1 = s2;
-            }
-            else if ( ntk.level( ntk.get_node( s2 ) ) == max_level )
-            {
-              max = s2;
-              min0 = s0;
-              min1 = s1;
-            }
-
-            auto const a = sim.get_phase( ntk.get_node( max  ) ) ? !max  : max;
-            auto const b = sim.get_phase( ntk.get_node( min0 ) ) ? !min0 : min0;
-            auto const c = sim.get_phase( ntk.get_node( min1 ) ) ? !min1 : min1;
-
-            ++st.num_div12_2and_accepts;
-            return sim.get_phase( root ) ? !ntk.create_and( a, ntk.create_and( b, c ) ) : ntk.create_and( a, ntk.create_and( b, c ) );
+            max = s2;
+            min0 = s0;
+            min1 = s1;
           }
+
+          auto const a = sim.get_phase( ntk.get_node( max  ) ) ? !max  : max;
+          auto const b = sim.get_phase( ntk.get_node( min0 ) ) ? !min0 : min0;
+          auto const c = sim.get_phase( ntk.get_node( min1 ) ) ? !min1 : min1;
+
+          ++st.num_div12_2and_accepts;
+          return sim.get_phase( root ) ? !ntk.create_and( a, ntk.create_and( b, c ) ) : ntk.create_and( a, ntk.create_and( b, c ) );
         }
       }
     }
@@ -512,76 +520,87 @@ public:
 
   void collect_binate_divisors( node const& root, uint32_t required )
   {
-    bdivs.clear();
+    auto const layout = sim.get_tt_layout();
+    bdivs.clear( layout );
 
-    auto const& tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const positive = []( auto t, auto a, auto b ) { return a & b & ~t; };
+    auto const negative = []( auto t, auto a, auto b ) { return t & ~( a & b ); };
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
     for ( auto i = 0u; i < udivs.next_candidates.size(); ++i )
     {
       auto const& s0 = udivs.next_candidates.at( i );
       if ( ntk.level( ntk.get_node( s0 ) ) > required - 2 )
         continue;
 
+      auto const tt_s0 = sim.get_tt_ref( s0 );
+
       for ( auto j = i + 1; j < udivs.next_candidates.size(); ++j )
       {
         auto const& s1 = udivs.next_candidates.at( j );
         if ( ntk.level( ntk.get_node( s1 ) ) > required - 2 )
           continue;
 
+        auto const tt_s1 = sim.get_tt_ref( s1 );
+
         if ( bdivs.positive_divisors0.size() < 500 ) // ps.max_divisors2
         {
-          auto const& tt_s0 = sim.get_tt( s0 );
-          auto const& tt_s1 = sim.get_tt( s1 );
-          if ( kitty::implies( tt_s0 & tt_s1, tt ) )
+          if ( is_const0_words( layout, positive, tt, tt_s0, tt_s1 ) )
           {
             bdivs.positive_divisors0.emplace_back(  s0 );
             bdivs.positive_divisors1.emplace_back(  s1 );
+            bdivs.positive_batch.add( tt_s0, tt_s1 );
           }
 
-          if ( kitty::implies( ~tt_s0 & tt_s1, tt ) )
+          if ( is_const0_words( layout, positive, tt, ~tt_s0, tt_s1 ) )
           {
             bdivs.positive_divisors0.emplace_back( !s0 );
             bdivs.positive_divisors1.emplace_back(  s1 );
+            bdivs.positive_batch.add( ~tt_s0, tt_s1 );
           }
 
-          if ( kitty::implies( tt_s0 & ~tt_s1, tt ) )
+          if ( is_const0_words( layout, positive, tt, tt_s0, ~tt_s1 ) )
           {
             bdivs.positive_divisors0.emplace_back(  s0 );
             bdivs.positive_divisors1.emplace_back( !s1 );
+            bdivs.positive_batch.add( tt_s0, ~tt_s1 );
           }
 
-          if ( kitty::implies( ~tt_s0 & ~tt_s1, tt ) )
+          if ( is_const0_words( layout, positive, tt, ~tt_s0, ~tt_s1 ) )
           {
             bdivs.positive_divisors0.emplace_back( !s0 );
             bdivs.positive_divisors1.emplace_back( !s1 );
+            bdivs.positive_batch.add( ~tt_s0, ~tt_s1 );
           }
         }
 
         if ( bdivs.negative_divisors0.size() < 500 ) // ps.max_divisors2
         {
-          auto const& tt_s0 = sim.get_tt( s0 );
-          auto const& tt_s1 = sim.get_tt( s1 );
-          if ( kitty::implies( tt, tt_s0 & tt_s1 ) )
+          if ( is_const0_words( layout, negative, tt, tt_s0, tt_s1 ) )
           {
             bdivs.negative_divisors0.emplace_back(  s0 );
             bdivs.negative_divisors1.emplace_back(  s1 );
+            bdivs.negative_batch.add( tt_s0, tt_s1 );
           }
 
-          if ( kitty::implies( tt, ~tt_s0 & tt_s1 ) )
+          if ( is_const0_words( layout, negative, tt, ~tt_s0, tt_s1 ) )
           {
             bdivs.negative_divisors0.emplace_back( !s0 );
             bdivs.negative_divisors1.emplace_back(  s1 );
+            bdivs.negative_batch.add( ~tt_s0, tt_s1 );
           }
 
-          if ( kitty::implies( tt, tt_s0 & ~tt_s1 ) )
+          if ( is_const0_words( layout, negative, tt, tt_s0, ~tt_s1 ) )
           {
             bdivs.negative_divisors0.emplace_back(  s0 );
             bdivs.negative_divisors1.emplace_back( !s1 );
+            bdivs.negative_batch.add( tt_s0, ~tt_s1 );
           }
 
-          if ( kitty::implies( tt, ~tt_s0 & ~tt_s1 ) )
+          if ( is_const0_words( layout, negative, tt, ~tt_s0, ~tt_s1 ) )
           {
             bdivs.negative_divisors0.emplace_back( !s0 );
             bdivs.negative_divisors1.emplace_back( !s1 );
+            bdivs.negative_batch.add( ~tt_s0, ~tt_s1 );
           }
         }
       }
@@ -592,59 +611,47 @@ public:
   {
     (void)required;
     auto const s = ntk.make_signal( root );
-    auto const& tt = sim.get_tt( s );
+    auto const tt = sim.get_tt_ref( s );
+    auto const or_and = []( auto t, auto a, auto b, auto c ) { return ( a | ( b & c ) ) ^ t; };
 
     /* check positive unate divisors */
-    for ( const auto& s0 : udivs.positive_divisors )
+    bdivs.positive_index.build( bdivs.positive_batch, []( auto a, auto b ) { return a & b; }, []( auto t ) { return t; }, tt );
+    for ( auto i = 0u; i < udivs.positive_divisors.size(); ++i )
     {
-      auto const& tt_s0 = sim.get_tt( s0 );
-
-      for ( auto j = 0u; j < bdivs.positive_divisors0.size(); ++j )
+      if ( auto const j = bdivs.positive_index.find( bdivs.positive_batch, 0u, []( auto t, auto a ) { return t & ~a; }, or_and, tt, udivs.positive_batch[i][0] ) )
       {
-        auto const s1 = bdivs.positive_divisors0.at( j );
-        auto const s2 = bdivs.positive_divisors1.at( j );
-
-        auto const& tt_s1 = sim.get_tt( s1 );
-        auto const& tt_s2 = sim.get_tt( s2 );
+        auto const s0 = udivs.positive_divisors.at( i );
+        auto const s1 = bdivs.positive_divisors0.at( *j );
+        auto const s2 = bdivs.positive_divisors1.at( *j );
 
         auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
         auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
         auto const c = sim.get_phase( ntk.get_node( s2 ) ) ? !s2 : s2;
 
-        if ( ( tt_s0 | ( tt_s1 & tt_s2 ) ) == tt )
-        {
-          ++st.num_div2_or_and_accepts;
-          return sim.get_phase( root ) ?
-            !ntk.create_or( a, ntk.create_and( b, c ) ) :
-             ntk.create_or( a, ntk.create_and( b, c ) );
-        }
+        ++st.num_div2_or_and_accepts;
+        return sim.get_phase( root ) ?
+          !ntk.create_or( a, ntk.create_and( b, c ) ) :
+           ntk.create_or( a, ntk.create_and( b, c ) );
       }
     }
 
     /* check negative unate divisors */
-    for ( const auto& s0 : udivs.negative_divisors )
+    for ( auto i = 0u; i < udivs.negative_divisors.size(); ++i )
     {
-      auto const& tt_s0 = sim.get_tt( s0 );
-
-      for ( auto j = 0u; j < bdivs.negative_divisors0.size(); ++j )
+      if ( auto const j = bdivs.negative_batch.find( 0u, or_and, tt, udivs.negative_batch[i][0] ) )
       {
-        auto const s1 = bdivs.negative_divisors0.at( j );
-        auto const s2 = bdivs.negative_divisors1.at( j );
-
-        auto const& tt_s1 = sim.get_tt( s1 );
-        auto const& tt_s2 = sim.get_tt( s2 );
+        auto const s0 = udivs.negative_divisors.at( i );
+        auto const s1 = bdivs.negative_divisors0.at( *j );
+        auto const s2 = bdivs.negative_divisors1.at( *j );
 
         auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
         auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
         auto const c = sim.get_phase( ntk.get_node( s2 ) ) ? !s2 : s2;
 
-        if ( ( tt_s0 | ( tt_s1 & tt_s2 ) ) == tt )
-        {
-          ++st.num_div2_or_and_accepts;
-          return sim.get_phase( root ) ?
-            !ntk.create_and( a, ntk.create_or( b, c ) ) :
-             ntk.create_and( a, ntk.create_or( b, c ) );
-        }
+        ++st.num_div2_or_and_accepts;
+        return sim.get_phase( root ) ?
+          !ntk.create_and( a, ntk.create_or( b, c ) ) :
+           ntk.create_and( a, ntk.create_or( b, c ) );
       }
     }
 
@@ -656,65 +663,49 @@ public:
     (void)required;
 
     auto const s = ntk.make_signal( root );
-    auto const& tt = sim.get_tt( s );
+    auto const tt = sim.get_tt_ref( s );
 
+    auto const& positive = bdivs.positive_batch;
     for ( auto i = 0u; i < bdivs.positive_divisors0.size(); ++i )
     {
-      auto const s0 = bdivs.positive_divisors0.at( i );
-      auto const s1 = bdivs.positive_divisors1.at( i );
-
-      for ( auto j = i + 1; j < bdivs.positive_divisors0.size(); ++j )
+      if ( auto const j = positive.find( i + 1, []( auto t, auto a, auto b, auto c, auto d ) { return ( ( a | b ) & ( c | d ) ) ^ t; }, tt, positive[i][0], positive[i][1] ) )
       {
-        auto const s2 = bdivs.positive_divisors0.at( j );
-        auto const s3 = bdivs.positive_divisors1.at( j );
+        auto const s0 = bdivs.positive_divisors0.at( i );
+        auto const s1 = bdivs.positive_divisors1.at( i );
+        auto const s2 = bdivs.positive_divisors0.at( *j );
+        auto const s3 = bdivs.positive_divisors1.at( *j );
 
-        auto const& tt_s0 = sim.get_tt( s0 );
-        auto const& tt_s1 = sim.get_tt( s1 );
-        auto const& tt_s2 = sim.get_tt( s2 );
-        auto const& tt_s3 = sim.get_tt( s3 );
+        auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
+        auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
+        auto const c = sim.get_phase( ntk.get_node( s2 ) ) ? !s2 : s2;
+        auto const d = sim.get_phase( ntk.get_node( s3 ) ) ? !s3 : s3;
 
-        if ( ( ( tt_s0 | tt_s1 ) & ( tt_s2 | tt_s3 ) ) == tt )
-        {
-          auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
-          auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
-          auto const c = sim.get_phase( ntk.get_node( s2 ) ) ? !s2 : s2;
-          auto const d = sim.get_phase( ntk.get_node( s3 ) ) ? !s3 : s3;
-
-          ++st.num_div3_and_2or_accepts;
-          return sim.get_phase( root ) ?
-            !ntk.create_and( ntk.create_or( a, b ) , ntk.create_or( c, d ) ) :
-             ntk.create_and( ntk.create_or( a, b ) , ntk.create_or( c, d ) );
-        }
+        ++st.num_div3_and_2or_accepts;
+        return sim.get_phase( root ) ?
+          !ntk.create_and( ntk.create_or( a, b ) , ntk.create_or( c, d ) ) :
+           ntk.create_and( ntk.create_or( a, b ) , ntk.create_or( c, d ) );
       }
     }
 
+    auto const& negative = bdivs.negative_batch;
     for ( auto i = 0u; i < bdivs.negative_divisors0.size(); ++i )
     {
-      auto const s0 = bdivs.negative_divisors0.at( i );
-      auto const s1 = bdivs.negative_divisors1.at( i );
-
-      for ( auto j = i + 1; j < bdivs.negative_divisors0.size(); ++j )
+      if ( auto const j = negative.find( i + 1, []( auto t, auto a, auto b, auto c, auto d ) { return ( ( a & b ) | ( c & d ) ) ^ t; }, tt, negative[i][0], negative[i][1] ) )
       {
-        auto const s2 = bdivs.negative_divisors0.at( j );
-        auto const s3 = bdivs.negative_divisors1.at( j );
+        auto const s0 = bdivs.negative_divisors0.at( i );
+        auto const s1 = bdivs.negative_divisors1.at( i );
+        auto const s2 = bdivs.negative_divisors0.at( *j );
+        auto const s3 = bdivs.negative_divisors1.at( *j );
 
-        auto const& tt_s0 = sim.get_tt( s0 );
-        auto const& tt_s1 = sim.get_tt( s1 );
-        auto const& tt_s2 = sim.get_tt( s2 );
-        auto const& tt_s3 = sim.get_tt( s3 );
+        auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
+        auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
+        auto const c = sim.get_phase( ntk.get_node( s2 ) ) ? !s2 : s2;
+        auto const d = sim.get_phase( ntk.get_node( s3 ) ) ? !s3 : s3;
 
-        if ( ( ( tt_s0 & tt_s1 ) | ( tt_s2 & tt_s3 ) ) == tt )
-        {
-          auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
-          auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
-          auto const c = sim.get_phase( ntk.get_node( s2 ) ) ? !s2 : s2;
-          auto const d = sim.get_phase( ntk.get_node( s3 ) ) ? !s3 : s3;
-
-          ++st.num_div3_or_2and_accepts;
-          return sim.get_phase( root ) ?
-            !ntk.create_or( ntk.create_and( a, b ) , ntk.create_and( c, d ) ) :
-             ntk.create_or( ntk.create_and( a, b ) , ntk.create_and( c, d ) );
-        }
+        ++st.num_div3_or_2and_accepts;
+        return sim.get_phase( root ) ?
+          !ntk.create_or( ntk.create_and( a, b ) , ntk.create_and( c, d ) ) :
+           ntk.create_or( ntk.create_and( a, b ) , ntk.create_and( c, d ) );
       }
     }
 
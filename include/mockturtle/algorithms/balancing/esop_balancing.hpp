@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_map>
@@ -206,22 +207,25 @@ private:
   std::vector<kitty::cube> create_sop_form( kitty::dynamic_truth_table const& func ) const
   {
     stopwatch<> t( time_sop );
-    if ( auto it = sop_hash_.find( func ); it != sop_hash_.end() )
+    std::vector<kitty::cube> esop;
+    if ( sop_cache->if_contains( func, [&]( auto const& v ) { esop = v; } ) )
     {
       sop_cache_hits++;
-      return it->second;
+      return esop;
     }
     else
     {
       sop_cache_misses++;
-      return sop_hash_[func] = mockturtle::exorcism( func ); // TODO generalize
+      esop = mockturtle::exorcism( func ); // TODO generalize
+      sop_cache->try_emplace( func, esop );
+      return esop;
     }
   }
 
-private:
-  mutable std::unordered_map<kitty::dynamic_truth_table, std::vector<kitty::cube>, kitty::hash<kitty::dynamic_truth_table>> sop_hash_;
-
 public:
+  /*! \brief Cache of minimized ESOPs, can be shared with batch `exorcism`. */
+  std::shared_ptr<exorcism_cache_t> sop_cache{std::make_shared<exorcism_cache_t>()};
+
   bool spp_optimization{false};
   bool mux_optimization{false};
 
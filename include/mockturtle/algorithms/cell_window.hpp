@@ -132,41 +132,69 @@ public:
   bool compute_window_for( node const& pivot )
   {
     init_cell_refs();
+    build_window( pivot );
+    return mark_window_visited();
+  }
 
-    //print_time<> pt;
-    assert( Ntk::is_cell_root( pivot ) );
-
-    // reset old window
-    _storage->_nodes.clear();
-    _storage->_gates.clear();
-
-    std::vector<node> gates;
-    gates.reserve( _storage->_max_gates );
-    collect_mffc( pivot, gates );
-    add_node( pivot, gates );
+  /*! \brief Computes the window for `pivot` with the current cell references.
+   *
+   * Unlike `compute_window_for`, this method neither recomputes the cell
+   * references nor marks the window as visited, such that many windows can
+   * be computed for the same mapping at the cost of one traversal of the
+   * network.  Call `init_cell_refs` after the mapping has been changed.
+   *
+   * Returns false, if the window has been visited before.
+   */
+  bool peek_window_for( node const& pivot )
+  {
+    build_window( pivot );
+    return !_storage->_window_hash.count( _storage->_window_mask );
+  }
 
-    if ( gates.size() > _storage->_max_gates )
-    {
-      assert( false );
-    }
+  /*! \brief Marks the current window as visited.
+   *
+   * Returns false, if the window has been visited before.
+   */
+  bool mark_window_visited()
+  {
+    return _storage->_window_hash.insert( _storage->_window_mask ).second;
+  }
 
-    std::optional<node> next;
-    while ( ( next = find_next_pivot() ) )
-    {
-      gates.clear();
-      collect_mffc( *next, gates );
+  /*! \brief Recomputes the cell references from the mapping of the network. */
+  void init_cell_refs()
+  {
+    _storage->_cell_refs.reset();
+    _storage->_cell_parents.reset();
 
-      if ( _storage->_gates.size() + gates.size() > _storage->_max_gates )
+    /* initial ref counts for cells */
+    Ntk::foreach_gate( [&]( auto const& n ) {
+      if ( Ntk::is_cell_root( n ) )
       {
-        break;
-      }
-      add_node( *next, gates );
-    }
-
-    find_leaves_and_roots();
-    set_indexes();
+        Ntk::foreach_cell_fanin( n, [&]( auto const& n2 ) {
+          _storage->_cell_refs[n2]++;
+          _storage->_cell_parents[n2].push_back( n );
+        } );
+    } } );
+    Ntk::foreach_po( [&]( auto const& f ) {
+      _storage->_cell_refs[f]++;
+    } );
+  }
 
-    return _storage->_window_hash.insert( _storage->_window_mask ).second;
+  /*! \brief Returns a copy of the current window with its own window data.
+   *
+   * The copy shares the network and the cell references with this window.
+   * It cannot compute new windows, but it can be mapped independently of
+   * this window, e.g., in another thread, as long as the gates of the
+   * windows are disjoint and the mapping is not read in the meantime.
+   */
+  cell_window snapshot()
+  {
+    /* do not copy the hashes of visited windows */
+    auto window_hash = std::move( _storage->_window_hash );
+    cell_window copy( *this, std::make_shared<detail::cell_window_storage<Ntk>>( *_storage ) );
+    _storage->_window_hash = std::move( window_hash );
+    copy._storage->_window_hash.clear();
+    return copy;
   }
 
   uint32_t num_pis() const
@@ -179,6 +207,16 @@ public:
     return _storage->_roots.size();
   }
 
+  uint32_t num_cis() const
+  {
+    return _storage->_leaves.size();
+  }
+
+  uint32_t num_cos() const
+  {
+    return _storage->_roots.size();
+  }
+
   uint32_t num_gates() const
   {
     return _storage->_gates.size();
@@ -199,6 +237,11 @@ public:
     return _storage->_leaves.count( n );
   }
 
+  bool is_ci( node const& n ) const
+  {
+    return _storage->_leaves.count( n );
+  }
+
   bool is_cell_root( node const& n ) const
   {
     return _storage->_nodes.count( n );
@@ -249,6 +292,18 @@ public:
     detail::foreach_element( _storage->_roots.begin(), _storage->_roots.end(), fn );
   }
 
+  template<typename Fn>
+  void foreach_ci( Fn&& fn ) const
+  {
+    detail::foreach_element( _storage->_leaves.begin(), _storage->_leaves.end(), fn );
+  }
+
+  template<typename Fn>
+  void foreach_co( Fn&& fn ) const
+  {
+    detail::foreach_element( _storage->_roots.begin(), _storage->_roots.end(), fn );
+  }
+
   template<typename Fn>
   void foreach_gate( Fn&& fn ) const
   {
@@ -262,23 +317,45 @@ public:
   }
 
 private:
-  void init_cell_refs()
+  cell_window( Ntk const& ntk, storage const& s )
+      : Ntk( ntk ),
+        _storage( s )
   {
-    _storage->_cell_refs.reset();
-    _storage->_cell_parents.reset();
+  }
 
-    /* initial ref counts for cells */
-    Ntk::foreach_gate( [&]( auto const& n ) {
-      if ( Ntk::is_cell_root( n ) )
+  void build_window( node const& pivot )
+  {
+    assert( Ntk::is_cell_root( pivot ) );
+
+    // reset old window
+    _storage->_nodes.clear();
+    _storage->_gates.clear();
+
+    std::vector<node> gates;
+    gates.reserve( _storage->_max_gates );
+    collect_mffc( pivot, gates );
+    add_node( pivot, gates );
+
+    if ( gates.size() > _storage->_max_gates )
+    {
+      assert( false );
+    }
+
+    std::optional<node> next;
+    while ( ( next = find_next_pivot() ) )
+    {
+      gates.clear();
+      collect_mffc( *next, gates );
+
+      if ( _storage->_gates.size() + gates.size() > _storage->_max_gates )
       {
-        Ntk::foreach_cell_fanin( n, [&]( auto const& n2 ) {
-          _storage->_cell_refs[n2]++;
-          _storage->_cell_parents[n2].push_back( n );
-        } );
-    } } );
-    Ntk::foreach_po( [&]( auto const& f ) {
-      _storage->_cell_refs[f]++;
-    } );
+        break;
+      }
+      add_node( *next, gates );
+    }
+
+    find_leaves_and_roots();
+    set_indexes();
   }
 
   void collect_mffc( node const& pivot, std::vector<node>& gates )
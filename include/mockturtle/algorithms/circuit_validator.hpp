@@ -35,6 +35,10 @@
 #include "../networks/events.hpp"
 #include "../utils/node_map.hpp"
 #include "cnf.hpp"
+#include <algorithm>
+#include <array>
+#include <fmt/format.h>
+#include <iostream>
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <bill/sat/interface/common.hpp>
 #include <bill/sat/interface/glucose.hpp>
@@ -56,6 +60,60 @@ struct validator_params
 
   /*! \brief Seed for randomized solving. */
   uint32_t random_seed{0};
+
+  /*! \brief Recycle the SAT solver instead of restarting it when `max_clauses` is exceeded.
+   *
+   * The clauses of each node are guarded by an activation literal.  When
+   * more than `max_clauses` clauses have been added since the last
+   * collection, the transitive fanin cones of the nodes used in the most
+   * recent queries are kept, and the clauses of all other nodes are
+   * disabled.  The solver is only restarted if too many of its variables
+   * are unused.
+   */
+  bool recycle_solver{false};
+
+  /*! \brief Maximum cut size for encoding nodes with the CNF of a cut function.
+   *
+   * If at least 3, encoding a node absorbs fanout-free fanin gates that are
+   * not encoded yet into a cut of up to this many leaves (at most 6), as long
+   * as the CNF of the cut function has no more clauses than encoding the
+   * absorbed gates separately.  Absorbed gates do not get a variable.  For
+   * 0, each gate is encoded separately.
+   */
+  uint32_t cnf_cut_size{0u};
+};
+
+struct validator_stats
+{
+  /*! \brief Number of solver restarts. */
+  uint32_t num_restarts{0};
+
+  /*! \brief Number of garbage collections (keeping the used cones). */
+  uint32_t num_recycles{0};
+
+  /*! \brief Number of node encodings. */
+  uint64_t num_encoded{0};
+
+  /*! \brief Number of encodings of nodes that had been encoded before. */
+  uint64_t num_reencoded{0};
+
+  /*! \brief Number of encoded nodes dropped by garbage collections. */
+  uint64_t num_collected{0};
+
+  /*! \brief Number of gates absorbed into the cuts of encoded nodes (`cnf_cut_size`). */
+  uint64_t num_absorbed{0};
+
+  void report() const
+  {
+    // clang-format off
+    std::cout << fmt::format( "[i] #restarts  = {:8d}\n", num_restarts );
+    std::cout << fmt::format( "[i] #recycles  = {:8d}\n", num_recycles );
+    std::cout << fmt::format( "[i] #encoded   = {:8d}\n", num_encoded );
+    std::cout << fmt::format( "[i] #reencoded = {:8d}\n", num_reencoded );
+    std::cout << fmt::format( "[i] #collected = {:8d}\n", num_collected );
+    std::cout << fmt::format( "[i] #absorbed  = {:8d}\n", num_absorbed );
+    // clang-format on
+  }
 };
 
 template<class Ntk, bill::solvers Solver = bill::solvers::glucose_41, bool use_pushpop = false, bool randomize = false, bool use_odc = false>
@@ -70,6 +128,36 @@ public:
 
   friend class network_events<Ntk>::add_accessor;
 
+private:
+  static constexpr uint32_t MAX_CNF_CUT_SIZE = 6u;
+
+  /* encoding information of a node */
+  struct node_info
+  {
+    /* solver epoch in which the node is encoded */
+    uint32_t epoch{0};
+
+    /* last query in which the node was used */
+    uint32_t last_used{0};
+
+    /* traversal stamp for garbage collection */
+    uint32_t trav{0};
+
+    /* number of clauses encoding the node's function */
+    uint32_t num_clauses{0};
+
+    /* activation literal guarding the node's clauses */
+    bill::lit_type activation;
+
+    /* fanins (or cut leaves) at the time of encoding */
+    std::array<node, MAX_CNF_CUT_SIZE> fanins;
+    uint32_t num_fanins{0};
+
+    bool encoded_before{false};
+  };
+
+public:
+
   enum gate_type
   {
     AND,
@@ -99,7 +187,7 @@ public:
   };
 
   explicit circuit_validator( Ntk const& ntk, validator_params const& ps = {} )
-      : ntk( ntk ), ps( ps ), literals( ntk ), constructed( ntk ), num_invoke( 0u ), cex( ntk.num_pis() )
+      : ntk( ntk ), ps( ps ), recycle_solver( ps.recycle_solver ), literals( ntk ), infos( ntk ), num_invoke( 0u ), cex( ntk.num_pis() )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
@@ -143,6 +231,7 @@ public:
       (void)n;
       auto self = reinterpret_cast<circuit_validator *>(wp);
       self->literals.resize();
+      self->infos.resize();
     });
 
     /* constants are mapped to var 0 */
@@ -163,30 +252,18 @@ public:
   /*! \brief Validate functional equivalence of signals `f` and `d`. */
   std::optional<bool> validate( signal const& f, signal const& d )
   {
-    if ( !constructed.has( d ) && !ntk.is_pi( ntk.get_node( d ) ) && !ntk.is_constant( ntk.get_node( d ) ) )
-    {
-      construct( ntk.get_node( d ) );
-    }
+    use_node( ntk.get_node( d ) );
     auto const res = validate( ntk.get_node( f ), lit_not_cond( literals[d], ntk.is_complemented( f ) ^ ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_solver_size();
     return res;
   }
 
   /*! \brief Validate functional equivalence of node `root` and signal `d`. */
   std::optional<bool> validate( node const& root, signal const& d )
   {
-    if ( !constructed.has( d ) && !ntk.is_pi( ntk.get_node( d ) ) && !ntk.is_constant( ntk.get_node( d ) ) )
-    {
-      construct( ntk.get_node( d ) );
-    }
+    use_node( ntk.get_node( d ) );
     auto const res = validate( root, lit_not_cond( literals[d], ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_solver_size();
     return res;
   }
 
@@ -220,18 +297,12 @@ public:
   template<class iterator_type>
   std::optional<bool> validate( node const& root, iterator_type divs_begin, iterator_type divs_end, std::vector<gate> const& circuit, bool output_negation = false )
   {
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    use_node( root );
 
     std::vector<bill::lit_type> lits;
     while ( divs_begin != divs_end )
     {
-      if ( !constructed.has( *divs_begin ) && !ntk.is_pi( *divs_begin ) && !ntk.is_constant( *divs_begin ) )
-      {
-        construct( *divs_begin );
-      }
+      use_node( *divs_begin );
       lits.emplace_back( literals[*divs_begin] );
       divs_begin++;
     }
@@ -253,10 +324,7 @@ public:
       pop();
     }
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_solver_size();
 
     return res;
   }
@@ -270,10 +338,7 @@ public:
   /*! \brief Validate whether node `root` is a constant of `value`. */
   std::optional<bool> validate( node const& root, bool value )
   {
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    use_node( root );
 
     std::optional<bool> res;
     if constexpr ( use_odc )
@@ -300,10 +365,7 @@ public:
       res = solve( {lit_not_cond( literals[root], value )} );
     }
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_solver_size();
     return res;
   }
 
@@ -328,10 +390,7 @@ public:
   template<bool enabled = use_pushpop, typename = std::enable_if_t<enabled>>
   std::vector<std::vector<bool>> generate_pattern( node const& root, bool value, std::vector<std::vector<bool>> const& block_patterns = {}, uint32_t num_patterns = 1u )
   {
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    use_node( root );
 
     push();
 
@@ -367,10 +426,7 @@ public:
     }
 
     pop();
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_solver_size();
     return generated;
   }
 
@@ -381,9 +437,16 @@ public:
    */
   void update()
   {
+    ++st.num_restarts;
     restart();
   }
 
+  /*! \brief Returns statistics about restarts and encodings. */
+  validator_stats const& stats() const
+  {
+    return st;
+  }
+
 private:
   void restart()
   {
@@ -394,15 +457,384 @@ private:
       solver.set_random_phase( ps.random_seed );
     }
 
-    constructed.reset();
+    /* invalidates the encoding of all nodes */
+    ++epoch;
+    period_start = num_queries;
+    used.clear();
+    num_encoded_nodes = 0u;
+    num_live_clauses = 0u;
+    collect_threshold = 0u;
+    dead_vars.clear();
 
     solver.add_variables( ntk.num_pis() + 1 );
     solver.add_clause( {~literals[ntk.get_constant( false )]} );
+    if ( recycle_solver )
+    {
+      period_lit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    }
   }
 
+  /* restarts or recycles the solver if it has too many clauses */
+  void check_solver_size()
+  {
+    ++num_queries;
+    if ( num_invoke < MIN_NUM_INVOKE )
+    {
+      return;
+    }
+
+    if ( !recycle_solver )
+    {
+      if ( solver.num_clauses() > ps.max_clauses )
+      {
+        ++st.num_restarts;
+        restart();
+      }
+    }
+    else if ( num_live_clauses > std::max<uint64_t>( ps.max_clauses, collect_threshold ) )
+    {
+      recycle();
+    }
+  }
+
+  /* keeps the cones of the nodes used in the most recent queries and disables all other clauses;
+     the next collection is triggered when `max_clauses` clauses have been added */
+  void recycle()
+  {
+    /* mark the transitive fanin cones (at the time of encoding) of the used nodes */
+    ++trav_stamp;
+    std::vector<node> hot;
+    uint64_t hot_clauses{0};
+    stack.clear();
+    for ( auto const& n : used )
+    {
+      if ( infos[n].epoch == epoch && infos[n].last_used + RECENT_QUERIES > num_queries )
+      {
+        stack.emplace_back( n );
+      }
+    }
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      stack.pop_back();
+      auto& info = infos[n];
+      if ( info.trav == trav_stamp )
+      {
+        continue;
+      }
+      info.trav = trav_stamp;
+      hot.emplace_back( n );
+      hot_clauses += info.num_clauses + 1u;
+      for ( auto i = 0u; i < info.num_fanins; ++i )
+      {
+        if ( !ntk.is_pi( info.fanins[i] ) && !ntk.is_constant( info.fanins[i] ) )
+        {
+          stack.emplace_back( info.fanins[i] );
+        }
+      }
+    }
+
+    /* restart, if there are too many unused variables */
+    uint64_t const num_live_vars = ntk.num_pis() + 2u + 2u * hot.size();
+    if ( solver.num_variables() > 2u * num_live_vars + ps.max_clauses )
+    {
+      ++st.num_restarts;
+      restart();
+      return;
+    }
+
+    ++st.num_recycles;
+    st.num_collected += num_encoded_nodes - hot.size();
+    num_invoke = 0u;
+    ++epoch;
+    period_start = num_queries;
+    used.clear();
+
+    /* move the hot nodes into the new period */
+    period_lit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    std::vector<bool> live( solver.num_variables(), false );
+    for ( auto i = 0u; i <= ntk.num_pis(); ++i )
+    {
+      live[i] = true;
+    }
+    live[period_lit.variable()] = true;
+    for ( auto const& n : hot )
+    {
+      auto& info = infos[n];
+      info.epoch = epoch;
+      live[literals[n].variable()] = true;
+      live[info.activation.variable()] = true;
+      solver.add_clause( {~period_lit, info.activation} );
+    }
+    num_encoded_nodes = hot.size();
+    num_live_clauses = hot_clauses;
+    collect_threshold = hot_clauses + ps.max_clauses;
+
+    /* fix all other variables, which satisfies their clauses */
+    dead_vars.resize( solver.num_variables(), false );
+    for ( auto v = 0u; v < solver.num_variables(); ++v )
+    {
+      if ( live[v] || dead_vars[v] )
+      {
+        continue;
+      }
+      dead_vars[v] = true;
+      solver.add_clause( bill::lit_type( v, bill::lit_type::polarities::negative ) );
+    }
+  }
+
+  /* encodes a node used in a query */
+  void use_node( node const& n )
+  {
+    if ( ntk.is_pi( n ) || ntk.is_constant( n ) )
+    {
+      return;
+    }
+
+    construct( n );
+    auto& info = infos[n];
+    if ( info.last_used <= period_start )
+    {
+      used.emplace_back( n );
+    }
+    info.last_used = num_queries;
+  }
+
+  bool is_encoded( node const& n ) const
+  {
+    return ntk.is_pi( n ) || ntk.is_constant( n ) || infos[n].epoch == epoch;
+  }
+
+  /* encodes the transitive fanin cone of `n` (iteratively) */
   void construct( node const& n )
   {
-    assert( !constructed.has( n ) && !ntk.is_pi( n ) && !ntk.is_constant( n ) );
+    if ( ntk.is_pi( n ) || ntk.is_constant( n ) )
+    {
+      return;
+    }
+
+    stack.clear();
+    stack.emplace_back( n );
+    while ( !stack.empty() )
+    {
+      auto const m = stack.back();
+      if ( is_encoded( m ) )
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      auto const size = stack.size();
+      bool const use_cut = compute_cnf_cut( m );
+      if ( use_cut )
+      {
+        for ( auto i = 0u; i < num_cut_leaves; ++i )
+        {
+          if ( !is_encoded( cut_leaves[i] ) )
+          {
+            stack.emplace_back( cut_leaves[i] );
+          }
+        }
+      }
+      else
+      {
+        ntk.foreach_fanin( m, [&]( auto const& f ) {
+          if ( !is_encoded( ntk.get_node( f ) ) )
+          {
+            stack.emplace_back( ntk.get_node( f ) );
+          }
+        } );
+      }
+
+      if ( stack.size() == size )
+      {
+        stack.pop_back();
+        if ( use_cut )
+        {
+          encode_cut( m );
+        }
+        else
+        {
+          encode_node( m );
+        }
+      }
+    }
+  }
+
+  /* D-MAJ nodes are encoded and simulated as majority gates */
+  bool is_maj_gate( node const& n ) const
+  {
+    if constexpr ( has_is_dmaj_v<Ntk> )
+    {
+      if ( ntk.is_dmaj( n ) )
+      {
+        return true;
+      }
+    }
+    return ntk.is_maj( n );
+  }
+
+  /* number of clauses of the gate encoding of `n` */
+  uint32_t gate_clauses( node const& n ) const
+  {
+    if ( ntk.is_and( n ) )
+    {
+      return 3u;
+    }
+    else if ( ntk.is_xor( n ) )
+    {
+      return 4u;
+    }
+    else if ( is_maj_gate( n ) )
+    {
+      return 6u;
+    }
+    return 8u; /* XOR3 */
+  }
+
+  /* simulates the cone of `n` on the cut leaves (constants are not leaves) */
+  uint64_t simulate_cut( node const& n ) const
+  {
+    static constexpr uint64_t projections[] = {0xaaaaaaaaaaaaaaaa, 0xcccccccccccccccc, 0xf0f0f0f0f0f0f0f0, 0xff00ff00ff00ff00, 0xffff0000ffff0000, 0xffffffff00000000};
+
+    if ( ntk.is_constant( n ) )
+    {
+      return 0u;
+    }
+    for ( auto i = 0u; i < num_cut_leaves; ++i )
+    {
+      if ( cut_leaves[i] == n )
+      {
+        return projections[i];
+      }
+    }
+
+    std::array<uint64_t, 3> values{};
+    auto i = 0u;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto const v = simulate_cut( ntk.get_node( f ) );
+      values[i++] = ntk.is_complemented( f ) ? ~v : v;
+    } );
+
+    if ( ntk.is_and( n ) )
+    {
+      return values[0] & values[1];
+    }
+    else if ( ntk.is_xor( n ) )
+    {
+      return values[0] ^ values[1];
+    }
+    else if ( is_maj_gate( n ) )
+    {
+      return ( values[0] & values[1] ) | ( values[0] & values[2] ) | ( values[1] & values[2] );
+    }
+    return values[0] ^ values[1] ^ values[2]; /* XOR3 */
+  }
+
+  /* updates the function of the current cut, returns its number of clauses */
+  uint32_t update_cut_function( node const& n )
+  {
+    cut_function = kitty::dynamic_truth_table( num_cut_leaves );
+    cut_function._bits[0] = simulate_cut( n );
+    cut_function.mask_bits();
+    return cnf_functions.num_clauses( cut_function );
+  }
+
+  /* computes a cut for `n` by absorbing fanout-free fanin gates that are not
+     encoded yet, if this does not increase the number of clauses; returns
+     false, if `n` should be encoded as a gate */
+  bool compute_cnf_cut( node const& n )
+  {
+    if constexpr ( has_fanout_size_v<Ntk> )
+    {
+      auto const cut_size = std::min<uint32_t>( ps.cnf_cut_size, MAX_CNF_CUT_SIZE );
+      if ( cut_size < 3u )
+      {
+        return false;
+      }
+
+      const auto add_fanins = [&]( node const& g, std::array<node, MAX_CNF_CUT_SIZE + 2>& leaves, uint32_t& num_leaves ) {
+        bool fits{true};
+        ntk.foreach_fanin( g, [&]( auto const& f ) {
+          auto const l = ntk.get_node( f );
+          if ( ntk.is_constant( l ) || std::find( leaves.begin(), leaves.begin() + num_leaves, l ) != leaves.begin() + num_leaves )
+          {
+            return true;
+          }
+          if ( num_leaves == cut_size )
+          {
+            fits = false;
+            return false;
+          }
+          leaves[num_leaves++] = l;
+          return true;
+        } );
+        return fits;
+      };
+
+      num_cut_leaves = 0u;
+      add_fanins( n, candidate_leaves, num_cut_leaves );
+      std::copy( candidate_leaves.begin(), candidate_leaves.begin() + num_cut_leaves, cut_leaves.begin() );
+      auto cost = update_cut_function( n );
+      num_cut_absorbed = 0u;
+
+      bool improved{true};
+      while ( improved )
+      {
+        improved = false;
+        for ( auto i = 0u; i < num_cut_leaves; ++i )
+        {
+          auto const l = cut_leaves[i];
+          if ( is_encoded( l ) || ntk.fanout_size( l ) != 1u )
+          {
+            continue;
+          }
+
+          /* replace the leaf by its fanins */
+          auto const saved_leaves = cut_leaves;
+          auto const saved_num_leaves = num_cut_leaves;
+          std::copy( cut_leaves.begin(), cut_leaves.begin() + num_cut_leaves, candidate_leaves.begin() );
+          uint32_t num_leaves = num_cut_leaves;
+          std::copy( candidate_leaves.begin() + i + 1, candidate_leaves.begin() + num_leaves, candidate_leaves.begin() + i );
+          --num_leaves;
+          if ( !add_fanins( l, candidate_leaves, num_leaves ) )
+          {
+            continue;
+          }
+
+          std::copy( candidate_leaves.begin(), candidate_leaves.begin() + num_leaves, cut_leaves.begin() );
+          num_cut_leaves = num_leaves;
+          auto const new_cost = update_cut_function( n );
+          if ( new_cost <= cost + gate_clauses( l ) )
+          {
+            cost = new_cost;
+            ++num_cut_absorbed;
+            improved = true;
+            break;
+          }
+
+          cut_leaves = saved_leaves;
+          num_cut_leaves = saved_num_leaves;
+        }
+      }
+
+      if ( num_cut_absorbed == 0u )
+      {
+        return false;
+      }
+      update_cut_function( n );
+      return true;
+    }
+    else
+    {
+      (void)n;
+      return false;
+    }
+  }
+
+  /* encodes `n` with the CNF of the cut computed by `compute_cnf_cut` */
+  void encode_cut( node const& n )
+  {
     if constexpr ( use_pushpop )
     {
       if ( between_push_pop )
@@ -411,40 +843,116 @@ private:
       }
     }
 
+    auto& info = infos[n];
     std::vector<bill::lit_type> child_lits;
-    ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( !constructed.has( f ) && !ntk.is_pi( ntk.get_node( f ) ) && !ntk.is_constant( ntk.get_node( f ) ) )
+    for ( auto i = 0u; i < num_cut_leaves; ++i )
+    {
+      info.fanins[i] = cut_leaves[i];
+      child_lits.push_back( literals[cut_leaves[i]] );
+    }
+    info.num_fanins = num_cut_leaves;
+    bill::lit_type node_lit = literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    st.num_absorbed += num_cut_absorbed;
+
+    start_encoding( info );
+    detail::on_function( node_lit, child_lits, cnf_functions( cut_function ), [&]( auto const& clause ) {
+      add_node_clause( info, clause );
+    } );
+  }
+
+  void start_encoding( node_info& info )
+  {
+    info.epoch = epoch;
+    info.num_clauses = 0u;
+    ++num_encoded_nodes;
+    ++st.num_encoded;
+    if ( info.encoded_before )
+    {
+      ++st.num_reencoded;
+    }
+    info.encoded_before = true;
+
+    if ( recycle_solver )
+    {
+      info.activation = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+      solver.add_clause( {~period_lit, info.activation} );
+      ++num_live_clauses;
+    }
+  }
+
+  template<class Clause>
+  void add_node_clause( node_info& info, Clause const& clause )
+  {
+    ++info.num_clauses;
+    ++num_live_clauses;
+    if ( recycle_solver )
+    {
+      clause_buffer.assign( clause.begin(), clause.end() );
+      clause_buffer.emplace_back( ~info.activation );
+      solver.add_clause( clause_buffer );
+    }
+    else
+    {
+      solver.add_clause( clause );
+    }
+  }
+
+  void encode_node( node const& n )
+  {
+    if constexpr ( use_pushpop )
+    {
+      if ( between_push_pop )
       {
-        construct( ntk.get_node( f ) );
+        tmp.emplace_back( n );
       }
+    }
+
+    auto& info = infos[n];
+    std::vector<bill::lit_type> child_lits;
+    info.num_fanins = 0u;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      assert( info.num_fanins < info.fanins.size() );
+      info.fanins[info.num_fanins++] = ntk.get_node( f );
       child_lits.push_back( lit_not_cond( literals[f], ntk.is_complemented( f ) ) );
     } );
     bill::lit_type node_lit = literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-    constructed[n] = true;
+
+    start_encoding( info );
+    auto const add_node_clause = [&]( auto const& clause ) {
+      this->add_node_clause( info, clause );
+    };
 
     if ( ntk.is_and( n ) )
     {
-      detail::on_and<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } );
+      detail::on_and<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], add_node_clause );
     }
     else if ( ntk.is_xor( n ) )
     {
-      detail::on_xor<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } );
+      detail::on_xor<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], add_node_clause );
     }
     else if ( ntk.is_xor3( n ) )
     {
-      detail::on_xor3<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } );
+      detail::on_xor3<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], add_node_clause );
     }
-    else if ( ntk.is_maj( n ) )
+    else if ( is_maj_gate( n ) )
     {
-      detail::on_maj<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } );
+      detail::on_maj<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], add_node_clause );
+    }
+  }
+
+  /* adds a clause that is only needed in the current period */
+  void add_clause( std::vector<bill::lit_type> const& clause )
+  {
+    ++num_live_clauses;
+    if ( recycle_solver )
+    {
+      clause_buffer.assign( clause.begin(), clause.end() );
+      clause_buffer.emplace_back( ~period_lit );
+      solver.add_clause( clause_buffer );
+    }
+    else
+    {
+      solver.add_clause( clause );
     }
   }
 
@@ -453,6 +961,7 @@ private:
     solver.push();
     between_push_pop = true;
     tmp.clear();
+    num_live_clauses_before_push = num_live_clauses;
   }
 
   void pop()
@@ -460,8 +969,10 @@ private:
     solver.pop();
     for ( auto& n : tmp )
     {
-      constructed.erase( n );
+      infos[n].epoch = 0u;
+      --num_encoded_nodes;
     }
+    num_live_clauses = num_live_clauses_before_push;
     between_push_pop = false;
   }
 
@@ -473,13 +984,13 @@ private:
     if ( type == AND )
     {
       detail::on_and<add_clause_fn_t>( nlit, a, b, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_clause( clause );
       } );
     }
     else if ( type == XOR )
     {
       detail::on_xor<add_clause_fn_t>( nlit, a, b, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_clause( clause );
       } );
     }
 
@@ -494,13 +1005,13 @@ private:
     if ( type == MAJ )
     {
       detail::on_maj<add_clause_fn_t>( nlit, a, b, c, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_clause( clause );
       } );
     }
     else if ( type == XOR )
     {
       detail::on_xor3<add_clause_fn_t>( nlit, a, b, c, [&]( auto const& clause ) {
-        solver.add_clause( clause );
+        add_clause( clause );
       } );
     }
 
@@ -530,6 +1041,10 @@ private:
   std::optional<bool> solve( std::vector<bill::lit_type> assumptions )
   {
     ++num_invoke;
+    if ( recycle_solver )
+    {
+      assumptions.emplace_back( period_lit );
+    }
     auto const res = solver.solve( assumptions, ps.conflict_limit );
 
     if ( res == bill::result::states::satisfiable )
@@ -550,10 +1065,7 @@ private:
 
   std::optional<bool> validate( node const& root, bill::lit_type const& lit )
   {
-    if ( !constructed.has( root ) && !ntk.is_pi( root ) && !ntk.is_constant( root ) )
-    {
-      construct( root );
-    }
+    use_node( root );
 
     std::optional<bool> res;
     if constexpr ( use_odc )
@@ -573,16 +1085,16 @@ private:
       else
       {
         auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-        solver.add_clause( {literals[root], lit, nlit} );
-        solver.add_clause( {~( literals[root] ), ~lit, nlit} );
+        add_clause( {literals[root], lit, nlit} );
+        add_clause( {~( literals[root] ), ~lit, nlit} );
         res = solve( {~nlit} );
       }
     }
     else
     {
       auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
-      solver.add_clause( {literals[root], lit, nlit} );
-      solver.add_clause( {~( literals[root] ), ~lit, nlit} );
+      add_clause( {literals[root], lit, nlit} );
+      add_clause( {~( literals[root] ), ~lit, nlit} );
       res = solve( {~nlit} );
     }
 
@@ -596,7 +1108,7 @@ private:
     ntk.foreach_pi( [&]( auto const& n, auto i ) {
       clause.emplace_back( lit_not_cond( literals[n] , pattern[i] ) );
     } );
-    solver.add_clause( clause );
+    add_clause( clause );
   }
 
 private:
@@ -625,7 +1137,7 @@ private:
     assert( miter.size() > 0 && "max fanout depth < odc_levels (-1 is infinity) and there is no PO in TFO cone" );
     auto nlit2 = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
     miter.emplace_back( nlit2 );
-    solver.add_clause( miter );
+    add_clause( miter );
     return ~nlit2;
   }
 
@@ -639,10 +1151,7 @@ private:
 
       std::vector<bill::lit_type> l_fi;
       ntk.foreach_fanin( fo, [&]( auto const& fi ) {
-        if ( !constructed.has( fi ) && !ntk.is_pi( ntk.get_node( fi ) ) && !ntk.is_constant( ntk.get_node( fi ) ) )
-        {
-          construct( ntk.get_node( fi ) );
-        }
+        construct( ntk.get_node( fi ) );
         l_fi.emplace_back( lit_not_cond( lits.has( ntk.get_node( fi ) ) ? lits[fi] : literals[fi], ntk.is_complemented( fi ) ) );
       } );
       if ( l_fi.size() == 2u )
@@ -653,8 +1162,8 @@ private:
       else
       {
         assert( l_fi.size() == 3u );
-        assert( ntk.is_maj( fo ) || ntk.is_xor3( fo ) );
-        add_clauses_for_3input_gate( l_fi[0], l_fi[1], l_fi[2], lits[fo], ntk.is_maj( fo ) ? MAJ : XOR );
+        assert( is_maj_gate( fo ) || ntk.is_xor3( fo ) );
+        add_clauses_for_3input_gate( l_fi[0], l_fi[1], l_fi[2], lits[fo], is_maj_gate( fo ) ? MAJ : XOR );
       }
 
       if ( level == ps.odc_levels )
@@ -673,10 +1182,7 @@ private:
         return true; /* skip */
       ntk.set_visited( fo, ntk.trav_id() );
 
-      if ( !constructed.has( fo ) )
-      {
-        construct( fo );
-      }
+      construct( fo );
 
       lits[fo] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
 
@@ -694,7 +1200,7 @@ private:
   template<bool enabled = use_odc, typename = std::enable_if_t<enabled>>
   void add_miter_clauses( node const& n, unordered_node_map<bill::lit_type, Ntk> const& lits, std::vector<bill::lit_type>& miter )
   {
-    assert( constructed.has( n ) && literals[n] != literals[ntk.get_constant( false )] );
+    assert( is_encoded( n ) && literals[n] != literals[ntk.get_constant( false )] );
     miter.emplace_back( add_clauses_for_2input_gate( literals[n], lits[n], std::nullopt, XOR ) );
   }
 
@@ -702,17 +1208,49 @@ private:
   Ntk const& ntk;
 
   validator_params const& ps;
+  bool const recycle_solver;
 
   node_map<bill::lit_type, Ntk> literals;
-  unordered_node_map<bool, Ntk> constructed;
+  node_map<node_info, Ntk> infos;
   bill::solver<Solver> solver;
 
   static const uint32_t MIN_NUM_INVOKE = 20u;
   uint32_t num_invoke;
 
+  /* nodes are encoded if their epoch is the current one (0 is never used) */
+  uint32_t epoch{0};
+
+  /* periods are separated by restarts and garbage collections; clauses
+     of temporary gates are guarded by the period's literal */
+  uint32_t period_start{0};
+  uint32_t num_queries{1};
+  static const uint32_t RECENT_QUERIES = 2u;
+  bill::lit_type period_lit;
+  std::vector<node> used;
+
+  uint32_t trav_stamp{0};
+  uint64_t num_encoded_nodes{0};
+  uint64_t num_live_clauses{0};
+  uint64_t num_live_clauses_before_push{0};
+  uint64_t collect_threshold{0};
+  std::vector<bool> dead_vars;
+
+  std::vector<node> stack;
+  std::vector<bill::lit_type> clause_buffer;
+
+  /* current cut for encoding with `cnf_cut_size` */
+  std::array<node, MAX_CNF_CUT_SIZE + 2> cut_leaves;
+  std::array<node, MAX_CNF_CUT_SIZE + 2> candidate_leaves;
+  uint32_t num_cut_leaves{0};
+  uint32_t num_cut_absorbed{0};
+  kitty::dynamic_truth_table cut_function;
+  cnf_cache cnf_functions;
+
   bool between_push_pop = false;
   std::vector<node> tmp;
 
+  validator_stats st;
+
 public:
   std::vector<bool> cex;
 };
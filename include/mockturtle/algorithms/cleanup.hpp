@@ -32,8 +32,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <kitty/operations.hpp>
@@ -82,122 +85,160 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSource const& ntk, NtkDest& de
 
   /* foreach node in topological order */
   topo_view topo{ntk};
-  topo.foreach_node( [&]( auto node ) {
-    if ( ntk.is_constant( node ) || ntk.is_pi( node ) )
-      return;
-
-    /* collect children */
-    std::vector<signal<NtkDest>> children;
-    ntk.foreach_fanin( node, [&]( auto child, auto ) {
-      const auto f = old_to_new[child];
-      if ( ntk.is_complemented( child ) )
+
+  if constexpr ( std::is_same_v<NtkSource, NtkDest> && has_create_and_batch_v<NtkDest> )
+  {
+    /* create AND gates in batches, in which fanins from the same batch are placeholder signals */
+    std::vector<std::array<signal<NtkDest>, 2u>> batch;
+    std::vector<node<NtkSource>> batch_nodes;
+    const auto flush = [&]() {
+      const auto fs = dest.create_and_batch( batch );
+      for ( auto i = 0u; i < fs.size(); ++i )
       {
-        children.push_back( dest.create_not( f ) );
+        old_to_new[batch_nodes[i]] = fs[i];
       }
-      else
+      batch.clear();
+      batch_nodes.clear();
+    };
+
+    topo.foreach_node( [&]( auto node ) {
+      if ( ntk.is_constant( node ) || ntk.is_pi( node ) )
+        return;
+
+      std::array<signal<NtkDest>, 2u> children;
+      ntk.foreach_fanin( node, [&]( auto child, auto i ) {
+        const auto f = old_to_new[child];
+        children[i] = ntk.is_complemented( child ) ? dest.create_not( f ) : f;
+      } );
+      batch.push_back( children );
+      batch_nodes.push_back( node );
+      old_to_new[node] = dest.make_signal( dest.size() + batch.size() - 1u );
+      if ( batch.size() == 4096u )
       {
-        children.push_back( f );
+        flush();
       }
     } );
-    if constexpr ( std::is_same_v<NtkSource, NtkDest> )
-    {
-      old_to_new[node] = dest.clone_node( ntk, node, children );
-    }
-    else
-    {
-      do
+    flush();
+  }
+  else
+  {
+    topo.foreach_node( [&]( auto node ) {
+      if ( ntk.is_constant( node ) || ntk.is_pi( node ) )
+        return;
+
+      /* collect children */
+      std::vector<signal<NtkDest>> children;
+      ntk.foreach_fanin( node, [&]( auto child, auto ) {
+        const auto f = old_to_new[child];
+        if ( ntk.is_complemented( child ) )
+        {
+          children.push_back( dest.create_not( f ) );
+        }
+        else
+        {
+          children.push_back( f );
+        }
+      } );
+      if constexpr ( std::is_same_v<NtkSource, NtkDest> )
       {
-        if constexpr ( has_is_and_v<NtkSource> )
+        old_to_new[node] = dest.clone_node( ntk, node, children );
+      }
+      else
+      {
+        do
         {
-          static_assert( has_create_and_v<NtkDest>, "NtkDest cannot create AND gates" );
-          if ( ntk.is_and( node ) )
+          if constexpr ( has_is_and_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_and( children[0], children[1] );
-            break;
+            static_assert( has_create_and_v<NtkDest>, "NtkDest cannot create AND gates" );
+            if ( ntk.is_and( node ) )
+            {
+              old_to_new[node] = dest.create_and( children[0], children[1] );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_or_v<NtkSource> )
-        {
-          static_assert( has_create_or_v<NtkDest>, "NtkDest cannot create OR gates" );
-          if ( ntk.is_or( node ) )
+          if constexpr ( has_is_or_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_or( children[0], children[1] );
-            break;
+            static_assert( has_create_or_v<NtkDest>, "NtkDest cannot create OR gates" );
+            if ( ntk.is_or( node ) )
+            {
+              old_to_new[node] = dest.create_or( children[0], children[1] );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_xor_v<NtkSource> )
-        {
-          static_assert( has_create_xor_v<NtkDest>, "NtkDest cannot create XOR gates" );
-          if ( ntk.is_xor( node ) )
+          if constexpr ( has_is_xor_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_xor( children[0], children[1] );
-            break;
+            static_assert( has_create_xor_v<NtkDest>, "NtkDest cannot create XOR gates" );
+            if ( ntk.is_xor( node ) )
+            {
+              old_to_new[node] = dest.create_xor( children[0], children[1] );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_maj_v<NtkSource> )
-        {
-          static_assert( has_create_maj_v<NtkDest>, "NtkDest cannot create MAJ gates" );
-          if ( ntk.is_maj( node ) )
+          if constexpr ( has_is_maj_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_maj( children[0], children[1], children[2] );
-            break;
+            static_assert( has_create_maj_v<NtkDest>, "NtkDest cannot create MAJ gates" );
+            if ( ntk.is_maj( node ) )
+            {
+              old_to_new[node] = dest.create_maj( children[0], children[1], children[2] );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_ite_v<NtkSource> )
-        {
-          static_assert( has_create_ite_v<NtkDest>, "NtkDest cannot create ITE gates" );
-          if ( ntk.is_ite( node ) )
+          if constexpr ( has_is_ite_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_ite( children[0], children[1], children[2] );
-            break;
+            static_assert( has_create_ite_v<NtkDest>, "NtkDest cannot create ITE gates" );
+            if ( ntk.is_ite( node ) )
+            {
+              old_to_new[node] = dest.create_ite( children[0], children[1], children[2] );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_xor3_v<NtkSource> )
-        {
-          static_assert( has_create_xor3_v<NtkDest>, "NtkDest cannot create XOR3 gates" );
-          if ( ntk.is_xor3( node ) )
+          if constexpr ( has_is_xor3_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_xor3( children[0], children[1], children[2] );
-            break;
+            static_assert( has_create_xor3_v<NtkDest>, "NtkDest cannot create XOR3 gates" );
+            if ( ntk.is_xor3( node ) )
+            {
+              old_to_new[node] = dest.create_xor3( children[0], children[1], children[2] );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_nary_and_v<NtkSource> )
-        {
-          static_assert( has_create_nary_and_v<NtkDest>, "NtkDest cannot create n-ary AND gates" );
-          if ( ntk.is_nary_and( node ) )
+          if constexpr ( has_is_nary_and_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_nary_and( children );
-            break;
+            static_assert( has_create_nary_and_v<NtkDest>, "NtkDest cannot create n-ary AND gates" );
+            if ( ntk.is_nary_and( node ) )
+            {
+              old_to_new[node] = dest.create_nary_and( children );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_nary_or_v<NtkSource> )
-        {
-          static_assert( has_create_nary_or_v<NtkDest>, "NtkDest cannot create n-ary OR gates" );
-          if ( ntk.is_nary_or( node ) )
+          if constexpr ( has_is_nary_or_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_nary_or( children );
-            break;
+            static_assert( has_create_nary_or_v<NtkDest>, "NtkDest cannot create n-ary OR gates" );
+            if ( ntk.is_nary_or( node ) )
+            {
+              old_to_new[node] = dest.create_nary_or( children );
+              break;
+            }
           }
-        }
-        if constexpr ( has_is_nary_xor_v<NtkSource> )
-        {
-          static_assert( has_create_nary_xor_v<NtkDest>, "NtkDest cannot create n-ary XOR gates" );
-          if ( ntk.is_nary_xor( node ) )
+          if constexpr ( has_is_nary_xor_v<NtkSource> )
           {
-            old_to_new[node] = dest.create_nary_xor( children );
+            static_assert( has_create_nary_xor_v<NtkDest>, "NtkDest cannot create n-ary XOR gates" );
+            if ( ntk.is_nary_xor( node ) )
+            {
+              old_to_new[node] = dest.create_nary_xor( children );
+              break;
+            }
+          }
+          if constexpr ( has_is_function_v<NtkSource> )
+          {
+            static_assert( has_create_node_v<NtkDest>, "NtkDest cannot create arbitrary function gates" );
+            old_to_new[node] = dest.create_node( children, ntk.node_function( node ) );
             break;
           }
-        }
-        if constexpr ( has_is_function_v<NtkSource> )
-        {
-          static_assert( has_create_node_v<NtkDest>, "NtkDest cannot create arbitrary function gates" );
-          old_to_new[node] = dest.create_node( children, ntk.node_function( node ) );
-          break;
-        }
-        std::cerr << "[e] something went wrong, could not copy node " << ntk.node_to_index( node ) << "\n";
-      } while ( false );
-    }
-  } );
+          std::cerr << "[e] something went wrong, could not copy node " << ntk.node_to_index( node ) << "\n";
+        } while ( false );
+      }
+    } );
+  }
 
   /* create outputs in same order */
   std::vector<signal<NtkDest>> fs;
@@ -277,6 +318,135 @@ NtkDest cleanup_dangling( NtkSrc const& ntk )
   return dest;
 }
 
+namespace detail
+{
+
+/* gates in the transitive fanin of the combinational outputs in the
+ * depth-first order in which `cleanup_dangling` creates them */
+template<class Ntk>
+std::vector<node<Ntk>> dfs_gate_order( Ntk const& ntk )
+{
+  /* iterative depth-first search, a node is pushed once to expand and once to collect it */
+  std::vector<node<Ntk>> gates;
+  std::vector<bool> visited( ntk.size(), false );
+  std::vector<std::pair<node<Ntk>, bool>> stack;
+  std::vector<node<Ntk>> fanins;
+  ntk.foreach_co( [&]( auto const& f ) {
+    stack.emplace_back( ntk.get_node( f ), false );
+    while ( !stack.empty() )
+    {
+      const auto [n, expanded] = stack.back();
+      stack.pop_back();
+      if ( expanded )
+      {
+        gates.push_back( n );
+        continue;
+      }
+      if ( visited[ntk.node_to_index( n )] || ntk.is_constant( n ) || ntk.is_ci( n ) )
+      {
+        continue;
+      }
+      visited[ntk.node_to_index( n )] = true;
+      stack.emplace_back( n, true );
+
+      /* push fanins in reverse order, such that the first fanin is visited first */
+      fanins.clear();
+      ntk.foreach_fanin( n, [&]( auto const& c ) {
+        fanins.push_back( ntk.get_node( c ) );
+      } );
+      for ( auto it = fanins.rbegin(); it != fanins.rend(); ++it )
+      {
+        stack.emplace_back( *it, false );
+      }
+    }
+  } );
+  return gates;
+}
+
+} // namespace detail
+
+/*! \brief Cleans up dangling nodes in place.
+ *
+ * This method removes all dangling nodes from the network without
+ * reconstructing it, and rebuilds the fan-out sizes and the structural hash
+ * table.  If the node indices are a topological order, which is the case
+ * unless nodes have been substituted by nodes created later, the remaining
+ * gates keep their order and the network is compacted in linear passes
+ * over the nodes.  Otherwise, the gates are renumbered in the order in
+ * which `cleanup_dangling` creates them, i.e., the order of a depth-first
+ * search from the combinational outputs.  Unlike `cleanup_dangling`, gates
+ * are not simplified or merged again and registers are kept.
+ *
+ * Returns the new index of each old node, where removed nodes are mapped
+ * to 0.  Node maps and views of the network are invalidated.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `foreach_co`
+ * - `foreach_fanin`
+ * - `is_ci`
+ * - `is_constant`
+ * - `renumber_nodes`
+ */
+template<class Ntk>
+std::vector<node<Ntk>> cleanup_dangling_inplace( Ntk& ntk )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_renumber_nodes_v<Ntk>, "Ntk does not implement the renumber_nodes method" );
+
+  std::vector<node<Ntk>> gates;
+  std::vector<bool> visited( ntk.size(), false );
+
+  /* if every gate has smaller fanin indices, live gates are found in one backward sweep */
+  ntk.foreach_co( [&]( auto const& f ) {
+    visited[ntk.node_to_index( ntk.get_node( f ) )] = true;
+  } );
+  bool topological = true;
+  for ( auto i = ntk.size(); i-- > 1u && topological; )
+  {
+    const auto n = ntk.index_to_node( i );
+    if ( !visited[i] || ntk.is_ci( n ) )
+    {
+      continue;
+    }
+    ntk.foreach_fanin( n, [&]( auto const& c ) {
+      const auto j = ntk.node_to_index( ntk.get_node( c ) );
+      topological = topological && j < i;
+      visited[j] = true;
+    } );
+  }
+
+  if ( topological )
+  {
+    for ( auto i = 1u; i < ntk.size(); ++i )
+    {
+      if ( visited[i] && !ntk.is_ci( ntk.index_to_node( i ) ) )
+      {
+        gates.push_back( ntk.index_to_node( i ) );
+      }
+    }
+    std::vector<bool>().swap( visited );
+  }
+  else
+  {
+    std::vector<bool>().swap( visited );
+    gates = detail::dfs_gate_order( ntk );
+  }
+
+  return ntk.renumber_nodes( gates );
+}
+
 /*! \brief Cleans up LUT nodes.
  *
  * This method reconstructs a LUT network and optimizes LUTs when they do not
@@ -35,6 +35,7 @@
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <bill/sat/interface/common.hpp>
@@ -42,6 +43,7 @@
 #include <fmt/format.h>
 #include <kitty/cnf.hpp>
 #include <kitty/constructors.hpp>
+#include <kitty/hash.hpp>
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
@@ -205,52 +207,114 @@ inline void on_ite( bill::lit_type d, bill::lit_type a, bill::lit_type b, bill::
   fn( {a, c, ~d} );
 }
 
-/* general case */
+/* general case, `cnf` is the characteristic CNF of the function over `child_lits` and `f` */
 template<class ClauseFn>
-inline void on_function( uint32_t f, std::vector<uint32_t> const& child_lits, kitty::dynamic_truth_table const& function, ClauseFn&& fn )
+inline void on_function( uint32_t f, std::vector<uint32_t> const& child_lits, std::vector<kitty::cube> const& cnf, ClauseFn&& fn )
 {
-  const auto cnf = kitty::cnf_characteristic( function );
-
-  auto lits = child_lits;
-  lits.push_back( f );
+  std::vector<uint32_t> clause;
   for ( auto const& cube : cnf )
   {
-    std::vector<uint32_t> clause;
-    for ( auto i = 0u; i < lits.size(); ++i )
+    clause.clear();
+    for ( auto i = 0u; i < child_lits.size(); ++i )
     {
       if ( cube.get_mask( i ) )
       {
-        clause.push_back( lit_not_cond( lits[i], !cube.get_bit( i ) ) );
+        clause.push_back( lit_not_cond( child_lits[i], !cube.get_bit( i ) ) );
       }
     }
+    if ( cube.get_mask( child_lits.size() ) )
+    {
+      clause.push_back( lit_not_cond( f, !cube.get_bit( child_lits.size() ) ) );
+    }
     fn( clause );
   }
 }
 
-/* general case */
+/* general case, `cnf` is the characteristic CNF of the function over `child_lits` and `f` */
 template<class ClauseFn>
-inline void on_function( bill::lit_type f, std::vector<bill::lit_type> const& child_lits, kitty::dynamic_truth_table const& function, ClauseFn&& fn )
+inline void on_function( bill::lit_type f, std::vector<bill::lit_type> const& child_lits, std::vector<kitty::cube> const& cnf, ClauseFn&& fn )
 {
-  const auto cnf = kitty::cnf_characteristic( function );
-
-  auto lits = child_lits;
-  lits.push_back( f );
+  bill::result::clause_type clause;
   for ( auto const& cube : cnf )
   {
-    bill::result::clause_type clause;
-    for ( auto i = 0u; i < lits.size(); ++i )
+    clause.clear();
+    for ( auto i = 0u; i < child_lits.size(); ++i )
     {
       if ( cube.get_mask( i ) )
       {
-        clause.push_back( cube.get_bit( i ) ? lits[i] : ~lits[i] );
+        clause.push_back( cube.get_bit( i ) ? child_lits[i] : ~child_lits[i] );
       }
     }
+    if ( cube.get_mask( child_lits.size() ) )
+    {
+      clause.push_back( cube.get_bit( child_lits.size() ) ? f : ~f );
+    }
     fn( clause );
   }
 }
 
+/* general case */
+template<class ClauseFn>
+inline void on_function( uint32_t f, std::vector<uint32_t> const& child_lits, kitty::dynamic_truth_table const& function, ClauseFn&& fn )
+{
+  on_function( f, child_lits, kitty::cnf_characteristic( function ), fn );
+}
+
+/* general case */
+template<class ClauseFn>
+inline void on_function( bill::lit_type f, std::vector<bill::lit_type> const& child_lits, kitty::dynamic_truth_table const& function, ClauseFn&& fn )
+{
+  on_function( f, child_lits, kitty::cnf_characteristic( function ), fn );
+}
+
 } // namespace detail
 
+/*! \brief Cache for the CNF encodings of node functions.
+ *
+ * Stores the characteristic CNF of each function (see
+ * `kitty::cnf_characteristic`), which has one clause for each cube in the
+ * irredundant SOPs of the function and of its complement.  Encoders that see
+ * the same cell functions many times, e.g., after technology mapping, compute
+ * each CNF only once.
+ */
+class cnf_cache
+{
+public:
+  /*! \brief Returns the characteristic CNF of `function`.
+   *
+   * Variable `function.num_vars()` of the cubes is the output.
+   */
+  std::vector<kitty::cube> const& operator()( kitty::dynamic_truth_table const& function )
+  {
+    auto it = cache_.find( function );
+    if ( it == cache_.end() )
+    {
+      it = cache_.emplace( function, kitty::cnf_characteristic( function ) ).first;
+    }
+    return it->second;
+  }
+
+  /*! \brief Number of clauses in the CNF of `function`. */
+  uint32_t num_clauses( kitty::dynamic_truth_table const& function )
+  {
+    return static_cast<uint32_t>( ( *this )( function ).size() );
+  }
+
+  /*! \brief Number of cached functions. */
+  uint32_t size() const
+  {
+    return static_cast<uint32_t>( cache_.size() );
+  }
+
+  void clear()
+  {
+    cache_.clear();
+  }
+
+private:
+  std::unordered_map<kitty::dynamic_truth_table, std::vector<kitty::cube>, kitty::hash<kitty::dynamic_truth_table>> cache_;
+};
+
 /*! \brief Clause callback function for generate_cnf. */
 template<class lit_t>
 using clause_callback_t = std::function<void( std::vector<lit_t> const& )>;
@@ -324,11 +388,12 @@ node_map<lit_t, Ntk> node_literals( Ntk const& ntk, std::optional<uint32_t> cons
 namespace detail
 {
 
-template<class Ntk, typename lit_t>
+/* `ClauseFn` is called with a braced list or a vector of literals for each clause */
+template<class Ntk, typename lit_t, class ClauseFn = clause_callback_t<lit_t> const>
 class generate_cnf_impl
 {
 public:
-  generate_cnf_impl( Ntk const& ntk, clause_callback_t<lit_t> const& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits )
+  generate_cnf_impl( Ntk const& ntk, ClauseFn& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits )
       : ntk_( ntk ),
         fn_( fn ),
         node_lits_( node_lits ? *node_lits : node_literals<Ntk, lit_t>( ntk ) )
@@ -342,7 +407,8 @@ public:
 
     /* compute clauses for nodes */
     ntk_.foreach_gate( [&]( auto const& n ) {
-      std::vector<lit_t> child_lits;
+      auto& child_lits = child_lits_;
+      child_lits.clear();
       ntk_.foreach_fanin( n, [&]( auto const& f ) {
         child_lits.push_back( lit_not_cond( node_lits_[f], ntk_.is_complemented( f ) ) );
       } );
@@ -384,6 +450,15 @@ public:
         }
       }
 
+      if constexpr ( has_is_dmaj_v<Ntk> )
+      {
+        if ( ntk_.is_dmaj( n ) )
+        {
+          detail::on_maj( node_lit, child_lits[0], child_lits[1], child_lits[2], fn_ );
+          return true;
+        }
+      }
+
       if constexpr ( has_is_ite_v<Ntk> )
       {
         if ( ntk_.is_ite( n ) )
@@ -443,9 +518,10 @@ public:
 
 private:
   Ntk const& ntk_;
-  clause_callback_t<lit_t> const& fn_;
+  ClauseFn& fn_;
 
   node_map<lit_t, Ntk> node_lits_;
+  std::vector<lit_t> child_lits_;
 };
 
 } // namespace detail
@@ -502,4 +578,154 @@ std::vector<lit_t> generate_cnf( Ntk const& ntk, clause_callback_t<lit_t> const&
   return impl.run();
 }
 
+/*! \brief Create a node literal map for a mapped network.
+ *
+ * Like `node_literals`, constants are mapped to variable `0` and primary
+ * inputs to variables `1, ..., n`.  Then the next variables are assigned to
+ * the cell roots in order.  Nodes inside cells do not get a variable.
+ */
+template<class Ntk, typename lit_t = uint32_t>
+node_map<lit_t, Ntk> mapped_node_literals( Ntk const& ntk )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_is_cell_root_v<Ntk>, "Ntk does not implement the is_cell_root method" );
+
+  const auto make = []( uint32_t var, bool complemented ) {
+    if constexpr ( std::is_same<lit_t, bill::lit_type>::value )
+    {
+      return bill::lit_type( var, complemented ? bill::lit_type::polarities::negative : bill::lit_type::polarities::positive );
+    }
+    else
+    {
+      return make_lit( var, complemented );
+    }
+  };
+
+  node_map<lit_t, Ntk> node_lits( ntk );
+  node_lits[ntk.get_constant( false )] = make( 0, false );
+  if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    node_lits[ntk.get_constant( true )] = make( 0, true );
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    node_lits[n] = make( i + 1, false );
+  } );
+
+  uint32_t next_var = ntk.num_pis() + 1;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( ntk.is_cell_root( n ) )
+    {
+      node_lits[n] = make( next_var++, false );
+    }
+  } );
+
+  return node_lits;
+}
+
+namespace detail
+{
+
+/* `ClauseFn` is called with a braced list or a vector of literals for each clause */
+template<class Ntk, typename lit_t, class ClauseFn = clause_callback_t<lit_t> const>
+class generate_mapped_cnf_impl
+{
+public:
+  generate_mapped_cnf_impl( Ntk const& ntk, ClauseFn& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits, cnf_cache& cache )
+      : ntk_( ntk ),
+        fn_( fn ),
+        node_lits_( node_lits ? *node_lits : mapped_node_literals<Ntk, lit_t>( ntk ) ),
+        cache_( cache )
+  {
+  }
+
+  std::vector<lit_t> run()
+  {
+    /* unit clause for constant-0 */
+    fn_( {lit_not( node_lits_[ntk_.get_constant( false )] )} );
+
+    /* one CNF for each cell */
+    ntk_.foreach_gate( [&]( auto const& n ) {
+      if ( !ntk_.is_cell_root( n ) )
+      {
+        return;
+      }
+
+      leaf_lits_.clear();
+      ntk_.foreach_cell_fanin( n, [&]( auto const& leaf ) {
+        leaf_lits_.push_back( node_lits_[leaf] );
+      } );
+      detail::on_function( node_lits_[n], leaf_lits_, cache_( ntk_.cell_function( n ) ), fn_ );
+    } );
+
+    std::vector<lit_t> output_lits;
+    ntk_.foreach_po( [&]( auto const& f ) {
+      output_lits.push_back( lit_not_cond( node_lits_[f], ntk_.is_complemented( f ) ) );
+    } );
+
+    return output_lits;
+  }
+
+private:
+  Ntk const& ntk_;
+  ClauseFn& fn_;
+
+  node_map<lit_t, Ntk> node_lits_;
+  cnf_cache& cache_;
+  std::vector<lit_t> leaf_lits_;
+};
+
+} // namespace detail
+
+/*! \brief Generates CNF for a mapped logic network.
+ *
+ * This function generates one CNF for each cell of a mapped network, e.g., a
+ * `mapping_view` after `cnf_map` or `lut_mapping`, using the cell functions.
+ * Nodes inside cells are not encoded, which results in fewer variables and,
+ * for mappings that minimize the number of clauses, fewer clauses than
+ * `generate_cnf`.
+ *
+ * The clause callback and the return value are the same as for
+ * `generate_cnf`.  If no literal map is given, the one created with
+ * `mapped_node_literals` is used.  Clauses of cell functions are taken from
+ * `cache`, if given, which avoids recomputing them across calls.
+ *
+ * \param ntk Mapped logic network
+ * \param fn Clause creation function
+ * \param node_lits (optional) custom node literal map
+ * \param cache (optional) cache for the CNFs of cell functions
+ */
+template<class Ntk>
+std::vector<uint32_t> generate_mapped_cnf( Ntk const& ntk, clause_callback_t<uint32_t> const& fn, std::optional<node_map<uint32_t, Ntk>> const& node_lits = {}, cnf_cache* cache = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_cell_root_v<Ntk>, "Ntk does not implement the is_cell_root method" );
+  static_assert( has_foreach_cell_fanin_v<Ntk>, "Ntk does not implement the foreach_cell_fanin method" );
+  static_assert( has_cell_function_v<Ntk>, "Ntk does not implement the cell_function method" );
+
+  cnf_cache local_cache;
+  detail::generate_mapped_cnf_impl<Ntk, uint32_t> impl( ntk, fn, node_lits, cache ? *cache : local_cache );
+  return impl.run();
+}
+
+template<class Ntk, typename lit_t = bill::lit_type>
+std::vector<lit_t> generate_mapped_cnf( Ntk const& ntk, clause_callback_t<lit_t> const& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits = {}, cnf_cache* cache = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_cell_root_v<Ntk>, "Ntk does not implement the is_cell_root method" );
+  static_assert( has_foreach_cell_fanin_v<Ntk>, "Ntk does not implement the foreach_cell_fanin method" );
+  static_assert( has_cell_function_v<Ntk>, "Ntk does not implement the cell_function method" );
+
+  cnf_cache local_cache;
+  detail::generate_mapped_cnf_impl<Ntk, lit_t> impl( ntk, fn, node_lits, cache ? *cache : local_cache );
+  return impl.run();
+}
+
 } // namespace mockturtle
\ No newline at end of file
@@ -0,0 +1,198 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file cnf_map.hpp
+  \brief Technology mapping for CNF generation
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+
+#include <fmt/format.h>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "cnf.hpp"
+#include "cut_enumeration.hpp"
+#include "cut_enumeration/cnf_cut.hpp"
+#include "lut_mapping.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for cnf_map.
+ *
+ * The data structure `cnf_map_params` holds configurable parameters with
+ * default arguments for `cnf_map`.
+ */
+struct cnf_map_params
+{
+  cnf_map_params()
+  {
+    cut_enumeration_ps.cut_size = 4;
+    cut_enumeration_ps.cut_limit = 8;
+  }
+
+  /*! \brief Parameters for cut enumeration
+   *
+   * The default cut size is 4, the default cut limit is 8.
+   */
+  cut_enumeration_params cut_enumeration_ps{};
+
+  /*! \brief Number of rounds for area flow optimization. */
+  uint32_t rounds{2u};
+
+  /*! \brief Number of rounds for exact area optimization. */
+  uint32_t rounds_ela{2u};
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Statistics for cnf_map.
+ *
+ * The data structure `cnf_map_stats` provides data collected by running
+ * `cnf_map`.
+ */
+struct cnf_map_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Number of cells. */
+  uint32_t num_cells{0};
+
+  /*! \brief Number of variables of the mapped CNF (constant, PIs, cells). */
+  uint32_t num_vars{0};
+
+  /*! \brief Number of clauses of the mapped CNF (without output units). */
+  uint32_t num_clauses{0};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] cells   = {:>8}\n", num_cells );
+    std::cout << fmt::format( "[i] vars    = {:>8}\n", num_vars );
+    std::cout << fmt::format( "[i] clauses = {:>8}\n", num_clauses );
+    std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+/*! \brief Technology mapping for CNF generation.
+ *
+ * This function maps a logic network, typically an AIG or XAG, into cells
+ * whose cost is the number of clauses in their CNF, i.e., the number of cubes
+ * in the irredundant SOPs of the cell function and of its complement.  The
+ * mapping is computed with `lut_mapping` using `cut_enumeration_cnf_cut`, so
+ * that area flow and exact area minimize the total number of clauses.  The
+ * cell functions are stored in the mapping, which can then be encoded with
+ * `generate_mapped_cnf` or `write_dimacs`.
+ *
+ * Mapped CNFs have a variable for the constant, the primary inputs, and the
+ * cells only.  They are usually smaller than CNFs from `generate_cnf` and are
+ * solved faster, e.g., in `equivalence_checking`.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `is_pi`
+ * - `is_constant`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `get_node`
+ * - `foreach_po`
+ * - `foreach_node`
+ * - `fanout_size`
+ * - `clear_mapping`
+ * - `add_to_mapping`
+ * - `set_cell_function`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+
+      mapping_view<aig_network, true> mapped{aig};
+      cnf_map( mapped );
+
+      percy::bsat_wrapper solver;
+      const auto outputs = generate_mapped_cnf( mapped, [&]( auto const& clause ) {
+        solver.add_clause( clause );
+      } );
+
+   .. note::
+
+      The approach follows the CNF generation in ABC, see Eén, Mishchenko,
+      and Sörensson, Applying logic synthesis for speeding up SAT, SAT 2007.
+   \endverbatim
+ */
+template<class Ntk>
+void cnf_map( Ntk& ntk, cnf_map_params const& ps = {}, cnf_map_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_is_cell_root_v<Ntk>, "Ntk does not implement the is_cell_root method" );
+  static_assert( has_num_cells_v<Ntk>, "Ntk does not implement the num_cells method" );
+  static_assert( has_cell_function_v<Ntk>, "Ntk does not implement the cell_function method" );
+  static_assert( has_set_cell_function_v<Ntk>, "Ntk does not implement the set_cell_function method" );
+
+  cnf_map_stats st;
+  {
+    stopwatch t( st.time_total );
+
+    lut_mapping_params lps;
+    lps.cut_enumeration_ps = ps.cut_enumeration_ps;
+    lps.rounds = ps.rounds;
+    lps.rounds_ela = ps.rounds_ela;
+    lut_mapping<Ntk, true, cut_enumeration_cnf_cut>( ntk, lps );
+
+    cnf_cache cache;
+    st.num_cells = ntk.num_cells();
+    st.num_vars = ntk.num_pis() + st.num_cells + 1u;
+    st.num_clauses = 1u;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      if ( ntk.is_cell_root( n ) )
+      {
+        st.num_clauses += cache.num_clauses( ntk.cell_function( n ) );
+      }
+    } );
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+}
+
+} // namespace mockturtle
@@ -205,6 +205,12 @@ public:
     return _cuts.size();
   }
 
+  /*! \brief Resizes the cut database, e.g., after nodes have been added to the network */
+  void resize( uint32_t size )
+  {
+    _cuts.resize( size );
+  }
+
   /* compute positions of leave indices in cut `sub` (subset) with respect to
    * leaves in cut `sup` (super set).
    *
@@ -305,33 +311,45 @@ public:
     stopwatch t( st.time_total );
 
     ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+      compute_cuts( ntk.node_to_index( node ) );
+    } );
+  }
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+  /*! \brief Computes the cuts of a single node from the cuts of its fanins.
+   *
+   * The cut set of the node is replaced, which allows to update the cut
+   * database after the network has been modified.
+   */
+  void compute_cuts( uint32_t index )
+  {
+    const auto node = ntk.index_to_node( index );
 
-      if ( ntk.is_constant( node ) )
-      {
-        cuts.add_zero_cut( index );
-      }
-      else if ( ntk.is_pi( node ) )
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts._cuts[index].clear();
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_pi( node ) )
+    {
+      cuts._cuts[index].clear();
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        cuts.add_unit_cut( index );
+        merge_cuts2( index );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
-        }
+        merge_cuts( index );
       }
-    } );
+    }
   }
 
 private:
@@ -444,11 +462,10 @@ private:
     lcuts[fanin] = &cuts.cuts( index );
 
     auto& rcuts = *lcuts[fanin];
+    rcuts.clear();
 
     if ( fanin > 1 && fanin <= ps.fanin_limit )
     {
-      rcuts.clear();
-
       cut_t new_cut, tmp_cut;
 
       std::vector<cut_t const*> vcuts( fanin );
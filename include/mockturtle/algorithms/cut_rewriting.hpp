@@ -32,12 +32,16 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <optional>
+#include <numeric>
 #include <set>
+#include <thread>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 #include "../networks/klut.hpp"
@@ -47,6 +51,7 @@
 #include "../utils/node_map.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/window_index_arena.hpp"
 #include "../views/cut_view.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/fanout_view.hpp"
@@ -56,6 +61,8 @@
 #include "dont_cares.hpp"
 
 #include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
 #include <kitty/print.hpp>
 
 namespace mockturtle
@@ -100,6 +107,21 @@ struct cut_rewriting_params
   /*! \brief If true, candidates are only accepted if they do not increase logic level of node. */
   bool preserve_depth{false};
 
+  /*! \brief Maximum number of candidates per partition of the compatibility graph.
+   *
+   * If 0, the independent set is computed on the whole compatibility graph.
+   * Otherwise, the graph is split into connected components, and larger
+   * components are split into partitions of at most this many candidates
+   * (in topological order of their roots).  Partitions are solved
+   * independently, and conflicts between partitions are resolved greedily.
+   * This bounds memory and runtime, which are quadratic in the number of
+   * conflicting candidates, at the cost of some gain.
+   */
+  uint32_t mis_partition_size{0u};
+
+  /*! \brief Number of threads to solve partitions of the compatibility graph (0: hardware concurrency). */
+  uint32_t mis_num_threads{0u};
+
   /*! \brief Show progress. */
   bool progress{false};
 
@@ -129,14 +151,28 @@ struct cut_rewriting_stats
   /*! \brief Runtime to find minimal independent set. */
   stopwatch<>::duration time_mis{0};
 
+  /*! \brief Number of partitions of the compatibility graph. */
+  uint32_t num_mis_partitions{0};
+
+  /*! \brief Number of candidates dropped due to conflicts between partitions. */
+  uint32_t num_mis_conflicts{0};
+
+  /*! \brief Runtime for resynthesizing cut functions in advance. */
+  stopwatch<>::duration time_prefetch{0};
+
   void report( bool show_time_mis = true ) const
   {
     fmt::print( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
     fmt::print( "[i] cut enum. time = {:>5.2f} secs\n", to_seconds( time_cuts ) );
+    fmt::print( "[i] prefetch time  = {:>5.2f} secs\n", to_seconds( time_prefetch ) );
     fmt::print( "[i] rewriting time = {:>5.2f} secs\n", to_seconds( time_rewriting ) );
     if ( show_time_mis )
     {
       fmt::print( "[i] ind. set time  = {:>5.2f} secs\n", to_seconds( time_mis ) );
+      if ( num_mis_partitions > 0u )
+      {
+        fmt::print( "[i] partitions     = {:>5} ({} conflicts)\n", num_mis_partitions, num_mis_conflicts );
+      }
     }
   }
 };
@@ -304,6 +340,7 @@ std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_grap
 
   ntk.clear_visited();
 
+  window_index_arena arena( ntk.size() );
   ntk.foreach_node( [&]( auto const& n, auto index ) {
     if ( index >= cuts.nodes_size() || ntk.is_constant( n ) || ntk.is_pi( n ) )
       return;
@@ -332,7 +369,7 @@ std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_grap
       {
         leaves.push_back( ntk.index_to_node( leaf_index ) );
       }
-      cut_view<Ntk> dcut( ntk, leaves, ntk.make_signal( n ) );
+      cut_view<Ntk> dcut( ntk, leaves, ntk.make_signal( n ), &arena );
       dcut.foreach_gate( [&]( auto const& n2 ) {
         //if ( dcut.is_constant( n2 ) || dcut.is_pi( n2 ) )
         //  return;
@@ -368,6 +405,195 @@ std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_grap
   return {g, vertex_to_cut_addr};
 }
 
+/* independent set of candidates on a partitioned compatibility graph (see `cut_rewriting_params::mis_partition_size`) */
+template<typename Ntk, bool ComputeTruth>
+std::vector<std::pair<node<Ntk>, uint32_t>> network_cuts_partitioned_independent_set( Ntk const& ntk, network_cuts<Ntk, ComputeTruth, cut_enumeration_cut_rewriting_cut> const& cuts, cut_rewriting_params const& ps, cut_rewriting_stats& st )
+{
+  /* candidates with the gates they cover; two candidates conflict if they cover a common gate */
+  std::vector<std::pair<node<Ntk>, uint32_t>> vertex_to_cut_addr;
+  std::vector<int32_t> weights;
+  std::vector<uint32_t> gates, gates_begin{0u};
+
+  window_index_arena arena( ntk.size() );
+  ntk.foreach_node( [&]( auto const& n, auto index ) {
+    if ( index >= cuts.nodes_size() || ntk.is_constant( n ) || ntk.is_pi( n ) )
+      return;
+
+    if ( mffc_size( ntk, n ) == 1 )
+      return;
+
+    auto cctr{0u};
+    for ( auto const& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+    {
+      if ( cut->size() < ps.min_cand_cut_size_override.value_or( ps.min_cand_cut_size ) )
+        continue;
+
+      if ( ( *cut )->data.gain < ( ps.allow_zero_gain ? 0 : 1 ) )
+        continue;
+
+      std::vector<node<Ntk>> leaves;
+      for ( auto leaf_index : *cut )
+      {
+        leaves.push_back( ntk.index_to_node( leaf_index ) );
+      }
+      cut_view<Ntk> dcut( ntk, leaves, ntk.make_signal( n ), &arena );
+      dcut.foreach_gate( [&]( auto const& n2 ) {
+        gates.push_back( static_cast<uint32_t>( ntk.node_to_index( n2 ) ) );
+      } );
+      gates_begin.push_back( static_cast<uint32_t>( gates.size() ) );
+
+      vertex_to_cut_addr.emplace_back( n, cctr );
+      weights.push_back( ( *cut )->data.gain );
+
+      ++cctr;
+    }
+  } );
+
+  auto const num_vertices = static_cast<uint32_t>( weights.size() );
+
+  /* connected components with union-find */
+  std::vector<uint32_t> parent( num_vertices );
+  std::iota( parent.begin(), parent.end(), 0u );
+  auto const find = [&]( uint32_t v ) {
+    while ( parent[v] != v )
+    {
+      v = parent[v] = parent[parent[v]];
+    }
+    return v;
+  };
+
+  std::vector<uint32_t> gate_owner( ntk.size(), num_vertices );
+  for ( auto v = 0u; v < num_vertices; ++v )
+  {
+    for ( auto i = gates_begin[v]; i < gates_begin[v + 1]; ++i )
+    {
+      auto& owner = gate_owner[gates[i]];
+      if ( owner == num_vertices )
+      {
+        owner = v;
+      }
+      else
+      {
+        parent[find( v )] = find( owner );
+      }
+    }
+  }
+
+  /* split components into partitions, vertices stay in topological order */
+  std::vector<std::vector<uint32_t>> components( num_vertices );
+  for ( auto v = 0u; v < num_vertices; ++v )
+  {
+    components[find( v )].push_back( v );
+  }
+  std::vector<std::vector<uint32_t>> partitions;
+  for ( auto& component : components )
+  {
+    for ( auto i = 0u; i < component.size(); i += ps.mis_partition_size )
+    {
+      auto const last = std::min<std::size_t>( component.size(), i + ps.mis_partition_size );
+      partitions.emplace_back( component.begin() + i, component.begin() + last );
+    }
+  }
+  components.clear();
+
+  /* solve partitions in parallel */
+  std::vector<std::vector<uint32_t>> solutions( partitions.size() );
+  std::atomic<std::size_t> next_partition{0};
+  auto const worker = [&]() {
+    std::vector<std::pair<uint32_t, uint32_t>> gate_vertex;
+    while ( true )
+    {
+      auto const p = next_partition++;
+      if ( p >= partitions.size() )
+      {
+        return;
+      }
+      auto const& vertices = partitions[p];
+
+      graph g;
+      gate_vertex.clear();
+      for ( auto i = 0u; i < vertices.size(); ++i )
+      {
+        g.add_vertex( weights[vertices[i]] );
+        for ( auto j = gates_begin[vertices[i]]; j < gates_begin[vertices[i] + 1]; ++j )
+        {
+          gate_vertex.emplace_back( gates[j], i );
+        }
+      }
+      std::sort( gate_vertex.begin(), gate_vertex.end() );
+      for ( auto j = 0u; j < gate_vertex.size(); )
+      {
+        auto k = j;
+        while ( k < gate_vertex.size() && gate_vertex[k].first == gate_vertex[j].first )
+        {
+          ++k;
+        }
+        for ( auto a = j; a < k; ++a )
+        {
+          for ( auto b = a + 1; b < k; ++b )
+          {
+            g.add_edge( gate_vertex[a].second, gate_vertex[b].second );
+          }
+        }
+        j = k;
+      }
+
+      const auto is = ( ps.candidate_selection_strategy == cut_rewriting_params::minimize_weight ) ? maximum_weighted_independent_set_gwmin( g ) : maximal_weighted_independent_set( g );
+      for ( auto const v : is )
+      {
+        solutions[p].push_back( vertices[v] );
+      }
+    }
+  };
+
+  auto num_threads = ps.mis_num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.mis_num_threads;
+  num_threads = static_cast<uint32_t>( std::min<std::size_t>( num_threads, partitions.size() ) );
+  if ( num_threads <= 1u )
+  {
+    worker();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for ( auto i = 0u; i < num_threads; ++i )
+    {
+      threads.emplace_back( worker );
+    }
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+  }
+
+  /* merge solutions; only partitions of the same component can conflict */
+  std::vector<std::pair<node<Ntk>, uint32_t>> independent_set;
+  std::fill( gate_owner.begin(), gate_owner.end(), num_vertices );
+  for ( auto const& solution : solutions )
+  {
+    for ( auto const v : solution )
+    {
+      bool conflict = false;
+      for ( auto i = gates_begin[v]; i < gates_begin[v + 1] && !conflict; ++i )
+      {
+        conflict = gate_owner[gates[i]] != num_vertices;
+      }
+      if ( conflict )
+      {
+        ++st.num_mis_conflicts;
+        continue;
+      }
+      for ( auto i = gates_begin[v]; i < gates_begin[v + 1]; ++i )
+      {
+        gate_owner[gates[i]] = v;
+      }
+      independent_set.push_back( vertex_to_cut_addr[v] );
+    }
+  }
+
+  st.num_mis_partitions += static_cast<uint32_t>( partitions.size() );
+  return independent_set;
+}
+
 template<class Ntk, class RewritingFn, class Iterator, class = void>
 struct has_rewrite_with_dont_cares : std::false_type
 {
@@ -388,6 +614,49 @@ struct has_rewrite_with_dont_cares<Ntk,
 template<class Ntk, class RewritingFn, class Iterator>
 inline constexpr bool has_rewrite_with_dont_cares_v = has_rewrite_with_dont_cares<Ntk, RewritingFn, Iterator>::value;
 
+template<class RewritingFn, class = void>
+struct has_prefetch : std::false_type
+{
+};
+
+template<class RewritingFn>
+struct has_prefetch<RewritingFn, std::void_t<decltype( std::declval<std::remove_reference_t<RewritingFn> const&>().prefetch( std::declval<std::vector<kitty::dynamic_truth_table> const&>() ) )>> : std::true_type
+{
+};
+
+template<class RewritingFn>
+inline constexpr bool has_prefetch_v = has_prefetch<RewritingFn>::value;
+
+/* passes the functions of all candidate cuts to the rewriting function, if it can resynthesize them in advance */
+template<class Ntk, class Cuts, class RewritingFn>
+void prefetch_cut_functions( Ntk const& ntk, Cuts const& cuts, RewritingFn const& rewriting_fn, cut_rewriting_params const& ps, cut_rewriting_stats& st )
+{
+  if constexpr ( has_prefetch_v<RewritingFn> )
+  {
+    stopwatch t( st.time_prefetch );
+
+    std::unordered_set<kitty::dynamic_truth_table, kitty::hash<kitty::dynamic_truth_table>> functions;
+    ntk.foreach_gate( [&]( auto const& n ) {
+      for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+      {
+        if ( cut->size() > 1 && cut->size() >= ps.min_cand_cut_size )
+        {
+          functions.insert( cuts.truth_table( *cut ) );
+        }
+      }
+    } );
+    rewriting_fn.prefetch( std::vector<kitty::dynamic_truth_table>( functions.begin(), functions.end() ) );
+  }
+  else
+  {
+    (void)ntk;
+    (void)cuts;
+    (void)rewriting_fn;
+    (void)ps;
+    (void)st;
+  }
+}
+
 template<class Ntk, class RewritingFn, class NodeCostFn>
 class cut_rewriting_with_compatibility_graph_impl
 {
@@ -406,6 +675,12 @@ public:
     /* enumerate cuts */
     const auto cuts = call_with_stopwatch( st.time_cuts, [&]() { return cut_enumeration<Ntk, true, cut_enumeration_cut_rewriting_cut>( ntk, ps.cut_enumeration_ps ); } );
 
+    /* don't cares depend on the cut, so functions cannot be resynthesized in advance */
+    if ( !ps.use_dont_cares )
+    {
+      prefetch_cut_functions( ntk, cuts, rewriting_fn, ps, st );
+    }
+
     /* for cost estimation we use reference counters initialized by the fanout size */
     ntk.clear_values();
     ntk.foreach_node( [&]( auto const& n ) {
@@ -512,24 +787,35 @@ public:
     } );
 
     stopwatch t2( st.time_mis );
-    auto [g, map] = network_cuts_graph( ntk, cuts, ps );
+    const auto is = [&]() {
+      if ( ps.mis_partition_size != 0u )
+      {
+        return network_cuts_partitioned_independent_set( ntk, cuts, ps, st );
+      }
 
-    if ( ps.very_verbose )
-    {
-      std::cout << "[i] replacement dependency graph has " << g.num_vertices() << " vertices and " << g.num_edges() << " edges\n";
-    }
+      auto [g, map] = network_cuts_graph( ntk, cuts, ps );
 
-    const auto is = ( ps.candidate_selection_strategy == cut_rewriting_params::minimize_weight ) ? maximum_weighted_independent_set_gwmin( g ) : maximal_weighted_independent_set( g );
+      if ( ps.very_verbose )
+      {
+        std::cout << "[i] replacement dependency graph has " << g.num_vertices() << " vertices and " << g.num_edges() << " edges\n";
+      }
+
+      const auto is = ( ps.candidate_selection_strategy == cut_rewriting_params::minimize_weight ) ? maximum_weighted_independent_set_gwmin( g ) : maximal_weighted_independent_set( g );
+      std::vector<std::pair<node<Ntk>, uint32_t>> cut_addrs;
+      for ( const auto v : is )
+      {
+        cut_addrs.push_back( map[v] );
+      }
+      return cut_addrs;
+    }();
 
     if ( ps.very_verbose )
     {
       std::cout << "[i] size of independent set is " << is.size() << "\n";
     }
 
-    for ( const auto v : is )
+    for ( const auto& [v_node, v_cut] : is )
     {
-      const auto v_node = map[v].first;
-      const auto v_cut = map[v].second;
 
       if ( ps.very_verbose )
       {
@@ -603,6 +889,11 @@ private:
  * `mockturtle/algorithms/node_resyntesis`, since the resynthesis functions
  * have the same signature.
  *
+ * If the rewriting function has a method `prefetch( std::vector<kitty::dynamic_truth_table> const& )`,
+ * it is called with the functions of all candidate cuts after cut
+ * enumeration, e.g., to resynthesize them in parallel (see
+ * `exact_resynthesis`).
+ *
  * In contrast to node resynthesis, cut rewriting uses the same type for the
  * input and output network.  Consequently, the algorithm does not return a
  * new network but applies changes in-place to the input network.
@@ -647,7 +938,7 @@ void cut_rewriting_with_compatibility_graph( Ntk& ntk, RewritingFn&& rewriting_f
   static_assert( has_make_signal_v<Ntk>, "Ntk does not implement the make_signal method" );
 
   cut_rewriting_stats st;
-  if constexpr ( std::is_same_v<typename Ntk::base_type, klut_network> )
+  if constexpr ( is_klut_network_type_v<typename Ntk::base_type> )
   {
     detail::cut_rewriting_with_compatibility_graph_impl<Ntk, RewritingFn, NodeCostFn> p( ntk, rewriting_fn, ps, st, cost_fn );
     p.run();
@@ -702,6 +993,7 @@ struct cut_rewriting_impl
 
     /* enumerate cuts */
     const auto cuts = call_with_stopwatch( st_.time_cuts, [&]() { return cut_enumeration<Ntk, true, cut_enumeration_cut_rewriting_cut>( ntk_, ps_.cut_enumeration_ps ); } );
+    prefetch_cut_functions( ntk_, cuts, rewriting_fn_, ps_, st_ );
 
     /* for cost estimation we use reference counters initialized by the fanout size */
     initialize_values_with_fanout( ntk_ );
@@ -827,6 +1119,11 @@ private:
  * `mockturtle/algorithms/node_resyntesis`, since the resynthesis functions
  * have the same signature.
  *
+ * If the rewriting function has a method `prefetch( std::vector<kitty::dynamic_truth_table> const& )`,
+ * it is called with the functions of all candidate cuts after cut
+ * enumeration, e.g., to resynthesize them in parallel (see
+ * `exact_resynthesis`).
+ *
  * In contrast to node resynthesis, cut rewriting uses the same type for the
  * input and output network.
  *
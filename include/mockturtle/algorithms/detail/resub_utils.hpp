@@ -41,6 +41,8 @@
 
 #include <kitty/constructors.hpp>
 
+#include "../../utils/divisor_kernels.hpp"
+
 namespace mockturtle::detail
 {
 
@@ -202,6 +204,17 @@ public:
     return ntk.is_complemented( s ) ? ~tt : tt;
   }
 
+  /* returns a reference to the truth table of `s` without copying it */
+  tt_ref get_tt_ref( signal const& s ) const
+  {
+    return make_tt_ref( tts[node_to_index[ntk.get_node( s )]], ntk.is_complemented( s ) );
+  }
+
+  tt_layout get_tt_layout() const
+  {
+    return make_tt_layout( tts[0] );
+  }
+
   void set_tt( uint32_t index, truthtable_t const& tt )
   {
     tts[index] = tt;
@@ -39,7 +39,9 @@
 #include "../traits.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../views/mapping_view.hpp"
 #include "cnf.hpp"
+#include "cnf_map.hpp"
 
 #include <fmt/format.h>
 
@@ -60,6 +62,12 @@ struct equivalence_checking_params
    */
   uint32_t conflict_limit{0u};
 
+  /*! \brief Encode the miter with `cnf_map` instead of one CNF per gate. */
+  bool use_cnf_map{false};
+
+  /*! \brief Parameters for `cnf_map` (if `use_cnf_map` is true). */
+  cnf_map_params cnf_map_ps{};
+
   /* \brief Be verbose. */
   bool verbose{false};
 };
@@ -74,11 +82,23 @@ struct equivalence_checking_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{};
 
+  /*! \brief Runtime for CNF generation (including `cnf_map`). */
+  stopwatch<>::duration time_encoding{};
+
+  /*! \brief Number of variables. */
+  uint32_t num_vars{0};
+
+  /*! \brief Number of clauses. */
+  uint32_t num_clauses{0};
+
   /*! \brief Counter-example, in case miter is not equivalent. */
   std::vector<bool> counter_example;
 
   void report() const
   {
+    std::cout << fmt::format( "[i] vars           = {:>8}\n", num_vars );
+    std::cout << fmt::format( "[i] clauses        = {:>8}\n", num_clauses );
+    std::cout << fmt::format( "[i] encoding time  = {:>5.2f} secs\n", to_seconds( time_encoding ) );
     std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
   }
 };
@@ -102,9 +122,27 @@ public:
     stopwatch<> t( st_.time_total );
 
     percy::bsat_wrapper solver;
-    int output = generate_cnf( miter_, [&]( auto const& clause ) {
+    const auto add_clause = [&]( auto const& clause ) {
       solver.add_clause( clause );
-    } )[0];
+      ++st_.num_clauses;
+    };
+
+    int output;
+    {
+      stopwatch t_enc( st_.time_encoding );
+      if ( ps_.use_cnf_map )
+      {
+        mapping_view<Ntk, true> mapped{miter_};
+        cnf_map( mapped, ps_.cnf_map_ps );
+        output = generate_mapped_cnf( mapped, add_clause )[0];
+        st_.num_vars = mapped.num_pis() + mapped.num_cells() + 1u;
+      }
+      else
+      {
+        output = generate_cnf( miter_, add_clause )[0];
+        st_.num_vars = miter_.num_pis() + miter_.num_gates() + 1u;
+      }
+    }
 
     const auto res = solver.solve( &output, &output + 1, 0 );
 
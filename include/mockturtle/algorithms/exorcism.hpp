@@ -32,13 +32,33 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <shared_mutex>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <eabc/exor.h>
+#include <fmt/format.h>
 #include <kitty/constructors.hpp>
 #include <kitty/cube.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/esop.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#include "../utils/stopwatch.hpp"
 
 namespace abc::exorcism
 {
@@ -48,6 +68,7 @@ namespace abc::exorcism
 namespace mockturtle
 {
 
+/*! \brief Minimizes an ESOP over `num_vars` variables (at least 1). */
 inline std::vector<kitty::cube> exorcism( std::vector<kitty::cube> const& esop, uint32_t num_vars )
 {
   auto vesop = abc::exorcism::Vec_WecAlloc( esop.size() );
@@ -71,9 +92,300 @@ inline std::vector<kitty::cube> exorcism( std::vector<kitty::cube> const& esop,
   return exorcism_esop;
 }
 
+/*! \brief Computes a minimized ESOP for a function, starting from its optimum pseudo-Kronecker expression. */
 inline std::vector<kitty::cube> exorcism( kitty::dynamic_truth_table const& func )
 {
+  if ( func.num_vars() == 0u )
+  {
+    return kitty::is_const0( func ) ? std::vector<kitty::cube>{} : std::vector<kitty::cube>{kitty::cube()};
+  }
   return exorcism( kitty::esop_from_optimum_pkrm( func ), func.num_vars() );
 }
 
-}
\ No newline at end of file
+/*! \brief Cache of minimized ESOPs.
+ *
+ * Maps a truth table to an ESOP of that truth table.  The map has 16 shards,
+ * each protected by a reader-writer lock, such that it can be shared by
+ * concurrent minimizations.
+ */
+using exorcism_cache_t = phmap::parallel_flat_hash_map<kitty::dynamic_truth_table, std::vector<kitty::cube>, kitty::hash<kitty::dynamic_truth_table>, std::equal_to<kitty::dynamic_truth_table>,
+                                                       std::allocator<std::pair<const kitty::dynamic_truth_table, std::vector<kitty::cube>>>, 4, std::shared_mutex>;
+
+/*! \brief Parameters for batch ESOP minimization.
+ *
+ * The data structure `exorcism_params` holds configurable parameters with
+ * default arguments for `exorcism` on many functions.
+ */
+struct exorcism_params
+{
+  /*! \brief Number of worker threads (0: hardware concurrency). */
+  uint32_t num_threads{1u};
+
+  /*! \brief Minimize only one representative per NPN class. */
+  bool npn_deduplication{true};
+
+  /*! \brief Cache of minimized ESOPs, shared between calls (optional). */
+  std::shared_ptr<exorcism_cache_t> cache;
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Statistics for batch ESOP minimization. */
+struct exorcism_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Runtime for NPN canonization. */
+  stopwatch<>::duration time_canonization{0};
+
+  /*! \brief Runtime for ESOP minimization. */
+  stopwatch<>::duration time_minimization{0};
+
+  /*! \brief Number of functions. */
+  uint32_t num_functions{0u};
+
+  /*! \brief Number of distinct functions (or NPN classes). */
+  uint32_t num_classes{0u};
+
+  /*! \brief Number of distinct functions found in the cache. */
+  uint32_t num_cache_hits{0u};
+
+  /*! \brief Number of minimized functions. */
+  uint32_t num_minimized{0u};
+
+  /*! \brief Total number of cubes in the result. */
+  uint64_t num_cubes{0u};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] functions         = {} ({} classes, {} cache hits, {} minimized)\n", num_functions, num_classes, num_cache_hits, num_minimized )
+              << fmt::format( "[i] cubes             = {}\n", num_cubes )
+              << fmt::format( "[i] canonization time = {:>5.2f} secs\n", to_seconds( time_canonization ) )
+              << fmt::format( "[i] minimization time = {:>5.2f} secs\n", to_seconds( time_minimization ) )
+              << fmt::format( "[i] total time        = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+template<class Fn>
+void exorcism_parallel_for( std::size_t size, uint32_t num_threads, Fn&& fn )
+{
+  std::atomic<std::size_t> next{0};
+  const auto worker = [&]() {
+    while ( true )
+    {
+      const auto i = next++;
+      if ( i >= size )
+      {
+        return;
+      }
+      fn( i );
+    }
+  };
+
+  const auto threads_used = static_cast<uint32_t>( std::min<std::size_t>( num_threads, size ) );
+  if ( threads_used <= 1u )
+  {
+    worker();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for ( auto i = 0u; i < threads_used; ++i )
+    {
+      threads.emplace_back( worker );
+    }
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+  }
+}
+
+/* applies the NPN configuration to the ESOP of the representative, in the
+ * same order as `kitty::create_from_npn_config` applies it to the function */
+inline void exorcism_apply_npn_config( std::vector<kitty::cube>& esop, uint32_t num_vars, uint32_t phase, std::vector<uint8_t> perm )
+{
+  /* output complementation */
+  if ( ( phase >> num_vars ) & 1 )
+  {
+    if ( auto it = std::find_if( esop.begin(), esop.end(), []( auto const& c ) { return c._mask == 0u; } ); it != esop.end() )
+    {
+      esop.erase( it );
+    }
+    else if ( auto it = std::find_if( esop.begin(), esop.end(), []( auto const& c ) { return c.num_literals() == 1; } ); it != esop.end() )
+    {
+      it->_bits ^= it->_mask;
+    }
+    else
+    {
+      esop.emplace_back( 0u, 0u );
+    }
+  }
+
+  /* input permutations */
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    if ( perm[i] == i )
+    {
+      continue;
+    }
+
+    auto k = i;
+    while ( perm[k] != i )
+    {
+      ++k;
+    }
+
+    for ( auto& c : esop )
+    {
+      const auto swap_bits = [&]( uint32_t w ) {
+        const auto d = ( ( w >> i ) ^ ( w >> k ) ) & 1u;
+        return w ^ ( ( d << i ) | ( d << k ) );
+      };
+      c._bits = swap_bits( c._bits );
+      c._mask = swap_bits( c._mask );
+    }
+    std::swap( perm[i], perm[k] );
+  }
+
+  /* input complementations */
+  for ( auto& c : esop )
+  {
+    c._bits ^= c._mask & phase & static_cast<uint32_t>( ( uint64_t( 1 ) << num_vars ) - 1 );
+  }
+}
+
+} // namespace detail
+
+/*! \brief ESOP minimization of many functions.
+ *
+ * Computes an ESOP for each function in `functions`, using `exorcism` on a
+ * pseudo-Kronecker expression of the function.  Functions are deduplicated
+ * before minimization: if `ps.npn_deduplication` is set, only one
+ * representative per NPN class is minimized (exact NPN canonization for up
+ * to 4 variables, sifting otherwise) and its ESOP is transformed for every
+ * function of the class.  Distinct functions are minimized on
+ * `ps.num_threads` threads and the results are stored in `ps.cache`, if it is
+ * set, such that later calls (and other users of the same cache, e.g.,
+ * `esop_rebalancing`) do not minimize them again.
+ *
+ * The functions may have different numbers of variables (up to 32).
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      exorcism_params ps;
+      ps.num_threads = 4u;
+      ps.cache = std::make_shared<exorcism_cache_t>();
+
+      std::vector<kitty::dynamic_truth_table> functions = ...;
+      const auto esops = exorcism( functions, ps );
+   \endverbatim
+ */
+inline std::vector<std::vector<kitty::cube>> exorcism( std::vector<kitty::dynamic_truth_table> const& functions, exorcism_params const& ps, exorcism_stats* pst = nullptr )
+{
+  exorcism_stats st;
+  std::vector<std::vector<kitty::cube>> esops( functions.size() );
+
+  {
+    stopwatch<> t( st.time_total );
+    const auto num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+
+    /* representatives and the configuration to obtain each function from its representative */
+    std::vector<std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>>> configs( functions.size() );
+    {
+      stopwatch<> t_canon( st.time_canonization );
+      detail::exorcism_parallel_for( functions.size(), num_threads, [&]( std::size_t i ) {
+        auto const& func = functions[i];
+        assert( func.num_vars() <= 32u );
+        if ( !ps.npn_deduplication || func.num_vars() == 0u )
+        {
+          std::vector<uint8_t> perm( func.num_vars() );
+          std::iota( perm.begin(), perm.end(), 0u );
+          configs[i] = std::make_tuple( func, 0u, perm );
+        }
+        else
+        {
+          configs[i] = func.num_vars() <= 4u ? kitty::exact_npn_canonization( func ) : kitty::sifting_npn_canonization( func );
+        }
+      } );
+    }
+
+    /* distinct representatives */
+    std::unordered_map<kitty::dynamic_truth_table, uint32_t, kitty::hash<kitty::dynamic_truth_table>> class_index;
+    std::vector<uint32_t> index_of( functions.size() );
+    std::vector<kitty::dynamic_truth_table const*> representatives;
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      auto const& repr = std::get<0>( configs[i] );
+      const auto [it, inserted] = class_index.emplace( repr, static_cast<uint32_t>( representatives.size() ) );
+      if ( inserted )
+      {
+        representatives.push_back( &repr );
+      }
+      index_of[i] = it->second;
+    }
+    st.num_functions = static_cast<uint32_t>( functions.size() );
+    st.num_classes = static_cast<uint32_t>( representatives.size() );
+
+    /* minimize the representatives that are not cached */
+    std::vector<std::vector<kitty::cube>> repr_esops( representatives.size() );
+    std::vector<uint32_t> pending;
+    for ( auto j = 0u; j < representatives.size(); ++j )
+    {
+      if ( ps.cache && ps.cache->if_contains( *representatives[j], [&]( auto const& v ) { repr_esops[j] = v; } ) )
+      {
+        ++st.num_cache_hits;
+      }
+      else
+      {
+        pending.push_back( j );
+      }
+    }
+
+    {
+      stopwatch<> t_min( st.time_minimization );
+      detail::exorcism_parallel_for( pending.size(), num_threads, [&]( std::size_t i ) {
+        const auto j = pending[i];
+        repr_esops[j] = exorcism( *representatives[j] );
+        if ( ps.cache )
+        {
+          ps.cache->try_emplace( *representatives[j], repr_esops[j] );
+        }
+      } );
+    }
+    st.num_minimized = static_cast<uint32_t>( pending.size() );
+
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      esops[i] = repr_esops[index_of[i]];
+      if ( ps.npn_deduplication )
+      {
+        detail::exorcism_apply_npn_config( esops[i], functions[i].num_vars(), std::get<1>( configs[i] ), std::get<2>( configs[i] ) );
+      }
+      st.num_cubes += esops[i].size();
+    }
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return esops;
+}
+
+} // namespace mockturtle
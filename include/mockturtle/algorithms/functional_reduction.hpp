@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../utils/pattern_store.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/fanout_view.hpp"
@@ -65,6 +66,11 @@ struct functional_reduction_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Binary pattern store (see `pattern_store`) to reload patterns from and append the new patterns (with CEXs) to.
+   * If the store contains patterns of the network, they replace the 256 random patterns.
+   */
+  std::optional<std::string> pattern_store_filename{};
+
   /*! \brief Maximum number of nodes in the transitive fanin cone (and their fanouts) to be compared to. */
   uint32_t max_TFI_nodes{1000};
 
@@ -76,6 +82,9 @@ struct functional_reduction_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{1000};
+
+  /*! \brief Recycle the SAT solver instead of restarting it (see `validator_params`). */
+  bool recycle_solver{false};
 };
 
 struct functional_reduction_stats
@@ -104,6 +113,9 @@ struct functional_reduction_stats
   /*! \brief Number of SAT solver timeout. */
   uint32_t num_timeout{0};
 
+  /*! \brief Restarts and encodings of the SAT solver. */
+  validator_stats validator_st;
+
   void report() const
   {
     // clang-format off
@@ -114,6 +126,7 @@ struct functional_reduction_stats
     std::cout << fmt::format( "[i] #SAT      = {:8d}\n", num_cex );
     std::cout << fmt::format( "[i] #UNSAT    = {:8d}\n", num_reduction );
     std::cout << fmt::format( "[i] #TIMEOUT  = {:8d}\n", num_timeout );
+    validator_st.report();
     std::cout <<              "[i] ======== Runtime ========\n";
     std::cout << fmt::format( "[i] total        : {:>5.2f} secs\n", to_seconds( time_total ) );
     std::cout << fmt::format( "[i]   simulation : {:>5.2f} secs\n", to_seconds( time_sim ) );
@@ -138,6 +151,17 @@ public:
         sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), 256 ) ), validator( ntk, vps )
   {
     static_assert( !validator_t::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
+
+    if ( ps.pattern_store_filename )
+    {
+      store.emplace( *ps.pattern_store_filename );
+      auto loaded = ps.pattern_filename ? sim : partial_simulator( ntk.num_pis(), 0 );
+      if ( load_patterns( *store, ntk, loaded ) > 0u )
+      {
+        sim = loaded;
+        store_begin = sim.num_bits();
+      }
+    }
   }
 
   ~functional_reduction_impl()
@@ -146,6 +170,10 @@ public:
     {
       write_patterns( sim, *ps.save_patterns );
     }
+    if ( store )
+    {
+      save_patterns( *store, ntk, sim, store_begin );
+    }
   }
 
   void run()
@@ -168,6 +196,8 @@ public:
       size_before = ntk.size();
       substitute_equivalent_nodes();
     }
+
+    st.validator_st = validator.stats();
   }
 
 private:
@@ -404,6 +434,8 @@ private:
 
   TT tts;
   partial_simulator sim;
+  std::optional<pattern_store> store;
+  uint64_t store_begin{0u};
   validator_t validator;
 
   uint32_t candidates{0};
@@ -435,6 +467,7 @@ void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {},
   validator_params vps;
   vps.max_clauses = ps.max_clauses;
   vps.conflict_limit = ps.conflict_limit;
+  vps.recycle_solver = ps.recycle_solver;
 
   using fanout_view_t = fanout_view<Ntk>;
   fanout_view_t fanout_view{ntk};
@@ -0,0 +1,636 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file incremental_lut_mapping.hpp
+  \brief Incremental LUT mapping after local network changes
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/topo_view.hpp"
+#include "cut_enumeration.hpp"
+#include "cut_enumeration/mf_cut.hpp"
+#include "lut_mapping.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Statistics for incremental_lut_mapping.
+ *
+ * The data structure `incremental_lut_mapping_stats` provides data collected
+ * by an `incremental_lut_mapping` object.
+ */
+struct incremental_lut_mapping_stats
+{
+  /*! \brief Runtime of the initial mapping. */
+  stopwatch<>::duration time_mapping{0};
+
+  /*! \brief Total runtime of all updates. */
+  stopwatch<>::duration time_update{0};
+
+  /*! \brief Number of updates. */
+  uint32_t num_updates{0};
+
+  /*! \brief Number of nodes whose cuts have been recomputed. */
+  uint64_t num_recomputed_cuts{0};
+
+  /*! \brief Number of nodes whose cut sets have changed. */
+  uint64_t num_changed_cuts{0};
+
+  /*! \brief Number of cell selections during updates. */
+  uint64_t num_remapped{0};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] updates       = {:>8}\n", num_updates );
+    std::cout << fmt::format( "[i] recomputed    = {:>8}\n", num_recomputed_cuts );
+    std::cout << fmt::format( "[i] changed cuts  = {:>8}\n", num_changed_cuts );
+    std::cout << fmt::format( "[i] remapped      = {:>8}\n", num_remapped );
+    std::cout << fmt::format( "[i] mapping time  = {:>5.2f} secs\n", to_seconds( time_mapping ) );
+    std::cout << fmt::format( "[i] update time   = {:>5.2f} secs\n", to_seconds( time_update ) );
+  }
+};
+
+/*! \brief Incremental LUT mapping.
+ *
+ * This class maps a network with `lut_mapping` and keeps the mapping up to
+ * date while the network is modified, e.g., by engineering change orders or
+ * by local rewriting.  It subscribes to the network events and records added,
+ * modified, and deleted nodes.  A call to `update` then recomputes the cuts of
+ * the changed nodes and of their transitive fanout, in topological order, and
+ * stops at nodes whose cut sets do not change.  The cells of these nodes are
+ * selected again using exact local area, while the cells in the rest of the
+ * network are kept.  After `update` returns, the mapping stored in the
+ * network is consistent with the network, i.e., every referenced node is a
+ * cell root and every cell covers its root with a cut.
+ *
+ * The cells are referenced in the mapping view itself, such that cells that
+ * are no longer needed after a change are removed from the mapping.  The
+ * parameters `cut_enumeration_ps`, `rounds`, and `rounds_ela` control the
+ * initial mapping; `rounds_ela` is also the number of exact area rounds over
+ * the updated nodes.
+ *
+ * The network is modified through the network that is wrapped by the mapping
+ * view, which shares its storage.  The fanouts of nodes are required to find
+ * the nodes that need to be updated.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `is_pi`
+ * - `is_constant`
+ * - `is_dead`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `get_node`
+ * - `foreach_po`
+ * - `foreach_node`
+ * - `foreach_fanin`
+ * - `foreach_fanout`
+ * - `fanout_size`
+ * - `events`
+ * - `clear_mapping`
+ * - `add_to_mapping`
+ * - `remove_from_mapping`
+ * - `is_cell_root`
+ * - `foreach_cell_fanin`
+ * - `set_cell_function` (if `StoreFunction` is true)
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      fanout_view aig_fanout{aig};
+      mapping_view<fanout_view<aig_network>, true> mapped{aig_fanout};
+
+      incremental_lut_mapping<decltype( mapped ), true> mapper( mapped );
+
+      // local change
+      aig.substitute_node( n, aig.create_and( a, b ) );
+      mapper.update();
+   \endverbatim
+ */
+template<class Ntk, bool StoreFunction = false, typename CutData = cut_enumeration_mf_cut>
+class incremental_lut_mapping
+    : public event_add_crtp<Ntk, incremental_lut_mapping<Ntk, StoreFunction, CutData>>,
+      public event_modified_crtp<Ntk, incremental_lut_mapping<Ntk, StoreFunction, CutData>>,
+      public event_delete_crtp<Ntk, incremental_lut_mapping<Ntk, StoreFunction, CutData>>
+{
+public:
+  using network_cuts_t = network_cuts<Ntk, StoreFunction, CutData>;
+  using cut_t = typename network_cuts_t::cut_t;
+  using node = typename Ntk::node;
+
+  friend class network_events<Ntk>::add_accessor;
+  friend class network_events<Ntk>::modified_accessor;
+  friend class network_events<Ntk>::delete_accessor;
+
+  /*! \brief Maps the network and starts to record its changes. */
+  explicit incremental_lut_mapping( Ntk& ntk, lut_mapping_params const& ps = {} )
+      : ntk( ntk ),
+        ps( ps ),
+        cuts( initial_mapping() )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_foreach_fanout_v<Ntk>, "Ntk does not implement the foreach_fanout method" );
+    static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+    static_assert( has_clear_mapping_v<Ntk>, "Ntk does not implement the clear_mapping method" );
+    static_assert( has_add_to_mapping_v<Ntk>, "Ntk does not implement the add_to_mapping method" );
+    static_assert( has_remove_from_mapping_v<Ntk>, "Ntk does not implement the remove_from_mapping method" );
+    static_assert( has_is_cell_root_v<Ntk>, "Ntk does not implement the is_cell_root method" );
+    static_assert( has_foreach_cell_fanin_v<Ntk>, "Ntk does not implement the foreach_cell_fanin method" );
+    static_assert( !StoreFunction || has_set_cell_function_v<Ntk>, "Ntk does not implement the set_cell_function method" );
+
+    init_references();
+
+    ntk.events().on_add.emplace_back( event_add_crtp<Ntk, incremental_lut_mapping>::wp(), []( void* wp, auto const& n ) {
+      reinterpret_cast<incremental_lut_mapping*>( wp )->changed.push_back( n );
+    } );
+
+    ntk.events().on_modified.emplace_back( event_modified_crtp<Ntk, incremental_lut_mapping>::wp(), []( void* wp, auto const& n, auto const& previous ) {
+      (void)previous;
+      reinterpret_cast<incremental_lut_mapping*>( wp )->changed.push_back( n );
+    } );
+
+    ntk.events().on_delete.emplace_back( event_delete_crtp<Ntk, incremental_lut_mapping>::wp(), []( void* wp, auto const& n ) {
+      reinterpret_cast<incremental_lut_mapping*>( wp )->deleted.push_back( n );
+    } );
+  }
+
+  incremental_lut_mapping( incremental_lut_mapping const& ) = delete;
+  incremental_lut_mapping& operator=( incremental_lut_mapping const& ) = delete;
+
+  /*! \brief Updates the mapping to the changes since the last update. */
+  void update()
+  {
+    stopwatch t( st.time_update );
+    ++st.num_updates;
+
+    if ( map_refs.size() < ntk.size() )
+    {
+      map_refs.resize( ntk.size(), 0 );
+      levels.resize( ntk.size(), 0 );
+      flags.resize( ntk.size(), 0 );
+      cuts.resize( ntk.size() );
+    }
+
+    update_cuts();
+
+    /* free the cells of the changed nodes, their references are kept */
+    for ( auto const& index : region )
+    {
+      deref_cell( index );
+    }
+
+    update_outputs();
+
+    for ( auto const& n : deleted )
+    {
+      const auto index = ntk.node_to_index( n );
+      deref_cell( index );
+      map_refs[index] = 0;
+    }
+
+    /* select cells for referenced nodes, from the outputs to the inputs */
+    for ( auto it = region.rbegin(); it != region.rend(); ++it )
+    {
+      if ( map_refs[*it] > 0 && !ntk.is_cell_root( ntk.index_to_node( *it ) ) )
+      {
+        select_cell( *it );
+      }
+    }
+    for ( auto const& index : new_outputs )
+    {
+      if ( map_refs[index] > 0 && !ntk.is_cell_root( ntk.index_to_node( index ) ) )
+      {
+        select_cell( index );
+      }
+    }
+
+    /* exact local area on the changed nodes */
+    for ( auto i = 0u; i < ps.rounds_ela; ++i )
+    {
+      for ( auto const& index : region )
+      {
+        if ( map_refs[index] > 0 )
+        {
+          deref_cell( index );
+          select_cell( index );
+        }
+      }
+    }
+
+    for ( auto const& index : touched )
+    {
+      flags[index] = 0;
+    }
+    touched.clear();
+    region.clear();
+    new_outputs.clear();
+    changed.clear();
+    deleted.clear();
+  }
+
+  /*! \brief Returns the statistics. */
+  incremental_lut_mapping_stats const& stats() const
+  {
+    return st;
+  }
+
+private:
+  enum : uint8_t
+  {
+    flag_queued = 1u,
+    flag_recompute = 2u,
+    flag_region = 4u,
+    flag_touched = 8u
+  };
+
+  network_cuts_t initial_mapping()
+  {
+    stopwatch t( st.time_mapping );
+
+    lut_mapping_stats mst;
+    detail::lut_mapping_impl<Ntk, StoreFunction, CutData> p( ntk, ps, mst );
+    p.run();
+    return std::move( p.cut_database() );
+  }
+
+  void init_references()
+  {
+    map_refs.resize( ntk.size(), 0 );
+    levels.resize( ntk.size(), 0 );
+    flags.resize( ntk.size(), 0 );
+
+    topo_view<Ntk>{ntk}.foreach_node( [&]( auto const& n ) {
+      const auto index = ntk.node_to_index( n );
+      levels[index] = compute_level( n );
+
+      if ( !is_terminal( index ) && ntk.is_cell_root( n ) )
+      {
+        ntk.foreach_cell_fanin( n, [&]( auto const& leaf ) {
+          ++map_refs[ntk.node_to_index( leaf )];
+        } );
+      }
+    } );
+
+    ntk.foreach_po( [&]( auto const& f ) {
+      const auto index = ntk.node_to_index( ntk.get_node( f ) );
+      outputs.push_back( index );
+      ++map_refs[index];
+    } );
+  }
+
+  bool is_terminal( uint32_t index ) const
+  {
+    const auto n = ntk.index_to_node( index );
+    return ntk.is_constant( n ) || ntk.is_pi( n );
+  }
+
+  uint32_t compute_level( node const& n ) const
+  {
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+    {
+      return 0u;
+    }
+
+    uint32_t level{0u};
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] );
+    } );
+    return level + 1u;
+  }
+
+  void touch( uint32_t index, uint8_t flag )
+  {
+    if ( !flags[index] )
+    {
+      touched.push_back( index );
+    }
+    flags[index] |= flag | flag_touched;
+  }
+
+  /* recomputes the cuts of the changed nodes and of their transitive fanout
+   * in topological order, until the cut sets do not change anymore; collects
+   * the nodes with changed cut sets in `region` */
+  void update_cuts()
+  {
+    detail::cut_enumeration_impl<Ntk, StoreFunction, CutData> enumerator( ntk, ps.cut_enumeration_ps, cut_st, cuts );
+
+    /* pairs of level and node index, levels of queued nodes may increase */
+    using entry_t = std::pair<uint32_t, uint32_t>;
+    std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> queue;
+
+    const auto push = [&]( uint32_t index ) {
+      touch( index, flag_queued );
+      queue.emplace( levels[index], index );
+    };
+
+    std::sort( changed.begin(), changed.end() );
+    changed.erase( std::unique( changed.begin(), changed.end() ), changed.end() );
+    for ( auto const& n : changed )
+    {
+      if ( ntk.is_dead( n ) )
+      {
+        continue;
+      }
+
+      const auto index = ntk.node_to_index( n );
+      levels[index] = compute_level( n );
+      touch( index, flag_recompute | flag_region );
+      push( index );
+    }
+
+    while ( !queue.empty() )
+    {
+      const auto [level, index] = queue.top();
+      queue.pop();
+
+      const auto n = ntk.index_to_node( index );
+      if ( level != levels[index] || !( flags[index] & flag_queued ) || ntk.is_dead( n ) )
+      {
+        continue;
+      }
+      flags[index] &= static_cast<uint8_t>( ~flag_queued );
+      levels[index] = compute_level( n );
+
+      bool cuts_changed{false};
+      if ( flags[index] & flag_recompute )
+      {
+        flags[index] &= static_cast<uint8_t>( ~flag_recompute );
+
+        const auto before = cut_set_leaves( index );
+        enumerator.compute_cuts( index );
+        ++st.num_recomputed_cuts;
+
+        if ( cut_set_leaves( index ) != before )
+        {
+          cuts_changed = true;
+          ++st.num_changed_cuts;
+          touch( index, flag_region );
+        }
+      }
+
+      ntk.foreach_fanout( n, [&]( auto const& fo ) {
+        if ( ntk.is_dead( fo ) )
+        {
+          return;
+        }
+
+        const auto fo_index = ntk.node_to_index( fo );
+        if ( levels[fo_index] <= levels[index] )
+        {
+          levels[fo_index] = levels[index] + 1u;
+          push( fo_index );
+        }
+        if ( cuts_changed )
+        {
+          touch( fo_index, flag_recompute );
+          push( fo_index );
+        }
+      } );
+    }
+
+    for ( auto const& index : touched )
+    {
+      if ( ( flags[index] & flag_region ) && !is_terminal( index ) && !ntk.is_dead( ntk.index_to_node( index ) ) )
+      {
+        region.push_back( index );
+      }
+    }
+    std::sort( region.begin(), region.end(), [&]( auto i1, auto i2 ) {
+      return std::make_pair( levels[i1], i1 ) < std::make_pair( levels[i2], i2 );
+    } );
+  }
+
+  /* leaves (and functions) of all cuts of a node, independent of their order */
+  std::vector<std::vector<uint32_t>> cut_set_leaves( uint32_t index ) const
+  {
+    std::vector<std::vector<uint32_t>> leaves;
+    for ( auto const* cut : cuts.cuts( index ) )
+    {
+      leaves.emplace_back( cut->begin(), cut->end() );
+      if constexpr ( StoreFunction )
+      {
+        leaves.back().push_back( ( *cut )->func_id );
+      }
+    }
+    std::sort( leaves.begin(), leaves.end() );
+    return leaves;
+  }
+
+  /* updates the references of nodes that drive primary outputs */
+  void update_outputs()
+  {
+    std::vector<uint32_t> current;
+    current.reserve( outputs.size() );
+    ntk.foreach_po( [&]( auto const& f ) {
+      current.push_back( ntk.node_to_index( ntk.get_node( f ) ) );
+    } );
+
+    for ( auto const& index : current )
+    {
+      if ( map_refs[index]++ == 0 && !is_terminal( index ) )
+      {
+        new_outputs.push_back( index );
+      }
+    }
+    for ( auto const& index : outputs )
+    {
+      if ( --map_refs[index] == 0 && !is_terminal( index ) )
+      {
+        deref_cell( index );
+      }
+    }
+
+    outputs = std::move( current );
+  }
+
+  uint32_t cut_area( cut_t const& cut ) const
+  {
+    return static_cast<uint32_t>( cut->data.cost );
+  }
+
+  /* adds a cell for the node with the leaves of `cut` and recursively adds
+   * cells with the best cuts for leaves that are not yet referenced */
+  void ref_cell( uint32_t index, cut_t const& cut )
+  {
+    std::vector<node> leaves;
+    for ( auto leaf : cut )
+    {
+      leaves.push_back( ntk.index_to_node( leaf ) );
+    }
+
+    const auto n = ntk.index_to_node( index );
+    ntk.add_to_mapping( n, leaves.begin(), leaves.end() );
+    if constexpr ( StoreFunction )
+    {
+      ntk.set_cell_function( n, cuts.truth_table( cut ) );
+    }
+
+    for ( auto leaf : cut )
+    {
+      if ( !is_terminal( leaf ) && map_refs[leaf]++ == 0 )
+      {
+        ref_cell( leaf, cuts.cuts( leaf ).best() );
+      }
+    }
+  }
+
+  /* removes the cell of the node from the mapping and recursively removes the
+   * cells of leaves that are no longer referenced */
+  void deref_cell( uint32_t index )
+  {
+    const auto n = ntk.index_to_node( index );
+    if ( !ntk.is_cell_root( n ) )
+    {
+      return;
+    }
+
+    std::vector<uint32_t> leaves;
+    ntk.foreach_cell_fanin( n, [&]( auto const& leaf ) {
+      leaves.push_back( ntk.node_to_index( leaf ) );
+    } );
+    ntk.remove_from_mapping( n );
+
+    for ( auto leaf : leaves )
+    {
+      if ( !is_terminal( leaf ) && --map_refs[leaf] == 0 )
+      {
+        deref_cell( leaf );
+      }
+    }
+  }
+
+  /* see `cut_ref_limit_save` in `lut_mapping` */
+  uint32_t cut_ref_limit_save( cut_t const& cut, uint32_t limit )
+  {
+    uint32_t count = cut_area( cut );
+    if ( limit == 0 )
+      return count;
+
+    for ( auto leaf : cut )
+    {
+      if ( is_terminal( leaf ) )
+        continue;
+
+      tmp_area.push_back( leaf );
+      if ( map_refs[leaf]++ == 0 )
+      {
+        count += cut_ref_limit_save( cuts.cuts( leaf ).best(), limit - 1 );
+      }
+    }
+    return count;
+  }
+
+  uint32_t cut_area_estimation( cut_t const& cut )
+  {
+    tmp_area.clear();
+    const auto count = cut_ref_limit_save( cut, 8 );
+    for ( auto const& leaf : tmp_area )
+    {
+      map_refs[leaf]--;
+    }
+    return count;
+  }
+
+  /* selects the cut with the smallest exact local area as cell */
+  void select_cell( uint32_t index )
+  {
+    auto& node_cuts = cuts.cuts( index );
+
+    int32_t best_cut{-1};
+    uint32_t best_area{std::numeric_limits<uint32_t>::max()};
+    int32_t cut_index{-1};
+    for ( auto* cut : node_cuts )
+    {
+      ++cut_index;
+      if ( cut->size() == 1 )
+        continue;
+
+      const auto area = cut_area_estimation( *cut );
+      if ( area < best_area )
+      {
+        best_cut = cut_index;
+        best_area = area;
+      }
+    }
+
+    assert( best_cut != -1 );
+    if ( best_cut > 0 )
+    {
+      node_cuts.update_best( static_cast<uint32_t>( best_cut ) );
+    }
+    ref_cell( index, node_cuts.best() );
+    ++st.num_remapped;
+  }
+
+private:
+  Ntk& ntk;
+  lut_mapping_params const ps;
+  incremental_lut_mapping_stats st;
+  network_cuts_t cuts;
+  cut_enumeration_stats cut_st;
+
+  std::vector<uint32_t> map_refs;
+  std::vector<uint32_t> levels;
+  std::vector<uint8_t> flags;
+  std::vector<uint32_t> outputs; /* nodes driving the primary outputs */
+
+  std::vector<node> changed; /* added or modified nodes since the last update */
+  std::vector<node> deleted; /* deleted nodes since the last update */
+
+  std::vector<uint32_t> touched;     /* nodes with flags */
+  std::vector<uint32_t> region;      /* nodes with changed cut sets in topological order */
+  std::vector<uint32_t> new_outputs; /* nodes that started to drive primary outputs */
+  std::vector<uint32_t> tmp_area;    /* temporary vector to compute exact area */
+};
+
+} // namespace mockturtle
@@ -32,15 +32,22 @@
 
 #pragma once
 
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <random>
+#include <thread>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "../algorithms/cnf.hpp"
 #include "../algorithms/simulation.hpp"
 #include "../networks/xag.hpp"
+#include "../utils/gf2_matrix.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/cnf_view.hpp"
 #include "../traits.hpp"
@@ -179,21 +186,39 @@ public:
   }
 };
 
-struct pair_hash
+/* rows are the linear functions of the outputs over the primary inputs,
+ * complemented edges are ignored */
+template<class Ntk>
+gf2_matrix linear_gf2_simulation( Ntk const& ntk )
 {
-  template<class T1, class T2>
-  std::size_t operator()( std::pair<T1, T2> const& p ) const
-  {
-    return std::hash<T1>()( p.first ) ^ std::hash<T2>()( p.second );
-  }
-};
+  gf2_matrix values( ntk.size(), ntk.num_pis() );
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    values.set( ntk.node_to_index( n ), i );
+  } );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( !ntk.is_xor( n ) )
+    {
+      assert( false && "Only XOR gates allowed in linear forms" );
+      std::abort();
+    }
+    std::array<uint32_t, 2> fanins{};
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      fanins[i] = ntk.node_to_index( ntk.get_node( f ) );
+    } );
+    values.set_row_to_sum( fanins[0], fanins[1], ntk.node_to_index( n ) );
+  } );
+
+  gf2_matrix matrix( ntk.num_pos(), ntk.num_pis() );
+  ntk.foreach_po( [&]( auto const& f, auto i ) {
+    std::copy_n( values.row( ntk.node_to_index( ntk.get_node( f ) ) ), matrix.num_blocks(), matrix.row( i ) );
+  } );
+  return matrix;
+}
 
 template<class Ntk>
 struct linear_resynthesis_paar_impl
 {
 public:
-  using index_pair_t = std::pair<uint32_t, uint32_t>;
-
   linear_resynthesis_paar_impl( Ntk const& xag ) : xag( xag ) {}
 
   Ntk run()
@@ -202,173 +227,794 @@ public:
       signals.push_back( dest.create_pi() );
     } );
 
-    extract_linear_equations();
+    /* row i contains the outputs whose equations contain signal i */
+    occurrences = linear_gf2_simulation( xag ).transpose();
+    best.resize( signals.size() );
+    for ( auto i = 0u; i < signals.size(); ++i )
+    {
+      if ( occurrences.count_ones( i ) >= 2u )
+      {
+        live.push_back( i );
+      }
+    }
+    for ( auto i : live )
+    {
+      update_best( i );
+    }
 
-    while ( !occurrance_to_pairs.empty() )
+    /* once no pair occurs more than once, the order of the remaining XORs
+     * does not change their number */
+    while ( true )
     {
-      const auto p = *( occurrance_to_pairs.back().begin() );
-      replace_one_pair( p );
+      const auto it = std::max_element( live.begin(), live.end(), [&]( auto i, auto j ) { return best[i].first < best[j].first; } );
+      if ( it == live.end() || best[*it].first < 2u )
+      {
+        break;
+      }
+      replace_pair( std::min( *it, best[*it].second ), std::max( *it, best[*it].second ) );
     }
 
-    xag.foreach_po( [&]( auto const& f, auto i ) {
-      if ( linear_equations[i].empty() )
+    /* remaining signals of each output */
+    std::vector<std::vector<uint32_t>> linear_equations( xag.num_pos() );
+    for ( auto i = 0u; i < signals.size(); ++i )
+    {
+      occurrences.foreach_one( i, [&]( auto o ) {
+        linear_equations[o].push_back( i );
+      } );
+    }
+
+    xag.foreach_po( [&]( auto const& f, auto o ) {
+      auto const& leq = linear_equations[o];
+      if ( leq.empty() )
       {
         dest.create_po( dest.get_constant( xag.is_complemented( f ) ) );
+        return;
       }
-      else
+
+      auto s = signals[leq.front()];
+      for ( auto j = 1u; j < leq.size(); ++j )
       {
-        assert( linear_equations[i].size() == 1u );
-        dest.create_po( signals[linear_equations[i].front()] ^ xag.is_complemented( f ) );
+        s = dest.create_xor( s, signals[leq[j]] );
       }
+      dest.create_po( s ^ xag.is_complemented( f ) );
     } );
 
     return dest;
   }
 
 private:
-  void extract_linear_equations()
+  /* most frequent pair of a live signal with another live signal (first
+   * such signal in case of ties) */
+  void update_best( uint32_t i )
+  {
+    best[i] = {0u, i};
+    for ( auto j : live )
+    {
+      if ( j == i )
+      {
+        continue;
+      }
+      if ( const auto count = occurrences.count_common( i, j ); count > best[i].first )
+      {
+        best[i] = {count, j};
+      }
+    }
+  }
+
+  void replace_pair( uint32_t a, uint32_t b )
   {
-    occurrance_to_pairs.resize( 1u );
+    const auto c = static_cast<uint32_t>( signals.size() );
+    signals.push_back( dest.create_xor( signals[a], signals[b] ) );
+    best.emplace_back();
+
+    /* the outputs containing both a and b now contain c instead */
+    occurrences.add_row();
+    auto* occ_a = occurrences.row( a );
+    auto* occ_b = occurrences.row( b );
+    auto* occ_c = occurrences.row( c );
+    for ( auto k = 0u; k < occurrences.num_blocks(); ++k )
+    {
+      occ_c[k] = occ_a[k] & occ_b[k];
+      occ_a[k] &= ~occ_c[k];
+      occ_b[k] &= ~occ_c[k];
+    }
 
-    linear_xag lxag{xag};
-    linear_equations = simulate<std::vector<uint32_t>>( lxag, linear_sum_simulator{} );
+    /* only pairs with a or b occur less often, the best pair of a signal
+     * remains the best one if it still occurs as often as before */
+    const auto is_dead = [&]( auto i ) { return ( i == a || i == b ) && occurrences.count_ones( i ) < 2u; };
+    live.erase( std::remove_if( live.begin(), live.end(), is_dead ), live.end() );
+    live.push_back( c );
 
-    for ( auto o = 0u; o < linear_equations.size(); ++o )
+    for ( auto i : live )
     {
-      const auto& lin_eq = linear_equations[o];
-      for ( auto j = 1u; j < lin_eq.size(); ++j )
+      if ( i == c )
       {
-        for ( auto i = 0u; i < j; ++i )
+        continue;
+      }
+      if ( i == a || i == b || best[i].second == a || best[i].second == b )
+      {
+        if ( is_dead( best[i].second ) || occurrences.count_common( i, best[i].second ) < best[i].first )
         {
-          const auto p = std::make_pair( lin_eq[i], lin_eq[j] );
-          pairs_to_output[p].push_back( o );
-          add_pair( p );
+          update_best( i );
+          continue;
         }
       }
+      if ( const auto count = occurrences.count_common( i, c ); count > best[i].first )
+      {
+        best[i] = {count, c};
+      }
     }
+    update_best( c );
   }
 
-  void add_pair( index_pair_t const& p )
+private:
+  Ntk const& xag;
+  Ntk dest;
+  std::vector<signal<Ntk>> signals;
+  gf2_matrix occurrences;
+  std::vector<uint32_t> live;
+  std::vector<std::pair<uint32_t, uint32_t>> best;
+};
+
+} // namespace detail
+
+/*! \brief Linear circuit resynthesis (Paar's algorithm)
+ *
+ * This algorithm works on an XAG that is only composed of XOR gates.  It
+ * extracts a matrix representation of the linear output equations and
+ * resynthesizes them in a greedy manner by always substituting the most
+ * frequent pair of variables using the computed function of an XOR gate.
+ *
+ * Reference: [C. Paar, IEEE Int'l Symp. on Inf. Theo. (1997), page 250]
+ */
+template<typename Ntk>
+Ntk linear_resynthesis_paar( Ntk const& xag )
+{
+  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
+
+  return detail::linear_resynthesis_paar_impl<Ntk>( xag ).run();
+}
+
+struct linear_resynthesis_boyar_peralta_params
+{
+  /*! \brief Number of runs, all but the first one break ties randomly. */
+  uint32_t num_restarts{1u};
+
+  /*! \brief Number of worker threads for the runs (0: hardware concurrency). */
+  uint32_t num_threads{1u};
+
+  /*! \brief Seed for the random tie-breaking. */
+  uint32_t seed{1u};
+
+  /*! \brief Maximum number of signals to search for cancellations of two signals.
+   *
+   * After each new signal, the outputs are checked to be the XOR of the new
+   * signal and one existing signal.  As long as there are at most this many
+   * signals, they are also checked to be the XOR of the new signal and two
+   * existing signals, which takes time quadratic in the number of signals.
+   */
+  uint32_t max_search_size{256u};
+
+  /*! \brief Ignore inputs in any step to compute this output.
+   *
+   * Same format as `exact_linear_synthesis_params::ignore_inputs`.  This is
+   * required to merge the result back into an XAG with AND gates, since the
+   * heuristic does not compute cancellation-free circuits.
+   */
+  std::vector<std::vector<uint32_t>> ignore_inputs;
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+struct linear_resynthesis_boyar_peralta_stats
+{
+  /*! \brief Total time. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Number of XOR gates of the best run. */
+  uint32_t num_xors{0u};
+
+  /*! \brief Index of the best run. */
+  uint32_t best_restart{0u};
+
+  /*! \brief Prints report. */
+  void report() const
+  {
+    fmt::print( "[i] XOR gates    = {:>5}\n", num_xors );
+    fmt::print( "[i] best restart = {:>5}\n", best_restart );
+    fmt::print( "[i] total time   = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+/* XOR steps over a base of signals that starts with the inputs */
+struct linear_program
+{
+  std::vector<std::pair<uint32_t, uint32_t>> steps;
+
+  /* base element of each output, or `constant` */
+  std::vector<uint32_t> outputs;
+
+  static constexpr uint32_t constant = std::numeric_limits<uint32_t>::max();
+};
+
+class boyar_peralta_run
+{
+public:
+  boyar_peralta_run( gf2_matrix const& targets, gf2_matrix const& ignore, uint32_t max_base_size, uint32_t seed, bool randomize )
+      : targets( targets ),
+        ignore( ignore ),
+        has_ignore( ignore.num_rows() > 0u ),
+        base( 0u, targets.num_columns() ),
+        footprints( 0u, targets.num_columns() ),
+        occurrences( 0u, targets.num_rows() ),
+        members( targets.num_rows() ),
+        scratch( base.num_blocks() ),
+        scratch2( base.num_blocks() ),
+        max_base_size( max_base_size ),
+        rng( seed ),
+        randomize( randomize )
   {
-    if ( auto it = pair_to_occurrance.find( p ); it != pair_to_occurrance.end() )
+  }
+
+  linear_program run()
+  {
+    for ( auto i = 0u; i < targets.num_columns(); ++i )
+    {
+      add_base_element();
+      base.set( i, i );
+      footprints.set( i, i );
+      base_lookup.emplace( hash_row( base.row( i ) ), i );
+    }
+
+    for ( auto y = 0u; y < targets.num_rows(); ++y )
     {
-      // found another time
-      const auto occ = it->second;
-      occurrance_to_pairs[occ - 1u].erase( p );
-      if ( occurrance_to_pairs.size() <= occ + 1u )
+      targets.foreach_one( y, [&]( auto i ) {
+        assert( is_usable( i, y ) );
+        members[y].push_back( i );
+        occurrences.set( i, y );
+      } );
+    }
+
+    for ( auto i = 0u; i < base.num_rows(); ++i )
+    {
+      if ( occurrences.count_ones( i ) >= 2u )
       {
-        occurrance_to_pairs.resize( occ + 1u );
+        live.push_back( i );
+        is_live[i] = 1u;
       }
-      occurrance_to_pairs[occ].insert( p );
-      it->second++;
     }
-    else
+    for ( auto i : live )
+    {
+      update_best( i );
+    }
+
+    while ( true )
+    {
+      if ( const auto p = select_pair(); p )
+      {
+        add_xor( p->first, p->second );
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    for ( auto y = 0u; y < targets.num_rows(); ++y )
+    {
+      assert( members[y].size() <= 1u );
+      program.outputs.push_back( members[y].empty() ? linear_program::constant : members[y].front() );
+    }
+    return std::move( program );
+  }
+
+private:
+  uint32_t distance( uint32_t y ) const
+  {
+    return members[y].empty() ? 0u : static_cast<uint32_t>( members[y].size() ) - 1u;
+  }
+
+  /* the n-th candidate of equal quality replaces the current one with
+   * probability 1/n, if ties are broken randomly */
+  bool replace_candidate( uint32_t n )
+  {
+    return randomize && rng() % n == 0u;
+  }
+
+  std::optional<std::pair<uint32_t, uint32_t>> select_pair()
+  {
+    /* a target that is one XOR away is computed next */
+    std::optional<uint32_t> target;
+    uint32_t num_candidates{0u};
+    for ( auto y = 0u; y < targets.num_rows(); ++y )
+    {
+      if ( distance( y ) != 1u )
+      {
+        continue;
+      }
+      if ( ++num_candidates == 1u || replace_candidate( num_candidates ) )
+      {
+        target = y;
+      }
+    }
+    if ( target )
+    {
+      return std::make_pair( members[*target][0], members[*target][1] );
+    }
+
+    /* among the pairs that reduce the distances the most, the one that
+     * maximizes the norm of the new distance vector */
+    uint32_t max_count{0u};
+    for ( auto i : live )
+    {
+      max_count = std::max( max_count, best[i].first );
+    }
+    if ( max_count >= 2u )
+    {
+      std::optional<std::pair<uint32_t, uint32_t>> pair;
+      uint64_t min_loss{0u};
+      num_candidates = 0u;
+      for ( auto i : live )
+      {
+        if ( best[i].first != max_count )
+        {
+          continue;
+        }
+        const auto j = best[i].second;
+        uint64_t loss{0u};
+        auto const* occ_i = occurrences.row( i );
+        auto const* occ_j = occurrences.row( j );
+        for ( auto k = 0u; k < occurrences.num_blocks(); ++k )
+        {
+          for ( auto w = occ_i[k] & occ_j[k]; w; w &= w - 1u )
+          {
+            loss += 2u * distance( ( k << 6u ) + static_cast<uint32_t>( ctz64( w ) ) ) - 1u;
+          }
+        }
+        if ( !pair || loss < min_loss )
+        {
+          pair = std::make_pair( std::min( i, j ), std::max( i, j ) );
+          min_loss = loss;
+          num_candidates = 1u;
+        }
+        else if ( loss == min_loss && replace_candidate( ++num_candidates ) )
+        {
+          pair = std::make_pair( std::min( i, j ), std::max( i, j ) );
+        }
+      }
+      return pair;
+    }
+
+    /* no pair is shared by two targets, continue with a closest target */
+    num_candidates = 0u;
+    for ( auto y = 0u; y < targets.num_rows(); ++y )
+    {
+      if ( distance( y ) < 2u )
+      {
+        continue;
+      }
+      if ( !target || distance( y ) < distance( *target ) )
+      {
+        target = y;
+        num_candidates = 1u;
+      }
+      else if ( distance( y ) == distance( *target ) && replace_candidate( ++num_candidates ) )
+      {
+        target = y;
+      }
+    }
+    if ( !target )
+    {
+      return std::nullopt;
+    }
+
+    auto const& ms = members[*target];
+    if ( !randomize )
+    {
+      return std::make_pair( ms[0], ms[1] );
+    }
+    const auto i = static_cast<uint32_t>( rng() % ms.size() );
+    const auto j = static_cast<uint32_t>( ( i + 1u + rng() % ( ms.size() - 1u ) ) % ms.size() );
+    return std::make_pair( ms[i], ms[j] );
+  }
+
+  void add_xor( uint32_t a, uint32_t b )
+  {
+    /* targets whose decomposition contains both a and b */
+    std::vector<uint32_t> reduced;
+    {
+      auto const* occ_a = occurrences.row( a );
+      auto const* occ_b = occurrences.row( b );
+      for ( auto k = 0u; k < occurrences.num_blocks(); ++k )
+      {
+        for ( auto w = occ_a[k] & occ_b[k]; w; w &= w - 1u )
+        {
+          reduced.push_back( ( k << 6u ) + static_cast<uint32_t>( ctz64( w ) ) );
+        }
+      }
+    }
+
+    /* reuse an existing base element with the same value, if possible */
+    auto* sum = scratch.data();
+    for ( auto k = 0u; k < base.num_blocks(); ++k )
+    {
+      sum[k] = base.row( a )[k] ^ base.row( b )[k];
+    }
+    auto e = find_base_element( sum, [&]( auto s ) {
+      return std::all_of( reduced.begin(), reduced.end(), [&]( auto y ) { return is_usable( s, y ); } );
+    } );
+    if ( !e )
+    {
+      e = add_base_element();
+      base.set_row_to_sum( a, b, *e );
+      auto* fp = footprints.row( *e );
+      for ( auto k = 0u; k < footprints.num_blocks(); ++k )
+      {
+        fp[k] = footprints.row( a )[k] | footprints.row( b )[k];
+      }
+      base_lookup.emplace( hash_row( base.row( *e ) ), *e );
+      program.steps.emplace_back( a, b );
+    }
+    mark_dirty( a );
+    mark_dirty( b );
+    mark_dirty( *e );
+
+    for ( auto y : reduced )
+    {
+      toggle_member( y, a );
+      toggle_member( y, b );
+      toggle_member( y, *e );
+    }
+
+    /* targets that are a few XORs away from the new element, which may
+     * cancel inputs of the current decomposition */
+    for ( auto y = 0u; y < targets.num_rows(); ++y )
     {
-      // first time found
-      pair_to_occurrance[p] = 1u;
-      occurrance_to_pairs[0u].insert( p );
+      if ( distance( y ) == 0u || !is_usable( *e, y ) )
+      {
+        continue;
+      }
+      for ( auto k = 0u; k < base.num_blocks(); ++k )
+      {
+        sum[k] = targets.row( y )[k] ^ base.row( *e )[k];
+      }
+      if ( std::all_of( sum, sum + base.num_blocks(), []( auto w ) { return w == 0u; } ) )
+      {
+        set_members( y, {*e} );
+      }
+      else if ( distance( y ) >= 2u )
+      {
+        if ( const auto s = find_base_element( sum, [&]( auto s ) { return s != *e && is_usable( s, y ); } ); s )
+        {
+          set_members( y, {*e, *s} );
+        }
+        else if ( distance( y ) >= 3u && base.num_rows() <= max_base_size )
+        {
+          /* the output is the XOR of the new signal and two existing ones */
+          auto* sum2 = scratch2.data();
+          for ( auto s1 = 0u; s1 < base.num_rows(); ++s1 )
+          {
+            if ( s1 == *e || !is_usable( s1, y ) )
+            {
+              continue;
+            }
+            for ( auto k = 0u; k < base.num_blocks(); ++k )
+            {
+              sum2[k] = sum[k] ^ base.row( s1 )[k];
+            }
+            if ( const auto s2 = find_base_element( sum2, [&]( auto s ) { return s != *e && s != s1 && is_usable( s, y ); } ); s2 )
+            {
+              set_members( y, {*e, s1, *s2} );
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    update_live_and_best();
+  }
+
+  uint32_t add_base_element()
+  {
+    base.add_row();
+    footprints.add_row();
+    occurrences.add_row();
+    best.emplace_back( 0u, 0u );
+    is_live.push_back( 0u );
+    is_dirty.push_back( 0u );
+    return base.num_rows() - 1u;
+  }
+
+  template<typename Fn>
+  std::optional<uint32_t> find_base_element( uint64_t const* value, Fn&& fn ) const
+  {
+    const auto [begin, end] = base_lookup.equal_range( hash_row( value ) );
+    for ( auto it = begin; it != end; ++it )
+    {
+      if ( std::equal( value, value + base.num_blocks(), base.row( it->second ) ) && fn( it->second ) )
+      {
+        return it->second;
+      }
     }
+    return std::nullopt;
   }
 
-  void remove_all_pairs( index_pair_t const& p )
+  /* base element `s` does not depend on an input that target `y` must ignore */
+  bool is_usable( uint32_t s, uint32_t y ) const
   {
-    auto it = pair_to_occurrance.find( p );
-    const auto occ = it->second;
-    pair_to_occurrance.erase( it );
-    occurrance_to_pairs[occ - 1u].erase( p );
-    while ( !occurrance_to_pairs.empty() && occurrance_to_pairs.back().empty() )
+    return !has_ignore || is_const0_words( tt_layout{base.num_blocks(), ~UINT64_C( 0 )}, []( auto a, auto b ) { return a & b; }, tt_ref{footprints.row( s )}, tt_ref{ignore.row( y )} );
+  }
+
+  uint64_t hash_row( uint64_t const* words ) const
+  {
+    uint64_t h{0x9e3779b97f4a7c15};
+    for ( auto k = 0u; k < base.num_blocks(); ++k )
     {
-      occurrance_to_pairs.pop_back();
+      h = ( h ^ words[k] ) * UINT64_C( 0xff51afd7ed558ccd );
+      h ^= h >> 32u;
     }
-    pairs_to_output.erase( p );
+    return h;
   }
 
-  void remove_one_pair( index_pair_t const& p, uint32_t output )
+  void toggle_member( uint32_t y, uint32_t s )
   {
-    auto it = pair_to_occurrance.find( p );
-    const auto occ = it->second;
-    occurrance_to_pairs[occ - 1u].erase( p );
-    if ( occ > 1u )
+    auto& ms = members[y];
+    if ( occurrences.get( s, y ) )
+    {
+      ms.erase( std::find( ms.begin(), ms.end(), s ) );
+    }
+    else
     {
-      occurrance_to_pairs[occ - 2u].insert( p );
+      ms.push_back( s );
     }
-    it->second--;
-    pairs_to_output[p].erase( std::remove( pairs_to_output[p].begin(), pairs_to_output[p].end(), output ), pairs_to_output[p].end() );
+    occurrences.flip( s, y );
   }
 
-  void replace_one_pair( index_pair_t const& p )
+  void set_members( uint32_t y, std::vector<uint32_t> const& ms )
   {
-    const auto [a, b] = p;
-    auto c = static_cast<uint32_t>( signals.size() );
-    signals.push_back( dest.create_xor( signals[a], signals[b] ) );
+    for ( auto s : members[y] )
+    {
+      occurrences.set( s, y, false );
+      mark_dirty( s );
+    }
+    members[y] = ms;
+    for ( auto s : ms )
+    {
+      occurrences.set( s, y );
+      mark_dirty( s );
+    }
+  }
 
-    /* update data structures */
-    for ( auto o : pairs_to_output[p] )
+  void mark_dirty( uint32_t s )
+  {
+    if ( !is_dirty[s] )
     {
-      auto& leq = linear_equations[o];
-      leq.erase( std::remove( leq.begin(), leq.end(), a ), leq.end() );
-      leq.erase( std::remove( leq.begin(), leq.end(), b ), leq.end() );
-      for ( auto i : leq )
+      is_dirty[s] = 1u;
+      dirty.push_back( s );
+    }
+  }
+
+  /* most frequent pair of a live element with another live element */
+  void update_best( uint32_t i )
+  {
+    best[i] = {0u, i};
+    for ( auto j : live )
+    {
+      if ( j == i )
+      {
+        continue;
+      }
+      if ( const auto count = occurrences.count_common( i, j ); count > best[i].first )
       {
-        remove_one_pair( {std::min( i, a ), std::max( i, a )}, o );
-        remove_one_pair( {std::min( i, b ), std::max( i, b )}, o );
-        add_pair( {i, c} );
-        pairs_to_output[{i, c}].push_back( o );
+        best[i] = {count, j};
       }
-      leq.push_back( c );
     }
-    remove_all_pairs( p );
   }
 
-  void print_linear_matrix()
+  /* the occurrences of only the dirty elements have changed */
+  void update_live_and_best()
   {
-    for ( auto const& le : linear_equations )
+    for ( auto d : dirty )
+    {
+      const auto now_live = occurrences.count_ones( d ) >= 2u;
+      if ( now_live && !is_live[d] )
+      {
+        live.push_back( d );
+      }
+      is_live[d] = now_live ? 1u : 0u;
+    }
+    live.erase( std::remove_if( live.begin(), live.end(), [&]( auto i ) { return !is_live[i]; } ), live.end() );
+
+    for ( auto i : live )
     {
-      auto it = le.begin();
-      for ( auto i = 0u; i < signals.size(); ++i )
+      if ( is_dirty[i] )
       {
-        if ( it != le.end() && *it == i )
+        update_best( i );
+        continue;
+      }
+      if ( const auto p = best[i].second; p != i && is_dirty[p] && ( !is_live[p] || occurrences.count_common( i, p ) < best[i].first ) )
+      {
+        update_best( i );
+        continue;
+      }
+      for ( auto d : dirty )
+      {
+        if ( !is_live[d] )
         {
-          std::cout << " 1";
-          it++;
+          continue;
         }
-        else
+        if ( const auto count = occurrences.count_common( i, d ); count > best[i].first )
         {
-          std::cout << " 0";
+          best[i] = {count, d};
         }
       }
-      assert( it == le.end() );
-      std::cout << "\n";
     }
+
+    for ( auto d : dirty )
+    {
+      is_dirty[d] = 0u;
+    }
+    dirty.clear();
   }
 
 private:
-  Ntk const& xag;
-  Ntk dest;
-  std::vector<signal<Ntk>> signals;
-  std::vector<std::vector<uint32_t>> linear_equations;
-  std::vector<std::unordered_set<index_pair_t, pair_hash>> occurrance_to_pairs;
-  std::unordered_map<index_pair_t, uint32_t, pair_hash> pair_to_occurrance;
-  std::unordered_map<index_pair_t, std::vector<uint32_t>, pair_hash> pairs_to_output;
+  gf2_matrix const& targets;
+  gf2_matrix const& ignore;
+  bool has_ignore;
+
+  /* values and used inputs of the base elements */
+  gf2_matrix base;
+  gf2_matrix footprints;
+  std::unordered_multimap<uint64_t, uint32_t> base_lookup;
+
+  /* decomposition of each target into base elements, row i of `occurrences`
+   * contains the targets whose decomposition contains base element i */
+  gf2_matrix occurrences;
+  std::vector<std::vector<uint32_t>> members;
+
+  std::vector<uint32_t> live;
+  std::vector<uint8_t> is_live;
+  std::vector<std::pair<uint32_t, uint32_t>> best;
+  std::vector<uint32_t> dirty;
+  std::vector<uint8_t> is_dirty;
+
+  std::vector<uint64_t> scratch;
+  std::vector<uint64_t> scratch2;
+  uint32_t max_base_size;
+  std::mt19937 rng;
+  bool randomize;
+  linear_program program;
 };
 
 } // namespace detail
 
-/*! \brief Linear circuit resynthesis (Paar's algorithm)
+/*! \brief Linear circuit resynthesis (Boyar-Peralta heuristic)
  *
  * This algorithm works on an XAG that is only composed of XOR gates.  It
- * extracts a matrix representation of the linear output equations and
- * resynthesizes them in a greedy manner by always substituting the most
- * frequent pair of variables using the computed function of an XOR gate.
+ * extracts the linear output equations and keeps a base of computed signals,
+ * which initially contains the inputs, and a distance for each output, which
+ * is the number of XOR gates needed to compute the output from the base.  In
+ * each step, the XOR of two base signals that reduces the sum of distances
+ * the most is added to the base, and ties are broken by the largest norm of
+ * the new distance vector.  An output at distance 1 is always computed
+ * first.
  *
- * Reference: [C. Paar, IEEE Int'l Symp. on Inf. Theo. (1997), page 250]
+ * The distances are upper bounds that are derived from a decomposition of
+ * each output into base signals.  Besides the pairs in the decomposition,
+ * a new base signal can also reduce the distance of an output if the output
+ * is the XOR of the new signal and one existing signal (or two for small
+ * bases, see `ps.max_search_size`).  Therefore,
+ * the resulting circuit is not necessarily cancellation-free, and
+ * `ps.ignore_inputs` should be used if the circuit is merged back into an
+ * XAG with `merge_linear_circuit`.
+ *
+ * Several runs with random tie-breaking can be performed in parallel, and
+ * the circuit of the run with the fewest XOR gates is returned.  The first
+ * run breaks ties deterministically.
+ *
+ * Reference: [J. Boyar and R. Peralta, SEA (2010), page 178-189]
  */
 template<typename Ntk>
-Ntk linear_resynthesis_paar( Ntk const& xag )
+Ntk linear_resynthesis_boyar_peralta( Ntk const& xag, linear_resynthesis_boyar_peralta_params const& ps = {}, linear_resynthesis_boyar_peralta_stats* pst = nullptr )
 {
   static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
 
-  return detail::linear_resynthesis_paar_impl<Ntk>( xag ).run();
+  linear_resynthesis_boyar_peralta_stats st;
+  Ntk dest;
+  {
+    stopwatch<> t( st.time_total );
+
+    const auto targets = detail::linear_gf2_simulation( xag );
+    gf2_matrix ignore;
+    if ( std::any_of( ps.ignore_inputs.begin(), ps.ignore_inputs.end(), []( auto const& is ) { return !is.empty(); } ) )
+    {
+      /* check whether ignore inputs matches matrix size */
+      if ( ps.ignore_inputs.size() != targets.num_rows() )
+      {
+        fmt::print( "[e] size of ignored inputs vector must match number of rows in linear matrix" );
+        std::abort();
+      }
+      ignore = gf2_matrix( targets.num_rows(), targets.num_columns() );
+      for ( auto y = 0u; y < ps.ignore_inputs.size(); ++y )
+      {
+        for ( auto i : ps.ignore_inputs[y] )
+        {
+          ignore.set( y, i );
+        }
+      }
+    }
+
+    const auto num_restarts = std::max( 1u, ps.num_restarts );
+    const auto num_threads = std::min( num_restarts, ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads );
+    std::vector<detail::linear_program> programs( num_restarts );
+    std::atomic<uint32_t> next{0u};
+    const auto worker = [&]() {
+      while ( true )
+      {
+        const auto r = next++;
+        if ( r >= num_restarts )
+        {
+          return;
+        }
+        programs[r] = detail::boyar_peralta_run( targets, ignore, ps.max_search_size, ps.seed + r, r > 0u ).run();
+      }
+    };
+
+    if ( num_threads <= 1u )
+    {
+      worker();
+    }
+    else
+    {
+      std::vector<std::thread> threads;
+      for ( auto i = 0u; i < num_threads; ++i )
+      {
+        threads.emplace_back( worker );
+      }
+      for ( auto& thread : threads )
+      {
+        thread.join();
+      }
+    }
+
+    for ( auto r = 1u; r < num_restarts; ++r )
+    {
+      if ( programs[r].steps.size() < programs[st.best_restart].steps.size() )
+      {
+        st.best_restart = r;
+      }
+    }
+    auto const& program = programs[st.best_restart];
+
+    std::vector<signal<Ntk>> signals;
+    xag.foreach_pi( [&]( auto const& ) {
+      signals.push_back( dest.create_pi() );
+    } );
+    for ( auto const& [a, b] : program.steps )
+    {
+      signals.push_back( dest.create_xor( signals[a], signals[b] ) );
+    }
+    xag.foreach_po( [&]( auto const& f, auto i ) {
+      const auto s = program.outputs[i];
+      dest.create_po( ( s == detail::linear_program::constant ? dest.get_constant( false ) : signals[s] ) ^ xag.is_complemented( f ) );
+    } );
+    st.num_xors = static_cast<uint32_t>( program.steps.size() );
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return dest;
 }
 
 struct exact_linear_synthesis_params
@@ -953,8 +1599,7 @@ std::vector<std::vector<bool>> get_linear_matrix( Ntk const& ntk )
 {
   static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
 
-  detail::linear_matrix_simulator sim( ntk.num_pis() );
-  return simulate<std::vector<bool>>( detail::linear_xag{ntk}, sim );
+  return detail::linear_gf2_simulation( ntk ).to_bool_matrix();
 }
 
 /*! \brief Optimum linear circuit synthesis (based on SAT)
@@ -157,6 +157,12 @@ public:
     derive_mapping();
   }
 
+  /* cut database, the best cut of each node is in front after `run` */
+  network_cuts_t& cut_database()
+  {
+    return cuts;
+  }
+
 private:
   uint32_t cut_area( cut_t const& cut ) const
   {
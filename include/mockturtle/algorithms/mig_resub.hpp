@@ -131,11 +131,14 @@ public:
     std::vector<signal> u1;
     std::vector<signal> next_candidates;
 
-    void clear()
+    divisor_batch<2u> batch;
+
+    void clear( tt_layout const& layout )
     {
       u0.clear();
       u1.clear();
       next_candidates.clear();
+      batch.reset( layout );
     }
   };
 
@@ -145,11 +148,14 @@ public:
     std::vector<signal> b1;
     std::vector<signal> b2;
 
-    void clear()
+    divisor_batch<3u> batch;
+
+    void clear( tt_layout const& layout )
     {
       b0.clear();
       b1.clear();
       b2.clear();
+      batch.reset( layout );
     }
   };
 
@@ -255,12 +261,13 @@ public:
   std::optional<signal> resub_div0( node const& root, uint32_t required ) const
   {
     (void)required;
-    auto const tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const layout = sim.get_tt_layout();
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
     for ( auto i = 0u; i < num_divs; ++i )
     {
       auto const d = divs.at( i );
 
-      if ( tt != sim.get_tt( ntk.make_signal( d ) ) )
+      if ( !is_const0_words( layout, []( auto a, auto b ) { return a ^ b; }, tt, sim.get_tt_ref( ntk.make_signal( d ) ) ) )
         continue; /* next */
 
       return ( sim.get_phase( d ) ^ sim.get_phase( root ) ) ? !ntk.make_signal( d ) : ntk.make_signal( d );
@@ -352,43 +359,48 @@ public:
 
   void collect_unate_divisors( node const& root, uint32_t required )
   {
-    udivs.clear();
+    auto const layout = sim.get_tt_layout();
+    udivs.clear( layout );
 
-    auto const& tt = sim.get_tt( ntk.make_signal( root ) );
-    auto const& one = sim.get_tt( ntk.get_constant( true ) );
+    /* Boolean filtering rule for MAJ-3: MAJ( a, b, tt ) == tt */
+    auto const filter = []( auto t, auto a, auto b ) { return ( ( a & b ) | ( a & t ) | ( b & t ) ) ^ t; };
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
+    auto const one = sim.get_tt_ref( ntk.get_constant( true ) );
     for ( auto i = 0u; i < num_divs; ++i )
     {
       auto const d0 = divs.at( i );
       if ( ntk.level( d0 ) > required - 1 )
         continue;
-      auto const& tt_s0 = sim.get_tt( ntk.make_signal( d0 ) );
+      auto const tt_s0 = sim.get_tt_ref( ntk.make_signal( d0 ) );
 
       for ( auto j = i + 1; j < num_divs; ++j )
       {
         auto const d1 = divs.at( j );
         if ( ntk.level( d1 ) > required - 1 )
           continue;
-        auto const& tt_s1 = sim.get_tt( ntk.make_signal( d1 ) );
+        auto const tt_s1 = sim.get_tt_ref( ntk.make_signal( d1 ) );
 
-        /* Boolean filtering rule for MAJ-3 */
-        if ( kitty::ternary_majority( tt_s0, tt_s1, tt ) == tt )
+        if ( is_const0_words( layout, filter, tt, tt_s0, tt_s1 ) )
         {
           udivs.u0.emplace_back( ntk.make_signal( d0 ) );
           udivs.u1.emplace_back( ntk.make_signal( d1 ) );
+          udivs.batch.add( tt_s0, tt_s1 );
           continue;
         }
 
-        if ( kitty::ternary_majority( ~tt_s0, tt_s1, tt ) == tt )
+        if ( is_const0_words( layout, filter, tt, ~tt_s0, tt_s1 ) )
         {
           udivs.u0.emplace_back( !ntk.make_signal( d0 ) );
           udivs.u1.emplace_back( ntk.make_signal( d1 ) );
+          udivs.batch.add( ~tt_s0, tt_s1 );
           continue;
         }
 
-        if ( kitty::ternary_majority( tt_s0, ~tt_s1, tt ) == tt )
+        if ( is_const0_words( layout, filter, tt, tt_s0, ~tt_s1 ) )
         {
           udivs.u0.emplace_back( ntk.make_signal( d0 ) );
           udivs.u1.emplace_back( !ntk.make_signal( d1 ) );
+          udivs.batch.add( tt_s0, ~tt_s1 );
           continue;
         }
 
@@ -398,24 +410,27 @@ public:
 
       if constexpr ( use_constant ) /* allowing "not real" MAJ gates (one fanin is constant) */
       {
-        if ( kitty::ternary_majority( tt_s0, one, tt ) == tt )
+        if ( is_const0_words( layout, filter, tt, tt_s0, one ) )
         {
           udivs.u0.emplace_back( ntk.make_signal( d0 ) );
           udivs.u1.emplace_back( ntk.get_constant( true ) );
+          udivs.batch.add( tt_s0, one );
           continue;
         }
 
-        if ( kitty::ternary_majority( ~tt_s0, one, tt ) == tt )
+        if ( is_const0_words( layout, filter, tt, ~tt_s0, one ) )
         {
           udivs.u0.emplace_back( !ntk.make_signal( d0 ) );
           udivs.u1.emplace_back( ntk.get_constant( true ) );
+          udivs.batch.add( ~tt_s0, one );
           continue;
         }
 
-        if ( kitty::ternary_majority( tt_s0, ~one, tt ) == tt )
+        if ( is_const0_words( layout, filter, tt, tt_s0, ~one ) )
         {
           udivs.u0.emplace_back( ntk.make_signal( d0 ) );
           udivs.u1.emplace_back( ntk.get_constant( false ) );
+          udivs.batch.add( tt_s0, ~one );
           continue;
         }
       }
@@ -433,21 +448,23 @@ public:
   std::optional<signal> resub_div1( node const& root, uint32_t required )
   {
     (void)required;
-    auto const& tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
 
+    /* the third fanin is either the first or the second divisor of another unate pair */
+    auto const maj_first = []( auto t, auto a, auto b, auto c, auto d ) { (void)d; return ( ( a & b ) | ( a & c ) | ( b & c ) ) ^ t; };
+    auto const maj_second = []( auto t, auto a, auto b, auto c, auto d ) { (void)c; return ( ( a & b ) | ( a & d ) | ( b & d ) ) ^ t; };
+
+    auto const& batch = udivs.batch;
     for ( auto i = 0u; i < udivs.u0.size(); ++i )
     {
       auto const s0 = udivs.u0.at( i );
       auto const s1 = udivs.u1.at( i );
-      auto const& tt_s0 = sim.get_tt( s0 );
-      auto const& tt_s1 = sim.get_tt( s1 );
 
       for ( auto j = i + 1; j < udivs.u0.size(); ++j )
       {
         auto s2 = udivs.u0.at( j );
-        auto tt_s2 = sim.get_tt( s2 );
 
-        if ( kitty::ternary_majority( tt_s0, tt_s1, tt_s2 ) == tt )
+        if ( batch.test( j, maj_first, tt, batch[i][0], batch[i][1] ) )
         {
           auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
           auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
@@ -456,9 +473,8 @@ public:
         }
 
         s2 = udivs.u1.at( j );
-        tt_s2 = sim.get_tt( s2 );
 
-        if ( kitty::ternary_majority( tt_s0, tt_s1, tt_s2 ) == tt )
+        if ( batch.test( j, maj_second, tt, batch[i][0], batch[i][1] ) )
         {
           auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
           auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
@@ -473,16 +489,19 @@ public:
 
   void collect_binate_divisors( node const& root, uint32_t required )
   {
-    bdivs.clear();
+    auto const layout = sim.get_tt_layout();
+    bdivs.clear( layout );
 
-    auto const& tt = sim.get_tt( ntk.make_signal( root ) );
+    /* Note: the implication relation is actually not necessary for majority; this is an over-filtering */
+    auto const implies = []( auto t, auto a, auto b, auto c ) { return ( ( a & b ) | ( a & c ) | ( b & c ) ) & ~t; };
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
     for ( auto i = 0u; i < udivs.next_candidates.size(); ++i )
     {
       auto const& s0 = udivs.next_candidates.at( i );
       if ( ntk.level( ntk.get_node( s0 ) ) > required - 2 )
         continue;
 
-      auto const& tt_s0 = sim.get_tt( s0 );
+      auto const tt_s0 = sim.get_tt_ref( s0 );
 
       for ( auto j = i + 1; j < udivs.next_candidates.size(); ++j )
       {
@@ -490,7 +509,7 @@ public:
         if ( ntk.level( ntk.get_node( s1 ) ) > required - 2 )
           continue;
 
-        auto const& tt_s1 = sim.get_tt( s1 );
+        auto const tt_s1 = sim.get_tt_ref( s1 );
 
         for ( auto k = j + 1; k < udivs.next_candidates.size(); ++k )
         {
@@ -498,71 +517,22 @@ public:
           if ( ntk.level( ntk.get_node( s2 ) ) > required - 2 )
             continue;
 
-          auto const& tt_s2 = sim.get_tt( s2 );
-
-          /* Note: the implication relation is actually not necessary for majority; this is an over-filtering */
-          if ( kitty::implies( kitty::ternary_majority( tt_s0, tt_s1, tt_s2 ), tt ) )
-          {
-            bdivs.b0.emplace_back(  s0 );
-            bdivs.b1.emplace_back(  s1 );
-            bdivs.b2.emplace_back(  s2 );
-            continue;
-          }
-
-          if ( kitty::implies( kitty::ternary_majority( ~tt_s0, tt_s1, tt_s2 ), tt ) )
-          {
-            bdivs.b0.emplace_back( !s0 );
-            bdivs.b1.emplace_back(  s1 );
-            bdivs.b2.emplace_back(  s2 );
-            continue;
-          }
-
-          if ( kitty::implies( kitty::ternary_majority( tt_s0, ~tt_s1, tt_s2 ), tt ) )
-          {
-            bdivs.b0.emplace_back(  s0 );
-            bdivs.b1.emplace_back( !s1 );
-            bdivs.b2.emplace_back(  s2 );
-            continue;
-          }
-
-          if ( kitty::implies( kitty::ternary_majority( tt_s0, tt_s1, ~tt_s2 ), tt ) )
-          {
-            bdivs.b0.emplace_back(  s0 );
-            bdivs.b1.emplace_back(  s1 );
-            bdivs.b2.emplace_back( !s2 );
-            continue;
-          }
-
-          if ( kitty::implies( kitty::ternary_majority( ~tt_s0, ~tt_s1, tt_s2 ), tt ) )
-          {
-            bdivs.b0.emplace_back( !s0 );
-            bdivs.b1.emplace_back( !s1 );
-            bdivs.b2.emplace_back(  s2 );
-            continue;
-          }
-
-          if ( kitty::implies( kitty::ternary_majority( tt_s0, ~tt_s1, ~tt_s2 ), tt ) )
-          {
-            bdivs.b0.emplace_back(  s0 );
-            bdivs.b1.emplace_back( !s1 );
-            bdivs.b2.emplace_back( !s2 );
-            continue;
-          }
+          auto const tt_s2 = sim.get_tt_ref( s2 );
 
-          if ( kitty::implies( kitty::ternary_majority( ~tt_s0, tt_s1, ~tt_s2 ), tt ) )
+          /* try all polarities, in the order 000, 100, 010, 001, 110, 011, 101, 111 */
+          for ( auto const polarity : {0u, 1u, 2u, 4u, 3u, 6u, 5u, 7u} )
           {
-            bdivs.b0.emplace_back( !s0 );
-            bdivs.b1.emplace_back(  s1 );
-            bdivs.b2.emplace_back( !s2 );
-            continue;
-          }
-
-          if ( kitty::implies( kitty::ternary_majority( ~tt_s0, ~tt_s1, ~tt_s2 ), tt ) )
-          {
-            bdivs.b0.emplace_back( !s0 );
-            bdivs.b1.emplace_back( !s1 );
-            bdivs.b2.emplace_back( !s2 );
-            continue;
+            auto const t0 = ( polarity & 1u ) ? ~tt_s0 : tt_s0;
+            auto const t1 = ( polarity & 2u ) ? ~tt_s1 : tt_s1;
+            auto const t2 = ( polarity & 4u ) ? ~tt_s2 : tt_s2;
+            if ( is_const0_words( layout, implies, tt, t0, t1, t2 ) )
+            {
+              bdivs.b0.emplace_back( ( polarity & 1u ) ? !s0 : s0 );
+              bdivs.b1.emplace_back( ( polarity & 2u ) ? !s1 : s1 );
+              bdivs.b2.emplace_back( ( polarity & 4u ) ? !s2 : s2 );
+              bdivs.batch.add( t0, t1, t2 );
+              break;
+            }
           }
         }
       }
@@ -572,18 +542,21 @@ public:
   std::optional<signal> resub_div2( node const& root, uint32_t required )
   {
     (void)required;
-    auto const& tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
+    auto const maj_maj = []( auto t, auto a, auto b, auto c, auto d, auto e ) {
+      auto const m = ( c & d ) | ( c & e ) | ( d & e );
+      return ( ( a & b ) | ( a & m ) | ( b & m ) ) ^ t;
+    };
 
     for ( auto i = 0u; i < udivs.u0.size(); ++i )
     {
-      auto const& s0 = udivs.u0.at( i );
-      auto const& s1 = udivs.u1.at( i );
-
-      for ( auto j = 0u; j < bdivs.b0.size(); ++j )
+      if ( auto const j = bdivs.batch.find( 0u, maj_maj, tt, udivs.batch[i][0], udivs.batch[i][1] ) )
       {
-        auto const& s2 = bdivs.b0.at( j );
-        auto const& s3 = bdivs.b1.at( j );
-        auto const& s4 = bdivs.b2.at( j );
+        auto const& s0 = udivs.u0.at( i );
+        auto const& s1 = udivs.u1.at( i );
+        auto const& s2 = bdivs.b0.at( *j );
+        auto const& s3 = bdivs.b1.at( *j );
+        auto const& s4 = bdivs.b2.at( *j );
 
         auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
         auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
@@ -591,18 +564,9 @@ public:
         auto const d = sim.get_phase( ntk.get_node( s3 ) ) ? !s3 : s3;
         auto const e = sim.get_phase( ntk.get_node( s4 ) ) ? !s4 : s4;
 
-        auto const& tt_s0 = sim.get_tt( s0 );
-        auto const& tt_s1 = sim.get_tt( s1 );
-        auto const& tt_s2 = sim.get_tt( s2 );
-        auto const& tt_s3 = sim.get_tt( s3 );
-        auto const& tt_s4 = sim.get_tt( s4 );
-
-        if ( kitty::ternary_majority( tt_s0, tt_s1, kitty::ternary_majority( tt_s2, tt_s3, tt_s4 ) ) == tt )
-        {
-          return sim.get_phase( root ) ?
-            !ntk.create_maj( a, b, ntk.create_maj( c, d, e ) ) :
-             ntk.create_maj( a, b, ntk.create_maj( c, d, e ) );
-        }
+        return sim.get_phase( root ) ?
+          !ntk.create_maj( a, b, ntk.create_maj( c, d, e ) ) :
+           ntk.create_maj( a, b, ntk.create_maj( c, d, e ) );
       }
     }
 
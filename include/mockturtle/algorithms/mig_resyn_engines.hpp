@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../utils/divisor_kernels.hpp"
 #include "../utils/index_list.hpp"
 
 #include <kitty/kitty.hpp>
@@ -71,11 +72,20 @@ public:
 
   std::optional<mig_index_list> compute_function( uint32_t num_inserts )
   {
+    /* the divisors do not change from here on */
+    batch.reset( make_tt_layout( divisors.at( 0u ) ) );
+    num_ones.clear();
+    for ( auto const& d : divisors )
+    {
+      batch.add( make_tt_ref( d ) );
+      num_ones.emplace_back( batch.count_ones( batch.size() - 1u, []( auto a ) { return a; } ) );
+    }
+
     uint64_t max_score = 0u;
     max_i = 0u;
     for ( auto i = 0u; i < divisors.size(); ++i )
     {
-      uint32_t score = kitty::count_ones( divisors.at( i ) );
+      uint32_t score = num_ones[i];
       if ( score > max_score )
       {
         max_score = score;
@@ -118,11 +128,10 @@ private:
     /* the second fanin: 2 * #newly-covered-bits + 1 * #cover-again-bits */
     uint64_t max_score = 0u;
     max_j = 0u;
-    auto const not_covered_by_i = ~function_i;
+    auto const tt_i = make_tt_ref( function_i );
     for ( auto j = 0u; j < divisors.size(); ++j )
     {
-      auto const covered_by_j = divisors.at( j );
-      uint32_t score = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      uint32_t score = num_ones[j] + batch.count_ones( j, []( auto covered_by_i, auto covered_by_j ) { return covered_by_j & ~covered_by_i; }, tt_i );
       if ( score > max_score && (j >> 1) != (max_i >> 1) )
       {
         max_score = score;
@@ -134,10 +143,10 @@ private:
     /* the third fanin: only care about the disagreed bits */
     max_score = 0u;
     max_k = 0u;
-    auto const disagree_in_ij = function_i ^ divisors.at( max_j );
+    auto const tt_j = batch[max_j][0];
     for ( auto k = 0u; k < divisors.size(); ++k )
-    {      
-      uint32_t score = kitty::count_ones( divisors.at( k ) & disagree_in_ij );
+    {
+      uint32_t score = batch.count_ones( k, []( auto fi, auto fj, auto fk ) { return fk & ( fi ^ fj ); }, tt_i, tt_j );
       if ( score > max_score && (k >> 1) != (max_i >> 1) && (k >> 1) != (max_j >> 1) )
       {
         max_score = score;
@@ -175,6 +184,9 @@ private:
 
   std::vector<TT> divisors;
   mig_index_list index_list;
+
+  divisor_batch<1u> batch;
+  std::vector<uint32_t> num_ones;
 }; /* mig_resyn_engine_bottom_up */
 
 template<class TT>
@@ -32,21 +32,32 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cstdint>
-#if __GNUC__ == 7
-#include <experimental/filesystem>
-#else
-#include <filesystem>
-#endif
+#include <cstdio>
 #include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
 #include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/hash.hpp>
 #include <nlohmann/json.hpp>
+#include <parallel_hashmap/phmap.h>
 
 #include "traits.hpp"
 #include "../../traits.hpp"
 #include "../../algorithms/cleanup.hpp"
+#include "../../utils/append_log.hpp"
 #include "../../utils/json_utils.hpp"
 #include "../../utils/network_cache.hpp"
 
@@ -74,31 +85,176 @@ void from_json( nlohmann::json const& j, no_blacklist_cache_info& info )
   (void)info;
 }
 
+namespace detail
+{
+
+template<class T, class = void>
+struct has_from_json : std::false_type
+{
+};
+
+template<class T>
+struct has_from_json<T, std::void_t<decltype( from_json( std::declval<nlohmann::json const&>(), std::declval<T&>() ) )>> : std::true_type
+{
+};
+
+/* creates a gate from its function as returned by `node_function` */
+template<class Ntk>
+std::optional<signal<Ntk>> create_gate_from_function( Ntk& ntk, std::vector<signal<Ntk>> const& children, kitty::dynamic_truth_table const& function )
+{
+  if constexpr ( has_create_node_v<Ntk> )
+  {
+    return ntk.create_node( children, function );
+  }
+  else
+  {
+    auto const bits = function.num_vars() == children.size() ? function._bits[0] : 0u;
+    if constexpr ( has_create_and_v<Ntk> )
+    {
+      if ( children.size() == 2u && bits == 0x8 )
+      {
+        return ntk.create_and( children[0], children[1] );
+      }
+    }
+    if constexpr ( has_create_xor_v<Ntk> )
+    {
+      if ( children.size() == 2u && bits == 0x6 )
+      {
+        return ntk.create_xor( children[0], children[1] );
+      }
+    }
+    if constexpr ( has_create_maj_v<Ntk> )
+    {
+      if ( children.size() == 3u && bits == 0xe8 )
+      {
+        return ntk.create_maj( children[0], children[1], children[2] );
+      }
+    }
+    if constexpr ( has_create_xor3_v<Ntk> )
+    {
+      if ( children.size() == 3u && bits == 0x96 )
+      {
+        return ntk.create_xor3( children[0], children[1], children[2] );
+      }
+    }
+    return std::nullopt;
+  }
+}
+
+/* copies the single-output network `entry` into `ntk` without modifying `entry`
+ *
+ * Nodes of `entry` must be in topological order, which holds for networks
+ * constructed with `cleanup_dangling`.  In contrast to `cleanup_dangling`,
+ * this function does not use traversal IDs and can therefore be called by
+ * several threads on the same `entry`.
+ */
+template<class Ntk, class LeavesIterator>
+signal<Ntk> insert_cached_network( Ntk const& entry, Ntk& ntk, LeavesIterator begin )
+{
+  std::vector<signal<Ntk>> old2new( entry.size() );
+  old2new[entry.node_to_index( entry.get_node( entry.get_constant( false ) ) )] = ntk.get_constant( false );
+  if ( entry.get_node( entry.get_constant( true ) ) != entry.get_node( entry.get_constant( false ) ) )
+  {
+    old2new[entry.node_to_index( entry.get_node( entry.get_constant( true ) ) )] = ntk.get_constant( true );
+  }
+  entry.foreach_pi( [&]( auto const& n ) {
+    old2new[entry.node_to_index( n )] = *begin++;
+  } );
+
+  std::vector<signal<Ntk>> children;
+  entry.foreach_gate( [&]( auto const& n ) {
+    children.clear();
+    entry.foreach_fanin( n, [&]( auto const& f ) {
+      auto const s = old2new[entry.node_to_index( entry.get_node( f ) )];
+      children.push_back( entry.is_complemented( f ) ? ntk.create_not( s ) : s );
+    } );
+    old2new[entry.node_to_index( n )] = ntk.clone_node( entry, n, children );
+  } );
+
+  signal<Ntk> output = ntk.get_constant( false );
+  entry.foreach_po( [&]( auto const& f ) {
+    auto const s = old2new[entry.node_to_index( entry.get_node( f ) )];
+    output = entry.is_complemented( f ) ? ntk.create_not( s ) : s;
+  } );
+  return output;
+}
+
+} /* namespace detail */
+
+/*! \brief Resynthesis function with a cache.
+ *
+ * This resynthesis function wraps another resynthesis function and
+ * stores the resulting network for each function, such that the wrapped
+ * function is invoked at most once per function.  Functions for which the
+ * wrapped function does not return a result are stored in a blacklist.
+ * `BlacklistCacheInfo` decides whether blacklisted functions are retried,
+ * e.g., with a larger conflict limit.
+ *
+ * The cache can be shared by several threads.  Each entry is stored as a
+ * separate immutable network in a sharded hash table; lookups take a
+ * shared lock on a single shard only and copy the entry into the target
+ * network without further synchronization.  Calls to the wrapped
+ * resynthesis function (on cache misses) are serialized.  Methods other
+ * than the call operator and `report` must not be called concurrently.
+ *
+ * If a cache file is given, the cache is stored in a binary append-only
+ * file (see `append_log`).  New entries are appended in batches, and
+ * several processes can work on the same file.  When the cache is
+ * destroyed, pending entries are written and outdated records (e.g.,
+ * blacklisted functions that were later retried) are removed from the
+ * file.  A JSON cache file of a previous version is imported once: its
+ * entries are converted into the binary format, and the JSON file is kept
+ * next to it with the suffix `.json.bak`.  Blacklisted functions are only
+ * imported if `BlacklistCacheInfo` has a `from_json` overload.  Files in
+ * other formats are neither read nor overwritten.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      exact_aig_resynthesis<xag_network> exact_resyn;
+      cached_resynthesis<xag_network, decltype( exact_resyn )> resyn( exact_resyn, 6u, "exact.cache" );
+      xag = cut_rewriting( xag, resyn );
+   \endverbatim
+ */
 template<class Ntk, class ResynthesisFn, class BlacklistCacheInfo = no_blacklist_cache_info>
 class cached_resynthesis
 {
 public:
   explicit cached_resynthesis( ResynthesisFn const& resyn_fn, uint32_t max_pis, std::string const& cache_filename = {}, BlacklistCacheInfo const& blacklist_cache_info = {} )
     : _resyn_fn( resyn_fn ),
-      _cache( max_pis ),
-      _cache_filename( cache_filename ),
       _blacklist_cache_info( blacklist_cache_info ),
       _initial_size( max_pis )
   {
-    if ( !_cache_filename.empty() )
+    static_assert( std::is_trivially_copyable_v<BlacklistCacheInfo>, "BlacklistCacheInfo must be trivially copyable" );
+    static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+
+    ensure_pis( _initial_size );
+
+    if ( !cache_filename.empty() )
     {
-      load();
+      _log = std::make_unique<append_log>( cache_filename, magic );
+      _log->read( [&]( std::string const& payload ) { load_record( payload ); } );
+      if ( !_log->good() )
+      {
+        import_json( cache_filename );
+      }
     }
   }
 
   ~cached_resynthesis()
   {
-    if ( !_cache_filename.empty() )
+    if ( _log && _log->good() )
     {
       save();
     }
   }
 
+  cached_resynthesis( cached_resynthesis const& ) = delete;
+  cached_resynthesis& operator=( cached_resynthesis const& ) = delete;
+
 private:
   using cache_key_t = std::pair<kitty::dynamic_truth_table, std::vector<kitty::dynamic_truth_table>>;
 
@@ -115,40 +271,28 @@ private:
     kitty::hash<kitty::dynamic_truth_table> _h;
   };
 
-  using blacklist_cache_key_t = std::pair<kitty::dynamic_truth_table, BlacklistCacheInfo>;
-
-  struct blacklist_cache_hash
-  {
-    std::size_t operator()( const blacklist_cache_key_t& p ) const
-    {
-      return _h( p.first );
-    }
-
-  private:
-    kitty::hash<kitty::dynamic_truth_table> _h;
-  };
+  /* 16 shards, each protected by a reader-writer lock */
+  using cache_map_t = phmap::parallel_flat_hash_map<cache_key_t, Ntk, cache_hash, std::equal_to<cache_key_t>, std::allocator<std::pair<const cache_key_t, Ntk>>, 4, std::shared_mutex>;
+  using blacklist_map_t = phmap::parallel_flat_hash_map<kitty::dynamic_truth_table, BlacklistCacheInfo, kitty::hash<kitty::dynamic_truth_table>, std::equal_to<kitty::dynamic_truth_table>,
+                                                        std::allocator<std::pair<const kitty::dynamic_truth_table, BlacklistCacheInfo>>, 4, std::shared_mutex>;
 
-  struct blacklist_cache_equal
-  {
-    bool operator()( const blacklist_cache_key_t& lhs, const blacklist_cache_key_t& rhs ) const
-    {
-      return lhs.first == rhs.first;
-    }
-  };
+  static constexpr uint32_t magic = 0x4352544d; /* "MTRC" */
+  static constexpr uint32_t flush_threshold = 64u;
 
   bool is_blacklisted( kitty::dynamic_truth_table const& tt )
   {
-    auto it = _blacklist_cache.find( {tt, _blacklist_cache_info} );
+    std::optional<BlacklistCacheInfo> info;
+    _blacklist_cache.if_contains( tt, [&]( auto const& v ) { info = v; } );
 
     /* function cannot be found in black list cache */
-    if ( it == _blacklist_cache.end() )
+    if ( !info )
     {
       return false;
     }
     /* newer black list info, erase old entry from cache */
-    else if ( _blacklist_cache_info.retry( it->second ) )
+    else if ( _blacklist_cache_info.retry( *info ) )
     {
-      _blacklist_cache.erase( it );
+      _blacklist_cache.erase( tt );
       return false;
     }
     /* function is black listed */
@@ -158,50 +302,64 @@ private:
     }
   }
 
+  std::optional<Ntk> find( cache_key_t const& key ) const
+  {
+    std::optional<Ntk> entry;
+    _cache.if_contains( key, [&]( auto const& v ) { entry = v; } );
+    return entry;
+  }
+
 public:
   template<typename LeavesIterator, typename Fn>
   void operator()( Ntk& ntk, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn )
   {
-    if ( auto const key = std::make_pair( function, _existing_functions );
-         _cache.has( key ) )
-    {
-      ++_cache_hits;
-      std::vector<signal<Ntk>> signals( _cache.pis().size(), ntk.get_constant( false ) );
+    auto const key = std::make_pair( function, _existing_functions );
+    auto const insert = [&]( Ntk const& entry ) {
+      std::vector<signal<Ntk>> signals( _pis.size(), ntk.get_constant( false ) );
       std::copy( begin, end, signals.begin() );
       std::copy( _existing_signals.begin(), _existing_signals.end(), signals.begin() + _initial_size );
-      fn( cleanup_dangling( _cache.get_view( key ), ntk, signals.begin(), signals.end() ).front() );
+      fn( detail::insert_cached_network( entry, ntk, signals.begin() ) );
+    };
+
+    if ( auto const entry = find( key ) )
+    {
+      ++_cache_hits;
+      insert( *entry );
+      return;
     }
     else if ( is_blacklisted( function ) )
     {
       ++_cache_hits;
       return; /* do nothing */
     }
-    else
-    {
-      bool found_one = false;
-      auto on_signal = [&]( signal<Ntk> const& f ) {
-        if ( !found_one )
-        {
-          ++_cache_misses;
-          _cache.insert_signal( key, f );
-          found_one = true;
-
-          std::vector<signal<Ntk>> signals( _cache.pis().size(), ntk.get_constant( false ) );
-          std::copy( begin, end, signals.begin() );
-          std::copy( _existing_signals.begin(), _existing_signals.end(), signals.begin() + _initial_size );
-          fn( cleanup_dangling( _cache.get_view( key ), ntk, signals.begin(), signals.end() ).front() );
-        }
-      };
 
-      _resyn_fn( _cache.network(), function, _cache.pis().begin(), _cache.pis().begin() + function.num_vars(), on_signal );
+    std::optional<Ntk> entry;
+    {
+      std::lock_guard<std::mutex> lock( _resyn_mutex );
 
-      if ( !found_one )
+      /* another thread may have resynthesized the function in the meantime */
+      if ( entry = find( key ); entry )
+      {
+        ++_cache_hits;
+      }
+      else if ( _blacklist_cache.contains( function ) )
       {
-        _blacklist_cache.insert( {function, _blacklist_cache_info} );
+        ++_cache_hits;
+        return;
       }
+      else
+      {
+        ++_cache_misses;
+        entry = resynthesize( key );
+      }
+    }
+
+    if ( entry )
+    {
+      insert( *entry );
     }
   }
-  
+
   void set_bounds( std::optional<uint32_t> const& lower_bound, std::optional<uint32_t> const& upper_bound )
   {
     if constexpr ( has_set_bounds_v<ResynthesisFn> )
@@ -229,16 +387,16 @@ public:
 
       _existing_signals.push_back( s );
       _existing_functions.push_back( tt );
-      _cache.ensure_pis( _initial_size + _existing_functions.size() );
+      ensure_pis( _initial_size + _existing_functions.size() );
 
-      _resyn_fn.add_function( _cache.pis()[pi_index], tt );
+      _resyn_fn.add_function( _pis[pi_index], tt );
     }
     else
     {
       // TODO assert or warn?
     }
   }
-    
+
   void report() const
   {
     fmt::print( "[i] cache hits              = {}\n", _cache_hits );
@@ -248,62 +406,409 @@ public:
   }
 
 private:
-  void load()
+  /* PIs of the networks passed to the resynthesis function; PI signals only depend on their creation order */
+  void ensure_pis( uint32_t count )
+  {
+    while ( _pis.size() < count )
+    {
+      _pis.emplace_back( _pi_template.create_pi() );
+    }
+  }
+
+  std::optional<Ntk> resynthesize( cache_key_t const& key )
+  {
+    auto const& function = key.first;
+
+    Ntk scratch;
+    std::vector<signal<Ntk>> pis( _pis.size() );
+    std::generate( pis.begin(), pis.end(), [&]() { return scratch.create_pi(); } );
+    assert( pis == _pis );
+
+    bool found_one = false;
+    _resyn_fn( scratch, function, pis.begin(), pis.begin() + function.num_vars(), [&]( signal<Ntk> const& f ) {
+      if ( !found_one )
+      {
+        scratch.create_po( f );
+        found_one = true;
+      }
+    } );
+
+    if ( !found_one )
+    {
+      _blacklist_cache.insert_or_assign( function, _blacklist_cache_info );
+      queue_record( encode_blacklist( function, _blacklist_cache_info ) );
+      return std::nullopt;
+    }
+
+    /* compact copy in topological order without dangling nodes */
+    Ntk entry;
+    std::vector<signal<Ntk>> entry_pis( _pis.size() );
+    std::generate( entry_pis.begin(), entry_pis.end(), [&]() { return entry.create_pi(); } );
+    entry.create_po( cleanup_dangling( scratch, entry, entry_pis.begin(), entry_pis.end() ).front() );
+
+    _cache.try_emplace( key, entry );
+    queue_record( encode_entry( key, entry ) );
+    return entry;
+  }
+
+  /* converts a JSON cache file of a previous version into the binary format */
+  void import_json( std::string const& filename )
   {
-    std::ifstream is( _cache_filename.c_str(), std::ifstream::in );
-    if ( !is.good() ) return;
     nlohmann::json data;
-    is >> data;
+    {
+      std::ifstream is( filename );
+      if ( is.peek() != '{' )
+      {
+        std::cerr << fmt::format( "[w] cache file {} has an unknown format and is not used", filename ) << std::endl;
+        return;
+      }
+      data = nlohmann::json::parse( is, nullptr, false );
+    }
+    if ( data.is_discarded() || data.count( "cache" ) == 0u || data.count( "initial_size" ) == 0u )
+    {
+      std::cerr << fmt::format( "[w] cache file {} has an unknown format and is not used", filename ) << std::endl;
+      return;
+    }
 
-    _cache.insert_json( data["cache"] );
-    data["blacklist_cache"].get_to( _blacklist_cache );
-    data["initial_size"].get_to( _initial_size );
+    /* the networks in JSON files are stored in Verilog */
+    if constexpr ( !( has_create_nand_v<Ntk> && has_create_or_v<Ntk> && has_create_xor_v<Ntk> && has_create_maj_v<Ntk> && has_create_xor3_v<Ntk> ) )
+    {
+      std::cerr << fmt::format( "[w] JSON cache file {} cannot be imported for this network type and is not used", filename ) << std::endl;
+      return;
+    }
+    else
+    {
+      import_json_data( filename, data );
+    }
   }
 
-  void save()
+  void import_json_data( std::string const& filename, nlohmann::json& data )
+  {
+    /* existing functions are stored after the first `initial_size` PIs */
+    auto const initial_size = data["initial_size"].get<uint32_t>();
+    network_cache<Ntk, cache_key_t, cache_hash> old_cache( 0u );
+    old_cache.insert_json( data["cache"] );
+    ensure_pis( static_cast<uint32_t>( old_cache.pis().size() ) );
+    for ( auto const& key : data["cache"]["output_functions"].get<std::vector<cache_key_t>>() )
+    {
+      if ( !key.second.empty() && initial_size != _initial_size )
+      {
+        continue;
+      }
+      Ntk entry;
+      std::vector<signal<Ntk>> entry_pis( old_cache.pis().size() );
+      std::generate( entry_pis.begin(), entry_pis.end(), [&]() { return entry.create_pi(); } );
+      entry.create_po( cleanup_dangling( old_cache.get_view( key ), entry, entry_pis.begin(), entry_pis.end() ).front() );
+      _cache.try_emplace( key, entry );
+    }
+    if constexpr ( detail::has_from_json<BlacklistCacheInfo>::value )
+    {
+      for ( auto const& [function, info] : data["blacklist_cache"].get<std::vector<std::pair<kitty::dynamic_truth_table, BlacklistCacheInfo>>>() )
+      {
+        _blacklist_cache.insert_or_assign( function, info );
+      }
+    }
+
+    /* keep the JSON file and write the imported entries into a new binary file */
+    if ( std::rename( filename.c_str(), ( filename + ".json.bak" ).c_str() ) != 0 )
+    {
+      std::cerr << fmt::format( "[w] cannot rename JSON cache file {}, imported entries are not saved", filename ) << std::endl;
+      return;
+    }
+    _log = std::make_unique<append_log>( filename, magic );
+    for ( auto const& [key, entry] : _cache )
+    {
+      _pending.push_back( encode_entry( key, entry ) );
+    }
+    for ( auto const& [function, info] : _blacklist_cache )
+    {
+      _pending.push_back( encode_blacklist( function, info ) );
+    }
+    flush();
+    std::cerr << fmt::format( "[i] imported JSON cache file {}, kept as {}.json.bak", filename, filename ) << std::endl;
+  }
+
+  /* binary records */
+  static void write_truth_table( std::string& buffer, kitty::dynamic_truth_table const& tt )
+  {
+    append_log::write_value( buffer, static_cast<uint8_t>( tt.num_vars() ) );
+    for ( auto const& word : tt )
+    {
+      append_log::write_value( buffer, word );
+    }
+  }
+
+  static bool read_truth_table( std::string const& buffer, std::size_t& pos, kitty::dynamic_truth_table& tt )
+  {
+    uint8_t num_vars{0};
+    if ( !append_log::read_value( buffer, pos, num_vars ) )
+    {
+      return false;
+    }
+    tt = kitty::dynamic_truth_table( num_vars );
+    for ( auto& word : tt )
+    {
+      if ( !append_log::read_value( buffer, pos, word ) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static std::string encode_blacklist( kitty::dynamic_truth_table const& function, BlacklistCacheInfo const& info )
+  {
+    std::string payload;
+    append_log::write_value( payload, static_cast<uint8_t>( 0u ) );
+    write_truth_table( payload, function );
+    append_log::write_value( payload, info );
+    return payload;
+  }
+
+  /* gates are stored with literals 2 * i + c, where i is 0 for the constant, 1 to n for PIs, and n + j for the j-th gate */
+  std::string encode_entry( cache_key_t const& key, Ntk const& entry ) const
+  {
+    std::string payload;
+    append_log::write_value( payload, static_cast<uint8_t>( 1u ) );
+    write_truth_table( payload, key.first );
+    append_log::write_value( payload, _initial_size );
+    append_log::write_value( payload, static_cast<uint32_t>( key.second.size() ) );
+    for ( auto const& tt : key.second )
+    {
+      write_truth_table( payload, tt );
+    }
+
+    std::vector<uint32_t> index( entry.size() );
+    auto next_index = 1u;
+    entry.foreach_pi( [&]( auto const& n ) {
+      index[entry.node_to_index( n )] = next_index++;
+    } );
+    auto const literal = [&]( signal<Ntk> const& f ) {
+      auto const n = entry.get_node( f );
+      if ( entry.is_constant( n ) )
+      {
+        return static_cast<uint32_t>( entry.constant_value( n ) != entry.is_complemented( f ) );
+      }
+      return 2u * index[entry.node_to_index( n )] + ( entry.is_complemented( f ) ? 1u : 0u );
+    };
+
+    append_log::write_value( payload, static_cast<uint32_t>( entry.num_pis() ) );
+    append_log::write_value( payload, static_cast<uint32_t>( entry.num_gates() ) );
+    entry.foreach_gate( [&]( auto const& n ) {
+      index[entry.node_to_index( n )] = next_index++;
+      append_log::write_value( payload, static_cast<uint8_t>( entry.fanin_size( n ) ) );
+      entry.foreach_fanin( n, [&]( auto const& f ) {
+        append_log::write_value( payload, literal( f ) );
+      } );
+      write_truth_table( payload, entry.node_function( n ) );
+    } );
+    entry.foreach_po( [&]( auto const& f ) {
+      append_log::write_value( payload, literal( f ) );
+    } );
+    return payload;
+  }
+
+  static std::optional<Ntk> decode_entry( std::string const& payload, std::size_t& pos )
   {
-#if __GNUC__ == 7
-    namespace fs = std::experimental::filesystem::v1;
-#else
-    namespace fs = std::filesystem;
-#endif
-
-    nlohmann::json data{
-      {"cache", _cache.to_json()},
-      {"blacklist_cache", _blacklist_cache},
-      {"initial_size", _initial_size}
+    uint32_t num_pis{0}, num_gates{0};
+    if ( !append_log::read_value( payload, pos, num_pis ) || !append_log::read_value( payload, pos, num_gates ) )
+    {
+      return std::nullopt;
+    }
+
+    Ntk entry;
+    std::vector<signal<Ntk>> signals( 1u + num_pis, entry.get_constant( false ) );
+    std::generate( signals.begin() + 1, signals.end(), [&]() { return entry.create_pi(); } );
+    auto const signal_of = [&]( uint32_t lit ) -> std::optional<signal<Ntk>> {
+      if ( ( lit >> 1 ) >= signals.size() )
+      {
+        return std::nullopt;
+      }
+      if ( ( lit >> 1 ) == 0u )
+      {
+        return entry.get_constant( lit & 1 );
+      }
+      return ( lit & 1 ) ? entry.create_not( signals[lit >> 1] ) : signals[lit >> 1];
     };
 
-    // make a backup of existing cache file, if it exists
-    std::string _backup_filename = fmt::format( "{}.bak", _cache_filename );
-    if ( fs::exists( _cache_filename ) )
+    std::vector<signal<Ntk>> children;
+    for ( auto i = 0u; i < num_gates; ++i )
+    {
+      uint8_t fanin_size{0};
+      if ( !append_log::read_value( payload, pos, fanin_size ) )
+      {
+        return std::nullopt;
+      }
+      children.clear();
+      for ( auto j = 0u; j < fanin_size; ++j )
+      {
+        uint32_t lit{0};
+        if ( !append_log::read_value( payload, pos, lit ) )
+        {
+          return std::nullopt;
+        }
+        auto const s = signal_of( lit );
+        if ( !s )
+        {
+          return std::nullopt;
+        }
+        children.push_back( *s );
+      }
+      kitty::dynamic_truth_table function;
+      if ( !read_truth_table( payload, pos, function ) )
+      {
+        return std::nullopt;
+      }
+      auto const s = detail::create_gate_from_function( entry, children, function );
+      if ( !s )
+      {
+        return std::nullopt;
+      }
+      signals.push_back( *s );
+    }
+
+    uint32_t lit{0};
+    if ( !append_log::read_value( payload, pos, lit ) )
+    {
+      return std::nullopt;
+    }
+    auto const output = signal_of( lit );
+    if ( !output )
+    {
+      return std::nullopt;
+    }
+    entry.create_po( *output );
+    return entry;
+  }
+
+  void load_record( std::string const& payload )
+  {
+    ++_num_records;
+
+    /* records that cannot be used by this cache, e.g., written by a cache
+     * with a different number of PIs, are kept unchanged when compacting */
+    if ( !decode_record( payload ) )
+    {
+      _skipped_records.insert( payload );
+    }
+  }
+
+  bool decode_record( std::string const& payload )
+  {
+    std::size_t pos{0};
+    uint8_t kind{0};
+    kitty::dynamic_truth_table function;
+    if ( !append_log::read_value( payload, pos, kind ) || !read_truth_table( payload, pos, function ) )
+    {
+      return false;
+    }
+
+    if ( kind == 0u )
+    {
+      BlacklistCacheInfo info;
+      if ( !append_log::read_value( payload, pos, info ) )
+      {
+        return false;
+      }
+      _blacklist_cache.insert_or_assign( function, info );
+      return true;
+    }
+
+    uint32_t initial_size{0}, num_existing{0};
+    if ( !append_log::read_value( payload, pos, initial_size ) || !append_log::read_value( payload, pos, num_existing ) )
     {
-      fs::copy( _cache_filename, _backup_filename );
+      return false;
+    }
+    /* existing functions are stored after the first `initial_size` PIs */
+    if ( num_existing != 0u && initial_size != _initial_size )
+    {
+      return false;
+    }
+    cache_key_t key{function, std::vector<kitty::dynamic_truth_table>( num_existing )};
+    for ( auto& tt : key.second )
+    {
+      if ( !read_truth_table( payload, pos, tt ) )
+      {
+        return false;
+      }
+    }
+    auto const entry = decode_entry( payload, pos );
+    if ( !entry )
+    {
+      return false;
+    }
+    ensure_pis( entry->num_pis() );
+    _cache.try_emplace( key, *entry );
+    return true;
+  }
+
+  void queue_record( std::string const& payload )
+  {
+    if ( !_log )
+    {
+      return;
+    }
+    _pending.push_back( payload );
+    if ( _pending.size() >= flush_threshold )
+    {
+      flush();
     }
+  }
 
-    std::ofstream os( _cache_filename.c_str(), std::ofstream::out );
-    os << data.dump() << "\n";
-    os.close();
+  /* appends pending records and reads those of other processes */
+  void flush()
+  {
+    _log->append( _pending, [&]( std::string const& payload ) { load_record( payload ); } );
+    _num_records += _pending.size();
+    _pending.clear();
+  }
 
-    if ( fs::exists( _backup_filename ) )
+  void save()
+  {
+    flush();
+
+    /* remove outdated and duplicate records */
+    if ( _num_records <= _cache.size() + _blacklist_cache.size() + _skipped_records.size() )
     {
-      fs::remove( _backup_filename );
+      return;
     }
+    _log->compact( [&]( std::string const& payload ) { load_record( payload ); }, [&]() {
+      std::vector<std::string> payloads;
+      payloads.reserve( _cache.size() + _blacklist_cache.size() + _skipped_records.size() );
+      for ( auto const& [key, entry] : _cache )
+      {
+        payloads.push_back( encode_entry( key, entry ) );
+      }
+      for ( auto const& [function, info] : _blacklist_cache )
+      {
+        payloads.push_back( encode_blacklist( function, info ) );
+      }
+      payloads.insert( payloads.end(), _skipped_records.begin(), _skipped_records.end() );
+      return payloads;
+    } );
   }
 
 private:
   ResynthesisFn _resyn_fn;
-  network_cache<Ntk, cache_key_t, cache_hash> _cache;
-  std::unordered_set<blacklist_cache_key_t, blacklist_cache_hash, blacklist_cache_equal> _blacklist_cache;
-  std::string _cache_filename;
+  cache_map_t _cache;
+  blacklist_map_t _blacklist_cache;
   BlacklistCacheInfo _blacklist_cache_info;
   uint32_t _initial_size{};
 
+  Ntk _pi_template;
+  std::vector<signal<Ntk>> _pis;
+  std::mutex _resyn_mutex;
+
+  std::unique_ptr<append_log> _log;
+  std::vector<std::string> _pending;
+  uint64_t _num_records{0};
+  std::unordered_set<std::string> _skipped_records;
+
   std::vector<kitty::dynamic_truth_table> _existing_functions;
   std::vector<signal<Ntk>> _existing_signals;
 
   /* statistics */
-  uint32_t _cache_hits{};
-  uint32_t _cache_misses{};
+  std::atomic<uint32_t> _cache_hits{};
+  std::atomic<uint32_t> _cache_misses{};
 };
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
@@ -32,21 +32,33 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <fmt/format.h>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
 #include <kitty/print.hpp>
 #include <kitty/traits.hpp>
 
 #include "../../networks/aig.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../networks/klut.hpp"
+#include "../../utils/conflict_slices.hpp"
 #include "../../utils/include/percy.hpp"
+#include "../../utils/persistent_exact_cache.hpp"
+#include "../../utils/stopwatch.hpp"
 
 namespace mockturtle
 {
@@ -58,10 +70,15 @@ struct exact_resynthesis_params
 
   using blacklist_cache_map_t = std::unordered_map<kitty::dynamic_truth_table, int32_t, kitty::hash<kitty::dynamic_truth_table>>;
   using blacklist_cache_t = std::shared_ptr<blacklist_cache_map_t>;
+
+  using persistent_cache_t = std::shared_ptr<persistent_exact_cache>;
   
   cache_t cache;
   blacklist_cache_t blacklist_cache;
 
+  /*! \brief On-disk cache keyed by NPN class (used for functions without don't cares). */
+  persistent_cache_t persistent_cache;
+
   bool add_alonce_clauses{true};
   bool add_colex_clauses{true};
   bool add_lex_clauses{false};
@@ -76,8 +93,414 @@ struct exact_resynthesis_params
   percy::EncoderType encoder_type = percy::ENC_SSV;
 
   percy::SynthMethod synthesis_method = percy::SYNTH_STD;
+
+  /*! \brief Encoders and synthesis methods that race each other in `prefetch`.
+   *
+   * If empty, only `encoder_type` and `synthesis_method` are used.  The
+   * synthesis method must be supported by the encoder, e.g.,
+   * `SYNTH_STD_CEGAR` with `ENC_SSV` or `ENC_MSV`.
+   */
+  std::vector<std::pair<percy::EncoderType, percy::SynthMethod>> portfolio;
+
+  /*! \brief Number of worker threads in `prefetch` (0: hardware concurrency). */
+  uint32_t num_threads{0u};
+
+  /*! \brief Wall-clock time limit per function in `prefetch` (in seconds, 0: no limit). */
+  double timeout{0.0};
+};
+
+/*! \brief Statistics for exact resynthesis functions. */
+struct exact_resynthesis_stats
+{
+  /*! \brief Time spent in SAT-based exact synthesis. */
+  stopwatch<>::duration time_synthesis{0};
+
+  /*! \brief Hits in the in-memory cache. */
+  uint64_t cache_hits{0};
+
+  /*! \brief Misses in the in-memory cache. */
+  uint64_t cache_misses{0};
+
+  /*! \brief Hits in the in-memory blacklist cache. */
+  uint64_t blacklist_hits{0};
+
+  /*! \brief Hits in the persistent cache. */
+  uint64_t persistent_hits{0};
+
+  /*! \brief Misses in the persistent cache. */
+  uint64_t persistent_misses{0};
+
+  /*! \brief Number of calls to the exact synthesis engine. */
+  uint64_t num_synthesis{0};
+
+  /*! \brief Number of failed (or timed out) calls to the exact synthesis engine. */
+  uint64_t num_failures{0};
+
+  /*! \brief Number of functions that exceeded the time limit in `prefetch`. */
+  uint64_t num_timeouts{0};
+
+  /*! \brief Number of NPN classes synthesized in `prefetch`. */
+  uint64_t num_prefetched{0};
+
+  /*! \brief Wall-clock time spent in `prefetch`. */
+  stopwatch<>::duration time_prefetch{0};
+
+  void report() const
+  {
+    auto const rate = []( uint64_t hits, uint64_t misses ) {
+      return hits + misses == 0u ? 0.0 : 100.0 * hits / ( hits + misses );
+    };
+    std::cout << fmt::format( "[i] synthesis time   = {:>5.2f} secs\n", to_seconds( time_synthesis ) );
+    std::cout << fmt::format( "[i] synthesis calls  = {:>5} ({} failed)\n", num_synthesis, num_failures );
+    std::cout << fmt::format( "[i] prefetch         = {:>5} classes in {:>5.2f} secs ({} timeouts)\n", num_prefetched, to_seconds( time_prefetch ), num_timeouts );
+    std::cout << fmt::format( "[i] cache            = {:>5} hits, {:>5} misses ({:>5.2f}%)\n", cache_hits, cache_misses, rate( cache_hits, cache_misses ) );
+    std::cout << fmt::format( "[i] blacklist hits   = {:>5}\n", blacklist_hits );
+    std::cout << fmt::format( "[i] persistent cache = {:>5} hits, {:>5} misses ({:>5.2f}%)\n", persistent_hits, persistent_misses, rate( persistent_hits, persistent_misses ) );
+  }
 };
 
+namespace detail
+{
+
+/* encodes the synthesis parameters that affect the result of exact synthesis
+ *
+ * A lower bound on the number of steps (`spec.initial_steps`) may yield a
+ * chain that is not optimum, hence it is part of the fingerprint (the upper
+ * bound is not passed to percy).  Without a lower bound, the fingerprint is
+ * the same as in earlier versions.
+ */
+inline uint64_t exact_synthesis_fingerprint( exact_resynthesis_params const& ps, uint8_t primitive, uint8_t fanin_size, std::optional<uint32_t> const& lower_bound = std::nullopt )
+{
+  uint64_t fp = primitive;
+  fp = ( fp << 8 ) | fanin_size;
+  fp = ( fp << 8 ) | static_cast<uint8_t>( ps.encoder_type );
+  fp = ( fp << 8 ) | static_cast<uint8_t>( ps.synthesis_method );
+  for ( auto const flag : {ps.add_alonce_clauses, ps.add_colex_clauses, ps.add_lex_clauses, ps.add_lex_func_clauses,
+                           ps.add_nontriv_clauses, ps.add_noreapply_clauses, ps.add_symvar_clauses} )
+  {
+    fp = ( fp << 1 ) | ( flag ? 1u : 0u );
+  }
+  if ( lower_bound )
+  {
+    fp |= static_cast<uint64_t>( std::min<uint32_t>( *lower_bound, 0xfffffeu ) + 1u ) << 40;
+  }
+  return fp;
+}
+
+using exact_prefetch_map_t = std::unordered_map<kitty::dynamic_truth_table, std::optional<percy::chain>, kitty::hash<kitty::dynamic_truth_table>>;
+
+/* NPN class of `function` as key for caches */
+inline std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>> exact_synthesis_canonization( kitty::dynamic_truth_table const& function )
+{
+  /* exact canonization is too slow for larger functions; sifting is deterministic, which suffices for a key */
+  return function.num_vars() <= 4 ? kitty::exact_npn_canonization( function ) : kitty::sifting_npn_canonization( function );
+}
+
+/* exact synthesis of the NPN representative of `function` using the persistent cache */
+inline std::optional<percy::chain> exact_synthesis_with_persistent_cache( percy::spec& spec, kitty::dynamic_truth_table const& function, uint64_t fingerprint, bool denormalize,
+                                                                          exact_resynthesis_params const& ps, exact_resynthesis_stats* pst )
+{
+  auto const [repr, phase, perm] = exact_synthesis_canonization( function );
+
+  if ( auto const e = ps.persistent_cache->find( repr, fingerprint ) )
+  {
+    if ( e->chain )
+    {
+      if ( pst )
+      {
+        ++pst->persistent_hits;
+      }
+      auto c = *e->chain;
+      npn_transform_chain( c, phase, perm );
+      if ( denormalize )
+      {
+        c.denormalize();
+      }
+      return c;
+    }
+    else if ( e->conflict_limit == 0 || ( ps.conflict_limit != 0 && ps.conflict_limit <= e->conflict_limit ) )
+    {
+      if ( pst )
+      {
+        ++pst->persistent_hits;
+      }
+      return std::nullopt;
+    }
+  }
+
+  if ( pst )
+  {
+    ++pst->persistent_misses;
+    ++pst->num_synthesis;
+  }
+
+  spec[0] = repr;
+  percy::chain c;
+  stopwatch<>::duration time{0};
+  auto const result = call_with_stopwatch( time, [&]() { return percy::synthesize( spec, c, ps.solver_type, ps.encoder_type, ps.synthesis_method ); } );
+  if ( pst )
+  {
+    pst->time_synthesis += time;
+  }
+
+  if ( result != percy::success )
+  {
+    if ( pst )
+    {
+      ++pst->num_failures;
+    }
+    ps.persistent_cache->insert_failure( repr, fingerprint, result == percy::timeout ? ps.conflict_limit : 0 );
+    return std::nullopt;
+  }
+
+  if ( denormalize )
+  {
+    c.denormalize();
+  }
+  ps.persistent_cache->insert( repr, fingerprint, c );
+
+  npn_transform_chain( c, phase, perm );
+  if ( denormalize )
+  {
+    c.denormalize();
+  }
+  return c;
+}
+
+/* synthesis with a wall-clock deadline, which can be cancelled by other threads
+ *
+ * percy cannot be interrupted, so synthesis is restarted with a growing
+ * conflict limit until it succeeds, the deadline has passed, or another
+ * thread has solved the problem (see `solve_with_conflict_slices`).
+ * Returns the conflict limit of the last attempt in `conflict_limit`.
+ */
+inline percy::synth_result exact_synthesis_with_deadline( percy::spec const& spec, percy::chain& c, percy::SolverType solver_type, percy::EncoderType encoder_type, percy::SynthMethod synthesis_method,
+                                                          std::optional<std::chrono::steady_clock::time_point> const& deadline, bool sliced, std::atomic<bool> const& cancelled, int32_t& conflict_limit )
+{
+  if ( !deadline && !sliced )
+  {
+    auto s = spec;
+    conflict_limit = s.conflict_limit;
+    return percy::synthesize( s, c, solver_type, encoder_type, synthesis_method );
+  }
+
+  return solve_with_conflict_slices(
+      [&]( int32_t limit ) {
+        auto s = spec;
+        s.conflict_limit = limit;
+        return percy::synthesize( s, c, solver_type, encoder_type, synthesis_method );
+      },
+      spec.conflict_limit, false, deadline, [&]() { return cancelled.load(); }, conflict_limit );
+}
+
+/* synthesizes the NPN classes of `functions` on a thread pool
+ *
+ * Returns a chain for each function, or `std::nullopt` if synthesis
+ * failed or timed out.  The persistent cache is only accessed by the
+ * calling thread, before and after the parallel part.
+ */
+inline std::vector<std::optional<percy::chain>> exact_synthesis_batch( percy::spec const& spec, std::vector<kitty::dynamic_truth_table> const& functions, uint64_t fingerprint, bool denormalize,
+                                                                       exact_resynthesis_params const& ps, exact_resynthesis_stats* pst )
+{
+  /* unique NPN classes */
+  struct npn_class
+  {
+    kitty::dynamic_truth_table repr;
+    std::optional<percy::chain> chain;
+    bool solved{false};
+    bool definite_failure{false};
+    bool timed_out{false};
+    int32_t conflict_limit{0};
+  };
+  std::vector<npn_class> classes;
+  std::unordered_map<kitty::dynamic_truth_table, uint32_t, kitty::hash<kitty::dynamic_truth_table>> class_index;
+  std::vector<std::tuple<uint32_t, uint32_t, std::vector<uint8_t>>> configs;
+  configs.reserve( functions.size() );
+
+  for ( auto const& function : functions )
+  {
+    auto [repr, phase, perm] = exact_synthesis_canonization( function );
+    auto [it, inserted] = class_index.emplace( repr, static_cast<uint32_t>( classes.size() ) );
+    if ( inserted )
+    {
+      classes.emplace_back();
+      classes.back().repr = repr;
+    }
+    configs.emplace_back( it->second, phase, perm );
+  }
+
+  /* look up persistent cache */
+  std::vector<uint32_t> open;
+  for ( auto i = 0u; i < classes.size(); ++i )
+  {
+    auto& cls = classes[i];
+    if ( ps.persistent_cache )
+    {
+      if ( auto const e = ps.persistent_cache->find( cls.repr, fingerprint ) )
+      {
+        if ( e->chain || e->conflict_limit == 0 || ( ps.conflict_limit != 0 && ps.conflict_limit <= e->conflict_limit ) )
+        {
+          if ( pst )
+          {
+            ++pst->persistent_hits;
+          }
+          cls.chain = e->chain;
+          cls.solved = true;
+          continue;
+        }
+      }
+      if ( pst )
+      {
+        ++pst->persistent_misses;
+      }
+    }
+    open.push_back( i );
+  }
+
+  /* one task per class and portfolio entry; tasks of the same class race each other */
+  auto portfolio = ps.portfolio;
+  if ( portfolio.empty() )
+  {
+    portfolio.emplace_back( ps.encoder_type, ps.synthesis_method );
+  }
+  auto const num_tasks = open.size() * portfolio.size();
+  std::vector<std::atomic<bool>> done( classes.size() );
+  for ( auto& d : done )
+  {
+    d = false;
+  }
+  std::atomic<uint64_t> next_task{0};
+  std::mutex mutex;
+
+  auto const worker = [&]() {
+    while ( true )
+    {
+      auto const task = next_task++;
+      if ( task >= num_tasks )
+      {
+        return;
+      }
+      auto const index = open[task / portfolio.size()];
+      auto const [encoder_type, synthesis_method] = portfolio[task % portfolio.size()];
+      if ( done[index] )
+      {
+        continue;
+      }
+
+      std::optional<std::chrono::steady_clock::time_point> deadline;
+      if ( ps.timeout > 0.0 )
+      {
+        deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( ps.timeout ) );
+      }
+
+      percy::spec s = spec;
+      s[0] = classes[index].repr;
+      percy::chain c;
+      int32_t conflict_limit{0};
+      auto const result = exact_synthesis_with_deadline( s, c, ps.solver_type, encoder_type, synthesis_method, deadline, portfolio.size() > 1u, done[index], conflict_limit );
+
+      std::lock_guard<std::mutex> lock( mutex );
+      auto& cls = classes[index];
+      if ( cls.solved )
+      {
+        continue;
+      }
+      if ( result == percy::success )
+      {
+        cls.chain = c;
+        cls.solved = true;
+        done[index] = true;
+      }
+      else if ( result == percy::failure )
+      {
+        cls.definite_failure = true;
+        cls.solved = true;
+        done[index] = true;
+      }
+      else
+      {
+        cls.conflict_limit = std::max( cls.conflict_limit, conflict_limit );
+        cls.timed_out = cls.timed_out || ( deadline && std::chrono::steady_clock::now() >= *deadline );
+      }
+    }
+  };
+
+  auto num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+  num_threads = static_cast<uint32_t>( std::min<uint64_t>( num_threads, num_tasks ) );
+  if ( num_threads <= 1u )
+  {
+    worker();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for ( auto i = 0u; i < num_threads; ++i )
+    {
+      threads.emplace_back( worker );
+    }
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+  }
+
+  /* store results */
+  for ( auto const index : open )
+  {
+    auto& cls = classes[index];
+    if ( cls.chain )
+    {
+      if ( denormalize )
+      {
+        cls.chain->denormalize();
+      }
+      if ( ps.persistent_cache )
+      {
+        ps.persistent_cache->insert( cls.repr, fingerprint, *cls.chain );
+      }
+    }
+    else if ( ps.persistent_cache )
+    {
+      ps.persistent_cache->insert_failure( cls.repr, fingerprint, cls.definite_failure ? 0 : cls.conflict_limit );
+    }
+    if ( pst )
+    {
+      ++pst->num_synthesis;
+      ++pst->num_prefetched;
+      if ( !cls.chain )
+      {
+        ++pst->num_failures;
+        if ( cls.timed_out )
+        {
+          ++pst->num_timeouts;
+        }
+      }
+    }
+  }
+
+  std::vector<std::optional<percy::chain>> chains;
+  chains.reserve( functions.size() );
+  for ( auto const& [index, phase, perm] : configs )
+  {
+    if ( !classes[index].chain )
+    {
+      chains.emplace_back( std::nullopt );
+      continue;
+    }
+    auto c = *classes[index].chain;
+    npn_transform_chain( c, phase, perm );
+    if ( denormalize )
+    {
+      c.denormalize();
+    }
+    chains.emplace_back( c );
+  }
+
+  return chains;
+}
+
+} /* namespace detail */
+
 /*! \brief Resynthesis function based on exact synthesis.
  *
  * This resynthesis function can be passed to ``node_resynthesis``,
@@ -121,14 +544,36 @@ struct exact_resynthesis_params
    .. _percy: https://github.com/lsils/percy
    \endverbatim
  *
+ * Results can also be stored across runs in a `persistent_exact_cache`,
+ * which is keyed by NPN classes.  Cache hits and misses are reported in
+ * the statistics passed as third parameter.
+ *
+ * If many functions are known in advance, `prefetch` synthesizes them on
+ * several threads, optionally with a portfolio of encoders and a time limit
+ * per function.  `cut_rewriting` does this for all cut functions.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      exact_resynthesis_params ps;
+      ps.num_threads = 8;
+      ps.timeout = 1.0;
+      ps.portfolio = {{percy::ENC_SSV, percy::SYNTH_STD}, {percy::ENC_SSV, percy::SYNTH_STD_CEGAR}};
+      exact_resynthesis<klut_network> resyn( 3, ps );
+      klut = cut_rewriting( klut, resyn );
+   \endverbatim
  */
 template<class Ntk = klut_network>
 class exact_resynthesis
 {
 public:
-  explicit exact_resynthesis( uint32_t fanin_size = 3u, exact_resynthesis_params const& ps = {} )
+  explicit exact_resynthesis( uint32_t fanin_size = 3u, exact_resynthesis_params const& ps = {}, exact_resynthesis_stats* pst = nullptr )
       : _fanin_size( fanin_size ),
-        _ps( ps )
+        _ps( ps ),
+        _pst( pst )
   {
   }
 
@@ -147,17 +592,7 @@ public:
       return;
     }
 
-    percy::spec spec;
-    spec.fanin = _fanin_size;
-    spec.verbosity = 0;
-    spec.add_alonce_clauses = _ps.add_alonce_clauses;
-    spec.add_colex_clauses = _ps.add_colex_clauses;
-    spec.add_lex_clauses = _ps.add_lex_clauses;
-    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
-    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
-    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
-    spec.add_symvar_clauses = _ps.add_symvar_clauses;
-    spec.conflict_limit = _ps.conflict_limit;
+    percy::spec spec = make_spec();
     spec[0] = function;
     bool with_dont_cares{false};
     if ( !kitty::is_const0( dont_cares ) )
@@ -167,29 +602,73 @@ public:
     }
 
     auto c = [&]() -> std::optional<percy::chain> {
+      if ( !with_dont_cares )
+      {
+        if ( const auto it = _prefetched->find( function ); it != _prefetched->end() )
+        {
+          if ( _pst )
+          {
+            ++_pst->cache_hits;
+          }
+          return it->second;
+        }
+      }
+
       if ( !with_dont_cares && _ps.cache )
       {
         const auto it = _ps.cache->find( function );
         if ( it != _ps.cache->end() )
         {
+          if ( _pst )
+          {
+            ++_pst->cache_hits;
+          }
           return it->second;
         }
+        if ( _pst )
+        {
+          ++_pst->cache_misses;
+        }
       }
       else if ( !with_dont_cares && _ps.blacklist_cache )
       {
         const auto it = _ps.blacklist_cache->find( function );
         if ( it != _ps.blacklist_cache->end() && _ps.conflict_limit >= it->second )
         {
+          if ( _pst )
+          {
+            ++_pst->blacklist_hits;
+          }
           return std::nullopt;
         }
       }
 
+      if ( !with_dont_cares && _ps.persistent_cache )
+      {
+        const auto c = detail::exact_synthesis_with_persistent_cache( spec, function, detail::exact_synthesis_fingerprint( _ps, 0u, _fanin_size ), true, _ps, _pst );
+        if ( c && _ps.cache )
+        {
+          ( *_ps.cache )[function] = *c;
+        }
+        return c;
+      }
+
       percy::chain c;
-      if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
-                                             _ps.encoder_type,
-                                             _ps.synthesis_method );
-           result != percy::success )
+      stopwatch<>::duration time{0};
+      const auto result = call_with_stopwatch( time, [&]() { return percy::synthesize( spec, c, _ps.solver_type,
+                                                                                       _ps.encoder_type,
+                                                                                       _ps.synthesis_method ); } );
+      if ( _pst )
+      {
+        ++_pst->num_synthesis;
+        _pst->time_synthesis += time;
+      }
+      if ( result != percy::success )
       {
+        if ( _pst )
+        {
+          ++_pst->num_failures;
+        }
         if ( _ps.blacklist_cache )
         {
           ( *_ps.blacklist_cache )[function] = result == percy::timeout ? _ps.conflict_limit : 0;
@@ -224,9 +703,73 @@ public:
     fn( signals.back() );
   }
 
+  /*! \brief Synthesizes functions in parallel ahead of time.
+   *
+   * The NPN classes of `functions` are solved on a pool of worker threads
+   * (see `num_threads`, `portfolio`, and `timeout` in the parameters), and
+   * the results are stored such that later calls to the resynthesis
+   * function do not invoke the SAT solver for these functions.  Functions
+   * that failed or timed out are not resynthesized later.  This function
+   * is called by `cut_rewriting` after cut enumeration.
+   */
+  void prefetch( std::vector<kitty::dynamic_truth_table> const& functions ) const
+  {
+    std::vector<kitty::dynamic_truth_table> open;
+    for ( auto const& function : functions )
+    {
+      if ( static_cast<uint32_t>( function.num_vars() ) > _fanin_size && _prefetched->find( function ) == _prefetched->end() &&
+           !( _ps.cache && _ps.cache->find( function ) != _ps.cache->end() ) )
+      {
+        open.push_back( function );
+      }
+    }
+    if ( open.empty() )
+    {
+      return;
+    }
+
+    stopwatch<>::duration time{0};
+    const auto chains = call_with_stopwatch( time, [&]() {
+      return detail::exact_synthesis_batch( make_spec(), open, detail::exact_synthesis_fingerprint( _ps, 0u, _fanin_size ), true, _ps, _pst );
+    } );
+    if ( _pst )
+    {
+      _pst->time_prefetch += time;
+      _pst->time_synthesis += time;
+    }
+
+    for ( auto i = 0u; i < open.size(); ++i )
+    {
+      ( *_prefetched )[open[i]] = chains[i];
+      if ( chains[i] && _ps.cache )
+      {
+        ( *_ps.cache )[open[i]] = *chains[i];
+      }
+    }
+  }
+
+private:
+  percy::spec make_spec() const
+  {
+    percy::spec spec;
+    spec.fanin = _fanin_size;
+    spec.verbosity = 0;
+    spec.add_alonce_clauses = _ps.add_alonce_clauses;
+    spec.add_colex_clauses = _ps.add_colex_clauses;
+    spec.add_lex_clauses = _ps.add_lex_clauses;
+    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
+    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
+    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
+    spec.add_symvar_clauses = _ps.add_symvar_clauses;
+    spec.conflict_limit = _ps.conflict_limit;
+    return spec;
+  }
+
 private:
   uint32_t _fanin_size{3u};
   exact_resynthesis_params _ps;
+  exact_resynthesis_stats* _pst{nullptr};
+  std::shared_ptr<detail::exact_prefetch_map_t> _prefetched = std::make_shared<detail::exact_prefetch_map_t>();
 };
 
 /*! \brief Resynthesis function based on exact synthesis for AIGs.
@@ -270,14 +813,19 @@ private:
    .. _percy: https://github.com/lsils/percy
    \endverbatim
  *
+ * Results can also be stored across runs in a `persistent_exact_cache`,
+ * which is keyed by NPN classes.  Cache hits and misses are reported in
+ * the statistics passed as third parameter.
+ *
  */
 template<class Ntk = aig_network>
 class exact_aig_resynthesis
 {
 public:
-  explicit exact_aig_resynthesis( bool _allow_xor = false, exact_resynthesis_params const& ps = {} )
+  explicit exact_aig_resynthesis( bool _allow_xor = false, exact_resynthesis_params const& ps = {}, exact_resynthesis_stats* pst = nullptr )
       : _allow_xor( _allow_xor ),
-        _ps( ps )
+        _ps( ps ),
+        _pst( pst )
   {
   }
 
@@ -291,25 +839,7 @@ public:
   void operator()( Ntk& ntk, kitty::dynamic_truth_table const& function, kitty::dynamic_truth_table const& dont_cares, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
   {
     // TODO: special case for small functions (up to 2 variables)?
-    percy::spec spec;
-    if ( !_allow_xor )
-    {
-      spec.set_primitive( percy::AIG );
-    }
-    spec.fanin = 2;
-    spec.verbosity = 0;
-    spec.add_alonce_clauses = _ps.add_alonce_clauses;
-    spec.add_colex_clauses = _ps.add_colex_clauses;
-    spec.add_lex_clauses = _ps.add_lex_clauses;
-    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
-    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
-    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
-    spec.add_symvar_clauses = _ps.add_symvar_clauses;
-    spec.conflict_limit = _ps.conflict_limit;
-    if ( _lower_bound )
-    {
-      spec.initial_steps = *_lower_bound;
-    }
+    percy::spec spec = make_spec();
     spec[0] = function;
     bool with_dont_cares{false};
     if ( !kitty::is_const0( dont_cares ) )
@@ -319,21 +849,61 @@ public:
     }
 
     auto c = [&]() -> std::optional<percy::chain> {
+      if ( !with_dont_cares )
+      {
+        if ( const auto it = _prefetched->find( function ); it != _prefetched->end() )
+        {
+          if ( _pst )
+          {
+            ++_pst->cache_hits;
+          }
+          return it->second;
+        }
+      }
+
       if ( !with_dont_cares && _ps.cache )
       {
         const auto it = _ps.cache->find( function );
         if ( it != _ps.cache->end() )
         {
+          if ( _pst )
+          {
+            ++_pst->cache_hits;
+          }
           return it->second;
         }
+        if ( _pst )
+        {
+          ++_pst->cache_misses;
+        }
+      }
+
+      if ( !with_dont_cares && _ps.persistent_cache )
+      {
+        const auto c = detail::exact_synthesis_with_persistent_cache( spec, function, detail::exact_synthesis_fingerprint( _ps, _allow_xor ? 2u : 1u, 2u, _lower_bound ), false, _ps, _pst );
+        if ( c && _ps.cache )
+        {
+          ( *_ps.cache )[function] = *c;
+        }
+        return c;
       }
 
       percy::chain c;
-      if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
-                                                  _ps.encoder_type,
-                                                  _ps.synthesis_method );
-           result != percy::success )
+      stopwatch<>::duration time{0};
+      const auto result = call_with_stopwatch( time, [&]() { return percy::synthesize( spec, c, _ps.solver_type,
+                                                                                       _ps.encoder_type,
+                                                                                       _ps.synthesis_method ); } );
+      if ( _pst )
       {
+        ++_pst->num_synthesis;
+        _pst->time_synthesis += time;
+      }
+      if ( result != percy::success )
+      {
+        if ( _pst )
+        {
+          ++_pst->num_failures;
+        }
         return std::nullopt;
       }
       if ( !with_dont_cares && _ps.cache )
@@ -353,26 +923,36 @@ public:
     {
       auto c1 = signals[c->get_step( i )[0]];
       auto c2 = signals[c->get_step( i )[1]];
-      switch ( c->get_operator( i )._bits[0] )
+      auto const op = c->get_operator( i )._bits[0] & 0xf;
+      switch ( op )
       {
-      default:
-        std::cerr << "[e] unsupported operation " << kitty::to_hex( c->get_operator( i ) ) << "\n";
-        assert( false );
-        break;
-      case 0x8:
-        signals.emplace_back( ntk.create_and( c1, c2 ) );
+      case 0x6:
+        signals.emplace_back( ntk.create_xor( c1, c2 ) );
         break;
-      case 0x4:
-        signals.emplace_back( ntk.create_and( !c1, c2 ) );
+      case 0x9:
+        signals.emplace_back( !ntk.create_xor( c1, c2 ) );
         break;
+      case 0x1:
       case 0x2:
-        signals.emplace_back( ntk.create_and( c1, !c2 ) );
-        break;
+      case 0x4:
+      case 0x8:
+      case 0x7:
+      case 0xb:
+      case 0xd:
       case 0xe:
-        signals.emplace_back( !ntk.create_and( !c1, !c2 ) );
+      {
+        /* AND of literals for the only minterm in the on-set (or off-set) */
+        const auto num_ones = ( op & 1 ) + ( ( op >> 1 ) & 1 ) + ( ( op >> 2 ) & 1 ) + ( ( op >> 3 ) & 1 );
+        const auto complemented = num_ones == 3;
+        const auto mask = complemented ? ( ~op & 0xf ) : op;
+        const auto minterm = mask == 1 ? 0 : ( mask == 2 ? 1 : ( mask == 4 ? 2 : 3 ) );
+        const auto f = ntk.create_and( ( minterm & 1 ) ? c1 : !c1, ( minterm & 2 ) ? c2 : !c2 );
+        signals.emplace_back( complemented ? !f : f );
         break;
-      case 0x6:
-        signals.emplace_back( ntk.create_xor( c1, c2 ) );
+      }
+      default:
+        std::cerr << "[e] unsupported operation " << kitty::to_hex( c->get_operator( i ) ) << "\n";
+        assert( false );
         break;
       }
     }
@@ -386,9 +966,75 @@ public:
     _upper_bound = upper_bound;
   }
 
+  /*! \brief Synthesizes functions in parallel ahead of time.
+   *
+   * See `exact_resynthesis::prefetch`.
+   */
+  void prefetch( std::vector<kitty::dynamic_truth_table> const& functions ) const
+  {
+    std::vector<kitty::dynamic_truth_table> open;
+    for ( auto const& function : functions )
+    {
+      if ( _prefetched->find( function ) == _prefetched->end() && !( _ps.cache && _ps.cache->find( function ) != _ps.cache->end() ) )
+      {
+        open.push_back( function );
+      }
+    }
+    if ( open.empty() )
+    {
+      return;
+    }
+
+    stopwatch<>::duration time{0};
+    const auto chains = call_with_stopwatch( time, [&]() {
+      return detail::exact_synthesis_batch( make_spec(), open, detail::exact_synthesis_fingerprint( _ps, _allow_xor ? 2u : 1u, 2u, _lower_bound ), false, _ps, _pst );
+    } );
+    if ( _pst )
+    {
+      _pst->time_prefetch += time;
+      _pst->time_synthesis += time;
+    }
+
+    for ( auto i = 0u; i < open.size(); ++i )
+    {
+      ( *_prefetched )[open[i]] = chains[i];
+      if ( chains[i] && _ps.cache )
+      {
+        ( *_ps.cache )[open[i]] = *chains[i];
+      }
+    }
+  }
+
+private:
+  percy::spec make_spec() const
+  {
+    percy::spec spec;
+    if ( !_allow_xor )
+    {
+      spec.set_primitive( percy::AIG );
+    }
+    spec.fanin = 2;
+    spec.verbosity = 0;
+    spec.add_alonce_clauses = _ps.add_alonce_clauses;
+    spec.add_colex_clauses = _ps.add_colex_clauses;
+    spec.add_lex_clauses = _ps.add_lex_clauses;
+    spec.add_lex_func_clauses = _ps.add_lex_func_clauses;
+    spec.add_nontriv_clauses = _ps.add_nontriv_clauses;
+    spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
+    spec.add_symvar_clauses = _ps.add_symvar_clauses;
+    spec.conflict_limit = _ps.conflict_limit;
+    if ( _lower_bound )
+    {
+      spec.initial_steps = *_lower_bound;
+    }
+    return spec;
+  }
+
 private:
   bool _allow_xor = false;
   exact_resynthesis_params _ps;
+  exact_resynthesis_stats* _pst{nullptr};
+  std::shared_ptr<detail::exact_prefetch_map_t> _prefetched = std::make_shared<detail::exact_prefetch_map_t>();
 
   std::optional<uint32_t> _lower_bound;
   std::optional<uint32_t> _upper_bound;
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../utils/pattern_store.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include <bill/sat/interface/abc_bsat2.hpp>
@@ -41,7 +42,21 @@
 #include <mockturtle/algorithms/dont_cares.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace mockturtle
 {
@@ -76,6 +91,29 @@ struct pattern_generation_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{1000};
+
+  /*! \brief Number of worker threads (1: sequential, 0: hardware concurrency).
+   *
+   * Each worker checks a share of the nodes with a private copy of the
+   * network and its own validator and simulator.  The workers exchange
+   * their new patterns every `sync_interval` checked nodes, such that a
+   * pattern found by one worker also covers the nodes of the others.  The
+   * network must be a base network that exposes its storage (e.g.,
+   * `aig_network`), otherwise the patterns are generated sequentially.
+   * The set of generated patterns depends on the scheduling of the workers.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Number of nodes checked between two pattern exchanges (and coverage points). */
+  uint32_t sync_interval{256u};
+
+  /*! \brief Binary pattern store (see `pattern_store`) to reload and extend.
+   *
+   * If the store contains patterns of a network with the same signature,
+   * they are added to the simulator before generating new patterns.  The
+   * patterns generated in this run are appended to the store.
+   */
+  std::optional<std::string> pattern_store_filename{};
 };
 
 struct pattern_generation_stats
@@ -106,11 +144,139 @@ struct pattern_generation_stats
 
   /*! \brief Number of unobservable nodes (node for which an observable pattern can not be found). */
   uint32_t unobservable_node{0};
+
+  /*! \brief Number of patterns loaded from the pattern store. */
+  uint64_t num_loaded_patterns{0};
+
+  /*! \brief Number of patterns found by more than one worker (threaded mode). */
+  uint32_t num_duplicate_patterns{0};
+
+  /*! \brief Point of the coverage curve. */
+  struct coverage_point
+  {
+    /*! \brief Wall-clock time since the start of pattern generation. */
+    stopwatch<>::duration time{0};
+
+    /*! \brief Number of checked nodes (summed over both checks). */
+    uint32_t num_checked{0};
+
+    /*! \brief Number of generated patterns. */
+    uint32_t num_patterns{0};
+  };
+
+  /*! \brief Time-to-coverage curve, one point every `sync_interval` checked nodes.
+   *
+   * In the threaded mode, `time_sim`, `time_sat`, and `time_odc` are
+   * accumulated over all workers, whereas the times of the coverage curve
+   * and `time_total` are wall-clock times.
+   */
+  std::vector<coverage_point> coverage;
 };
 
 namespace detail
 {
 
+/* shares the target nodes and the new patterns between the workers of the threaded mode */
+template<class Node>
+class patgen_exchange
+{
+public:
+  struct entry
+  {
+    std::vector<bool> pattern;
+    std::vector<bool> care;
+    uint32_t worker;
+  };
+
+  patgen_exchange( std::vector<Node> gates, uint32_t chunk_size, std::chrono::steady_clock::time_point start, pattern_generation_stats& st )
+      : gates( std::move( gates ) ), chunk_size( std::max( 1u, chunk_size ) ), start( start ), st( st ), num_checked( st.coverage.empty() ? 0u : st.coverage.back().num_checked ), num_patterns_before( st.num_generated_patterns )
+  {
+  }
+
+  /* next range of target nodes */
+  std::optional<std::pair<uint32_t, uint32_t>> next_chunk()
+  {
+    auto const begin = next.fetch_add( chunk_size );
+    if ( begin >= gates.size() )
+    {
+      return std::nullopt;
+    }
+    return std::make_pair( begin, std::min<uint32_t>( begin + chunk_size, static_cast<uint32_t>( gates.size() ) ) );
+  }
+
+  Node const& gate( uint32_t index ) const
+  {
+    return gates[index];
+  }
+
+  /* publishes the pending patterns of `worker` and passes the patterns of the other workers since `cursor` to `fn` */
+  template<typename Fn>
+  void exchange( uint32_t worker, std::vector<entry>& pending, uint32_t checked, uint32_t& cursor, Fn&& fn )
+  {
+    std::lock_guard<std::mutex> lock( mutex );
+    for ( auto& e : pending )
+    {
+      if ( seen.insert( key( e ) ).second )
+      {
+        e.worker = worker;
+        log.emplace_back( std::move( e ) );
+      }
+      else
+      {
+        ++st.num_duplicate_patterns;
+      }
+    }
+    pending.clear();
+
+    for ( ; cursor < log.size(); ++cursor )
+    {
+      if ( log[cursor].worker != worker )
+      {
+        fn( log[cursor] );
+      }
+    }
+
+    num_checked += checked;
+    st.coverage.push_back( {std::chrono::steady_clock::now() - start, num_checked, num_patterns_before + static_cast<uint32_t>( log.size() )} );
+  }
+
+  /* all published patterns, in the order of publication */
+  std::vector<entry> const& patterns() const
+  {
+    return log;
+  }
+
+private:
+  /* patterns with the same cared values are duplicates */
+  static std::vector<bool> key( entry const& e )
+  {
+    if ( e.care.empty() )
+    {
+      return e.pattern;
+    }
+    std::vector<bool> k( 2u * e.pattern.size() );
+    for ( auto i = 0u; i < e.pattern.size(); ++i )
+    {
+      k[2u * i] = e.care[i];
+      k[2u * i + 1u] = e.care[i] && e.pattern[i];
+    }
+    return k;
+  }
+
+private:
+  std::vector<Node> const gates;
+  uint32_t const chunk_size;
+  std::chrono::steady_clock::time_point const start;
+  pattern_generation_stats& st;
+
+  std::atomic<uint32_t> next{0u};
+  std::mutex mutex;
+  std::vector<entry> log;
+  std::unordered_set<std::vector<bool>> seen;
+  uint32_t num_checked;
+  uint32_t const num_patterns_before;
+};
+
 template<class Ntk, class Simulator, bool use_odc = false>
 class patgen_impl
 {
@@ -118,10 +284,12 @@ public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
   using TT = unordered_node_map<kitty::partial_truth_table, Ntk>;
+  using exchange_t = patgen_exchange<node>;
 
-  explicit patgen_impl( Ntk& ntk, Simulator& sim, pattern_generation_params const& ps, validator_params& vps, pattern_generation_stats& st )
+  explicit patgen_impl( Ntk& ntk, Simulator& sim, pattern_generation_params const& ps, validator_params& vps, pattern_generation_stats& st,
+                        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now() )
       : ntk( ntk ), ps( ps ), st( st ), vps( vps ), validator( ntk, vps ),
-        tts( ntk ), sim( sim )
+        tts( ntk ), sim( sim ), start( start )
   {
   }
 
@@ -146,13 +314,7 @@ public:
       }
       if ( ps.substitute_const )
       {
-        for ( auto n : const_nodes )
-        {
-          if ( !ntk.is_dead( ntk.get_node( n ) ) )
-          {
-            ntk.substitute_node( ntk.get_node( n ), ntk.get_constant( ntk.is_complemented( n ) ) );
-          }
-        }
+        substitute_constants( ntk, const_nodes );
       }
     }
 
@@ -175,14 +337,111 @@ public:
     }
   }
 
+  /*! \brief Runs one check as a worker of the threaded mode.
+   *
+   * The worker checks the target nodes handed out by `exchange`, whose
+   * patterns are published to and received from the other workers.
+   */
+  void run_worker( exchange_t& exchange, uint32_t worker, bool observability, std::vector<signal> const& known_constants = {} )
+  {
+    this->exchange = &exchange;
+    this->worker = worker;
+    call_with_stopwatch( st.time_sim, [&]() {
+      simulate_nodes<Ntk>( ntk, tts, sim, true );
+    } );
+
+    if ( observability )
+    {
+      if constexpr ( use_odc )
+      {
+        const_nodes = known_constants;
+        observability_check();
+      }
+    }
+    else
+    {
+      stuck_at_check();
+    }
+    this->exchange = nullptr;
+  }
+
+  /*! \brief Constant nodes found by the stuck-at check. */
+  std::vector<signal> const& constant_nodes() const
+  {
+    return const_nodes;
+  }
+
+  static void substitute_constants( Ntk& ntk, std::vector<signal> const& constants )
+  {
+    for ( auto n : constants )
+    {
+      if ( !ntk.is_dead( ntk.get_node( n ) ) )
+      {
+        ntk.substitute_node( ntk.get_node( n ), ntk.get_constant( ntk.is_complemented( n ) ) );
+      }
+    }
+  }
+
 private:
+  /* calls `fn` on each target node: all gates in the sequential mode, the chunks of the exchange in the threaded mode */
+  template<typename Fn>
+  void foreach_target( kitty::partial_truth_table& zero, Fn&& fn )
+  {
+    if ( exchange == nullptr )
+    {
+      uint32_t num_checked = st.coverage.empty() ? 0u : st.coverage.back().num_checked;
+      ntk.foreach_gate( [&]( auto const& n, auto i ) {
+        fn( n, i );
+        if ( ++num_checked % ps.sync_interval == 0u )
+        {
+          st.coverage.push_back( {std::chrono::steady_clock::now() - start, num_checked, st.num_generated_patterns} );
+        }
+      } );
+      st.coverage.push_back( {std::chrono::steady_clock::now() - start, num_checked, st.num_generated_patterns} );
+      return;
+    }
+
+    while ( auto const chunk = exchange->next_chunk() )
+    {
+      for ( auto i = chunk->first; i < chunk->second; ++i )
+      {
+        fn( exchange->gate( i ), i );
+      }
+      synchronize( chunk->second - chunk->first, zero );
+    }
+  }
+
+  /* exchanges patterns with the other workers */
+  void synchronize( uint32_t num_checked, kitty::partial_truth_table& zero )
+  {
+    auto const num_bits = sim.num_bits();
+    exchange->exchange( worker, pending, num_checked, cursor, [&]( auto const& e ) {
+      if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
+      {
+        sim.add_pattern( e.pattern, e.care );
+      }
+      else
+      {
+        sim.add_pattern( e.pattern );
+      }
+    } );
+
+    if ( sim.num_bits() != num_bits )
+    {
+      call_with_stopwatch( st.time_sim, [&]() {
+        simulate_nodes<Ntk>( ntk, tts, sim, false );
+      } );
+      zero = sim.compute_constant( false );
+    }
+  }
+
   void stuck_at_check()
   {
-    progress_bar pbar{ntk.size(), "patgen-sa |{0}| node = {1:>4} #pat = {2:>4}", ps.progress};
+    progress_bar pbar{ntk.size(), "patgen-sa |{0}| node = {1:>4} #pat = {2:>4}", ps.progress && exchange == nullptr};
 
     kitty::partial_truth_table zero = sim.compute_constant( false );
 
-    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+    foreach_target( zero, [&]( auto const& n, auto i ) {
       pbar( i, i, sim.num_bits() );
 
       if ( tts[n].num_bits() != sim.num_bits() )
@@ -288,19 +547,22 @@ private:
 
   void observability_check()
   {
-    progress_bar pbar{ntk.size(), "patgen-obs |{0}| node = {1:>4} #pat = {2:>4}", ps.progress};
+    progress_bar pbar{ntk.size(), "patgen-obs |{0}| node = {1:>4} #pat = {2:>4}", ps.progress && exchange == nullptr};
 
     kitty::partial_truth_table zero = sim.compute_constant( false );
 
-    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+    std::vector<bool> is_constant( ntk.size(), false );
+    for ( auto const& f : const_nodes )
+    {
+      is_constant[ntk.node_to_index( ntk.get_node( f ) )] = true;
+    }
+
+    foreach_target( zero, [&]( auto const& n, auto i ) {
       pbar( i, i, sim.num_bits() );
 
-      for ( auto& f : const_nodes )
+      if ( is_constant[ntk.node_to_index( n )] )
       {
-        if ( ntk.get_node( f ) == n )
-        {
-          return true; /* skip constant nodes */
-        }
+        return true; /* skip constant nodes */
       }
 
       if ( tts[n].num_bits() != sim.num_bits() )
@@ -401,12 +663,21 @@ private:
   {
     if constexpr( std::is_same_v<Simulator, bit_packed_simulator> )
     {
-      sim.add_pattern( pattern, compute_support( n ) );
+      auto const care = compute_support( n );
+      sim.add_pattern( pattern, care );
+      if ( exchange != nullptr )
+      {
+        pending.push_back( {pattern, care, worker} );
+      }
     }
     else
     {
       (void)n;
       sim.add_pattern( pattern );
+      if ( exchange != nullptr )
+      {
+        pending.push_back( {pattern, {}, worker} );
+      }
     }
     
     ++st.num_generated_patterns;
@@ -526,8 +797,152 @@ private:
   std::vector<signal> const_nodes;
 
   Simulator& sim;
+
+  std::chrono::steady_clock::time_point const start;
+  exchange_t* exchange{nullptr};
+  uint32_t worker{0u};
+  uint32_t cursor{0u};
+  std::vector<typename exchange_t::entry> pending;
+};
+
+template<class Ntk, class = void>
+struct patgen_has_storage : std::false_type
+{
+};
+
+template<class Ntk>
+struct patgen_has_storage<Ntk, std::void_t<typename Ntk::storage, decltype( Ntk( std::declval<typename Ntk::storage>() ) ), decltype( std::declval<Ntk>()._storage )>> : std::bool_constant<std::is_same_v<Ntk, typename Ntk::base_type>>
+{
 };
 
+/* deep copy, such that the workers do not share traversal ids or events */
+template<class Ntk>
+Ntk patgen_copy_network( Ntk const& ntk )
+{
+  return Ntk( std::make_shared<typename Ntk::storage::element_type>( *ntk._storage ) );
+}
+
+template<class Ntk, class Simulator, bool use_odc>
+void patgen_run_workers( Ntk& ntk, Simulator& sim, pattern_generation_params const& ps, pattern_generation_stats& st, uint32_t num_threads, bool observability,
+                         std::chrono::steady_clock::time_point start, std::vector<typename Ntk::signal>& const_nodes )
+{
+  using worker_ntk_t = std::conditional_t<use_odc, fanout_view<Ntk>, Ntk>;
+  using impl_t = patgen_impl<worker_ntk_t, Simulator, use_odc>;
+
+  std::vector<bool> is_constant( ntk.size(), false );
+  for ( auto const& f : const_nodes )
+  {
+    is_constant[ntk.node_to_index( ntk.get_node( f ) )] = true;
+  }
+
+  std::vector<typename Ntk::node> gates;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( !is_constant[ntk.node_to_index( n )] )
+    {
+      gates.emplace_back( n );
+    }
+  } );
+  patgen_exchange<typename Ntk::node> exchange( std::move( gates ), ps.sync_interval, start, st );
+
+  /* workers are created sequentially, since validators register network events */
+  std::vector<Ntk> copies;
+  std::vector<std::unique_ptr<worker_ntk_t>> views;
+  std::vector<Simulator> sims( num_threads, sim );
+  std::vector<validator_params> vpss( num_threads );
+  std::vector<pattern_generation_stats> stss( num_threads );
+  std::vector<std::unique_ptr<impl_t>> impls;
+  copies.reserve( num_threads );
+  for ( auto i = 0u; i < num_threads; ++i )
+  {
+    copies.emplace_back( patgen_copy_network( ntk ) );
+    views.emplace_back( std::make_unique<worker_ntk_t>( copies.back() ) );
+    vpss[i].conflict_limit = ps.conflict_limit;
+    vpss[i].max_clauses = ps.max_clauses;
+    vpss[i].random_seed = ps.random_seed + i;
+    impls.emplace_back( std::make_unique<impl_t>( *views.back(), sims[i], ps, vpss[i], stss[i], start ) );
+  }
+
+  std::vector<std::thread> threads;
+  for ( auto i = 0u; i < num_threads; ++i )
+  {
+    threads.emplace_back( [&, i]() {
+      impls[i]->run_worker( exchange, i, observability, const_nodes );
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  /* merge patterns, constants, and statistics */
+  for ( auto const& e : exchange.patterns() )
+  {
+    if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
+    {
+      sim.add_pattern( e.pattern, e.care );
+    }
+    else
+    {
+      sim.add_pattern( e.pattern );
+    }
+  }
+  st.num_generated_patterns += static_cast<uint32_t>( exchange.patterns().size() );
+
+  for ( auto i = 0u; i < num_threads; ++i )
+  {
+    if ( !observability )
+    {
+      for ( auto const& f : impls[i]->constant_nodes() )
+      {
+        const_nodes.emplace_back( f );
+      }
+    }
+    st.time_sim += stss[i].time_sim;
+    st.time_sat += stss[i].time_sat;
+    st.time_odc += stss[i].time_odc;
+    st.num_constant += stss[i].num_constant;
+    st.unobservable_type1 += stss[i].unobservable_type1;
+    st.unobservable_type2 += stss[i].unobservable_type2;
+    st.unobservable_node += stss[i].unobservable_node;
+  }
+}
+
+/* threaded mode of `pattern_generation` */
+template<class Ntk, class Simulator, bool use_odc>
+void patgen_parallel( Ntk& ntk, Simulator& sim, pattern_generation_params const& ps, pattern_generation_stats& st, uint32_t num_threads )
+{
+  stopwatch t( st.time_total );
+  auto const start = std::chrono::steady_clock::now();
+
+  std::vector<typename Ntk::signal> const_nodes;
+  if ( ps.num_stuck_at > 0 )
+  {
+    patgen_run_workers<Ntk, Simulator, use_odc>( ntk, sim, ps, st, num_threads, false, start, const_nodes );
+    if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
+    {
+      sim.pack_bits();
+    }
+    if ( ps.substitute_const )
+    {
+      patgen_impl<Ntk, Simulator>::substitute_constants( ntk, const_nodes );
+    }
+  }
+
+  if constexpr ( use_odc )
+  {
+    patgen_run_workers<Ntk, Simulator, use_odc>( ntk, sim, ps, st, num_threads, true, start, const_nodes );
+    if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
+    {
+      sim.pack_bits();
+    }
+  }
+
+  if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
+  {
+    sim.randomize_dont_care_bits( ps.random_seed );
+  }
+}
+
 } /* namespace detail */
 
 /*! \brief Expressive simulation pattern generation.
@@ -563,7 +978,30 @@ void pattern_generation( Ntk& ntk, Simulator& sim, pattern_generation_params con
   vps.max_clauses = ps.max_clauses;
   vps.random_seed = ps.random_seed;
 
-  if ( ps.odc_levels != 0 )
+  std::optional<pattern_store> store;
+  if ( ps.pattern_store_filename )
+  {
+    store.emplace( *ps.pattern_store_filename );
+    st.num_loaded_patterns = load_patterns( *store, ntk, sim );
+  }
+  auto const num_patterns_before = sim.num_bits();
+
+  auto const num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+  if ( detail::patgen_has_storage<Ntk>::value && num_threads > 1u )
+  {
+    if constexpr ( detail::patgen_has_storage<Ntk>::value )
+    {
+      if ( ps.odc_levels != 0 )
+      {
+        detail::patgen_parallel<Ntk, Simulator, true>( ntk, sim, ps, st, num_threads );
+      }
+      else
+      {
+        detail::patgen_parallel<Ntk, Simulator, false>( ntk, sim, ps, st, num_threads );
+      }
+    }
+  }
+  else if ( ps.odc_levels != 0 )
   {
     using fanout_view_t = fanout_view<Ntk>;
     fanout_view_t fanout_view{ntk};
@@ -577,6 +1015,11 @@ void pattern_generation( Ntk& ntk, Simulator& sim, pattern_generation_params con
     p.run();
   }
 
+  if ( store )
+  {
+    save_patterns( *store, ntk, sim, num_patterns_before );
+  }
+
   if ( pst )
   {
     *pst = st;
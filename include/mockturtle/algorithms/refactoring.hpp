@@ -37,6 +37,7 @@
 #include "../utils/cost_functions.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/window_index_arena.hpp"
 #include "../views/cut_view.hpp"
 #include "../views/mffc_view.hpp"
 #include "../views/topo_view.hpp"
@@ -130,7 +131,7 @@ class refactoring_impl
 {
 public:
   refactoring_impl( Ntk& ntk, RefactoringFn&& refactoring_fn, refactoring_params const& ps, refactoring_stats& st, NodeCostFn const& cost_fn )
-      : ntk( ntk ), refactoring_fn( refactoring_fn ), ps( ps ), st( st ), cost_fn( cost_fn ) {}
+      : ntk( ntk ), refactoring_fn( refactoring_fn ), ps( ps ), st( st ), cost_fn( cost_fn ), arena( ntk.size() ) {}
 
   void run()
   {
@@ -154,7 +155,7 @@ public:
       {
         return true;
       }
-      const auto mffc = make_with_stopwatch<mffc_view<Ntk>>( st.time_mffc, ntk, n );
+      const auto mffc = make_with_stopwatch<mffc_view<Ntk>>( st.time_mffc, ntk, n, &arena );
 
       pbar( i, i, _candidates, _estimated_gain );
 
@@ -272,6 +273,9 @@ private:
   refactoring_stats& st;
   NodeCostFn cost_fn;
 
+  /* reused by all MFFC views */
+  window_index_arena arena;
+
   uint32_t _candidates{0};
   uint32_t _estimated_gain{0};
 };
@@ -0,0 +1,266 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file reorder_nodes.hpp
+  \brief Renumbers nodes for locality of fanin accesses
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "cleanup.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for reorder_nodes.
+ *
+ * The data structure `reorder_nodes_params` holds configurable parameters
+ * with default arguments for `reorder_nodes`.
+ */
+struct reorder_nodes_params
+{
+  /*! \brief Node order. */
+  enum order_t
+  {
+    /*! \brief Depth-first order from the combinational outputs.
+     *
+     * Most gates are placed right after one of their fanins, which keeps
+     * the fanins of a gate close to it.
+     */
+    dfs,
+    /*! \brief Level-major order.
+     *
+     * Gates are ordered by their level, and by their depth-first order
+     * within a level.
+     */
+    level
+  } order = dfs;
+
+  /*! \brief Distance in nodes above which a fanin is far from its gate. */
+  uint32_t far_distance{4096u};
+
+  /*! \brief Reorder only if the fraction of far fanins exceeds this value.
+   *
+   * With a positive value, `reorder_nodes` can be called after each pass of
+   * a long flow and only reorders the network when its locality degraded.
+   */
+  double min_far_fanins{0.0};
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Statistics for reorder_nodes.
+ *
+ * The data structure `reorder_nodes_stats` provides data collected by
+ * running `reorder_nodes`.
+ */
+struct reorder_nodes_stats
+{
+  /*! \brief Total time. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Fraction of far fanins before reordering. */
+  double far_fanins_before{0.0};
+
+  /*! \brief Fraction of far fanins after reordering. */
+  double far_fanins_after{0.0};
+
+  /*! \brief Whether the network has been reordered. */
+  bool reordered{false};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] far fanins = {:>5.2f}% -> {:>5.2f}% ({})\n", 100.0 * far_fanins_before, 100.0 * far_fanins_after, reordered ? "reordered" : "skipped" );
+    std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+/* fraction of fanins of gates that are gates with an index at least `distance` smaller, or a larger index */
+template<class Ntk>
+double far_fanin_ratio( Ntk const& ntk, uint32_t distance )
+{
+  uint64_t num_fanins{0u}, num_far{0u};
+  ntk.foreach_gate( [&]( auto const& n ) {
+    const auto i = ntk.node_to_index( n );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      const auto c = ntk.get_node( f );
+      if ( ntk.is_constant( c ) || ntk.is_ci( c ) )
+      {
+        return;
+      }
+      const auto j = ntk.node_to_index( c );
+      ++num_fanins;
+      if ( j > i || i - j >= distance )
+      {
+        ++num_far;
+      }
+    } );
+  } );
+  return num_fanins == 0u ? 0.0 : static_cast<double>( num_far ) / num_fanins;
+}
+
+/* stable counting sort of gates in topological order by their level */
+template<class Ntk>
+std::vector<node<Ntk>> level_gate_order( Ntk const& ntk, std::vector<node<Ntk>> const& gates )
+{
+  std::vector<uint32_t> levels( ntk.size(), 0u );
+  uint32_t depth{0u};
+  for ( auto const& n : gates )
+  {
+    uint32_t level{0u};
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] );
+    } );
+    levels[ntk.node_to_index( n )] = ++level;
+    depth = std::max( depth, level );
+  }
+
+  std::vector<uint32_t> offsets( depth + 2u, 0u );
+  for ( auto const& n : gates )
+  {
+    ++offsets[levels[ntk.node_to_index( n )] + 1u];
+  }
+  std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+
+  std::vector<node<Ntk>> sorted( gates.size() );
+  for ( auto const& n : gates )
+  {
+    sorted[offsets[levels[ntk.node_to_index( n )]]++] = n;
+  }
+  return sorted;
+}
+
+} // namespace detail
+
+/*! \brief Renumbers the nodes of a network for locality.
+ *
+ * Nodes are stored in the order of their creation, such that after many
+ * rewriting passes, the fanins of a gate are scattered in memory and
+ * traversals, simulation, or cut enumeration cause many cache misses.  This
+ * function renumbers the gates in depth-first or level-major order (see
+ * `reorder_nodes_params::order`) in place, which moves the node data and
+ * rebuilds the structural hash table.  The CIs keep their order and
+ * dangling gates are removed.  Afterwards, the node indices are a
+ * topological order.
+ *
+ * The fraction of fanins that are far from their gates (see
+ * `reorder_nodes_params::far_distance`) is measured before reordering, and
+ * the network is only reordered if it exceeds
+ * `reorder_nodes_params::min_far_fanins`.
+ *
+ * Returns the new index of each old node, where removed nodes are mapped
+ * to 0, or an empty vector if the network has not been reordered.  Node
+ * maps and views of the network are invalidated.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_co`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `is_ci`
+ * - `is_constant`
+ * - `renumber_nodes`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      reorder_nodes_params ps;
+      ps.min_far_fanins = 0.2;
+
+      for ( auto i = 0u; i < 10u; ++i )
+      {
+        aig_resubstitution( aig, resub_ps );
+        cleanup_dangling_inplace( aig );
+        reorder_nodes( aig, ps ); // only reorders when needed
+      }
+   \endverbatim
+ */
+template<class Ntk>
+std::vector<node<Ntk>> reorder_nodes( Ntk& ntk, reorder_nodes_params const& ps = {}, reorder_nodes_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_renumber_nodes_v<Ntk>, "Ntk does not implement the renumber_nodes method" );
+
+  reorder_nodes_stats st;
+  std::vector<node<Ntk>> old_to_new;
+  {
+    stopwatch t( st.time_total );
+
+    st.far_fanins_before = detail::far_fanin_ratio( ntk, ps.far_distance );
+    st.far_fanins_after = st.far_fanins_before;
+    if ( ps.min_far_fanins <= 0.0 || st.far_fanins_before > ps.min_far_fanins )
+    {
+      auto gates = detail::dfs_gate_order( ntk );
+      if ( ps.order == reorder_nodes_params::level )
+      {
+        gates = detail::level_gate_order( ntk, gates );
+      }
+      old_to_new = ntk.renumber_nodes( gates );
+      st.far_fanins_after = detail::far_fanin_ratio( ntk, ps.far_distance );
+      st.reordered = true;
+    }
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return old_to_new;
+}
+
+} // namespace mockturtle
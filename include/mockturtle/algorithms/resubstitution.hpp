@@ -95,6 +95,11 @@ struct resubstitution_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. Only used by simulation-based resub engine. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Binary pattern store (see `pattern_store`) to reload patterns from and append the new patterns (with CEXs) to.
+   * If the store contains patterns of the network, they replace the 1024 random patterns. Only used by simulation-based resub engine.
+   */
+  std::optional<std::string> pattern_store_filename{};
+
   /*! \brief Conflict limit for the SAT solver. Only used by simulation-based resub engine. */
   uint32_t conflict_limit{1000};
 
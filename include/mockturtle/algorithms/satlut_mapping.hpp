@@ -32,9 +32,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "../generators/sorting.hpp"
+#include "../utils/conflict_slices.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/progress_bar.hpp"
@@ -75,6 +85,25 @@ struct satlut_mapping_params
    */
   uint32_t conflict_limit{0u};
 
+  /*! \brief Number of worker threads in the windowed `satlut_mapping` (1: sequential, 0: hardware concurrency).
+   *
+   * In the parallel mode, windows with disjoint gates are selected for the
+   * current mapping, solved concurrently, and their improvements are then
+   * committed to the network.  Windows that overlap with a window of the
+   * same batch are recomputed for the next batch.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Maximum number of windows per batch in the parallel mode (0: 8 windows per thread). */
+  uint32_t batch_size{0u};
+
+  /*! \brief Wall-clock time limit per window in the windowed `satlut_mapping` (in seconds, 0: no limit).
+   *
+   * If the limit is exceeded, the smallest mapping found so far for the
+   * window is kept.
+   */
+  double window_timeout{0.0};
+
   /*! \brief Show progress. */
   bool progress{false};
 
@@ -95,21 +124,37 @@ struct satlut_mapping_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{0};
 
-  /*! \brief Total runtime. */
+  /*! \brief SAT solving time (accumulated over all threads in the parallel mode). */
   stopwatch<>::duration time_sat{0};
 
-  /*! \brief Number of SAT variables. */
+  /*! \brief Number of SAT variables (summed over all windows in the windowed mode). */
   uint64_t num_vars{0u};
 
-  /*! \brief Number of SAT clauses. */
+  /*! \brief Number of SAT clauses (summed over all windows in the windowed mode). */
   uint64_t num_clauses{0u};
 
+  /*! \brief Number of solved windows (windowed mode). */
+  uint32_t num_windows{0u};
+
+  /*! \brief Number of windows with fewer cells after mapping (windowed mode). */
+  uint32_t num_improved_windows{0u};
+
+  /*! \brief Number of windows that exceeded the time limit (windowed mode). */
+  uint32_t num_timeouts{0u};
+
+  /*! \brief Number of batches of windows (parallel windowed mode). */
+  uint32_t num_batches{0u};
+
   void report()
   {
     std::cout << fmt::format( "[i] total time              = {:>7.2f} secs\n", to_seconds( time_total ) )
               << fmt::format( "[i] SAT solving time        = {:>7.2f} secs\n", to_seconds( time_sat ) )
               << fmt::format( "[i] number of SAT variables = {}\n", num_vars )
               << fmt::format( "[i] number of SAT clauses   = {}\n", num_clauses );
+    if ( num_windows )
+    {
+      std::cout << fmt::format( "[i] windows                 = {} ({} improved, {} timeouts, {} batches)\n", num_windows, num_improved_windows, num_timeouts, num_batches );
+    }
   }
 };
 
@@ -181,12 +226,14 @@ class satlut_mapping_impl
 public:
   using network_cuts_t = network_cuts<Ntk, StoreFunction, CutData>;
   using cut_t = typename network_cuts_t::cut_t;
+  using deadline_t = std::optional<std::chrono::steady_clock::time_point>;
 
 public:
-  satlut_mapping_impl( Ntk& ntk, satlut_mapping_params const& ps, satlut_mapping_stats& st )
+  satlut_mapping_impl( Ntk& ntk, satlut_mapping_params const& ps, satlut_mapping_stats& st, deadline_t const& deadline = std::nullopt )
       : ntk( ntk ),
         ps( ps ),
         st( st ),
+        deadline( deadline ),
         cuts( cut_enumeration<Ntk, StoreFunction, CutData>( ntk, ps.cut_enumeration_ps ) )
   {
   }
@@ -195,6 +242,15 @@ public:
   {
     stopwatch t( st.time_total );
 
+    if ( solve() )
+    {
+      commit();
+    }
+  }
+
+  /* finds the smallest mapping within the resource limits, returns false if no mapping was found */
+  bool solve()
+  {
     std::vector<int> card_inp;
     node_map<int, Ntk> gate_var( ntk );
     node_map<std::vector<int>, Ntk> cut_vars( ntk );
@@ -243,10 +299,11 @@ public:
       solver.add_clause( &lit, &lit + 1 );
     } );
 
-    st.num_vars = solver.nr_vars();
-    st.num_clauses = solver.nr_clauses();
+    st.num_vars += solver.nr_vars();
+    st.num_clauses += solver.nr_clauses();
 
     auto best_size = ntk.has_mapping() ? ntk.num_cells() + 1 : card_inp.size();
+    auto found = false;
 
     progress_bar pbar{"satlut iteration = {0}   try size = {1}", ps.progress};
     auto iteration = 0u;
@@ -261,10 +318,11 @@ public:
       }
       auto assump = pabc::Abc_Var2Lit( card_out[card_out.size() - best_size], 1 );
 
-      const auto result = call_with_stopwatch( st.time_sat, [&]() { return solver.solve( &assump, &assump + 1, ps.conflict_limit ); } );
+      const auto result = call_with_stopwatch( st.time_sat, [&]() { return solve_with_deadline( solver, assump ); } );
       if ( result == percy::success )
       {
-        ntk.clear_mapping();
+        found = true;
+        best_cells.clear();
         ntk.foreach_gate( [&]( auto n ) {
           if ( solver.var_value( gate_var[n] ) )
           {
@@ -272,44 +330,265 @@ public:
             {
               if ( solver.var_value( cut_vars[n][i] ) )
               {
-                const auto index = ntk.node_to_index( n );
-                std::vector<node<Ntk>> nodes;
-                for ( auto const& l : cuts.cuts( index )[i] )
-                {
-                  nodes.push_back( ntk.index_to_node( l ) );
-                }
-                ntk.add_to_mapping( n, nodes.begin(), nodes.end() );
-
-                if constexpr ( StoreFunction )
-                {
-                  ntk.set_cell_function( n, cuts.truth_table( cuts.cuts( index )[i] ) );
-                }
+                best_cells.emplace_back( n, i );
                 break;
               }
             }
           }
         } );
 
-        if ( ntk.num_cells() == ntk.num_pos() )
+        if ( best_cells.size() == ntk.num_pos() )
         {
           /* no further improvement possible */
           break;
         }
 
-        best_size = ntk.num_cells();
+        best_size = best_cells.size();
       }
       else
       {
+        timed_out = result == percy::timeout && deadline && std::chrono::steady_clock::now() >= *deadline;
         break;
       }
     }
+
+    return found;
+  }
+
+  /* replaces the mapping of the network by the mapping found by `solve` */
+  void commit()
+  {
+    ntk.clear_mapping();
+
+    std::vector<node<Ntk>> nodes;
+    for ( auto const& [n, i] : best_cells )
+    {
+      const auto index = ntk.node_to_index( n );
+      nodes.clear();
+      for ( auto const& l : cuts.cuts( index )[i] )
+      {
+        nodes.push_back( ntk.index_to_node( l ) );
+      }
+      ntk.add_to_mapping( n, nodes.begin(), nodes.end() );
+
+      if constexpr ( StoreFunction )
+      {
+        ntk.set_cell_function( n, cuts.truth_table( cuts.cuts( index )[i] ) );
+      }
+    }
+  }
+
+  /* number of cells of the mapping found by `solve` */
+  uint32_t num_cells() const
+  {
+    return static_cast<uint32_t>( best_cells.size() );
+  }
+
+  bool has_timed_out() const
+  {
+    return timed_out;
+  }
+
+private:
+  /* bsat cannot be interrupted, so with a deadline the solver is called with
+   * a growing conflict limit until it terminates or the deadline has passed */
+  percy::synth_result solve_with_deadline( percy::bsat_wrapper& solver, int assump )
+  {
+    if ( !deadline )
+    {
+      return solver.solve( &assump, &assump + 1, ps.conflict_limit );
+    }
+
+    int32_t last_limit{0};
+    return solve_with_conflict_slices(
+        [&]( int32_t limit ) { return solver.solve( &assump, &assump + 1, limit ); },
+        static_cast<int32_t>( std::min<uint32_t>( ps.conflict_limit, std::numeric_limits<int32_t>::max() ) ), true, deadline, []() { return false; }, last_limit );
   }
 
 private:
   Ntk& ntk;
   satlut_mapping_params const& ps;
   satlut_mapping_stats& st;
+  deadline_t deadline;
   network_cuts_t cuts;
+
+  std::vector<std::pair<node<Ntk>, uint32_t>> best_cells; /* cell roots and their cut indexes */
+  bool timed_out{false};
+};
+
+/* solves disjoint windows of the mapping concurrently and commits their improvements */
+template<class Ntk, bool StoreFunction, typename CutData>
+class satlut_parallel_windows_impl
+{
+public:
+  using window_t = topo_view<cell_window<Ntk>>;
+  using window_impl_t = satlut_mapping_impl<window_t, StoreFunction, CutData>;
+
+public:
+  satlut_parallel_windows_impl( Ntk& ntk, uint32_t window_size, satlut_mapping_params const& ps, satlut_mapping_stats& st )
+      : ntk( ntk ),
+        window_size( window_size ),
+        ps( ps ),
+        st( st ),
+        inner_ps( ps )
+  {
+    inner_ps.progress = false; /* do not show inner progress */
+    num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+    batch_size = ps.batch_size == 0u ? 8u * num_threads : ps.batch_size;
+  }
+
+  void run()
+  {
+    cell_window window( ntk, window_size );
+
+    std::vector<node<Ntk>> gates;
+    gates.reserve( ntk.num_gates() );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+
+    progress_bar pbar{static_cast<uint32_t>( gates.size() ), "satlut (parallel) |{0}| gate = {1:>4} / " + std::to_string( gates.size() ) + "   batches = {2}", ps.progress};
+    std::vector<uint32_t> claimed( ntk.size(), 0u ); /* batch that claimed a gate */
+    std::vector<node<Ntk>> retry, deferred;
+    std::vector<window_t> windows;
+    auto next_gate = 0u;
+
+    while ( next_gate < gates.size() || !retry.empty() )
+    {
+      ++st.num_batches;
+      pbar( next_gate, next_gate, st.num_batches );
+      window.init_cell_refs();
+      windows.clear();
+      deferred.clear();
+
+      /* windows that overlap with a window of this batch are deferred to the next batch */
+      const auto select = [&]( node<Ntk> const& n ) {
+        if ( !ntk.is_cell_root( n ) || !window.peek_window_for( n ) )
+        {
+          return;
+        }
+        if ( window.num_cells() == window.num_pos() || window.num_pos() == 0 )
+        {
+          window.mark_window_visited();
+          return;
+        }
+
+        auto overlaps = false;
+        window.foreach_gate( [&]( auto const& g ) {
+          overlaps = claimed[ntk.node_to_index( g )] == st.num_batches;
+          return !overlaps;
+        } );
+        if ( overlaps )
+        {
+          deferred.push_back( n );
+          return;
+        }
+
+        window.mark_window_visited();
+        window.foreach_gate( [&]( auto const& g ) {
+          claimed[ntk.node_to_index( g )] = st.num_batches;
+        } );
+        windows.emplace_back( window.snapshot() );
+      };
+
+      for ( auto const& n : retry )
+      {
+        if ( windows.size() < batch_size )
+        {
+          select( n );
+        }
+        else
+        {
+          deferred.push_back( n );
+        }
+      }
+      while ( windows.size() < batch_size && next_gate < gates.size() )
+      {
+        select( gates[next_gate++] );
+      }
+      std::swap( retry, deferred );
+
+      solve_batch( windows );
+    }
+  }
+
+private:
+  void solve_batch( std::vector<window_t>& windows )
+  {
+    std::vector<std::unique_ptr<window_impl_t>> impls( windows.size() );
+    std::vector<satlut_mapping_stats> stats( windows.size() );
+    std::vector<uint8_t> found( windows.size(), 0u );
+
+    std::atomic<std::size_t> next_window{0};
+    const auto worker = [&]() {
+      while ( true )
+      {
+        const auto i = next_window++;
+        if ( i >= windows.size() )
+        {
+          return;
+        }
+
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        if ( ps.window_timeout > 0.0 )
+        {
+          deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( ps.window_timeout ) );
+        }
+        impls[i] = std::make_unique<window_impl_t>( windows[i], inner_ps, stats[i], deadline );
+        found[i] = impls[i]->solve();
+      }
+    };
+
+    const auto threads_used = static_cast<uint32_t>( std::min<std::size_t>( num_threads, windows.size() ) );
+    if ( threads_used <= 1u )
+    {
+      worker();
+    }
+    else
+    {
+      std::vector<std::thread> threads;
+      for ( auto i = 0u; i < threads_used; ++i )
+      {
+        threads.emplace_back( worker );
+      }
+      for ( auto& thread : threads )
+      {
+        thread.join();
+      }
+    }
+
+    /* commit in the order of selection */
+    for ( auto i = 0u; i < windows.size(); ++i )
+    {
+      ++st.num_windows;
+      st.time_sat += stats[i].time_sat;
+      st.num_vars += stats[i].num_vars;
+      st.num_clauses += stats[i].num_clauses;
+      if ( impls[i]->has_timed_out() )
+      {
+        ++st.num_timeouts;
+      }
+      if ( !found[i] )
+      {
+        continue;
+      }
+      if ( impls[i]->num_cells() < windows[i].num_cells() )
+      {
+        ++st.num_improved_windows;
+      }
+      impls[i]->commit();
+    }
+  }
+
+private:
+  Ntk& ntk;
+  uint32_t window_size;
+  satlut_mapping_params const& ps;
+  satlut_mapping_stats& st;
+
+  satlut_mapping_params inner_ps;
+  uint32_t num_threads{1u};
+  uint32_t batch_size{1u};
 };
 
 } // namespace detail
@@ -383,6 +662,13 @@ void satlut_mapping( Ntk& ntk, satlut_mapping_params const& ps = {}, satlut_mapp
  * The initial network must already contain a mapping, e.g., found with
  * `lut_mapping`.
  *
+ * If `ps.num_threads` is not 1, windows are solved in parallel.  For the
+ * current mapping, a batch of windows with disjoint gates is selected, the
+ * windows are mapped concurrently with a fixed mapping outside the windows,
+ * and the improvements are committed to the network.  The result may
+ * therefore differ from the sequential mode.  The time for each window can
+ * be limited with `ps.window_timeout`.
+ *
  * **Required network functions:**
  * - `is_pi`
  * - `index_to_node`
@@ -427,41 +713,79 @@ void satlut_mapping( Ntk& ntk, uint32_t window_size, satlut_mapping_params ps =
 
   satlut_mapping_stats st;
   stopwatch<>::duration time_total{};
-  cell_window window( ntk, window_size );
-  progress_bar pbar{ntk.size(), "satlut (windowed) |{0}| node = {1:>4} / " + std::to_string( ntk.size() ), ps.progress};
-  ps.progress = false; /* do not show inner progress */
-  ntk.foreach_gate( [&]( auto n, int index ) {
+
+  if ( ps.num_threads != 1u )
+  {
     stopwatch<> t( time_total );
-    pbar( index, ntk.node_to_index( n ) );
-    if ( ntk.is_cell_root( n ) )
-    {
-      if ( !window.compute_window_for( n ) ) /* window has been visited before */
+    detail::satlut_parallel_windows_impl<Ntk, StoreFunction, CutData> p( ntk, window_size, ps, st );
+    p.run();
+  }
+  else
+  {
+    cell_window window( ntk, window_size );
+    progress_bar pbar{ntk.size(), "satlut (windowed) |{0}| node = {1:>4} / " + std::to_string( ntk.size() ), ps.progress};
+    ps.progress = false; /* do not show inner progress */
+    auto mapping_changed = true;
+    ntk.foreach_gate( [&]( auto n, int index ) {
+      stopwatch<> t( time_total );
+      pbar( index, ntk.node_to_index( n ) );
+      if ( ntk.is_cell_root( n ) )
       {
-        return true;
-      }
+        /* cell references only need to be recomputed if the mapping has changed */
+        if ( mapping_changed )
+        {
+          window.init_cell_refs();
+          mapping_changed = false;
+        }
+        const auto is_new = window.peek_window_for( n ) && window.mark_window_visited();
+        if ( !is_new ) /* window has been visited before */
+        {
+          return true;
+        }
 
-      if ( ps.verbose )
-      {
-        std::cout << fmt::format( "[i] cell {:>5}   size = {:>4}   nodes = {:>2}   gates = {:>3}   pis = {:>3}   pos = {:>3}\n",
-                                  n,
-                                  window.size(),
-                                  window.num_cells(),
-                                  window.num_gates(),
-                                  window.num_pis(),
-                                  window.num_pos() );
-      }
-      if ( window.num_cells() == window.num_pos() || window.num_pos() == 0 )
-      {
+        if ( ps.verbose )
+        {
+          std::cout << fmt::format( "[i] cell {:>5}   size = {:>4}   nodes = {:>2}   gates = {:>3}   pis = {:>3}   pos = {:>3}\n",
+                                    n,
+                                    window.size(),
+                                    window.num_cells(),
+                                    window.num_gates(),
+                                    window.num_pis(),
+                                    window.num_pos() );
+        }
+        if ( window.num_cells() == window.num_pos() || window.num_pos() == 0 )
+        {
+          return true;
+        }
+
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        if ( ps.window_timeout > 0.0 )
+        {
+          deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( ps.window_timeout ) );
+        }
+
+        topo_view window_topo{window};
+        detail::satlut_mapping_impl<decltype( window_topo ), StoreFunction, CutData> p( window_topo, ps, st, deadline );
+        ++st.num_windows;
+        if ( p.solve() )
+        {
+          if ( p.num_cells() < window.num_cells() )
+          {
+            ++st.num_improved_windows;
+          }
+          p.commit();
+          mapping_changed = true;
+        }
+        if ( p.has_timed_out() )
+        {
+          ++st.num_timeouts;
+        }
         return true;
       }
-      topo_view window_topo{window};
-      detail::satlut_mapping_impl<decltype(window_topo), StoreFunction, CutData> p( window_topo, ps, st );
-      p.run();
-      return true;
-    }
 
-    return true;
-  } );
+      return true;
+    } );
+  }
 
   st.time_total = time_total;
 
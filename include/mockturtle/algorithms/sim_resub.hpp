@@ -34,8 +34,11 @@
 
 #include <variant>
 #include <algorithm>
+#include <limits>
 
 #include "../utils/abc_resub.hpp"
+#include "../utils/divisor_kernels.hpp"
+#include "../utils/pattern_store.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/abc_resub.hpp"
@@ -164,6 +167,7 @@ public:
     care = care_;
     tt = tts[root] & care;
     ntt = ~tts[root] & care;
+    batches_ready = false;
 
     while ( true )
     {
@@ -230,6 +234,7 @@ public:
         }
         case 2u:
         {
+          prepare_batches();
           if ( j == udivs.positive_divisors.size() )
           {
             break_div1_pos_inner();
@@ -254,6 +259,7 @@ public:
         }
         case 3u:
         {
+          prepare_batches();
           if ( j == udivs.negative_divisors.size() )
           {
             break_div1_neg_inner();
@@ -360,10 +366,54 @@ private:
     return std::nullopt;
   }
 
+  /* The truth tables may grow between two invocations of the functor, so
+   * the batches of unate divisors are built again in each invocation. */
+  void prepare_batches()
+  {
+    if ( batches_ready )
+    {
+      return;
+    }
+
+    auto const layout = make_tt_layout( tt );
+    auto const t = make_tt_ref( tt );
+    auto const c = make_tt_ref( care );
+    positive_batch.reset( layout );
+    for ( auto const& d : udivs.positive_divisors )
+    {
+      positive_batch.add( make_tt_ref( tts[ntk.get_node( d.first )], ntk.is_complemented( d.first ) ) );
+    }
+    negative_batch.reset( layout );
+    for ( auto const& d : udivs.negative_divisors )
+    {
+      negative_batch.add( make_tt_ref( tts[ntk.get_node( d.first )], ntk.is_complemented( d.first ) ) );
+    }
+
+    /* index the divisors by the onset (positive) and offset (negative) minterms that they cover */
+    positive_index.build( positive_batch, []( auto a ) { return a; }, []( auto t ) { return t; }, t );
+    negative_index.build( negative_batch, []( auto a ) { return ~a; }, []( auto t, auto c ) { return ~t & c; }, t, c );
+    partners_of = std::numeric_limits<uint32_t>::max();
+    batches_ready = true;
+  }
+
+  /* skips the divisors from j on that cannot be the partner of divisor i,
+   * returns false if there are no more candidates */
+  template<typename Required>
+  bool next_partner( divisor_index const& index, divisor_batch<1u> const& batch, Required&& required )
+  {
+    if ( partners_of != i )
+    {
+      partners = index.make_query( required, make_tt_ref( tt ), make_tt_ref( care ), batch[i][0] );
+      partners_of = i;
+    }
+
+    j = std::min( index.next_candidate( partners, j ), batch.size() );
+    return j < batch.size();
+  }
+
   std::optional<result_t> resub_div1_pos()
   {
     auto const& s0 = udivs.positive_divisors.at( i ).first;
-    auto const& tt_s0 = get_tt( ntk.get_node( s0 ), ntk.is_complemented( s0 ) );
     auto const& w_s0 = udivs.positive_divisors.at( i ).second;
     if ( w_s0 < uint32_t( w / 2 ) ) /* break div1_pos */
     {
@@ -371,23 +421,19 @@ private:
       return std::nullopt;
     }
 
-    if ( w_s0 + udivs.positive_divisors.at( j ).second < w ) /* break inner loop */
+    if ( !next_partner( positive_index, positive_batch, []( auto t, auto c, auto a ) { (void)c; return t & ~a; } ) ||
+         w_s0 + udivs.positive_divisors.at( j ).second < w ) /* break inner loop */
     {
       break_div1_pos_inner();
       return std::nullopt;
     }
 
     auto const& s1 = udivs.positive_divisors.at( j ).first;
-    auto const& tt_s1 = get_tt( ntk.get_node( s1 ), ntk.is_complemented( s1 ) );
-
-    for ( auto b = 0u; b < tt.num_blocks(); ++b )
+    if ( !positive_batch.test( j, []( auto t, auto c, auto a, auto b ) { return ( ( a | b ) & c ) ^ t; }, make_tt_ref( tt ), make_tt_ref( care ), positive_batch[i][0] ) )
     {
-      if ( ( tt_s0._bits[b] | tt_s1._bits[b] ) != tt._bits[b] )
-      {
-        return std::nullopt;
-      }
+      return std::nullopt;
     }
-    assert( tt == ( tt_s0 | tt_s1 ) );
+    assert( tt == ( get_tt( ntk.get_node( s0 ), ntk.is_complemented( s0 ) ) | get_tt( ntk.get_node( s1 ), ntk.is_complemented( s1 ) ) ) );
     fanin fi1{0, !ntk.is_complemented( s0 )};
     fanin fi2{1, !ntk.is_complemented( s1 )};
     vgate gate{{fi1, fi2}, gtype::AND};
@@ -399,7 +445,6 @@ private:
   std::optional<result_t> resub_div1_neg()
   {
     auto const& s0 = udivs.negative_divisors.at( i ).first;
-    auto const& tt_s0 = get_tt( ntk.get_node( s0 ), ntk.is_complemented( s0 ) );
     auto const& w_s0 = udivs.negative_divisors.at( i ).second;
     if ( w_s0 < uint32_t( nw / 2 ) ) /* break div1_neg */
     {
@@ -407,23 +452,19 @@ private:
       return std::nullopt;
     }
 
-    if ( w_s0 + udivs.negative_divisors.at( j ).second < nw ) /* break inner loop */
+    if ( !next_partner( negative_index, negative_batch, []( auto t, auto c, auto a ) { return ~t & c & a; } ) ||
+         w_s0 + udivs.negative_divisors.at( j ).second < nw ) /* break inner loop */
     {
       break_div1_neg_inner();
       return std::nullopt;
     }
 
     auto const& s1 = udivs.negative_divisors.at( j ).first;
-    auto const& tt_s1 = get_tt( ntk.get_node( s1 ), ntk.is_complemented( s1 ) );
-
-    for ( auto b = 0u; b < tt.num_blocks(); ++b )
+    if ( !negative_batch.test( j, []( auto t, auto c, auto a, auto b ) { return ( a & b & c ) ^ t; }, make_tt_ref( tt ), make_tt_ref( care ), negative_batch[i][0] ) )
     {
-      if ( ( tt_s0._bits[b] & tt_s1._bits[b] ) != tt._bits[b] )
-      {
-        return std::nullopt;
-      }
+      return std::nullopt;
     }
-    assert( tt == ( tt_s0 & tt_s1 ) );
+    assert( tt == ( get_tt( ntk.get_node( s0 ), ntk.is_complemented( s0 ) ) & get_tt( ntk.get_node( s1 ), ntk.is_complemented( s1 ) ) ) );
     fanin fi1{0, ntk.is_complemented( s0 )};
     fanin fi2{1, ntk.is_complemented( s1 )};
     vgate gate{{fi1, fi2}, gtype::AND};
@@ -436,6 +477,7 @@ private:
   void break_div1_pos()
   {
     i = 0; j = 1;
+    partners_of = std::numeric_limits<uint32_t>::max();
     ++step;
     if ( udivs.negative_divisors.size() < 2 )
     {
@@ -487,6 +529,14 @@ private:
   unate_divisors udivs;
   std::vector<node> tmp;
 
+  divisor_batch<1u> positive_batch;
+  divisor_batch<1u> negative_batch;
+  divisor_index positive_index;
+  divisor_index negative_index;
+  divisor_index::query partners;
+  uint32_t partners_of{0};
+  bool batches_ready{false};
+
   uint32_t const num_inserts;
   uint32_t step;
   uint32_t i;
@@ -767,13 +817,21 @@ public:
 
     /* prepare simulation patterns */
     call_with_stopwatch( st.time_patgen, [&]() {
-      if ( ps.pattern_filename )
+      sim = ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), 0 );
+      if ( ps.pattern_store_filename )
       {
-        sim = partial_simulator( *ps.pattern_filename );
+        store.emplace( *ps.pattern_store_filename );
+        if ( load_patterns( *store, ntk, sim ) > 0u )
+        {
+          store_begin = sim.num_bits();
+        }
       }
-      else
+      if ( !ps.pattern_filename )
       {
-        sim = partial_simulator( ntk.num_pis(), 1024 );
+        if ( store_begin == 0u )
+        {
+          sim = partial_simulator( ntk.num_pis(), 1024 );
+        }
         pattern_generation( ntk, sim );
       }
     });
@@ -791,6 +849,10 @@ public:
     {
       write_patterns( sim, *ps.save_patterns );
     }
+    if ( store )
+    {
+      save_patterns( *store, ntk, sim, store_begin );
+    }
   }
 
   std::optional<signal> run( node const& n, std::vector<node> const& divs, uint32_t potential_gain, uint32_t& last_gain )
@@ -950,6 +1012,8 @@ private:
 
   unordered_node_map<TT, Ntk> tts;
   partial_simulator sim;
+  std::optional<pattern_store> store;
+  uint64_t store_begin{0u};
 
   validator_params vps;
   validator_t validator;
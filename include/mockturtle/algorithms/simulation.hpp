@@ -37,8 +37,10 @@
 #include <vector>
 #include <fstream>
 #include <random>
+#include <type_traits>
 
 #include "../traits.hpp"
+#include "../utils/mapped_vector.hpp"
 #include "../utils/node_map.hpp"
 
 #include <kitty/constructors.hpp>
@@ -748,6 +750,54 @@ void simulate_nodes( Ntk const& ntk, unordered_node_map<kitty::partial_truth_tab
   }
 }
 
+namespace detail
+{
+
+/* simulates an out-of-core network in topological order, keeping the node
+ * values in a memory-mapped file and regularly dropping the nodes and
+ * values that have been visited from memory */
+template<class SimulationType, class Ntk, class Simulator>
+std::vector<SimulationType> simulate_out_of_core( Ntk const& ntk, Simulator const& sim )
+{
+  mapped_vector<SimulationType> values;
+  values.resize( ntk.size() );
+
+  const auto c0 = ntk.get_node( ntk.get_constant( false ) );
+  values[ntk.node_to_index( c0 )] = sim.compute_constant( ntk.constant_value( c0 ) );
+  if ( const auto c1 = ntk.get_node( ntk.get_constant( true ) ); c1 != c0 )
+  {
+    values[ntk.node_to_index( c1 )] = sim.compute_constant( ntk.constant_value( c1 ) );
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    values[ntk.node_to_index( n )] = sim.compute_pi( i );
+  } );
+
+  std::vector<SimulationType> fanin_values;
+  uint32_t counter{0u};
+  ntk.foreach_gate( [&]( auto const& n ) {
+    fanin_values.resize( ntk.fanin_size( n ) );
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      fanin_values[i] = values[ntk.node_to_index( ntk.get_node( f ) )];
+    } );
+    values[ntk.node_to_index( n )] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+
+    if ( ( ++counter & 0xffff ) == 0u )
+    {
+      ntk.release_nodes( 0u, n );
+      values.release( 0u, ntk.node_to_index( n ) );
+    }
+  } );
+
+  std::vector<SimulationType> po_values( ntk.num_pos() );
+  ntk.foreach_po( [&]( auto const& f, auto i ) {
+    auto const& value = values[ntk.node_to_index( ntk.get_node( f ) )];
+    po_values[i] = ntk.is_complemented( f ) ? sim.compute_not( value ) : value;
+  } );
+  return po_values;
+}
+
+} // namespace detail
+
 /*! \brief Simulates a network with a generic simulator.
  *
  * This is a generic simulation algorithm that can simulate arbitrary values.
@@ -766,6 +816,11 @@ void simulate_nodes( Ntk const& ntk, unordered_node_map<kitty::partial_truth_tab
  * position) to it's simulation value (taking possible complemented attributes
  * into account).
  *
+ * For out-of-core networks (e.g., `mapped_aig_network`) and trivially
+ * copyable simulation values (e.g., `bool` or `kitty::static_truth_table`),
+ * the node values are stored in a memory-mapped file and the visited nodes
+ * are dropped from memory, such that the resident memory is bounded.
+ *
  * **Required network functions:**
  * - `foreach_po`
  * - `is_complemented`
@@ -782,20 +837,27 @@ std::vector<SimulationType> simulate( Ntk const& ntk, Simulator const& sim = Sim
   static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented function" );
   static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute function for SimulationType" );
 
-  const auto node_to_value = simulate_nodes<SimulationType, Ntk, Simulator>( ntk, sim );
+  if constexpr ( is_out_of_core_v<Ntk> && std::is_trivially_copyable_v<SimulationType> )
+  {
+    return detail::simulate_out_of_core<SimulationType>( ntk, sim );
+  }
+  else
+  {
+    const auto node_to_value = simulate_nodes<SimulationType, Ntk, Simulator>( ntk, sim );
 
-  std::vector<SimulationType> po_values( ntk.num_pos() );
-  ntk.foreach_po( [&]( auto const& f, auto i ) {
-    if ( ntk.is_complemented( f ) )
-    {
-      po_values[i] = sim.compute_not( node_to_value[f] );
-    }
-    else
-    {
-      po_values[i] = node_to_value[f];
-    }
-  } );
-  return po_values;
+    std::vector<SimulationType> po_values( ntk.num_pos() );
+    ntk.foreach_po( [&]( auto const& f, auto i ) {
+      if ( ntk.is_complemented( f ) )
+      {
+        po_values[i] = sim.compute_not( node_to_value[f] );
+      }
+      else
+      {
+        po_values[i] = node_to_value[f];
+      }
+    } );
+    return po_values;
+  }
 }
 
 } // namespace mockturtle
\ No newline at end of file
@@ -33,6 +33,7 @@
 #include "../networks/events.hpp"
 #include "../utils/index_list.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/window_index_arena.hpp"
 #include "../utils/window_utils.hpp"
 #include "../views/topo_view.hpp"
 #include "../views/window_view.hpp"
@@ -84,6 +85,7 @@ public:
     : ntk( ntk )
     , ps( ps )
     , st( st )
+    , arena( ntk.size() )
   {
     auto const update_level_of_new_node = []( void *wp, const auto& n ) {
       auto self = reinterpret_cast<window_rewriting_impl *>(wp);
@@ -127,7 +129,7 @@ public:
 
       if ( const auto w = windowing.run( n, ps.cut_size, ps.num_levels ) )
       {
-        window_view win( ntk, w->inputs, w->outputs, w->nodes );
+        window_view win( ntk, w->inputs, w->outputs, w->nodes, &arena );
         topo_view topo_win{win};
 
         abc_index_list il;
@@ -335,6 +337,9 @@ private:
   Ntk& ntk;
   window_rewriting_params ps;
   window_rewriting_stats& st;
+
+  /* reused by all window views */
+  window_index_arena arena;
 }; /* window_rewriting_impl */
 
 } /* detail */
@@ -222,13 +222,16 @@ inline xag_network linear_resynthesis_optimization( xag_network const& xag, std:
   const auto linear = extract_linear_circuit( xag ).first;
 
   /* ignore inputs (if linear resynthesis is not cancellation-free) */
-  on_ignore_inputs( {} );
-  for ( auto i = 0u; i < num_ands; ++i )
+  if ( on_ignore_inputs )
   {
-    std::vector<uint32_t> ignore( num_ands - i );
-    std::iota( ignore.begin(), ignore.end(), xag.num_pis() + i );
-    on_ignore_inputs( ignore );
-    on_ignore_inputs( ignore );
+    on_ignore_inputs( {} );
+    for ( auto i = 0u; i < num_ands; ++i )
+    {
+      std::vector<uint32_t> ignore( num_ands - i );
+      std::iota( ignore.begin(), ignore.end(), xag.num_pis() + i );
+      on_ignore_inputs( ignore );
+      on_ignore_inputs( ignore );
+    }
   }
 
   const auto linear_optimized = linear_resyn( linear );
@@ -241,6 +244,36 @@ inline xag_network linear_resynthesis_optimization( xag_network const& xag, std:
   return merge_linear_circuit( linear_optimized, num_ands );
 }
 
+/*! \brief Optimizes XOR gates by linear network resynthesis with Paar's algorithm
+ */
+inline xag_network paar_linear_resynthesis_optimization( xag_network const& xag )
+{
+  return linear_resynthesis_optimization( xag, []( xag_network const& linear ) {
+    return linear_resynthesis_paar( linear );
+  } );
+}
+
+/*! \brief Optimizes XOR gates by linear network resynthesis with the Boyar-Peralta heuristic
+ *
+ * The inputs to ignore for each output are set by this function, such that
+ * the result can be merged back with the AND gates.
+ */
+inline xag_network boyar_peralta_linear_resynthesis_optimization( xag_network const& xag, linear_resynthesis_boyar_peralta_params const& ps = {}, linear_resynthesis_boyar_peralta_stats* pst = nullptr )
+{
+  auto ps_linear = ps;
+  ps_linear.ignore_inputs.clear();
+
+  const auto linear_resyn = [&]( xag_network const& linear ) {
+    return linear_resynthesis_boyar_peralta( linear, ps_linear, pst );
+  };
+
+  const auto on_ignore_inputs = [&]( std::vector<uint32_t> const& ignore ) {
+    ps_linear.ignore_inputs.push_back( ignore );
+  };
+
+  return linear_resynthesis_optimization( xag, linear_resyn, on_ignore_inputs );
+}
+
 /*! \brief Optimizes XOR gates by exact linear network resynthesis
  */
 template<bill::solvers Solver = bill::solvers::glucose_41>
@@ -172,12 +172,14 @@ public:
   std::optional<signal> resub_div0( node const& root, TT& care, uint32_t required ) const
   {
     (void)required;
-    auto const tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const layout = sim.get_tt_layout();
+    auto const tt = sim.get_tt_ref( ntk.make_signal( root ) );
+    auto const care_ref = make_tt_ref( care );
     for ( auto i = 0u; i < num_divs; ++i )
     {
       auto const d = divs.at( i );
 
-      if ( binary_and( tt, care ) != binary_and( sim.get_tt( ntk.make_signal( d ) ), care ) )
+      if ( !is_const0_words( layout, []( auto t, auto c, auto a ) { return ( a ^ t ) & c; }, tt, care_ref, sim.get_tt_ref( ntk.make_signal( d ) ) ) )
         continue; /* next */
 
       return ( sim.get_phase( d ) ^ sim.get_phase( root ) ) ? !ntk.make_signal( d ) : ntk.make_signal( d );
@@ -201,15 +203,24 @@ public:
   {
     (void)required;
     auto const& tt = sim.get_tt( ntk.make_signal( root ) );
+    auto const layout = sim.get_tt_layout();
+    auto const target = sim.get_tt_ref( ntk.make_signal( root ) );
+    auto const care_ref = make_tt_ref( care );
 
     const auto root_rdb = static_cast<int32_t>( absolute_distinguishing_power( tt ) );
 
+    /* relative distinguishing power from the number of ones in the divisor and in its intersection with the target */
+    uint64_t const num_bits = tt.num_bits();
+    uint64_t const ones_tt = kitty::count_ones( tt );
     std::vector<divisor> sorted_divs;
     for ( auto it = std::begin( divs ), ie = std::begin( divs ) + num_divs; it != ie; ++it )
     {
       auto const s = ntk.make_signal( *it );
-      auto const& tt_s = sim.get_tt( s );
-      sorted_divs.emplace_back( static_cast<uint32_t>( *it ), static_cast<uint32_t>( relative_distinguishing_power( tt_s, tt ) ) );
+      auto const tt_s = sim.get_tt_ref( s );
+      uint64_t const ones_s = count_ones_words( layout, []( auto a ) { return a; }, tt_s );
+      uint64_t const ones_both = count_ones_words( layout, []( auto a, auto b ) { return a & b; }, tt_s, target );
+      uint64_t const rdp = ( num_bits - ones_s - ones_tt + ones_both ) * ones_both + ( ones_tt - ones_both ) * ( ones_s - ones_both );
+      sorted_divs.emplace_back( static_cast<uint32_t>( *it ), static_cast<uint32_t>( rdp ) );
     }
     std::sort( std::rbegin( sorted_divs ), std::rend( sorted_divs ),
                [&]( auto const& u, auto const& v ) {
@@ -218,10 +229,19 @@ public:
                  return u.entropy < v.entropy ;
                } );
 
+    batch.reset( layout );
+    for ( auto const& d : sorted_divs )
+    {
+      batch.add( sim.get_tt_ref( ntk.make_signal( d.node ) ) );
+    }
+
+    auto const xor3 = []( auto t, auto c, auto a0, auto a1, auto a2 ) { return ( ( a0 ^ a1 ^ a2 ) ^ t ) & c; };
+    auto const maj3 = []( auto t, auto c, auto a0, auto a1, auto a2 ) { return ( ( ( a0 & a1 ) | ( a0 & a2 ) | ( a1 & a2 ) ) ^ t ) & c; };
+
     for ( auto i = 0u; i < sorted_divs.size(); ++i )
     {
       auto const s0 = ntk.make_signal( sorted_divs.at( i ).node );
-      auto const& tt0 = sim.get_tt( s0 );
+      auto const tt0 = batch[i][0];
       auto const a = sim.get_phase( ntk.get_node( s0 ) ) ? !s0 : s0;
 
       int64_t const db_s0 = sorted_divs.at( i ).entropy;
@@ -229,7 +249,7 @@ public:
       for ( auto j = i + 1; j < sorted_divs.size(); ++j )
       {
         auto const s1 = ntk.make_signal( sorted_divs.at( j ).node );
-        auto const& tt1 = sim.get_tt( s1 );
+        auto const tt1 = batch[j][0];
         auto const b = sim.get_phase( ntk.get_node( s1 ) ) ? !s1 : s1;
 
         int64_t const db_s1 = sorted_divs.at( j ).entropy;
@@ -243,7 +263,6 @@ public:
         for ( auto k = j + 1; k < sorted_divs.size(); ++k )
         {
           auto const s2 = ntk.make_signal( sorted_divs.at( k ).node );
-          auto const& tt2 = sim.get_tt( s2 );
           auto const c = sim.get_phase( ntk.get_node( s2 ) ) ? !s2 : s2;
 
           int64_t const db_s2 = sorted_divs.at( k ).entropy;
@@ -253,25 +272,25 @@ public:
             break;
           }
 
-          if ( binary_and( tt, care ) == binary_and( detail::ternary_xor( tt0, tt1, tt2 ), care ) )
+          if ( batch.test( k, xor3, target, care_ref, tt0, tt1 ) )
           {
             /* XOR3 */
             ++st.num_div1_xor3_accepts;
             return sim.get_phase( root ) ? !ntk.create_xor3( a, b, c ) : ntk.create_xor3( a, b, c );
           }
-          else if ( binary_and( tt, care ) == binary_and( detail::ternary_xor( ~tt0, tt1, tt2 ), care ) )
+          else if ( batch.test( k, xor3, target, care_ref, ~tt0, tt1 ) )
           {
             /* XNOR3 */
             ++st.num_div1_xnor3_accepts;
             return sim.get_phase( root ) ? !ntk.create_xor3( !a, b, c ) : ntk.create_xor3( !a, b, c );
           }
-          else if ( binary_and( tt, care ) == binary_and( kitty::ternary_majority( tt0, tt1, tt2 ), care ) )
+          else if ( batch.test( k, maj3, target, care_ref, tt0, tt1 ) )
           {
             /* MAJ3 */
             ++st.num_div1_maj3_accepts;
             return sim.get_phase( root ) ? !ntk.create_maj( a, b, c ) : ntk.create_maj( a, b, c );
           }
-          else if ( binary_and( tt, care ) == binary_and( kitty::ternary_majority( ~tt0, tt1, tt2 ), care ) )
+          else if ( batch.test( k, maj3, target, care_ref, ~tt0, tt1 ) )
           {
             /* NOT-MAJ3 */
             ++st.num_div1_not_maj3_accepts;
@@ -289,6 +308,8 @@ private:
   std::vector<node> const& divs;
   uint32_t const num_divs;
   stats& st;
+
+  divisor_batch<1u> batch;
 }; /* xmg_resub_functor */
 
 template<class Ntk>
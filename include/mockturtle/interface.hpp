@@ -56,6 +56,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -240,6 +241,15 @@ public:
   /*! \brief Creates a signal that computes the binary AND. */
   signal create_and( signal const& f, signal const& g );
 
+  /*! \brief Creates AND gates for a batch of fanin pairs.
+   *
+   * The result is the same as calling ``create_and`` for each pair in order.
+   * A fanin with index ``size() + i``, where ``size()`` is taken before the
+   * call, refers to the ``i``-th gate of the batch.  Implementations may
+   * prefetch the hash table entries of several gates ahead.
+   */
+  std::vector<signal> create_and_batch( std::vector<std::array<signal, 2u>> const& fanins );
+
   /*! \brief Creates a signal that computes the binary NAND. */
   signal create_nand( signal const& f, signal const& g );
 
@@ -426,6 +436,21 @@ public:
    * \brief new_signal Signal to replace ``old_node`` with
    */
   void substitute_node_of_parents( std::vector<node> const& parents, node const& old_node, signal const& new_signal );
+
+  /*! \brief Renumbers the nodes in place.
+   *
+   * The constant keeps index 0, the combinational inputs keep their order
+   * and are followed by the gates in ``gates``, which must be in
+   * topological order and contain all gates in the transitive fanin of the
+   * combinational outputs.  All other gates are removed.  The fan-out sizes
+   * and the structural hash table are recomputed, custom values and visited
+   * flags are moved with their nodes.  Node maps and views of the network
+   * are invalidated.
+   *
+   * \param gates Gates in their new order
+   * \return New index of each old node, removed nodes are mapped to 0
+   */
+  std::vector<node> renumber_nodes( std::vector<node> const& gates );
 #pragma endregion
 
 #pragma region Structural properties
@@ -34,6 +34,7 @@
 
 #include "../networks/aig.hpp"
 #include "../traits.hpp"
+#include "../utils/mapped_vector.hpp"
 #include <lorina/aiger.hpp>
 
 namespace mockturtle
@@ -117,6 +118,10 @@ protected:
  * **Optional network functions to support sequential networks:**
  * - `create_ri`
  * - `create_ro`
+ *
+ * For out-of-core networks (e.g., `mapped_aig_network`), the signals of
+ * the literals are also stored in a memory-mapped file, and the nodes are
+ * regularly dropped from memory while reading.
  *
    \verbatim embed:rst
 
@@ -252,6 +257,16 @@ public:
     }
 
     signals.push_back( _ntk.create_and( left, right ) );
+
+    if constexpr ( is_out_of_core_v<Ntk> )
+    {
+      /* drop the nodes and signals created so far from memory */
+      if ( ( index & 0xffff ) == 0u )
+      {
+        _ntk.release_nodes( 0u, _ntk.size() );
+        signals.release( 0u, signals.size() );
+      }
+    }
   }
 
   void on_latch( unsigned index, unsigned next, latch_init_value reset ) const override
@@ -276,7 +291,7 @@ private:
 
   mutable uint32_t _num_inputs = 0;
   mutable std::vector<std::tuple<unsigned, std::string>> outputs;
-  mutable std::vector<typename Ntk::signal> signals;
+  mutable std::conditional_t<is_out_of_core_v<Ntk>, mapped_vector<typename Ntk::signal>, std::vector<typename Ntk::signal>> signals;
   mutable std::vector<std::tuple<unsigned, int8_t, std::string>> latches;
   mutable NameMap<Ntk>* _names;
 };
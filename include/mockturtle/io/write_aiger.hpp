@@ -38,10 +38,15 @@
 
 #include "../traits.hpp"
 
+#include <array>
+#include <cassert>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <string>
 #include <cstdio>
+#include <utility>
+#include <vector>
 
 namespace mockturtle
 {
@@ -62,9 +67,23 @@ void encode( std::vector<unsigned char>& buffer, uint32_t lit )
   buffer.push_back( ch );
 }
 
+inline void encode( std::ostream& os, uint32_t lit )
+{
+  while ( lit & ~0x7f )
+  {
+    os.put( static_cast<char>( ( lit & 0x7f ) | 0x80 ) );
+    lit >>= 7;
+  }
+  os.put( static_cast<char>( lit ) );
+}
+
 } /* detail */
 
 /*! \brief Writes a combinational AIG network in binary AIGER format into a file
+ *
+ * The gates are written one by one, such that the memory does not depend
+ * on the size of the network.  For out-of-core networks, the nodes that
+ * have been written are dropped from memory using `release_nodes`.
  *
  * **Required network functions:**
  * - `num_cis`
@@ -78,21 +97,23 @@ void encode( std::vector<unsigned char>& buffer, uint32_t lit )
  * \param aig Combinational AIG network
  * \param os Output stream
  */
-void write_aiger( aig_network const& aig, std::ostream& os )
+template<class Ntk>
+void write_aiger( Ntk const& aig, std::ostream& os )
 {
-  static_assert( is_network_type_v<aig_network>, "Ntk is not a network type" );
-  static_assert( has_num_cis_v<aig_network>, "Ntk does not implement the num_cis method" );
-  static_assert( has_num_cos_v<aig_network>, "Ntk does not implement the num_cos method" );
-  static_assert( has_foreach_gate_v<aig_network>, "Ntk does not implement the foreach_gate method" );
-  static_assert( has_foreach_fanin_v<aig_network>, "Ntk does not implement the foreach_fanin method" );
-  static_assert( has_foreach_po_v<aig_network>, "Ntk does not implement the foreach_po method" );
-  static_assert( has_get_node_v<aig_network>, "Ntk does not implement the get_node method" );
-  static_assert( has_is_complemented_v<aig_network>, "Ntk does not implement the is_complemented method" );
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_num_cis_v<Ntk>, "Ntk does not implement the num_cis method" );
+  static_assert( has_num_cos_v<Ntk>, "Ntk does not implement the num_cos method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( Ntk::min_fanin_size == 2u && Ntk::max_fanin_size == 2u, "Ntk is not an AIG network" );
 
   assert( aig.is_combinational() && "Network has to be combinational" );
 
-  using node = aig_network::node;
-  using signal = aig_network::signal;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
 
   assert( aig.num_latches() == 0u );
   uint32_t const M = aig.num_cis() + aig.num_gates() + aig.num_latches();
@@ -109,31 +130,32 @@ void write_aiger( aig_network const& aig, std::ostream& os )
   });
 
   /* GATES */
-  std::vector<unsigned char> buffer;
+  [[maybe_unused]] node released = 0u;
   aig.foreach_gate( [&]( node const& n ){
-    std::vector<uint32_t> lits;
-    lits.push_back( 2*n );
+    std::array<uint32_t, 3u> lits{static_cast<uint32_t>( 2*n ), 0u, 0u};
 
-    aig.foreach_fanin( n, [&]( signal const& fi ){
-      lits.push_back( 2*aig.get_node( fi ) + aig.is_complemented( fi ) );
+    aig.foreach_fanin( n, [&]( signal const& fi, auto i ){
+      lits[i + 1] = 2*aig.get_node( fi ) + aig.is_complemented( fi );
     });
 
     if ( lits[1] > lits[2] )
     {
-      auto const tmp = lits[1];
-      lits[1] = lits[2];
-      lits[2] = tmp;
+      std::swap( lits[1], lits[2] );
     }
 
     assert( lits[2] < lits[0] );
-    detail::encode( buffer, lits[0] - lits[2] );
-    detail::encode( buffer, lits[2] - lits[1] );
-  });
+    detail::encode( os, lits[0] - lits[2] );
+    detail::encode( os, lits[2] - lits[1] );
 
-  for ( const auto& b : buffer )
-  {
-    os.put( b );
-  }
+    if constexpr ( is_out_of_core_v<Ntk> )
+    {
+      if ( n - released >= ( 1u << 16u ) )
+      {
+        aig.release_nodes( released, n );
+        released = n;
+      }
+    }
+  });
 
   /* COMMENT */
   os.put( 'c' );
@@ -153,7 +175,8 @@ void write_aiger( aig_network const& aig, std::ostream& os )
  * \param aig Combinational AIG network
  * \param filename Filename
  */
-void write_aiger( aig_network const& aig, std::string const& filename )
+template<class Ntk>
+void write_aiger( Ntk const& aig, std::string const& filename )
 {
   std::ofstream os( filename.c_str(), std::ofstream::out );
   write_aiger( aig, os );
@@ -56,52 +56,405 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
 #include <cstdint>
+#include <cstdio>
 #include <fstream>
+#include <initializer_list>
 #include <iostream>
-#include <sstream>
+#include <optional>
 #include <string>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
 
 #include <fmt/format.h>
 
 #include "../traits.hpp"
 #include "../algorithms/cnf.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
 
 namespace mockturtle
 {
 
+/*! \brief Parameters for write_dimacs.
+ *
+ * The data structure `write_dimacs_params` holds configurable parameters
+ * with default arguments for `write_dimacs`.
+ */
+struct write_dimacs_params
+{
+  /*! \brief Encode the cells of a mapped network instead of its gates.
+   *
+   * The network must provide a mapping with cell functions, e.g., a
+   * `mapping_view` after `lut_mapping` (with `cut_enumeration_cnf_cut` for
+   * CNF-aware cuts).  Variables are only created for the primary inputs and
+   * the cell roots, and the clauses of each cell are derived from the ISOPs
+   * of its function.
+   */
+  bool use_mapping{false};
+
+  /*! \brief Compress the file with gzip while writing.
+   *
+   * The output is piped through the external `gzip` program (only on POSIX
+   * systems; on other systems, the file is written uncompressed).  Since a
+   * compressed stream cannot be patched, the clauses are counted in a first
+   * pass over the network, without storing them.
+   */
+  bool compress{false};
+
+  /*! \brief Size of the output buffer in bytes. */
+  uint32_t buffer_size{1u << 20};
+};
+
+/*! \brief Statistics for write_dimacs. */
+struct write_dimacs_stats
+{
+  /*! \brief Number of variables. */
+  uint64_t num_vars{0};
+
+  /*! \brief Number of clauses. */
+  uint64_t num_clauses{0};
+
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+};
+
+/*! \brief Buffered writer for DIMACS clauses.
+ *
+ * Clauses are formatted into a fixed-size buffer, which is written to an
+ * output stream or a C file whenever it is full.  The writer can be used as
+ * clause callback of the CNF generation functions: literals follow the
+ * convention of `generate_cnf` (`2 * v` and `2 * v + 1` for variable `v`,
+ * which is written as DIMACS variable `v + 1`).
+ *
+ * If the header is written with `padded = true`, it has a fixed length and
+ * can be overwritten with the final numbers by `patch_header` once all
+ * clauses have been written.
+ */
+class dimacs_writer
+{
+public:
+  /*! \brief Writes into an output stream. */
+  explicit dimacs_writer( std::ostream& os, uint32_t buffer_size = 1u << 20 )
+      : _os( &os ), _buffer( std::max( buffer_size, 256u ) )
+  {
+  }
+
+  /*! \brief Writes into a C file (e.g., opened with `fopen` or `popen`). */
+  explicit dimacs_writer( std::FILE* file, uint32_t buffer_size = 1u << 20 )
+      : _file( file ), _buffer( std::max( buffer_size, 256u ) )
+  {
+  }
+
+  ~dimacs_writer()
+  {
+    flush();
+  }
+
+  dimacs_writer( dimacs_writer const& ) = delete;
+  dimacs_writer& operator=( dimacs_writer const& ) = delete;
+
+  /*! \brief Writes the `p cnf` header. */
+  void header( uint64_t num_vars, uint64_t num_clauses, bool padded = false )
+  {
+    auto line = padded ? padded_header( num_vars, num_clauses ) : fmt::format( "p cnf {} {}\n", num_vars, num_clauses );
+    write( line.data(), line.size() );
+  }
+
+  /*! \brief Overwrites a padded header at the beginning of a C file. */
+  static bool patch_header( std::FILE* file, uint64_t num_vars, uint64_t num_clauses )
+  {
+    auto const line = padded_header( num_vars, num_clauses );
+    return std::fseek( file, 0, SEEK_SET ) == 0 && std::fwrite( line.data(), 1, line.size(), file ) == line.size();
+  }
+
+  /*! \brief Writes a clause. */
+  template<typename Iterator>
+  void add_clause( Iterator begin, Iterator end )
+  {
+    reserve( 12u * static_cast<uint32_t>( std::distance( begin, end ) ) + 2u );
+    for ( ; begin != end; ++begin )
+    {
+      if ( *begin & 1 )
+      {
+        _buffer[_pos++] = '-';
+      }
+      write_number( ( *begin >> 1 ) + 1u );
+      _buffer[_pos++] = ' ';
+    }
+    _buffer[_pos++] = '0';
+    _buffer[_pos++] = '\n';
+    ++_num_clauses;
+  }
+
+  void operator()( std::initializer_list<uint32_t> clause )
+  {
+    add_clause( clause.begin(), clause.end() );
+  }
+
+  void operator()( std::vector<uint32_t> const& clause )
+  {
+    add_clause( clause.begin(), clause.end() );
+  }
+
+  /*! \brief Number of written clauses. */
+  uint64_t num_clauses() const
+  {
+    return _num_clauses;
+  }
+
+  /*! \brief Returns false, if writing to the stream or file has failed. */
+  bool good() const
+  {
+    return _good;
+  }
+
+  /*! \brief Writes the buffer. */
+  void flush()
+  {
+    if ( _pos == 0u )
+    {
+      return;
+    }
+    if ( _os )
+    {
+      _good = _os->write( _buffer.data(), _pos ).good() && _good;
+    }
+    else if ( _file )
+    {
+      _good = std::fwrite( _buffer.data(), 1, _pos, _file ) == _pos && std::fflush( _file ) == 0 && _good;
+    }
+    _pos = 0u;
+  }
+
+private:
+  static std::string padded_header( uint64_t num_vars, uint64_t num_clauses )
+  {
+    /* the trailing spaces of the fixed-width fields are ignored by DIMACS parsers */
+    return fmt::format( "p cnf {:<20} {:<20}\n", num_vars, num_clauses );
+  }
+
+  void reserve( uint32_t size )
+  {
+    if ( _pos + size > _buffer.size() )
+    {
+      flush();
+      if ( size > _buffer.size() )
+      {
+        _buffer.resize( size );
+      }
+    }
+  }
+
+  void write( char const* data, std::size_t size )
+  {
+    reserve( static_cast<uint32_t>( size ) );
+    std::copy( data, data + size, _buffer.begin() + _pos );
+    _pos += static_cast<uint32_t>( size );
+  }
+
+  void write_number( uint32_t value )
+  {
+    char digits[10];
+    auto num_digits = 0u;
+    do
+    {
+      digits[num_digits++] = static_cast<char>( '0' + value % 10u );
+      value /= 10u;
+    } while ( value != 0u );
+    while ( num_digits > 0u )
+    {
+      _buffer[_pos++] = digits[--num_digits];
+    }
+  }
+
+private:
+  std::ostream* _os{nullptr};
+  std::FILE* _file{nullptr};
+  std::vector<char> _buffer;
+  uint32_t _pos{0u};
+  uint64_t _num_clauses{0u};
+  bool _good{true};
+};
+
+namespace detail
+{
+
+/* clause callback that only counts the clauses */
+struct dimacs_clause_counter
+{
+  void operator()( std::initializer_list<uint32_t> )
+  {
+    ++num_clauses;
+  }
+
+  void operator()( std::vector<uint32_t> const& )
+  {
+    ++num_clauses;
+  }
+
+  uint64_t num_clauses{0u};
+};
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+/* writes `filename` compressed by a `gzip` process, which is started without a shell
+ *
+ * `fn` is called with the input pipe of `gzip` and returns false if writing
+ * has failed.  SIGPIPE is blocked in the calling thread while writing, such
+ * that a failing `gzip` is reported as a write error.
+ */
+template<class Fn>
+bool write_gzip_file( std::string const& filename, Fn&& fn )
+{
+  int const out = ::open( filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+  if ( out == -1 )
+  {
+    return false;
+  }
+  int fds[2];
+  if ( ::pipe( fds ) != 0 )
+  {
+    ::close( out );
+    return false;
+  }
+  ::fcntl( fds[1], F_SETFD, FD_CLOEXEC );
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init( &actions );
+  posix_spawn_file_actions_adddup2( &actions, fds[0], STDIN_FILENO );
+  posix_spawn_file_actions_adddup2( &actions, out, STDOUT_FILENO );
+  char arg0[] = "gzip", arg1[] = "-c";
+  char* argv[] = {arg0, arg1, nullptr};
+  pid_t pid;
+  bool success = posix_spawnp( &pid, "gzip", &actions, nullptr, argv, environ ) == 0;
+  posix_spawn_file_actions_destroy( &actions );
+  ::close( out );
+  ::close( fds[0] );
+
+  if ( !success )
+  {
+    ::close( fds[1] );
+    return false;
+  }
+
+  sigset_t sigpipe, old_mask, pending;
+  sigemptyset( &sigpipe );
+  sigaddset( &sigpipe, SIGPIPE );
+  pthread_sigmask( SIG_BLOCK, &sigpipe, &old_mask );
+
+  if ( auto* file = ::fdopen( fds[1], "w" ); file != nullptr )
+  {
+    success = fn( file );
+    success = std::fclose( file ) == 0 && success;
+  }
+  else
+  {
+    ::close( fds[1] );
+    success = false;
+  }
+
+  /* discard a SIGPIPE raised by the writes */
+  if ( sigpending( &pending ) == 0 && sigismember( &pending, SIGPIPE ) && !sigismember( &old_mask, SIGPIPE ) )
+  {
+    int signal_number;
+    sigwait( &sigpipe, &signal_number );
+  }
+  pthread_sigmask( SIG_SETMASK, &old_mask, nullptr );
+
+  int status;
+  while ( ::waitpid( pid, &status, 0 ) == -1 )
+  {
+    if ( errno != EINTR )
+    {
+      return false;
+    }
+  }
+  return success && WIFEXITED( status ) && WEXITSTATUS( status ) == 0;
+}
+#endif
+
+/* passes the clauses of `ntk` and the unit clauses of its outputs to `fn`, returns the number of variables */
+template<class Ntk, class ClauseFn>
+uint64_t write_dimacs_clauses( Ntk const& ntk, write_dimacs_params const& ps, ClauseFn& fn )
+{
+  if ( ps.use_mapping )
+  {
+    if constexpr ( has_has_mapping_v<Ntk> && has_num_cells_v<Ntk> && has_is_cell_root_v<Ntk> && has_foreach_cell_fanin_v<Ntk> && has_cell_function_v<Ntk> )
+    {
+      assert( ntk.has_mapping() );
+
+      cnf_cache cache;
+      detail::generate_mapped_cnf_impl<Ntk, uint32_t, ClauseFn> impl( ntk, fn, std::nullopt, cache );
+      for ( auto lit : impl.run() )
+      {
+        fn( {lit} );
+      }
+
+      return ntk.num_pis() + ntk.num_cells() + 1u;
+    }
+    else
+    {
+      assert( false && "network does not provide a mapping with cell functions" );
+    }
+  }
+
+  detail::generate_cnf_impl<Ntk, uint32_t, ClauseFn> impl( ntk, fn, std::nullopt );
+  for ( auto lit : impl.run() )
+  {
+    fn( {lit} );
+  }
+  return ntk.size();
+}
+
+} // namespace detail
+
 /*! \brief Writes network into CNF DIMACS format
  *
  * It also adds unit clauses for the outputs.  Therefore a satisfying solution
  * is one that makes all outputs 1.
  *
+ * The clauses are not stored: they are counted in a first pass over the
+ * network, such that the header can be written before them, and are
+ * written in a second pass.
+ *
  * \param ntk Logic network
  * \param out Output stream
+ * \param ps Parameters (`compress` is ignored)
+ * \param pst Statistics
  */
 template<class Ntk>
-void write_dimacs( Ntk const& ntk, std::ostream& out = std::cout )
+void write_dimacs( Ntk const& ntk, std::ostream& out = std::cout, write_dimacs_params const& ps = {}, write_dimacs_stats* pst = nullptr )
 {
-  std::stringstream clauses;
-  uint32_t num_clauses = 0u;
-
-  const auto lits = generate_cnf( ntk, [&]( std::vector<uint32_t> const& clause ) {
-    for ( auto lit : clause ) {
-      const auto var = ( lit / 2 ) + 1;
-      const auto pol = lit % 2;
-      clauses << fmt::format( "{}{} ", pol ? "-" : "", var );
-    }
-    clauses << fmt::format( "0\n" );
-    ++num_clauses;
-  } );
+  write_dimacs_stats st;
+  {
+    stopwatch t( st.time_total );
 
-  for ( auto lit : lits ) {
-    const auto var = ( lit / 2 ) + 1;
-    const auto pol = lit % 2;
-    clauses << fmt::format( "{}{} 0\n", pol ? "-" : "", var );
-    ++num_clauses;
+    detail::dimacs_clause_counter counter;
+    st.num_vars = detail::write_dimacs_clauses( ntk, ps, counter );
+    st.num_clauses = counter.num_clauses;
+
+    dimacs_writer writer( out, ps.buffer_size );
+    writer.header( st.num_vars, st.num_clauses );
+    detail::write_dimacs_clauses( ntk, ps, writer );
   }
 
-  out << fmt::format( "p cnf {} {}\n{}", ntk.size(), num_clauses, clauses.str() );
+  if ( pst )
+  {
+    *pst = st;
+  }
 }
 
 /*! \brief Writes network into CNF DIMACS format
@@ -109,15 +462,75 @@ void write_dimacs( Ntk const& ntk, std::ostream& out = std::cout )
  * It also adds unit clauses for the outputs.  Therefore a satisfying solution
  * is one that makes all outputs 1.
  *
+ * The network is traversed once and the clauses are streamed into the file
+ * through a fixed-size buffer, such that the clause set is never stored in
+ * memory.  The header is written with fixed-width fields and is patched
+ * with the final number of clauses at the end.  If the file is compressed
+ * (see `write_dimacs_params::compress`), the clauses are counted in a
+ * first pass instead.
+ *
+ * If the file cannot be written, or if `gzip` cannot be started or fails,
+ * the function returns false and the statistics report no variables and
+ * clauses.  The file may then be incomplete.
+ *
  * \param ntk Logic network
  * \param filename Filename
+ * \param ps Parameters
+ * \param pst Statistics
+ * \return True, if the file has been written
  */
 template<class Ntk>
-void write_dimacs( Ntk const& ntk, std::string const& filename )
+bool write_dimacs( Ntk const& ntk, std::string const& filename, write_dimacs_params const& ps = {}, write_dimacs_stats* pst = nullptr )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_dimacs( ntk, os );
-  os.close();
+  write_dimacs_stats st;
+  bool success = false;
+  {
+    stopwatch t( st.time_total );
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+    if ( ps.compress )
+    {
+      detail::dimacs_clause_counter counter;
+      st.num_vars = detail::write_dimacs_clauses( ntk, ps, counter );
+      st.num_clauses = counter.num_clauses;
+
+      success = detail::write_gzip_file( filename, [&]( std::FILE* pipe ) {
+        dimacs_writer writer( pipe, ps.buffer_size );
+        writer.header( st.num_vars, st.num_clauses );
+        detail::write_dimacs_clauses( ntk, ps, writer );
+        writer.flush();
+        return writer.good();
+      } );
+    }
+    else
+#endif
+    {
+      if ( auto* file = std::fopen( filename.c_str(), "wb" ); file != nullptr )
+      {
+        {
+          dimacs_writer writer( file, ps.buffer_size );
+          writer.header( 0u, 0u, true );
+          st.num_vars = detail::write_dimacs_clauses( ntk, ps, writer );
+          st.num_clauses = writer.num_clauses();
+          writer.flush();
+          success = writer.good();
+        }
+        success = dimacs_writer::patch_header( file, st.num_vars, st.num_clauses ) && success;
+        success = std::fclose( file ) == 0 && success;
+      }
+    }
+
+    if ( !success )
+    {
+      st.num_vars = st.num_clauses = 0u;
+    }
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return success;
 }
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
@@ -103,6 +103,9 @@
 #include "mockturtle/utils/progress_bar.hpp"
 #include "mockturtle/utils/mixed_radix.hpp"
 #include "mockturtle/utils/node_map.hpp"
+#include "mockturtle/utils/window_index_arena.hpp"
+#include "mockturtle/utils/append_log.hpp"
+#include "mockturtle/utils/persistent_exact_cache.hpp"
 #include "mockturtle/utils/cuts.hpp"
 #include "mockturtle/networks/aig.hpp"
 #include "mockturtle/networks/events.hpp"
@@ -34,10 +34,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include <fmt/format.h>
 #include <kitty/dynamic_truth_table.hpp>
@@ -51,41 +57,96 @@
 namespace mockturtle
 {
 
+/*! \brief Abstract XAG storage container
+
+  The fanins of all nodes are stored in a block arena that is only released
+  with the storage, instead of one allocation per node.  The structural hash
+  of a node is computed once from its fanins and cached in the node.
+*/
 struct abstract_xag_storage
 {
   struct node_type {
-    uint32_t* fanin{};
+    uint32_t const* fanin{};
     uint32_t fanin_size{};
     uint32_t fanout_size{};
     uint32_t value{};
     uint32_t visited{};
     uint32_t level{};
+    uint64_t hash{};
   };
 
-  abstract_xag_storage()
+  /*! \brief Bump allocator for fanin lists
+   *
+   * Fanin lists are allocated contiguously in blocks of `block_size`
+   * entries; lists that are larger than a block get a block of their own.
+   * Memory is never moved, and the last allocation can be taken back.
+   */
+  class fanin_arena
   {
-    /* constant 0 node */
-    nodes.emplace_back();
+  public:
+    static constexpr uint32_t block_size = 1u << 18;
 
-    //nodes.reserve( 10000u );
-  }
+    uint32_t* allocate( uint32_t size )
+    {
+      if ( _blocks.empty() || ( size <= block_size && _used + size > block_size ) )
+      {
+        /* not value-initialized */
+        _blocks.emplace_back( new uint32_t[block_size] );
+        _used = 0u;
+      }
 
-  ~abstract_xag_storage()
-  {
-    for ( auto& n : nodes )
+      _num_entries += size;
+      if ( size > block_size )
+      {
+        /* keep the current block the last one */
+        return _blocks.emplace( _blocks.end() - 1, new uint32_t[size] )->get();
+      }
+
+      auto* data = _blocks.back().get() + _used;
+      _used += size;
+      return data;
+    }
+
+    /*! \brief Takes back the most recent allocation. */
+    void deallocate_last( uint32_t const* data, uint32_t size )
     {
-      if ( n.fanin )
+      _num_entries -= size;
+      if ( size > block_size )
       {
-        delete[] n.fanin;
+        const auto it = std::find_if( _blocks.rbegin(), _blocks.rend(), [&]( auto const& b ) { return b.get() == data; } );
+        assert( it != _blocks.rend() );
+        _blocks.erase( std::next( it ).base() );
       }
+      else
+      {
+        assert( data + size == _blocks.back().get() + _used );
+        _used -= size;
+      }
+    }
+
+    /*! \brief Number of allocated fanin entries. */
+    uint64_t size() const
+    {
+      return _num_entries;
     }
+
+  private:
+    std::vector<std::unique_ptr<uint32_t[]>> _blocks;
+    uint32_t _used{0u};
+    uint64_t _num_entries{0u};
+  };
+
+  abstract_xag_storage()
+  {
+    /* constant 0 node */
+    nodes.emplace_back();
   }
 
   struct abstract_xag_node_eq
   {
     bool operator()( abstract_xag_storage::node_type const& a, abstract_xag_storage::node_type const& b ) const
     {
-      return a.fanin_size == b.fanin_size && std::equal( a.fanin, a.fanin + a.fanin_size, b.fanin );
+      return a.hash == b.hash && a.fanin_size == b.fanin_size && std::equal( a.fanin, a.fanin + a.fanin_size, b.fanin );
     }
   };
 
@@ -93,12 +154,49 @@ struct abstract_xag_storage
   {
     uint64_t operator()( abstract_xag_storage::node_type const& n ) const
     {
-      return std::accumulate( n.fanin, n.fanin + n.fanin_size, UINT64_C( 0 ), [&]( auto accu, auto c ) { return accu + std::hash<uint32_t>{}( c ); } );
+      return n.hash;
     }
   };
 
+  /*! \brief Hash value of a fanin list
+   *
+   * Multiplicative hashing of two fanins per 64-bit word in four independent
+   * lanes, followed by a final avalanche step (from MurmurHash3).
+   */
+  static uint64_t hash_fanin( uint32_t const* begin, uint32_t const* end )
+  {
+    const uint64_t m = UINT64_C( 0x9e3779b97f4a7c15 );
+    const auto word = []( uint32_t const* p ) { return static_cast<uint64_t>( p[0] ) | ( static_cast<uint64_t>( p[1] ) << 32 ); };
+
+    std::array<uint64_t, 4> h{static_cast<uint64_t>( end - begin ), 1u, 2u, 3u};
+    for ( ; end - begin >= 8; begin += 8 )
+    {
+      h[0] = ( h[0] ^ word( begin ) ) * m;
+      h[1] = ( h[1] ^ word( begin + 2 ) ) * m;
+      h[2] = ( h[2] ^ word( begin + 4 ) ) * m;
+      h[3] = ( h[3] ^ word( begin + 6 ) ) * m;
+    }
+    for ( ; begin != end; ++begin )
+    {
+      h[0] = ( h[0] ^ *begin ) * m;
+    }
+
+    uint64_t seed = h[0];
+    for ( auto i = 1u; i < 4u; ++i )
+    {
+      seed = ( ( seed << 31 ) | ( seed >> 33 ) ) ^ h[i];
+      seed *= m;
+    }
+    seed ^= seed >> 33;
+    seed *= UINT64_C( 0xff51afd7ed558ccd );
+    seed ^= seed >> 33;
+    seed *= UINT64_C( 0xc4ceb9fe1a85ec53 );
+    seed ^= seed >> 33;
+    return seed;
+  }
+
   std::vector<node_type> nodes;
-  std::vector<uint32_t> children;
+  fanin_arena children;
   std::vector<uint32_t> inputs;
   std::vector<std::pair<uint32_t, bool>> outputs;
   phmap::flat_hash_map<node_type, uint32_t, abstract_xag_node_hash, abstract_xag_node_eq> hash;
@@ -239,15 +337,19 @@ public:
 #pragma region Create binary functions
   signal _create_node( std::vector<uint32_t> const& fanin, uint32_t level_offset )
   {
+    /* the candidate fanins are allocated in the arena and taken back if the node exists */
+    auto* data = _storage->children.allocate( static_cast<uint32_t>( fanin.size() ) );
+    std::copy( fanin.begin(), fanin.end(), data );
+
     storage::element_type::node_type node;
-    node.fanin = new uint32_t[fanin.size()];
-    node.fanin_size = fanin.size();
-    std::copy( fanin.begin(), fanin.end(), node.fanin );
+    node.fanin = data;
+    node.fanin_size = static_cast<uint32_t>( fanin.size() );
+    node.hash = storage_type::hash_fanin( fanin.data(), fanin.data() + fanin.size() );
 
     /* structural hashing */
     if ( const auto it = _storage->hash.find( node ); it != _storage->hash.end() )
     {
-      delete[] node.fanin;
+      _storage->children.deallocate_last( data, node.fanin_size );
       return {it->second, 0};
     }
 
@@ -418,7 +520,7 @@ public:
       }
     };
 
-    const auto merge_many = [&]( uint32_t* begin, uint32_t* end ) {
+    const auto merge_many = [&]( uint32_t const* begin, uint32_t const* end ) {
       std::vector<uint32_t> tmp;
       std::set_symmetric_difference( _fs.begin(), _fs.end(), begin, end, std::back_inserter( tmp ) );
       _fs = std::move( tmp );
@@ -471,7 +573,7 @@ public:
       }
     };
 
-    const auto merge_many = [&]( uint32_t* begin, uint32_t* end ) {
+    const auto merge_many = [&]( uint32_t const* begin, uint32_t const* end ) {
       std::vector<uint32_t> tmp;
       std::set_symmetric_difference( _fs.begin(), _fs.end(), begin, end, std::back_inserter( tmp ) );
       _fs = std::move( tmp );
@@ -621,7 +723,7 @@ public:
       return;
 
     const auto& node = _storage->nodes[n];
-    detail::foreach_element_transform<uint32_t*, signal>( node.fanin, node.fanin + node.fanin_size, []( auto c ) -> signal { return { c, false }; }, fn );
+    detail::foreach_element_transform<uint32_t const*, signal>( node.fanin, node.fanin + node.fanin_size, []( auto c ) -> signal { return { c, false }; }, fn );
   }
 #pragma endregion
 
@@ -35,7 +35,9 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/mapped_vector.hpp"
 #include "detail/foreach.hpp"
+#include "detail/renumber.hpp"
 #include "events.hpp"
 #include "storage.hpp"
 
@@ -43,10 +45,12 @@
 #include <kitty/partial_truth_table.hpp>
 #include <kitty/operators.hpp>
 
+#include <array>
 #include <list>
 #include <memory>
 #include <optional>
 #include <stack>
+#include <stdexcept>
 #include <string>
 
 namespace mockturtle
@@ -73,6 +77,8 @@ struct aig_storage_data
   uint32_t num_pos = 0u;
   std::vector<int8_t> latches;
   uint32_t trav_id = 0u;
+  bool structural_hashing = true;
+  uint32_t num_unhashed_gates = 0u; /* number of gates if structural hashing is disabled */
 };
 
 /*! \brief AIG storage container
@@ -89,15 +95,27 @@ using aig_storage = storage<regular_node<2, 2, 1>,
                             aig_storage_data,
                             aig_hash<regular_node<2, 2, 1>>>;
 
-class aig_network
+/*! \brief AIG storage container with nodes in a memory-mapped file
+
+  Same as `aig_storage`, but the nodes are stored in a `mapped_vector`, such
+  that the operating system can evict them from memory.
+*/
+using mapped_aig_storage = storage<regular_node<2, 2, 1>,
+                                   aig_storage_data,
+                                   aig_hash<regular_node<2, 2, 1>>,
+                                   mapped_vector<regular_node<2, 2, 1>>>;
+
+template<class Storage>
+class basic_aig_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 2u;
   static constexpr auto max_fanin_size = 2u;
+  static constexpr bool is_out_of_core = !std::is_same_v<decltype( Storage::nodes ), std::vector<typename Storage::node_type>>;
 
-  using base_type = aig_network;
-  using storage = std::shared_ptr<aig_storage>;
+  using base_type = basic_aig_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
 
   struct signal
@@ -114,7 +132,7 @@ public:
     {
     }
 
-    signal( aig_storage::node_type::pointer_type const& p )
+    signal( typename Storage::node_type::pointer_type const& p )
         : complement( p.weight ), index( p.index )
     {
     }
@@ -163,28 +181,30 @@ public:
       return data < other.data;
     }
 
-    operator aig_storage::node_type::pointer_type() const
+    operator typename Storage::node_type::pointer_type() const
     {
       return {index, complement};
     }
 
 #if __cplusplus > 201703L
-    bool operator==( aig_storage::node_type::pointer_type const& other ) const
+    bool operator==( typename Storage::node_type::pointer_type const& other ) const
     {
       return data == other.data;
     }
 #endif
   };
 
-  aig_network()
-      : _storage( std::make_shared<aig_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_aig_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
+    /* out-of-core networks do not keep a hash table in memory by default */
+    _storage->data.structural_hashing = !is_out_of_core;
   }
 
-  aig_network( std::shared_ptr<aig_storage> storage )
+  basic_aig_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 #pragma endregion
@@ -312,33 +332,150 @@ public:
       return a.complement ? b : get_constant( false );
     }
 
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
-    /* structural hashing */
-    const auto it = _storage->hash.find( node );
-    if ( it != _storage->hash.end() )
+    return create_and_node( node, _storage->data.structural_hashing ? _storage->hash.hash( node ) : 0u );
+  }
+
+  /*! \brief Creates AND gates for a batch of fanin pairs.
+   *
+   * The gates are created in order and the result is the same as calling
+   * `create_and` for each of them.  A fanin with index `size() + i`, where
+   * `size()` is taken before the call, refers to the `i`-th gate of the
+   * batch, such that a batch can contain a topologically ordered part of a
+   * network.  The hash values of gates whose fanins are known some gates
+   * ahead are computed in advance and their buckets in the hash table are
+   * prefetched, which hides the latency of the lookups in large networks.
+   *
+   * \param fanins Fanin pairs of the gates
+   * \return Signals of the gates
+   */
+  std::vector<signal> create_and_batch( std::vector<std::array<signal, 2u>> const& fanins )
+  {
+    static constexpr std::size_t lookahead = 16u;
+
+    const auto base = static_cast<uint64_t>( _storage->nodes.size() );
+    const auto strash = _storage->data.structural_hashing;
+    std::vector<signal> fs( fanins.size() );
+
+    /* the hash values of the gates i, ..., i + lookahead - 1 */
+    std::array<std::size_t, lookahead> hashes;
+    std::array<bool, lookahead> prepared{};
+
+    const auto is_known = [&]( signal const& f, std::size_t num_created ) {
+      return f.index < base || f.index - base < num_created;
+    };
+    const auto resolve = [&]( signal const& f ) {
+      return f.index < base ? f : fs[f.index - base] ^ f.complement;
+    };
+    const auto make_node = [&]( std::size_t i ) {
+      auto a = resolve( fanins[i][0] );
+      auto b = resolve( fanins[i][1] );
+      if ( a.index > b.index )
+      {
+        std::swap( a, b );
+      }
+      typename Storage::node_type node;
+      node.children[0] = a;
+      node.children[1] = b;
+      return node;
+    };
+    const auto prefetch = [&]( std::size_t i, std::size_t num_created ) {
+      if ( i < fanins.size() && is_known( fanins[i][0], num_created ) && is_known( fanins[i][1], num_created ) )
+      {
+        hashes[i % lookahead] = _storage->hash.hash( make_node( i ) );
+        _storage->hash.prefetch_hash( hashes[i % lookahead] );
+        prepared[i % lookahead] = true;
+      }
+    };
+
+    if ( strash )
+    {
+      for ( auto i = 0u; i + 1u < lookahead; ++i )
+      {
+        prefetch( i, 0u );
+      }
+    }
+
+    for ( auto i = 0u; i < fanins.size(); ++i )
     {
-      assert( !is_dead( it->second ) );
-      return {it->second, 0};
+      if ( strash )
+      {
+        prefetch( i + lookahead - 1u, i );
+      }
+
+      const auto node = make_node( i );
+      signal const a = node.children[0];
+      signal const b = node.children[1];
+
+      /* trivial cases */
+      if ( a.index == b.index )
+      {
+        fs[i] = ( a.complement == b.complement ) ? a : get_constant( false );
+      }
+      else if ( a.index == 0 )
+      {
+        fs[i] = a.complement ? b : get_constant( false );
+      }
+      else if ( !strash )
+      {
+        fs[i] = create_and_node( node, 0u );
+      }
+      else
+      {
+        fs[i] = create_and_node( node, prepared[i % lookahead] ? hashes[i % lookahead] : _storage->hash.hash( node ) );
+      }
+      prepared[i % lookahead] = false;
     }
 
+    return fs;
+  }
+
+  /*! \brief Adds an AND gate with ordered non-trivial children.
+   *
+   * If structural hashing is enabled, `hash` must be the hash value of
+   * `node` in the hash table, and an existing equal gate is returned.
+   */
+  signal create_and_node( typename Storage::node_type const& node, std::size_t hash )
+  {
     const auto index = _storage->nodes.size();
+    const auto strash = _storage->data.structural_hashing;
 
     if ( index >= .9 * _storage->nodes.capacity() )
     {
       _storage->nodes.reserve( static_cast<uint64_t>( 3.1415f * index ) );
-      _storage->hash.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+      if ( strash )
+      {
+        _storage->hash.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+      }
     }
 
-    _storage->nodes.push_back( node );
+    if ( strash )
+    {
+      /* find the gate or insert it in a single lookup */
+      bool inserted{false};
+      const auto it = _storage->hash.lazy_emplace_with_hash( node, hash, [&]( auto const& ctor ) {
+        ctor( node, index );
+        inserted = true;
+      } );
+      if ( !inserted )
+      {
+        assert( !is_dead( it->second ) );
+        return {it->second, 0};
+      }
+    }
+    else
+    {
+      ++_storage->data.num_unhashed_gates;
+    }
 
-    _storage->hash[node] = index;
+    _storage->nodes.push_back( node );
 
     /* increase ref-count to children */
-    _storage->nodes[a.index].data[0].h1++;
-    _storage->nodes[b.index].data[0].h1++;
+    _storage->nodes[node.children[0].index].data[0].h1++;
+    _storage->nodes[node.children[1].index].data[0].h1++;
 
     _events->on_add( index );
 
@@ -432,7 +569,8 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( aig_network const& other, node const& source, std::vector<signal> const& children )
+  template<class OtherStorage>
+  signal clone_node( basic_aig_network<OtherStorage> const& other, node const& source, std::vector<signal> const& children )
   {
     (void)other;
     (void)source;
@@ -482,13 +620,18 @@ public:
       return std::make_pair( n, child0.complement ? child1 : get_constant( false ) );
     }
 
+    const auto strash = _storage->data.structural_hashing;
+
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename Storage::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
-    if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
+    if ( strash )
     {
-      return std::make_pair( n, signal( it->second, 0 ) );
+      if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
+      {
+        return std::make_pair( n, signal( it->second, 0 ) );
+      }
     }
 
     // remember before
@@ -496,12 +639,18 @@ public:
     const auto old_child1 = signal{node.children[1]};
 
     // erase old node in hash table
-    _storage->hash.erase( node );
+    if ( strash )
+    {
+      _storage->hash.erase( node );
+    }
 
     // insert updated node into hash table
     node.children[0] = child0;
     node.children[1] = child1;
-    _storage->hash[node] = n;
+    if ( strash )
+    {
+      _storage->hash[node] = n;
+    }
 
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
@@ -541,7 +690,14 @@ public:
     /* delete the node (ignoring it's current fanout_size) */
     auto& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
-    _storage->hash.erase( nobj );
+    if ( _storage->data.structural_hashing )
+    {
+      _storage->hash.erase( nobj );
+    }
+    else
+    {
+      --_storage->data.num_unhashed_gates;
+    }
 
     _events->on_delete( n );
 
@@ -560,6 +716,32 @@ public:
     }
   }
 
+  /*! \brief Renumbers the nodes in place.
+   *
+   * The CIs keep their order and are followed by the gates in `gates`,
+   * which must be in topological order and contain all gates in the
+   * transitive fanin of the COs.  All other gates are removed, and the
+   * fan-out sizes and the structural hash table are rebuilt.  Returns the
+   * new index of each old node, where removed nodes are mapped to 0.  Node
+   * maps and views of the network are invalidated.
+   */
+  std::vector<node> renumber_nodes( std::vector<node> const& gates )
+  {
+    const auto old_to_new = detail::renumber_storage( *_storage, gates, _storage->data.structural_hashing, []( auto& n, auto const& old_to_new ) {
+      n.children[0].index = old_to_new[n.children[0].index];
+      n.children[1].index = old_to_new[n.children[1].index];
+      if ( n.children[0].index > n.children[1].index )
+      {
+        std::swap( n.children[0], n.children[1] );
+      }
+    } );
+    if ( !_storage->data.structural_hashing )
+    {
+      _storage->data.num_unhashed_gates = static_cast<uint32_t>( gates.size() );
+    }
+    return old_to_new;
+  }
+
   inline bool is_dead( node const& n ) const
   {
     return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
@@ -732,7 +914,7 @@ public:
 
   auto num_gates() const
   {
-    return static_cast<uint32_t>( _storage->hash.size() );
+    return _storage->data.structural_hashing ? static_cast<uint32_t>( _storage->hash.size() ) : _storage->data.num_unhashed_gates;
   }
 
   uint32_t fanin_size( node const& n ) const
@@ -1221,13 +1403,74 @@ public:
   {
     return *_events;
   }
+
+  /*! \brief Enables or disables structural hashing.
+   *
+   * Disabling structural hashing frees the hash table.  It can only be
+   * enabled again as long as the network has no gates, otherwise
+   * `std::logic_error` is thrown and the network is not changed.
+   */
+  void set_structural_hashing( bool enabled )
+  {
+    if ( enabled == _storage->data.structural_hashing )
+    {
+      return;
+    }
+    if ( enabled && _storage->data.num_unhashed_gates != 0u )
+    {
+      throw std::logic_error( "structural hashing cannot be enabled in an AIG with gates" );
+    }
+    else
+    {
+      _storage->data.num_unhashed_gates = static_cast<uint32_t>( _storage->hash.size() );
+      decltype( _storage->hash )().swap( _storage->hash );
+    }
+    _storage->data.structural_hashing = enabled;
+  }
+
+  bool has_structural_hashing() const
+  {
+    return _storage->data.structural_hashing;
+  }
+
+  /*! \brief Drops the nodes in `[first, last)` from memory.
+   *
+   * Only has an effect for out-of-core networks, whose nodes are read back
+   * from the file when they are accessed again.
+   */
+  void release_nodes( node const& first, node const& last ) const
+  {
+    if constexpr ( is_out_of_core )
+    {
+      _storage->nodes.release( first, last );
+    }
+    else
+    {
+      (void)first;
+      (void)last;
+    }
+  }
 #pragma endregion
 
 public:
-  std::shared_ptr<aig_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using aig_network = basic_aig_network<aig_storage>;
+
+/*! \brief AIG network with nodes stored in a memory-mapped file
+ *
+ * The nodes are stored in a temporary file (in `$TMPDIR` or `/tmp`) that is
+ * mapped into memory, such that networks larger than the available memory
+ * can be processed.  Structural hashing is disabled by default, since the
+ * hash table is kept in memory; it can be enabled before creating gates
+ * with `set_structural_hashing`.  Algorithms that visit the nodes in
+ * topological order (e.g., `simulate` and `write_aiger`) call
+ * `release_nodes` to bound the resident memory.
+ */
+using mapped_aig_network = basic_aig_network<mapped_aig_storage>;
+
 } // namespace mockturtle
 
 namespace std
@@ -1248,4 +1491,13 @@ struct hash<mockturtle::aig_network::signal>
   }
 }; /* hash */
 
+template<>
+struct hash<mockturtle::mapped_aig_network::signal>
+{
+  uint64_t operator()( mockturtle::mapped_aig_network::signal const &s ) const noexcept
+  {
+    return hash<mockturtle::aig_network::signal>{}( mockturtle::aig_network::signal( s.data ) );
+  }
+}; /* hash */
+
 } // namespace std
\ No newline at end of file
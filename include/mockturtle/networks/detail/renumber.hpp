@@ -0,0 +1,179 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file renumber.hpp
+  \brief In-place renumbering of network storages
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mockturtle::detail
+{
+
+/*! \brief Renumbers the nodes of a storage with fixed fan-in in place.
+ *
+ * The constant keeps index 0, the CIs get the indices 1, 2, ... in the
+ * order of `storage.inputs`, and the gates in `gates` get the following
+ * indices in their order.  All other gates are removed.  If the kept nodes
+ * keep their relative order, they are moved in a single forward pass,
+ * otherwise they are permuted in place by following the cycles of the
+ * permutation, such that only the returned map and one bit per node are
+ * allocated.
+ *
+ * `rewrite( node, old_to_new )` must replace the children of a gate by
+ * their new indices and restore the canonical order of the children, which
+ * may encode the gate type.  The fan-out sizes are recomputed (which also
+ * revives dead nodes), the outputs are renumbered, and the hash table is
+ * rebuilt if `rehash` is true.
+ *
+ * Returns the new index of each old node, removed nodes are mapped to 0.
+ */
+template<class Storage, class Node, class Rewrite>
+std::vector<Node> renumber_storage( Storage& storage, std::vector<Node> const& gates, bool rehash, Rewrite&& rewrite )
+{
+  const auto size = static_cast<Node>( storage.nodes.size() );
+  const auto num_cis = static_cast<Node>( storage.inputs.size() );
+
+  std::vector<Node> old_to_new( size, 0u );
+  Node index = 1u;
+  for ( auto const& ci : storage.inputs )
+  {
+    old_to_new[ci] = index++;
+  }
+  for ( auto const& g : gates )
+  {
+    assert( g != 0u && old_to_new[g] == 0u );
+    old_to_new[g] = index++;
+  }
+  const auto new_size = index;
+
+  /* kept nodes that stay in their relative order are moved in one forward pass */
+  bool monotone = true;
+  for ( Node n = 1u, last = 0u; n < size && monotone; ++n )
+  {
+    if ( old_to_new[n] != 0u )
+    {
+      monotone = old_to_new[n] > last;
+      last = old_to_new[n];
+    }
+  }
+
+  if ( monotone )
+  {
+    for ( Node n = 1u; n < size; ++n )
+    {
+      if ( old_to_new[n] != 0u && old_to_new[n] != n )
+      {
+        storage.nodes[old_to_new[n]] = storage.nodes[n];
+      }
+    }
+  }
+  else
+  {
+    /* move the removed nodes behind the kept ones to complete the permutation */
+    for ( Node n = 1u; n < size; ++n )
+    {
+      if ( old_to_new[n] == 0u )
+      {
+        old_to_new[n] = index++;
+      }
+    }
+    assert( index == size );
+
+    /* apply the permutation cycle by cycle */
+    std::vector<bool> placed( size, false );
+    for ( Node n = 0u; n < size; ++n )
+    {
+      if ( placed[n] )
+      {
+        continue;
+      }
+      auto current = storage.nodes[n];
+      for ( auto j = old_to_new[n]; j != n; j = old_to_new[j] )
+      {
+        std::swap( current, storage.nodes[j] );
+        placed[j] = true;
+      }
+      storage.nodes[n] = current;
+      placed[n] = true;
+    }
+    std::vector<bool>().swap( placed );
+
+    for ( auto& v : old_to_new )
+    {
+      if ( v >= new_size )
+      {
+        v = 0u;
+      }
+    }
+  }
+  storage.nodes.resize( new_size );
+
+  /* renumber children and outputs, recompute fan-out sizes */
+  for ( Node n = 0u; n < new_size; ++n )
+  {
+    storage.nodes[n].data[0].h1 = 0u;
+  }
+  for ( auto n = Node( 1u ) + num_cis; n < new_size; ++n )
+  {
+    auto& node = storage.nodes[n];
+    rewrite( node, old_to_new );
+    for ( auto const& c : node.children )
+    {
+      assert( c.index < n );
+      storage.nodes[c.index].data[0].h1++;
+    }
+  }
+  for ( auto& o : storage.outputs )
+  {
+    assert( o.index == 0u || old_to_new[o.index] != 0u );
+    o.index = old_to_new[o.index];
+    storage.nodes[o.index].data[0].h1++;
+  }
+  for ( Node i = 0u; i < num_cis; ++i )
+  {
+    storage.inputs[i] = 1u + i;
+  }
+
+  if ( rehash )
+  {
+    storage.hash.clear();
+    storage.hash.reserve( new_size - 1u - num_cis );
+    for ( auto n = Node( 1u ) + num_cis; n < new_size; ++n )
+    {
+      storage.hash[storage.nodes[n]] = n;
+    }
+  }
+
+  return old_to_new;
+}
+
+} // namespace mockturtle::detail
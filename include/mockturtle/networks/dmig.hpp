@@ -37,8 +37,10 @@
 #include <stack>
 #include <string>
 
+#include <kitty/algorithm.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
@@ -1073,11 +1075,20 @@ public:
     auto const& c2 = _storage->nodes[n].children[1];
     auto const& c3 = _storage->nodes[n].children[2];
 
-    auto tt1 = *begin++;
-    auto tt2 = *begin++;
-    auto tt3 = *begin++;
-
-    return kitty::ternary_majority( c1.weight ? ~tt1 : tt1, c2.weight ? ~tt2 : tt2, c3.weight ? ~tt3 : tt3 );
+    auto const& tt1 = *begin++;
+    auto const& tt2 = *begin++;
+    auto const& tt3 = *begin++;
+
+    /* complemented fanins are applied per word, without copying the truth tables */
+    const auto m1 = c1.weight ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    const auto m2 = c2.weight ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    const auto m3 = c3.weight ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    return kitty::ternary_operation( tt1, tt2, tt3, [m1, m2, m3]( auto a, auto b, auto c ) {
+      a ^= m1;
+      b ^= m2;
+      c ^= m3;
+      return ( a & ( b ^ c ) ) ^ ( b & c );
+    } );
   }
 
   /*! \brief Re-compute the last block. */
@@ -1093,9 +1104,9 @@ public:
     auto const& c2 = _storage->nodes[n].children[1];
     auto const& c3 = _storage->nodes[n].children[2];
 
-    auto tt1 = *begin++;
-    auto tt2 = *begin++;
-    auto tt3 = *begin++;
+    auto const& tt1 = *begin++;
+    auto const& tt2 = *begin++;
+    auto const& tt3 = *begin++;
 
     assert( tt1.num_bits() > 0 && "truth tables must not be empty" );
     assert( tt1.num_bits() == tt2.num_bits() );
@@ -1103,11 +1114,12 @@ public:
     assert( tt1.num_bits() >= result.num_bits() );
     assert( result.num_blocks() == tt1.num_blocks() || ( result.num_blocks() == tt1.num_blocks() - 1 && result.num_bits() % 64 == 0 ) );
 
+    const auto a = c1.weight ? ~tt1._bits.back() : tt1._bits.back();
+    const auto b = c2.weight ? ~tt2._bits.back() : tt2._bits.back();
+    const auto c = c3.weight ? ~tt3._bits.back() : tt3._bits.back();
+
     result.resize( tt1.num_bits() );
-    result._bits.back() =
-      ( ( c1.weight ? ~tt1._bits.back() : tt1._bits.back() ) & ( c2.weight ? ~tt2._bits.back() : tt2._bits.back() ) ) |
-      ( ( c1.weight ? ~tt1._bits.back() : tt1._bits.back() ) & ( c3.weight ? ~tt3._bits.back() : tt3._bits.back() ) ) |
-      ( ( c2.weight ? ~tt2._bits.back() : tt2._bits.back() ) & ( c3.weight ? ~tt3._bits.back() : tt3._bits.back() ) );
+    result._bits.back() = ( a & ( b ^ c ) ) ^ ( b & c );
     result.mask_bits();
   }
 #pragma endregion
@@ -35,6 +35,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "../utils/lut_evaluator.hpp"
 #include "../utils/truth_table_cache.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
@@ -42,8 +43,13 @@
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
 
+#include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace mockturtle
 {
@@ -51,6 +57,7 @@ namespace mockturtle
 struct klut_storage_data
 {
   truth_table_cache<kitty::dynamic_truth_table> cache;
+  std::vector<lut_evaluator> evaluators; /* one per entry in `cache` */
   uint32_t num_pis = 0u;
   uint32_t num_pos = 0u;
   std::vector<int8_t> latches;
@@ -66,40 +73,63 @@ struct klut_storage_data
  */
 struct klut_storage_node : mixed_fanin_node<2>
 {
+  static constexpr auto max_fanin_size = 32;
+
   bool operator==( klut_storage_node const& other ) const
   {
     return data[1].h1 == other.data[1].h1 && children == other.children;
   }
 };
 
+/*! \brief k-LUT node with at most `MaxFanin` children stored inline
+ *
+ * Uses the same data fields as `klut_storage_node`, children are stored as
+ * 32-bit indexes.
+ */
+template<int MaxFanin>
+struct klut_inline_storage_node : inline_fanin_node<MaxFanin, 2, compact_node_pointer>
+{
+  static constexpr auto max_fanin_size = MaxFanin;
+
+  bool operator==( klut_inline_storage_node<MaxFanin> const& other ) const
+  {
+    return this->data[1].h1 == other.data[1].h1 && this->children == other.children;
+  }
+};
+
 /*! \brief k-LUT storage container
 
   ...
 */
-using klut_storage = storage<klut_storage_node, klut_storage_data>;
+template<class Node>
+using basic_klut_storage = storage<Node, klut_storage_data>;
 
-class klut_network
+using klut_storage = basic_klut_storage<klut_storage_node>;
+
+/*! \brief k-LUT network over a node type (see `klut_network` and `inline_klut_network`). */
+template<class Node>
+class basic_klut_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 1;
-  static constexpr auto max_fanin_size = 32;
+  static constexpr auto max_fanin_size = Node::max_fanin_size;
 
-  using base_type = klut_network;
-  using storage = std::shared_ptr<klut_storage>;
+  using base_type = basic_klut_network;
+  using storage = std::shared_ptr<basic_klut_storage<Node>>;
   using node = uint64_t;
   using signal = uint64_t;
 
-  klut_network()
-      : _storage( std::make_shared<klut_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_klut_network()
+      : _storage( std::make_shared<basic_klut_storage<Node>>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
 
-  klut_network( std::shared_ptr<klut_storage> storage )
+  basic_klut_network( std::shared_ptr<basic_klut_storage<Node>> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
@@ -112,57 +142,70 @@ private:
 
     /* reserve some truth tables for nodes */
     kitty::dynamic_truth_table tt_zero( 0 );
-    _storage->data.cache.insert( tt_zero );
+    _insert_function( tt_zero );
 
     static uint64_t _not = 0x1;
     kitty::dynamic_truth_table tt_not( 1 );
     kitty::create_from_words( tt_not, &_not, &_not + 1 );
-    _storage->data.cache.insert( tt_not );
+    _insert_function( tt_not );
 
     static uint64_t _and = 0x8;
     kitty::dynamic_truth_table tt_and( 2 );
     kitty::create_from_words( tt_and, &_and, &_and + 1 );
-    _storage->data.cache.insert( tt_and );
+    _insert_function( tt_and );
 
     static uint64_t _or = 0xe;
     kitty::dynamic_truth_table tt_or( 2 );
     kitty::create_from_words( tt_or, &_or, &_or + 1 );
-    _storage->data.cache.insert( tt_or );
+    _insert_function( tt_or );
 
     static uint64_t _lt = 0x4;
     kitty::dynamic_truth_table tt_lt( 2 );
     kitty::create_from_words( tt_lt, &_lt, &_lt + 1 );
-    _storage->data.cache.insert( tt_lt );
+    _insert_function( tt_lt );
 
     static uint64_t _le = 0xd;
     kitty::dynamic_truth_table tt_le( 2 );
     kitty::create_from_words( tt_le, &_le, &_le + 1 );
-    _storage->data.cache.insert( tt_le );
+    _insert_function( tt_le );
 
     static uint64_t _xor = 0x6;
     kitty::dynamic_truth_table tt_xor( 2 );
     kitty::create_from_words( tt_xor, &_xor, &_xor + 1 );
-    _storage->data.cache.insert( tt_xor );
+    _insert_function( tt_xor );
 
     static uint64_t _maj = 0xe8;
     kitty::dynamic_truth_table tt_maj( 3 );
     kitty::create_from_words( tt_maj, &_maj, &_maj + 1 );
-    _storage->data.cache.insert( tt_maj );
+    _insert_function( tt_maj );
 
     static uint64_t _ite = 0xd8;
     kitty::dynamic_truth_table tt_ite( 3 );
     kitty::create_from_words( tt_ite, &_ite, &_ite + 1 );
-    _storage->data.cache.insert( tt_ite );
+    _insert_function( tt_ite );
 
     static uint64_t _xor3 = 0x96;
     kitty::dynamic_truth_table tt_xor3( 3 );
     kitty::create_from_words( tt_xor3, &_xor3, &_xor3 + 1 );
-    _storage->data.cache.insert( tt_xor3 );
+    _insert_function( tt_xor3 );
 
     /* truth tables for constants */
     _storage->nodes[0].data[1].h1 = 0;
     _storage->nodes[1].data[1].h1 = 1;
   }
+
+  uint32_t _insert_function( kitty::dynamic_truth_table const& function )
+  {
+    const auto literal = _storage->data.cache.insert( function );
+
+    /* compile word-parallel evaluators for new functions */
+    auto& evaluators = _storage->data.evaluators;
+    while ( evaluators.size() < _storage->data.cache.size() )
+    {
+      evaluators.emplace_back( _storage->data.cache[static_cast<uint32_t>( 2u * evaluators.size() )] );
+    }
+    return literal;
+  }
 #pragma endregion
 
 #pragma region Primary I / O and constants
@@ -361,7 +404,13 @@ signal create_maj( signal a, signal b, signal c )
 #pragma region Create arbitrary functions
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
-    storage::element_type::node_type node;
+    /* the inline fanin array of a node only asserts its capacity */
+    if ( children.size() > static_cast<std::size_t>( max_fanin_size ) )
+    {
+      throw std::invalid_argument( "k-LUT node has " + std::to_string( children.size() ) + " fanins, but at most " + std::to_string( max_fanin_size ) + " are supported" );
+    }
+
+    typename storage::element_type::node_type node;
     std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
     node.data[1].h1 = literal;
 
@@ -395,10 +444,10 @@ signal create_maj( signal a, signal b, signal c )
       assert( function.num_vars() == 0u );
       return get_constant( !kitty::is_const0( function ) );
     }
-    return _create_node( children, _storage->data.cache.insert( function ) );
+    return _create_node( children, _insert_function( function ) );
   }
 
-  signal clone_node( klut_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_klut_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( !children.empty() );
     const auto tt = other._storage->data.cache[other._storage->nodes[source].data[1].h1];
@@ -752,7 +801,7 @@ signal create_maj( signal a, signal b, signal c )
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    using IteratorType = decltype( _storage->nodes[n].children.begin() );
     detail::foreach_element_transform<IteratorType, uint32_t>( _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; }, fn );
   }
 #pragma endregion
@@ -776,30 +825,74 @@ signal create_maj( signal a, signal b, signal c )
   compute( node const& n, Iterator begin, Iterator end ) const
   {
     const auto nfanin = _storage->nodes[n].children.size();
-    std::vector<typename Iterator::value_type> tts( begin, end );
+    std::vector<uint64_t const*> fanins;
+    fanins.reserve( nfanin );
 
     assert( nfanin != 0 );
-    assert( tts.size() == nfanin );
+    assert( static_cast<std::size_t>( std::distance( begin, end ) ) == nfanin );
 
     /* resulting truth table has the same size as any of the children */
-    auto result = tts.front().construct();
-    const auto gate_tt = _storage->data.cache[_storage->nodes[n].data[1].h1];
+    auto result = ( *begin ).construct();
+    if ( result.cbegin() == result.cend() )
+    {
+      return result;
+    }
 
-    for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
+    for ( ; begin != end; ++begin )
     {
-      uint32_t pattern = 0u;
-      for ( auto j = 0u; j < nfanin; ++j )
-      {
-        pattern |= kitty::get_bit( tts[j], i ) << j;
-      }
-      if ( kitty::get_bit( gate_tt, pattern ) )
-      {
-        kitty::set_bit( result, i );
-      }
+      fanins.push_back( &*( *begin ).cbegin() );
     }
 
+    _evaluate( n, fanins, result, 0u );
+    result.mask_bits();
     return result;
   }
+
+  /*! \brief Re-compute the last block. */
+  template<typename Iterator>
+  void compute( node const& n, kitty::partial_truth_table& result, Iterator begin, Iterator end ) const
+  {
+    static_assert( iterates_over_v<Iterator, kitty::partial_truth_table>, "begin and end have to iterate over partial_truth_tables" );
+
+    assert( n > 1 && !is_ci( n ) );
+    assert( static_cast<std::size_t>( std::distance( begin, end ) ) == _storage->nodes[n].children.size() );
+
+    auto const& tt1 = *begin;
+    assert( tt1.num_bits() > 0 && "truth tables must not be empty" );
+    assert( tt1.num_bits() >= result.num_bits() );
+    assert( result.num_blocks() == tt1.num_blocks() || ( result.num_blocks() == tt1.num_blocks() - 1 && result.num_bits() % 64 == 0 ) );
+
+    result.resize( tt1.num_bits() );
+
+    std::vector<uint64_t const*> fanins;
+    fanins.reserve( _storage->nodes[n].children.size() );
+    for ( ; begin != end; ++begin )
+    {
+      assert( ( *begin ).num_bits() == result.num_bits() );
+      fanins.push_back( &*( *begin ).cbegin() );
+    }
+
+    _evaluate( n, fanins, result, static_cast<uint32_t>( result.num_blocks() - 1u ) );
+    result.mask_bits();
+  }
+
+private:
+  template<typename TT>
+  void _evaluate( node const& n, std::vector<uint64_t const*> const& fanins, TT& result, uint32_t first_block ) const
+  {
+    const auto literal = _storage->nodes[n].data[1].h1;
+    const auto index = literal >> 1;
+    if ( index < _storage->data.evaluators.size() )
+    {
+      _storage->data.evaluators[index].evaluate( fanins, result, first_block, literal & 1 );
+    }
+    else
+    {
+      lut_evaluator( _storage->data.cache[literal] ).evaluate( fanins, result, first_block );
+    }
+  }
+
+public:
 #pragma endregion
 
 #pragma region Custom node values
@@ -864,8 +957,39 @@ signal create_maj( signal a, signal b, signal c )
 #pragma endregion
 
 public:
-  std::shared_ptr<klut_storage> _storage;
+  std::shared_ptr<basic_klut_storage<Node>> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+/*! \brief k-LUT network with fanins stored in a `std::vector` per node (up to 32 fanins). */
+using klut_network = basic_klut_network<klut_storage_node>;
+
+/*! \brief k-LUT network with at most `MaxFanin` fanins stored inline in each node.
+ *
+ * Provides the same interface as `klut_network`, but the children of a node
+ * are stored in the node itself instead of a separate heap allocation.  This
+ * reduces memory and improves locality for networks of small LUTs, e.g., the
+ * result of a 6-LUT mapping.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      mapping_view<aig_network, true> mapped{aig};
+      lut_mapping<decltype( mapped ), true>( mapped );
+      const auto luts = *collapse_mapped_network<inline_klut_network<6>>( mapped );
+   \endverbatim
+ */
+template<int MaxFanin>
+using inline_klut_network = basic_klut_network<klut_inline_storage_node<MaxFanin>>;
+
+/*! \brief Checks whether a network type is a k-LUT network (any node type). */
+template<class Ntk>
+inline constexpr bool is_klut_network_type_v = false;
+
+template<class Node>
+inline constexpr bool is_klut_network_type_v<basic_klut_network<Node>> = true;
+
 } // namespace mockturtle
\ No newline at end of file
@@ -33,7 +33,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <unordered_map>
 #include <vector>
@@ -86,6 +90,30 @@ public:
   }
 };
 
+/*! \brief Node pointer with a 32-bit index and no weight field.
+ *
+ * Halves the size of fanin arrays for networks with less than 2^32 nodes.
+ */
+struct compact_node_pointer
+{
+public:
+  compact_node_pointer() = default;
+  compact_node_pointer( uint64_t index ) : index( static_cast<uint32_t>( index ) )
+  {
+    assert( index <= UINT32_MAX );
+  }
+
+  union {
+    uint32_t index;
+    uint32_t data;
+  };
+
+  bool operator==( compact_node_pointer const& other ) const
+  {
+    return data == other.data;
+  }
+};
+
 union cauint64_t {
   uint64_t n{0};
   struct
@@ -130,6 +158,90 @@ struct mixed_fanin_node
   }
 };
 
+/*! \brief Fanin array with inline storage for at most `MaxFanin` pointers.
+ *
+ * Provides the subset of the `std::vector` interface that networks use for
+ * the children of a node, without a heap allocation per node.
+ */
+template<int MaxFanin, typename PointerType>
+class inline_fanin_array
+{
+  static_assert( MaxFanin > 0 && MaxFanin < 256, "MaxFanin must be between 1 and 255" );
+
+public:
+  using value_type = PointerType;
+  using reference = PointerType&;
+  using const_reference = PointerType const&;
+  using iterator = PointerType*;
+  using const_iterator = PointerType const*;
+  using size_type = std::size_t;
+
+  iterator begin() { return _data.data(); }
+  iterator end() { return _data.data() + _size; }
+  const_iterator begin() const { return _data.data(); }
+  const_iterator end() const { return _data.data() + _size; }
+  const_iterator cbegin() const { return _data.data(); }
+  const_iterator cend() const { return _data.data() + _size; }
+
+  size_type size() const { return _size; }
+  bool empty() const { return _size == 0u; }
+  static constexpr size_type capacity() { return MaxFanin; }
+
+  reference operator[]( size_type i ) { return _data[i]; }
+  const_reference operator[]( size_type i ) const { return _data[i]; }
+  reference front() { return _data[0]; }
+  const_reference front() const { return _data[0]; }
+  reference back() { return _data[_size - 1u]; }
+  const_reference back() const { return _data[_size - 1u]; }
+
+  void push_back( value_type const& value )
+  {
+    assert( _size < MaxFanin );
+    _data[_size++] = value;
+  }
+
+  void clear() { _size = 0u; }
+
+  void resize( size_type size )
+  {
+    assert( size <= MaxFanin );
+    for ( auto i = static_cast<size_type>( _size ); i < size; ++i )
+    {
+      _data[i] = value_type{};
+    }
+    _size = static_cast<uint8_t>( size );
+  }
+
+  bool operator==( inline_fanin_array const& other ) const
+  {
+    return _size == other._size && std::equal( begin(), end(), other.begin() );
+  }
+
+  bool operator!=( inline_fanin_array const& other ) const
+  {
+    return !( *this == other );
+  }
+
+private:
+  std::array<PointerType, MaxFanin> _data;
+  uint8_t _size{0u};
+};
+
+/*! \brief Node with up to `MaxFanin` children stored inline. */
+template<int MaxFanin, int Size = 0, typename PointerType = node_pointer<0>>
+struct inline_fanin_node
+{
+  using pointer_type = PointerType;
+
+  inline_fanin_array<MaxFanin, pointer_type> children;
+  std::array<cauint64_t, Size> data;
+
+  bool operator==( inline_fanin_node<MaxFanin, Size, PointerType> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
 /*! \brief Hash function for 64-bit word */
 inline uint64_t hash_block( uint64_t word )
 {
@@ -187,7 +299,13 @@ struct empty_storage_data
 {
 };
 
-template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
+/*! \brief Network storage
+ *
+ * `NodeContainer` is the container of the nodes, which must provide the
+ * interface of `std::vector<Node>` used by the networks (e.g.,
+ * `mapped_vector<Node>` to store the nodes in a memory-mapped file).
+ */
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>, typename NodeContainer = std::vector<Node>>
 struct storage
 {
   storage()
@@ -201,7 +319,7 @@ struct storage
 
   using node_type = Node;
 
-  std::vector<node_type> nodes;
+  NodeContainer nodes;
   std::vector<uint64_t> inputs;
   std::vector<typename node_type::pointer_type> outputs;
   std::unordered_map<uint64_t, latch_info> latch_information;
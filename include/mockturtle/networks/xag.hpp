@@ -43,6 +43,7 @@
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
 #include "detail/foreach.hpp"
+#include "detail/renumber.hpp"
 #include "events.hpp"
 #include "storage.hpp"
 
@@ -589,6 +590,29 @@ public:
     }
   }
 
+  /*! \brief Renumbers the nodes in place.
+   *
+   * The CIs keep their order and are followed by the gates in `gates`,
+   * which must be in topological order and contain all gates in the
+   * transitive fanin of the COs.  All other gates are removed, and the
+   * fan-out sizes and the structural hash table are rebuilt.  Returns the
+   * new index of each old node, where removed nodes are mapped to 0.  Node
+   * maps and views of the network are invalidated.
+   */
+  std::vector<node> renumber_nodes( std::vector<node> const& gates )
+  {
+    return detail::renumber_storage( *_storage, gates, true, []( auto& n, auto const& old_to_new ) {
+      /* the order of the children distinguishes AND and XOR gates */
+      const auto is_xor = n.children[0].index > n.children[1].index;
+      n.children[0].index = old_to_new[n.children[0].index];
+      n.children[1].index = old_to_new[n.children[1].index];
+      if ( ( n.children[0].index > n.children[1].index ) != is_xor )
+      {
+        std::swap( n.children[0], n.children[1] );
+      }
+    } );
+  }
+
   inline bool is_dead( node const& n ) const
   {
     return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
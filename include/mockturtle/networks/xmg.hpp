@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <stack>
@@ -43,6 +44,7 @@
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
 #include "detail/foreach.hpp"
+#include "detail/renumber.hpp"
 #include "events.hpp"
 #include "storage.hpp"
 
@@ -690,6 +692,28 @@ public:
     }
   }
 
+  /*! \brief Renumbers the nodes in place.
+   *
+   * The CIs keep their order and are followed by the gates in `gates`,
+   * which must be in topological order and contain all gates in the
+   * transitive fanin of the COs.  All other gates are removed, and the
+   * fan-out sizes and the structural hash table are rebuilt.  Returns the
+   * new index of each old node, where removed nodes are mapped to 0.  Node
+   * maps and views of the network are invalidated.
+   */
+  std::vector<node> renumber_nodes( std::vector<node> const& gates )
+  {
+    return detail::renumber_storage( *_storage, gates, true, []( auto& n, auto const& old_to_new ) {
+      /* MAJ gates have ascending and XOR3 gates descending children */
+      const auto is_maj = n.children[0].index < n.children[1].index;
+      for ( auto& c : n.children )
+      {
+        c.index = old_to_new[c.index];
+      }
+      std::sort( n.children.begin(), n.children.end(), [is_maj]( auto const& a, auto const& b ) { return is_maj ? a.index < b.index : a.index > b.index; } );
+    } );
+  }
+
   inline bool is_dead( node const& n ) const
   {
     return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
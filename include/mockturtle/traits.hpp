@@ -32,10 +32,12 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <type_traits>
 #include <list>
 #include <map>
+#include <vector>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/traits.hpp>
@@ -84,6 +86,21 @@ template<class Ntk>
 inline constexpr bool is_topologically_sorted_v = is_topologically_sorted<Ntk>::value;
 #pragma endregion
 
+#pragma region is_out_of_core
+template<class Ntk, class = void>
+struct is_out_of_core : std::false_type
+{
+};
+
+template<class Ntk>
+struct is_out_of_core<Ntk, std::enable_if_t<Ntk::is_out_of_core, std::void_t<decltype( Ntk::is_out_of_core )>>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_out_of_core_v = is_out_of_core<Ntk>::value;
+#pragma endregion
+
 #pragma region has_get_constant
 template<class Ntk, class = void>
 struct has_get_constant : std::false_type
@@ -294,6 +311,21 @@ template<class Ntk>
 inline constexpr bool has_create_and_v = has_create_and<Ntk>::value;
 #pragma endregion
 
+#pragma region has_create_and_batch
+template<class Ntk, class = void>
+struct has_create_and_batch : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_create_and_batch<Ntk, std::void_t<decltype( std::declval<Ntk>().create_and_batch( std::declval<std::vector<std::array<signal<Ntk>, 2u>>>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_create_and_batch_v = has_create_and_batch<Ntk>::value;
+#pragma endregion
+
 #pragma region has_create_nand
 template<class Ntk, class = void>
 struct has_create_nand : std::false_type
@@ -639,6 +671,21 @@ template<class Ntk>
 inline constexpr bool has_take_out_node_v = has_take_out_node<Ntk>::value;
 #pragma endregion
 
+#pragma region has_renumber_nodes
+template<class Ntk, class = void>
+struct has_renumber_nodes : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_renumber_nodes<Ntk, std::void_t<decltype( std::declval<Ntk>().renumber_nodes( std::declval<std::vector<node<Ntk>>>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_renumber_nodes_v = has_renumber_nodes<Ntk>::value;
+#pragma endregion
+
 #pragma region is_dead
 template<class Ntk, class = void>
 struct has_is_dead : std::false_type
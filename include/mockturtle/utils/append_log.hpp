@@ -0,0 +1,422 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file append_log.hpp
+  \brief Append-only binary record files shared between processes
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#define MOCKTURTLE_APPEND_LOG_HAS_FLOCK
+#endif
+
+namespace mockturtle
+{
+
+namespace detail
+{
+#if __GNUC__ == 7
+namespace append_log_fs = std::experimental::filesystem::v1;
+#else
+namespace append_log_fs = std::filesystem;
+#endif
+} /* namespace detail */
+
+/*! \brief Append-only binary record file.
+ *
+ * The file starts with a header (a 32-bit magic number chosen by the user
+ * of the log, a 32-bit format version, and a 64-bit compaction counter).
+ * Each record is stored as its payload size, a checksum of the payload, and
+ * the payload itself.  Records are never modified once written, except
+ * when the whole file is replaced by `compact`.
+ *
+ * If a process crashes while appending a record, the file ends with an
+ * incomplete or corrupt record.  Such a tail is ignored when reading and
+ * is truncated before the next append, so that the file stays readable.
+ * Compaction writes a temporary file and renames it, such that a crash
+ * leaves either the old or the new file.
+ *
+ * On POSIX systems, the file is protected by an advisory lock (`flock`) on
+ * a lock file next to it: readers take a shared lock and writers an
+ * exclusive lock.  Several processes can therefore share one file, and
+ * each process sees the records appended by the others on its next call to
+ * `read` or `append`.  On other systems, no locking is performed.
+ *
+ * Integers are stored in host byte order; log files are not portable
+ * between platforms of different endianness.
+ */
+class append_log
+{
+public:
+  /*! \brief Opens (or creates) the log file `filename`.
+   *
+   * \param filename Path to the log file
+   * \param magic Magic number that identifies the file format of the user
+   * \param version Format version of the user
+   */
+  append_log( std::string const& filename, uint32_t magic, uint32_t version = 1u )
+      : _filename( filename ),
+        _magic( magic ),
+        _version( version )
+  {
+    std::ofstream touch( _filename, std::ios::binary | std::ios::app );
+    _good = touch.good();
+#ifdef MOCKTURTLE_APPEND_LOG_HAS_FLOCK
+    _fd = ::open( ( _filename + ".lock" ).c_str(), O_RDWR | O_CREAT, 0644 );
+    _good = _good && _fd != -1;
+#endif
+  }
+
+  ~append_log()
+  {
+#ifdef MOCKTURTLE_APPEND_LOG_HAS_FLOCK
+    if ( _fd != -1 )
+    {
+      ::close( _fd );
+    }
+#endif
+  }
+
+  append_log( append_log const& ) = delete;
+  append_log& operator=( append_log const& ) = delete;
+
+  /*! \brief Returns false, if the file cannot be opened or has a different format. */
+  bool good() const
+  {
+    return _good;
+  }
+
+  /*! \brief Returns the path to the log file. */
+  std::string const& filename() const
+  {
+    return _filename;
+  }
+
+  /*! \brief Checks whether the file has grown since the last read or append. */
+  bool has_new_records() const
+  {
+    std::error_code ec;
+    auto const size = detail::append_log_fs::file_size( _filename, ec );
+    return !ec && size > _offset;
+  }
+
+  /*! \brief Reads all records that have not been read yet.
+   *
+   * The function `fn` is called with each record's payload as
+   * `std::string const&`.
+   */
+  template<typename Fn>
+  void read( Fn&& fn )
+  {
+    if ( !_good )
+    {
+      return;
+    }
+
+    lock_guard lock( *this, false );
+    read_tail( fn );
+  }
+
+  /*! \brief Appends records to the file.
+   *
+   * Records appended by other processes since the last read are read
+   * first and passed to `fn`.  If the file has been compacted by another
+   * process in the meantime, all records are passed to `fn` again.
+   */
+  template<typename Fn>
+  void append( std::vector<std::string> const& payloads, Fn&& fn )
+  {
+    if ( !_good )
+    {
+      return;
+    }
+
+    lock_guard lock( *this, true );
+    auto const valid_end = read_tail( fn );
+    if ( !_good || payloads.empty() )
+    {
+      return;
+    }
+
+    /* remove incomplete records, e.g., from a crashed process */
+    std::error_code ec;
+    if ( detail::append_log_fs::file_size( _filename, ec ) != valid_end )
+    {
+      detail::append_log_fs::resize_file( _filename, valid_end, ec );
+    }
+
+    std::string buffer;
+    if ( valid_end == 0u )
+    {
+      write_header( buffer );
+    }
+    for ( auto const& payload : payloads )
+    {
+      write_value( buffer, static_cast<uint32_t>( payload.size() ) );
+      write_value( buffer, checksum( payload ) );
+      buffer += payload;
+    }
+
+    std::ofstream os( _filename, std::ios::binary | std::ios::app );
+    os.write( buffer.data(), buffer.size() );
+    os.flush();
+    if ( os.good() )
+    {
+      _offset = valid_end + buffer.size();
+    }
+  }
+
+  /*! \brief Appends records to the file. */
+  void append( std::vector<std::string> const& payloads )
+  {
+    append( payloads, []( std::string const& ) {} );
+  }
+
+  /*! \brief Replaces the contents of the file.
+   *
+   * This is used to remove outdated or duplicate records.  Records
+   * appended by other processes since the last read are read first and
+   * passed to `fn`.  Then, `payloads` is called without arguments and
+   * must return all records that should be kept as
+   * `std::vector<std::string>`.  The records are written into a temporary
+   * file, which then replaces the log file.
+   */
+  template<typename Fn, typename PayloadsFn>
+  void compact( Fn&& fn, PayloadsFn&& payloads_fn )
+  {
+    if ( !_good )
+    {
+      return;
+    }
+
+    lock_guard lock( *this, true );
+    read_tail( fn );
+    if ( !_good )
+    {
+      return;
+    }
+    std::vector<std::string> const payloads = payloads_fn();
+
+    /* other processes start reading from the beginning after compaction */
+    ++_epoch;
+
+    std::string buffer;
+    write_header( buffer );
+    for ( auto const& payload : payloads )
+    {
+      write_value( buffer, static_cast<uint32_t>( payload.size() ) );
+      write_value( buffer, checksum( payload ) );
+      buffer += payload;
+    }
+
+    auto const tmp_filename = _filename + ".tmp";
+    {
+      std::ofstream os( tmp_filename, std::ios::binary | std::ios::trunc );
+      os.write( buffer.data(), buffer.size() );
+      if ( !os.good() )
+      {
+        return;
+      }
+    }
+
+    std::error_code ec;
+    detail::append_log_fs::rename( tmp_filename, _filename, ec );
+    if ( !ec )
+    {
+      _offset = buffer.size();
+    }
+  }
+
+  /*! \brief Appends the binary representation of `value` to `buffer`. */
+  template<typename T>
+  static void write_value( std::string& buffer, T const& value )
+  {
+    static_assert( std::is_trivially_copyable_v<T>, "T must be trivially copyable" );
+    char bytes[sizeof( T )];
+    std::memcpy( bytes, &value, sizeof( T ) );
+    buffer.append( bytes, sizeof( T ) );
+  }
+
+  /*! \brief Reads a value from `buffer` at position `pos` and advances `pos`.
+   *
+   * Returns false, if the buffer is too short.
+   */
+  template<typename T>
+  static bool read_value( std::string const& buffer, std::size_t& pos, T& value )
+  {
+    static_assert( std::is_trivially_copyable_v<T>, "T must be trivially copyable" );
+    if ( pos + sizeof( T ) > buffer.size() )
+    {
+      return false;
+    }
+    std::memcpy( &value, buffer.data() + pos, sizeof( T ) );
+    pos += sizeof( T );
+    return true;
+  }
+
+private:
+  /* RAII wrapper around flock */
+  class lock_guard
+  {
+  public:
+    lock_guard( append_log const& log, bool exclusive )
+        : _log( log )
+    {
+#ifdef MOCKTURTLE_APPEND_LOG_HAS_FLOCK
+      while ( ::flock( _log._fd, exclusive ? LOCK_EX : LOCK_SH ) == -1 && errno == EINTR )
+      {
+      }
+#else
+      (void)exclusive;
+#endif
+    }
+
+    ~lock_guard()
+    {
+#ifdef MOCKTURTLE_APPEND_LOG_HAS_FLOCK
+      ::flock( _log._fd, LOCK_UN );
+#endif
+    }
+
+  private:
+    append_log const& _log;
+  };
+
+  static constexpr uint64_t header_size = 2u * sizeof( uint32_t ) + sizeof( uint64_t );
+
+  void write_header( std::string& buffer ) const
+  {
+    write_value( buffer, _magic );
+    write_value( buffer, _version );
+    write_value( buffer, _epoch );
+  }
+
+  static uint32_t checksum( std::string const& payload )
+  {
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    for ( auto const c : payload )
+    {
+      hash ^= static_cast<uint8_t>( c );
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  /* reads records from _offset, returns the end of the last valid record */
+  template<typename Fn>
+  uint64_t read_tail( Fn&& fn )
+  {
+    std::ifstream is( _filename, std::ios::binary );
+    if ( !is.good() )
+    {
+      return _offset;
+    }
+
+    std::string header( header_size, '\0' );
+    is.read( header.data(), header_size );
+    if ( is.gcount() != static_cast<std::streamsize>( header_size ) )
+    {
+      /* empty file or incomplete header: file is rewritten on next append */
+      _offset = 0u;
+      return 0u;
+    }
+
+    std::size_t header_pos{0};
+    uint32_t magic{0}, version{0};
+    uint64_t epoch{0};
+    read_value( header, header_pos, magic );
+    read_value( header, header_pos, version );
+    read_value( header, header_pos, epoch );
+    if ( magic != _magic || version != _version )
+    {
+      _good = false;
+      return 0u;
+    }
+    if ( _offset == 0u || epoch != _epoch )
+    {
+      _offset = header_size;
+      _epoch = epoch;
+    }
+
+    is.seekg( _offset );
+    std::string const buffer( ( std::istreambuf_iterator<char>( is ) ), std::istreambuf_iterator<char>() );
+
+    std::size_t pos{0};
+
+    while ( true )
+    {
+      auto record_pos = pos;
+      uint32_t size{0}, sum{0};
+      if ( !read_value( buffer, record_pos, size ) || !read_value( buffer, record_pos, sum ) || record_pos + size > buffer.size() )
+      {
+        break;
+      }
+      std::string payload = buffer.substr( record_pos, size );
+      if ( checksum( payload ) != sum )
+      {
+        break;
+      }
+      pos = record_pos + size;
+      fn( payload );
+    }
+
+    _offset += pos;
+    return _offset;
+  }
+
+private:
+  std::string _filename;
+  uint32_t _magic;
+  uint32_t _version;
+  uint64_t _offset{0};
+  uint64_t _epoch{0};
+  bool _good{false};
+#ifdef MOCKTURTLE_APPEND_LOG_HAS_FLOCK
+  int _fd{-1};
+#endif
+};
+
+} /* namespace mockturtle */
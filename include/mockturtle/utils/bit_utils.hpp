@@ -0,0 +1,87 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file bit_utils.hpp
+  \brief Portable bit counting on machine words
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Returns the number of ones in a 64-bit word. */
+inline uint32_t popcount64( uint64_t word )
+{
+#if defined( _MSC_VER ) && defined( _M_X64 )
+  return static_cast<uint32_t>( __popcnt64( word ) );
+#elif defined( _MSC_VER )
+  word = word - ( ( word >> 1u ) & UINT64_C( 0x5555555555555555 ) );
+  word = ( word & UINT64_C( 0x3333333333333333 ) ) + ( ( word >> 2u ) & UINT64_C( 0x3333333333333333 ) );
+  word = ( word + ( word >> 4u ) ) & UINT64_C( 0x0f0f0f0f0f0f0f0f );
+  return static_cast<uint32_t>( ( word * UINT64_C( 0x0101010101010101 ) ) >> 56u );
+#else
+  return static_cast<uint32_t>( __builtin_popcountll( word ) );
+#endif
+}
+
+/*! \brief Returns the index of the least significant one in a non-zero 32-bit word. */
+inline uint32_t ctz32( uint32_t word )
+{
+  assert( word != 0u );
+#if defined( _MSC_VER )
+  unsigned long index;
+  _BitScanForward( &index, word );
+  return static_cast<uint32_t>( index );
+#else
+  return static_cast<uint32_t>( __builtin_ctz( word ) );
+#endif
+}
+
+/*! \brief Returns the index of the least significant one in a non-zero 64-bit word. */
+inline uint32_t ctz64( uint64_t word )
+{
+  assert( word != 0u );
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_ARM64 ) )
+  unsigned long index;
+  _BitScanForward64( &index, word );
+  return static_cast<uint32_t>( index );
+#elif defined( _MSC_VER )
+  auto const low = static_cast<uint32_t>( word );
+  return low != 0u ? ctz32( low ) : 32u + ctz32( static_cast<uint32_t>( word >> 32u ) );
+#else
+  return static_cast<uint32_t>( __builtin_ctzll( word ) );
+#endif
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,116 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file conflict_slices.hpp
+  \brief Solving with a deadline by growing conflict limits
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "include/percy.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Calls a solver with growing conflict limits until a deadline has passed.
+ *
+ * The SAT solvers used through percy cannot be interrupted.  Instead,
+ * `solve` is called with a conflict limit (`int32_t`) and must return a
+ * `percy::synth_result`, which is `percy::timeout` if the limit has been
+ * reached.  Then `solve` is called again with a larger limit, until it
+ * returns another result, the deadline has passed, `stop()` returns true,
+ * or the overall `conflict_limit` (0 for no limit) has been reached.
+ *
+ * If `incremental` is true, the solver keeps its state between calls and
+ * `conflict_limit` bounds the sum of all limits.  Otherwise, each call
+ * starts from scratch and `conflict_limit` bounds each limit.
+ *
+ * The first limit is 1,024 conflicts and each next limit is twice the
+ * previous one.  With a deadline, a limit is also bounded by the number of
+ * conflicts that fit into the remaining time, estimated from the conflicts
+ * per second of the previous call, such that the deadline is exceeded by
+ * little more than the estimation error.
+ *
+ * The limit of the last call is returned in `last_limit`.
+ */
+template<typename SolveFn, typename StopFn>
+percy::synth_result solve_with_conflict_slices( SolveFn&& solve, int32_t conflict_limit, bool incremental, std::optional<std::chrono::steady_clock::time_point> const& deadline,
+                                                StopFn&& stop, int32_t& last_limit )
+{
+  using clock = std::chrono::steady_clock;
+  constexpr int64_t initial_slice = 1024;
+  constexpr int64_t min_slice = 64;
+  constexpr int64_t max_slice = std::numeric_limits<int32_t>::max();
+
+  int64_t slice = initial_slice;
+  int64_t conflicts = 0;
+  while ( true )
+  {
+    auto limit = slice;
+    if ( conflict_limit != 0 )
+    {
+      limit = std::min<int64_t>( limit, incremental ? conflict_limit - conflicts : conflict_limit );
+    }
+    last_limit = static_cast<int32_t>( limit );
+
+    auto const begin = clock::now();
+    auto const result = solve( last_limit );
+    if ( result != percy::timeout )
+    {
+      return result;
+    }
+    auto const end = clock::now();
+
+    conflicts += limit;
+    if ( ( conflict_limit != 0 && ( incremental ? conflicts : limit ) >= conflict_limit ) || stop() || ( deadline && end >= *deadline ) )
+    {
+      return percy::timeout;
+    }
+
+    slice = std::min( 2 * slice, max_slice );
+    if ( deadline )
+    {
+      auto const elapsed = std::chrono::duration<double>( end - begin ).count();
+      if ( elapsed > 0.0 )
+      {
+        auto const remaining = std::chrono::duration<double>( *deadline - end ).count();
+        auto const affordable = static_cast<double>( limit ) / elapsed * remaining;
+        if ( affordable < static_cast<double>( slice ) )
+        {
+          slice = std::max( static_cast<int64_t>( affordable ), min_slice );
+        }
+      }
+    }
+  }
+}
+
+} /* namespace mockturtle */
@@ -357,6 +357,16 @@ public:
    */
   cut_set();
 
+  /*! \brief Copy constructor.
+   *
+   * The cut pointers of the copy refer to the cuts of the copy, such that cut
+   * sets can be stored in containers that grow.
+   */
+  cut_set( cut_set const& other );
+
+  /*! \brief Copy assignment. */
+  cut_set& operator=( cut_set const& other );
+
   /*! \brief Clears a cut set.
    */
   void clear();
@@ -468,6 +478,28 @@ cut_set<CutType, MaxCuts>::cut_set()
   clear();
 }
 
+template<typename CutType, int MaxCuts>
+cut_set<CutType, MaxCuts>::cut_set( cut_set const& other )
+{
+  *this = other;
+}
+
+template<typename CutType, int MaxCuts>
+cut_set<CutType, MaxCuts>& cut_set<CutType, MaxCuts>::operator=( cut_set const& other )
+{
+  if ( this != &other )
+  {
+    /* only the cuts in the set are initialized */
+    clear();
+    for ( auto const* c : other )
+    {
+      **_pend++ = *c;
+      ++_pcend;
+    }
+  }
+  return *this;
+}
+
 template<typename CutType, int MaxCuts>
 void cut_set<CutType, MaxCuts>::clear()
 {
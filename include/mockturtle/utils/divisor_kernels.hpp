@@ -0,0 +1,610 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file divisor_kernels.hpp
+  \brief Word-level kernels to score divisors against a target function
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+#include "bit_utils.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Reference to the words of a truth table, possibly complemented.
+ *
+ * The reference does not own the words and does not copy them.  The
+ * complementation is applied when a word is loaded by a kernel.
+ */
+struct tt_ref
+{
+  /*! \brief Pointer to the first word. */
+  uint64_t const* words{nullptr};
+
+  /*! \brief Either 0 or all ones, XOR-ed to each word. */
+  uint64_t mask{0u};
+};
+
+/*! \brief Creates a reference to a truth table (static, dynamic, or partial). */
+template<typename TT>
+inline tt_ref make_tt_ref( TT const& tt, bool complemented = false )
+{
+  return tt_ref{&*tt.cbegin(), complemented ? ~UINT64_C( 0 ) : UINT64_C( 0 )};
+}
+
+/*! \brief Complements a truth table reference. */
+inline tt_ref operator~( tt_ref const& ref )
+{
+  return tt_ref{ref.words, ~ref.mask};
+}
+
+/*! \brief Word layout shared by all truth tables of a kernel call. */
+struct tt_layout
+{
+  /*! \brief Number of 64-bit words. */
+  uint32_t num_blocks{1u};
+
+  /*! \brief Valid bits of the last word. */
+  uint64_t tail{~UINT64_C( 0 )};
+};
+
+/*! \brief Returns the word layout of a truth table. */
+template<typename TT>
+inline tt_layout make_tt_layout( TT const& tt )
+{
+  tt_layout layout;
+  layout.num_blocks = static_cast<uint32_t>( tt.cend() - tt.cbegin() );
+  auto const num_bits = static_cast<uint64_t>( tt.num_bits() );
+  if ( num_bits % 64u != 0u )
+  {
+    layout.tail = ( UINT64_C( 1 ) << ( num_bits % 64u ) ) - 1u;
+  }
+  return layout;
+}
+
+namespace detail
+{
+
+inline uint64_t load_word( tt_ref const& ref, uint32_t i )
+{
+  return ref.words[i] ^ ref.mask;
+}
+
+#if defined( __AVX2__ )
+/* four words, on which the user functions are called; the operators are
+   implemented with intrinsics, since MSVC has no operators on `__m256i` */
+struct words4
+{
+  __m256i v;
+};
+
+inline words4 operator&( words4 a, words4 b )
+{
+  return words4{_mm256_and_si256( a.v, b.v )};
+}
+
+inline words4 operator|( words4 a, words4 b )
+{
+  return words4{_mm256_or_si256( a.v, b.v )};
+}
+
+inline words4 operator^( words4 a, words4 b )
+{
+  return words4{_mm256_xor_si256( a.v, b.v )};
+}
+
+inline words4 operator~( words4 a )
+{
+  return words4{_mm256_xor_si256( a.v, _mm256_set1_epi64x( -1 ) )};
+}
+
+/* `lddqu` is an unaligned load as `loadu`, but is not a dereference in GCC,
+   which otherwise warns about loads beyond small truth tables on dead paths */
+inline words4 load_words4( tt_ref const& ref, uint32_t i )
+{
+  return words4{_mm256_xor_si256( _mm256_lddqu_si256( reinterpret_cast<__m256i const*>( ref.words + i ) ), _mm256_set1_epi64x( static_cast<int64_t>( ref.mask ) ) )};
+}
+
+/* per 64-bit lane popcount using nibble lookups */
+inline __m256i popcount_words4( __m256i v )
+{
+  __m256i const lookup = _mm256_setr_epi8( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+  __m256i const low_mask = _mm256_set1_epi8( 0x0f );
+  __m256i const lo = _mm256_and_si256( v, low_mask );
+  __m256i const hi = _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low_mask );
+  __m256i const cnt = _mm256_add_epi8( _mm256_shuffle_epi8( lookup, lo ), _mm256_shuffle_epi8( lookup, hi ) );
+  return _mm256_sad_epu8( cnt, _mm256_setzero_si256() );
+}
+#endif
+
+inline uint64_t popcount_word( uint64_t word )
+{
+  return popcount64( word );
+}
+
+template<typename Fn, typename... Refs>
+inline bool is_const0_words_from( tt_layout const& layout, uint32_t begin, Fn&& fn, Refs const&... refs )
+{
+  auto i = begin;
+  auto const last = layout.num_blocks - 1u;
+#if defined( __AVX2__ )
+  for ( ; i + 4u <= last; i += 4u )
+  {
+    __m256i const v = fn( load_words4( refs, i )... ).v;
+    if ( !_mm256_testz_si256( v, v ) )
+    {
+      return false;
+    }
+  }
+#endif
+  for ( ; i < last; ++i )
+  {
+    if ( fn( load_word( refs, i )... ) != 0u )
+    {
+      return false;
+    }
+  }
+  return i > last || ( fn( load_word( refs, last )... ) & layout.tail ) == 0u;
+}
+
+} /* namespace detail */
+
+/*! \brief Checks whether a bitwise function of truth tables is constant 0.
+ *
+ * The function `fn` is called with one word (`uint64_t`) of each truth
+ * table in `refs` and must return the resulting word.  It must only use
+ * bitwise operators, since it is also called with 256-bit vectors of
+ * words if the code is compiled with AVX2 support.  The words are visited
+ * from first to last and the function returns on the first non-zero word.
+ *
+ * For example, `is_const0_words( layout, []( auto a, auto b ) { return a & ~b; }, a, b )`
+ * checks whether `a` implies `b`.
+ */
+template<typename Fn, typename... Refs>
+inline bool is_const0_words( tt_layout const& layout, Fn&& fn, Refs const&... refs )
+{
+  return detail::is_const0_words_from( layout, 0u, fn, refs... );
+}
+
+/*! \brief Counts the ones of a bitwise function of truth tables.
+ *
+ * The function `fn` has the same requirements as for `is_const0_words`.
+ */
+template<typename Fn, typename... Refs>
+inline uint64_t count_ones_words( tt_layout const& layout, Fn&& fn, Refs const&... refs )
+{
+  uint32_t i = 0u;
+  uint64_t count = 0u;
+  auto const last = layout.num_blocks - 1u;
+#if defined( __AVX2__ )
+  if ( last >= 4u )
+  {
+    __m256i sum = _mm256_setzero_si256();
+    for ( ; i + 4u <= last; i += 4u )
+    {
+      sum = _mm256_add_epi64( sum, detail::popcount_words4( fn( detail::load_words4( refs, i )... ).v ) );
+    }
+    count += static_cast<uint64_t>( _mm256_extract_epi64( sum, 0 ) ) + static_cast<uint64_t>( _mm256_extract_epi64( sum, 1 ) ) +
+             static_cast<uint64_t>( _mm256_extract_epi64( sum, 2 ) ) + static_cast<uint64_t>( _mm256_extract_epi64( sum, 3 ) );
+  }
+#endif
+  for ( ; i < last; ++i )
+  {
+    count += detail::popcount_word( fn( detail::load_word( refs, i )... ) );
+  }
+  return count + detail::popcount_word( fn( detail::load_word( refs, last )... ) & layout.tail );
+}
+
+/*! \brief Batch of divisors (or tuples of divisors) to be scored against a target.
+ *
+ * Each entry consists of `Arity` truth table references.  Besides the
+ * references, the batch stores the first word of each truth table in a
+ * contiguous array.  This signature is used to reject most candidates
+ * without accessing the truth tables: if a bitwise function is not 0 on
+ * the first word, it is not constant 0.
+ *
+ * The batch does not own the truth tables, which must not be moved while
+ * the batch is in use.  Clearing the batch keeps its memory, such that
+ * a batch that is reused for many windows does not allocate.
+ */
+template<uint32_t Arity = 1u>
+class divisor_batch
+{
+public:
+  using entry_t = std::array<tt_ref, Arity>;
+
+public:
+  divisor_batch() = default;
+
+  explicit divisor_batch( tt_layout const& layout )
+      : _layout( layout )
+  {
+  }
+
+  /*! \brief Removes all entries and sets a new word layout. */
+  void reset( tt_layout const& layout )
+  {
+    _layout = layout;
+    clear();
+  }
+
+  /*! \brief Removes all entries. */
+  void clear()
+  {
+    _entries.clear();
+    _signatures.clear();
+  }
+
+  /*! \brief Adds an entry. */
+  template<typename... Refs>
+  void add( Refs const&... refs )
+  {
+    static_assert( sizeof...( Refs ) == Arity, "number of references must match arity" );
+    _entries.push_back( entry_t{refs...} );
+    _signatures.push_back( {detail::load_word( refs, 0u )...} );
+  }
+
+  /*! \brief Number of entries. */
+  uint32_t size() const
+  {
+    return static_cast<uint32_t>( _entries.size() );
+  }
+
+  /*! \brief Returns the references of an entry. */
+  entry_t const& operator[]( uint32_t index ) const
+  {
+    return _entries[index];
+  }
+
+  /*! \brief Returns the word layout. */
+  tt_layout const& layout() const
+  {
+    return _layout;
+  }
+
+  /*! \brief Checks whether `fn( fixed..., entry )` is constant 0.
+   *
+   * The references of the entry are passed after the `fixed` references.
+   * The signature of the entry is checked first.
+   */
+  template<typename Fn, typename... Fixed>
+  bool test( uint32_t index, Fn&& fn, Fixed const&... fixed ) const
+  {
+    return test_impl( index, fn, std::make_index_sequence<Arity>{}, fixed... );
+  }
+
+  /*! \brief Returns the first entry from `begin` on for which `fn( fixed..., entry )` is constant 0. */
+  template<typename Fn, typename... Fixed>
+  std::optional<uint32_t> find( uint32_t begin, Fn&& fn, Fixed const&... fixed ) const
+  {
+    for ( auto i = begin; i < _entries.size(); ++i )
+    {
+      if ( test_impl( i, fn, std::make_index_sequence<Arity>{}, fixed... ) )
+      {
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Counts the ones of `fn( fixed..., entry )`. */
+  template<typename Fn, typename... Fixed>
+  uint64_t count_ones( uint32_t index, Fn&& fn, Fixed const&... fixed ) const
+  {
+    return count_ones_impl( index, fn, std::make_index_sequence<Arity>{}, fixed... );
+  }
+
+private:
+  template<typename Fn, std::size_t... Is, typename... Fixed>
+  uint64_t count_ones_impl( uint32_t index, Fn&& fn, std::index_sequence<Is...>, Fixed const&... fixed ) const
+  {
+    assert( index < _entries.size() );
+    auto const& entry = _entries[index];
+    return count_ones_words( _layout, fn, fixed..., entry[Is]... );
+  }
+
+  template<typename Fn, std::size_t... Is, typename... Fixed>
+  bool test_impl( uint32_t index, Fn&& fn, std::index_sequence<Is...>, Fixed const&... fixed ) const
+  {
+    assert( index < _entries.size() );
+    auto const sig_mask = _layout.num_blocks == 1u ? _layout.tail : ~UINT64_C( 0 );
+    auto const& sig = _signatures[index];
+    if ( ( fn( detail::load_word( fixed, 0u )..., sig[Is]... ) & sig_mask ) != 0u )
+    {
+      return false;
+    }
+    auto const& entry = _entries[index];
+    return detail::is_const0_words_from( _layout, 1u, fn, fixed..., entry[Is]... );
+  }
+
+private:
+  tt_layout _layout;
+  std::vector<entry_t> _entries;
+  std::vector<std::array<uint64_t, Arity>> _signatures;
+};
+
+/*! \brief Index of the entries of a divisor batch by the minterms that they cover.
+ *
+ * Most pair searches of resubstitution are covering problems: for example,
+ * `( a | b ) == t` for two positive unate divisors only holds if `b`
+ * covers all minterms of `t & ~a`.  The index selects up to `max_pivots`
+ * minterms of the target (pivots) and stores for each pivot a bitset of
+ * the entries that cover it.  A search for the partner of `a` intersects
+ * the bitsets of the rarest pivots in `t & ~a`, which filters 64 entries
+ * per word operation, and only tests the remaining entries.  If no entry
+ * covers one of these pivots, the search returns immediately.
+ *
+ * The pivots are taken from a few words of the truth tables, such that
+ * building the index evaluates only a few words per entry.  The first
+ * word is only used if there is no other one, since it is already checked
+ * by the signatures of the batch.
+ *
+ * Batches with fewer than `min_entries` entries are not indexed, since
+ * scanning them is cheaper than building the index.  In this case, or if
+ * no pivot is required, `find` falls back to `divisor_batch::find`.  Both
+ * searches return the same entry.
+ */
+class divisor_index
+{
+public:
+  /*! \brief Maximum number of pivots that are intersected by a query. */
+  static constexpr uint32_t max_query_pivots = 4u;
+
+  /*! \brief Candidates of one search, created by `make_query`. */
+  struct query
+  {
+    std::array<uint64_t const*, max_query_pivots> rows;
+    uint32_t num_rows{0u};
+    bool empty{false};
+  };
+
+public:
+  explicit divisor_index( uint32_t min_entries = 256u, uint32_t max_pivots = 32u )
+      : _min_entries( min_entries ),
+        _max_pivots( max_pivots )
+  {
+  }
+
+  /*! \brief Removes all pivots, searches scan the whole batch. */
+  void clear()
+  {
+    _pivot_words.clear();
+    _num_pivots = 0u;
+    _num_entries = 0u;
+    _num_entry_words = 0u;
+  }
+
+  /*! \brief Builds the index for a batch.
+   *
+   * The pivots are chosen among the ones of `pivots( refs... )`, which is
+   * evaluated like the function of `is_const0_words`.  An entry covers a
+   * pivot if `cover( entry )` is 1 at the pivot's minterm.
+   */
+  template<uint32_t Arity, typename Cover, typename Pivots, typename... Refs>
+  void build( divisor_batch<Arity> const& batch, Cover&& cover, Pivots&& pivots, Refs const&... refs )
+  {
+    clear();
+    if ( batch.size() < _min_entries )
+    {
+      return;
+    }
+
+    auto const& layout = batch.layout();
+    auto const first = layout.num_blocks > 1u ? 1u : 0u;
+    for ( auto w = first; w < layout.num_blocks && _num_pivots < _max_pivots; ++w )
+    {
+      auto word = pivots( detail::load_word( refs, w )... );
+      if ( w + 1u == layout.num_blocks )
+      {
+        word &= layout.tail;
+      }
+      /* take the lowest ones up to the maximum number of pivots */
+      uint64_t mask{0u};
+      auto num_pivots = _num_pivots;
+      for ( ; word != 0u && num_pivots < _max_pivots; word &= word - 1u, ++num_pivots )
+      {
+        mask |= word & ( ~word + 1u );
+      }
+      if ( mask != 0u )
+      {
+        _pivot_words.push_back( pivot_word{w, mask, _num_pivots} );
+        _num_pivots = num_pivots;
+      }
+    }
+
+    _num_entries = batch.size();
+    _num_entry_words = ( _num_entries + 63u ) >> 6u;
+    _rows.assign( _num_pivots * _num_entry_words, 0u );
+    _counts.assign( _num_pivots, 0u );
+    for ( auto e = 0u; e < _num_entries; ++e )
+    {
+      add_entry( batch[e], e, cover, std::make_index_sequence<Arity>{} );
+    }
+  }
+
+  /*! \brief Number of pivots. */
+  uint32_t num_pivots() const
+  {
+    return _num_pivots;
+  }
+
+  /*! \brief Creates a query for the entries that cover all pivots set in `required( fixed... )`.
+   *
+   * The rarest of these pivots are intersected.  If no pivot is set, all
+   * entries are candidates.
+   */
+  template<typename Required, typename... Fixed>
+  query make_query( Required&& required, Fixed const&... fixed ) const
+  {
+    query q;
+    std::array<uint32_t, max_query_pivots> counts{};
+    for ( auto const& pw : _pivot_words )
+    {
+      auto const word = required( detail::load_word( fixed, pw.index )... );
+      auto p = pw.offset;
+      for ( auto mask = pw.mask; mask != 0u; mask &= mask - 1u, ++p )
+      {
+        if ( ( word & mask & ( ~mask + 1u ) ) == 0u )
+        {
+          continue;
+        }
+
+        auto const count = _counts[p];
+        if ( count == 0u )
+        {
+          q.empty = true;
+          return q;
+        }
+
+        /* insert into the rarest pivots, sorted by count */
+        if ( q.num_rows == max_query_pivots && count >= counts[max_query_pivots - 1u] )
+        {
+          continue;
+        }
+        auto pos = std::min( q.num_rows, max_query_pivots - 1u );
+        for ( ; pos > 0u && counts[pos - 1u] > count; --pos )
+        {
+          counts[pos] = counts[pos - 1u];
+          q.rows[pos] = q.rows[pos - 1u];
+        }
+        counts[pos] = count;
+        q.rows[pos] = &_rows[p * _num_entry_words];
+        q.num_rows = std::min( q.num_rows + 1u, max_query_pivots );
+      }
+    }
+    return q;
+  }
+
+  /*! \brief Returns the first candidate of a query from `begin` on, or the number of entries if there is none. */
+  uint32_t next_candidate( query const& q, uint32_t begin ) const
+  {
+    if ( q.empty )
+    {
+      return _num_entries;
+    }
+    if ( q.num_rows == 0u )
+    {
+      return begin;
+    }
+
+    for ( auto w = begin >> 6u; w < _num_entry_words; ++w )
+    {
+      auto word = q.rows[0][w];
+      for ( auto r = 1u; r < q.num_rows; ++r )
+      {
+        word &= q.rows[r][w];
+      }
+      if ( w == ( begin >> 6u ) )
+      {
+        word &= ~UINT64_C( 0 ) << ( begin & 63u );
+      }
+      if ( word != 0u )
+      {
+        return ( w << 6u ) | ctz64( word );
+      }
+    }
+    return _num_entries;
+  }
+
+  /*! \brief Returns the first entry from `begin` on for which `fn( fixed..., entry )` is constant 0.
+   *
+   * Each entry for which `fn( fixed..., entry )` is constant 0 must cover
+   * all minterms of `required( fixed... )`.  The batch must be the one for
+   * which the index has been built.
+   */
+  template<uint32_t Arity, typename Required, typename Fn, typename... Fixed>
+  std::optional<uint32_t> find( divisor_batch<Arity> const& batch, uint32_t begin, Required&& required, Fn&& fn, Fixed const&... fixed ) const
+  {
+    auto const q = make_query( required, fixed... );
+    if ( q.num_rows == 0u && !q.empty )
+    {
+      return batch.find( begin, fn, fixed... );
+    }
+
+    assert( batch.size() == _num_entries );
+    for ( auto e = next_candidate( q, begin ); e < _num_entries; e = next_candidate( q, e + 1u ) )
+    {
+      if ( batch.test( e, fn, fixed... ) )
+      {
+        return e;
+      }
+    }
+    return std::nullopt;
+  }
+
+private:
+  struct pivot_word
+  {
+    uint32_t index;
+    uint64_t mask;
+    uint32_t offset;
+  };
+
+  template<typename Entry, typename Cover, std::size_t... Is>
+  void add_entry( Entry const& entry, uint32_t index, Cover&& cover, std::index_sequence<Is...> )
+  {
+    for ( auto const& pw : _pivot_words )
+    {
+      auto const word = cover( detail::load_word( entry[Is], pw.index )... );
+      auto p = pw.offset;
+      for ( auto mask = pw.mask; mask != 0u; mask &= mask - 1u, ++p )
+      {
+        if ( ( word & mask & ( ~mask + 1u ) ) == 0u )
+        {
+          continue;
+        }
+        _rows[p * _num_entry_words + ( index >> 6u )] |= UINT64_C( 1 ) << ( index & 63u );
+        ++_counts[p];
+      }
+    }
+  }
+
+private:
+  uint32_t _min_entries;
+  uint32_t _max_pivots;
+  uint32_t _num_pivots{0u};
+  uint32_t _num_entries{0u};
+  uint32_t _num_entry_words{0u};
+  std::vector<pivot_word> _pivot_words;
+  std::vector<uint64_t> _rows;
+  std::vector<uint32_t> _counts;
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,281 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file gf2_matrix.hpp
+  \brief Bit-packed matrices over GF(2)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "bit_utils.hpp"
+#include "divisor_kernels.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Bit-packed matrix over GF(2).
+ *
+ * Each row is stored in `num_blocks()` consecutive 64-bit words and all
+ * rows are stored in one contiguous array.  The unused bits of the last
+ * word of a row are always 0.  Row operations (addition, weight, and the
+ * weight of the intersection of two rows) are computed word by word, using
+ * the kernels of `divisor_kernels.hpp`, which use AVX2 if available.
+ *
+ * Rows can be appended, which is used by linear resynthesis algorithms to
+ * add rows for new intermediate signals.  Appending a row may invalidate
+ * pointers returned by `row`.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      gf2_matrix m( 2u, 100u );
+      m.set( 0u, 3u );
+      m.set( 0u, 70u );
+      m.set( 1u, 70u );
+      m.add_row_to( 0u, 1u ); // row 1 is now { 3 }
+      m.count_ones( 1u );     // 1
+   \endverbatim
+ */
+class gf2_matrix
+{
+public:
+  gf2_matrix() = default;
+
+  /*! \brief Creates a zero matrix. */
+  gf2_matrix( uint32_t num_rows, uint32_t num_columns )
+      : _num_rows( num_rows ),
+        _num_columns( num_columns ),
+        _num_blocks( std::max<uint32_t>( 1u, ( num_columns + 63u ) >> 6u ) ),
+        _words( static_cast<std::size_t>( num_rows ) * _num_blocks, 0u )
+  {
+  }
+
+  /*! \brief Creates a matrix from a vector of rows.
+   *
+   * All rows must have the same size.
+   */
+  explicit gf2_matrix( std::vector<std::vector<bool>> const& rows )
+      : gf2_matrix( static_cast<uint32_t>( rows.size() ), rows.empty() ? 0u : static_cast<uint32_t>( rows.front().size() ) )
+  {
+    for ( auto r = 0u; r < _num_rows; ++r )
+    {
+      assert( rows[r].size() == _num_columns );
+      for ( auto c = 0u; c < _num_columns; ++c )
+      {
+        if ( rows[r][c] )
+        {
+          set( r, c );
+        }
+      }
+    }
+  }
+
+  /*! \brief Number of rows. */
+  uint32_t num_rows() const
+  {
+    return _num_rows;
+  }
+
+  /*! \brief Number of columns. */
+  uint32_t num_columns() const
+  {
+    return _num_columns;
+  }
+
+  /*! \brief Number of 64-bit words per row. */
+  uint32_t num_blocks() const
+  {
+    return _num_blocks;
+  }
+
+  /*! \brief Returns the words of a row. */
+  uint64_t* row( uint32_t r )
+  {
+    assert( r < _num_rows );
+    return _words.data() + static_cast<std::size_t>( r ) * _num_blocks;
+  }
+
+  /*! \brief Returns the words of a row. */
+  uint64_t const* row( uint32_t r ) const
+  {
+    assert( r < _num_rows );
+    return _words.data() + static_cast<std::size_t>( r ) * _num_blocks;
+  }
+
+  /*! \brief Returns an entry. */
+  bool get( uint32_t r, uint32_t c ) const
+  {
+    assert( c < _num_columns );
+    return ( row( r )[c >> 6u] >> ( c & 63u ) ) & 1u;
+  }
+
+  /*! \brief Sets an entry. */
+  void set( uint32_t r, uint32_t c, bool value = true )
+  {
+    assert( c < _num_columns );
+    auto& word = row( r )[c >> 6u];
+    const auto mask = UINT64_C( 1 ) << ( c & 63u );
+    word = value ? ( word | mask ) : ( word & ~mask );
+  }
+
+  /*! \brief Complements an entry. */
+  void flip( uint32_t r, uint32_t c )
+  {
+    assert( c < _num_columns );
+    row( r )[c >> 6u] ^= UINT64_C( 1 ) << ( c & 63u );
+  }
+
+  /*! \brief Appends a zero row and returns its index. */
+  uint32_t add_row()
+  {
+    _words.resize( _words.size() + _num_blocks, 0u );
+    return _num_rows++;
+  }
+
+  /*! \brief Adds (XORs) row `src` to row `dst`. */
+  void add_row_to( uint32_t src, uint32_t dst )
+  {
+    add_words_to( row( src ), dst );
+  }
+
+  /*! \brief Adds (XORs) words in the layout of a row to row `dst`. */
+  void add_words_to( uint64_t const* src, uint32_t dst )
+  {
+    auto* d = row( dst );
+    for ( auto i = 0u; i < _num_blocks; ++i )
+    {
+      d[i] ^= src[i];
+    }
+  }
+
+  /*! \brief Sets row `dst` to the sum (XOR) of rows `src1` and `src2`. */
+  void set_row_to_sum( uint32_t src1, uint32_t src2, uint32_t dst )
+  {
+    auto const* s1 = row( src1 );
+    auto const* s2 = row( src2 );
+    auto* d = row( dst );
+    for ( auto i = 0u; i < _num_blocks; ++i )
+    {
+      d[i] = s1[i] ^ s2[i];
+    }
+  }
+
+  /*! \brief Number of ones in a row. */
+  uint32_t count_ones( uint32_t r ) const
+  {
+    return static_cast<uint32_t>( count_ones_words( layout(), []( auto a ) { return a; }, tt_ref{row( r )} ) );
+  }
+
+  /*! \brief Number of columns in which both rows have a one. */
+  uint32_t count_common( uint32_t r1, uint32_t r2 ) const
+  {
+    return static_cast<uint32_t>( count_ones_words( layout(), []( auto a, auto b ) { return a & b; }, tt_ref{row( r1 )}, tt_ref{row( r2 )} ) );
+  }
+
+  /*! \brief Number of ones in the sum (XOR) of two rows. */
+  uint32_t count_ones_of_sum( uint32_t r1, uint32_t r2 ) const
+  {
+    return static_cast<uint32_t>( count_ones_words( layout(), []( auto a, auto b ) { return a ^ b; }, tt_ref{row( r1 )}, tt_ref{row( r2 )} ) );
+  }
+
+  /*! \brief Checks whether a row is zero. */
+  bool is_zero_row( uint32_t r ) const
+  {
+    return is_const0_words( layout(), []( auto a ) { return a; }, tt_ref{row( r )} );
+  }
+
+  /*! \brief Calls `fn` on the column index of each one in a row, in increasing order. */
+  template<typename Fn>
+  void foreach_one( uint32_t r, Fn&& fn ) const
+  {
+    auto const* words = row( r );
+    for ( auto i = 0u; i < _num_blocks; ++i )
+    {
+      for ( auto w = words[i]; w; w &= w - 1u )
+      {
+        fn( ( i << 6u ) + static_cast<uint32_t>( ctz64( w ) ) );
+      }
+    }
+  }
+
+  /*! \brief Returns the transposed matrix. */
+  gf2_matrix transpose() const
+  {
+    gf2_matrix result( _num_columns, _num_rows );
+    for ( auto r = 0u; r < _num_rows; ++r )
+    {
+      foreach_one( r, [&]( auto c ) {
+        result.set( c, r );
+      } );
+    }
+    return result;
+  }
+
+  /*! \brief Returns the matrix as a vector of rows. */
+  std::vector<std::vector<bool>> to_bool_matrix() const
+  {
+    std::vector<std::vector<bool>> rows( _num_rows, std::vector<bool>( _num_columns, false ) );
+    for ( auto r = 0u; r < _num_rows; ++r )
+    {
+      foreach_one( r, [&]( auto c ) {
+        rows[r][c] = true;
+      } );
+    }
+    return rows;
+  }
+
+  bool operator==( gf2_matrix const& other ) const
+  {
+    return _num_rows == other._num_rows && _num_columns == other._num_columns && _words == other._words;
+  }
+
+  bool operator!=( gf2_matrix const& other ) const
+  {
+    return !( *this == other );
+  }
+
+private:
+  tt_layout layout() const
+  {
+    return tt_layout{_num_blocks, ~UINT64_C( 0 )};
+  }
+
+private:
+  uint32_t _num_rows{0u};
+  uint32_t _num_columns{0u};
+  uint32_t _num_blocks{1u};
+  std::vector<uint64_t> _words;
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,277 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file lut_evaluator.hpp
+  \brief Word-parallel evaluation of LUT functions
+*/
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <kitty/cube.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/isop.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+
+#include "bit_utils.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Word-parallel evaluation of a LUT function.
+ *
+ * The evaluator computes 64 evaluations of a function at once from one
+ * 64-bit word per input, using bitwise operations only.  The function is
+ * compiled once into the cheaper of two forms:
+ *
+ * - an ISOP of the function or of its complement (one AND per literal and
+ *   one OR per cube), or
+ * - for up to 6 variables, a reduced decision diagram with complemented
+ *   edges, evaluated bottom-up as a sequence of multiplexers.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      kitty::dynamic_truth_table maj( 3u );
+      kitty::create_majority( maj );
+      lut_evaluator eval( maj );
+
+      std::array<uint64_t, 3> inputs{0xaaaa, 0xcccc, 0xf0f0};
+      auto w = eval( inputs.data() ); // w == 0xe8e8
+   \endverbatim
+ */
+class lut_evaluator
+{
+public:
+  /*! \brief Maximum number of variables for the decision diagram form. */
+  static constexpr uint32_t max_dd_vars = 6u;
+
+private:
+  /* out = l ^ ( ( h ^ l ) & x[var] ), where l and h are the values of the
+   * low and high children (possibly complemented) */
+  struct mux
+  {
+    uint32_t var;
+    uint32_t lo;
+    uint32_t hi;
+    uint64_t lo_mask;
+    uint64_t hi_mask;
+  };
+
+  /* at most 1 + 2 + 4 + 8 + 8 + 1 nodes for 6 variables */
+  static constexpr uint32_t max_dd_nodes = 32u;
+
+public:
+  lut_evaluator() = default;
+
+  /*! \brief Compiles a function. */
+  explicit lut_evaluator( kitty::dynamic_truth_table const& function )
+      : _num_vars( function.num_vars() )
+  {
+    if ( kitty::is_const0( function ) || kitty::is_const0( ~function ) )
+    {
+      _output_mask = kitty::is_const0( function ) ? UINT64_C( 0 ) : ~UINT64_C( 0 );
+      return;
+    }
+
+    /* ISOP of the function or of its complement, whichever has fewer literals */
+    auto cubes = kitty::isop( function );
+    auto cubes_neg = kitty::isop( ~function );
+    const auto isop_cost = []( std::vector<kitty::cube> const& cs ) {
+      uint32_t cost = static_cast<uint32_t>( cs.size() );
+      for ( auto const& c : cs )
+      {
+        cost += c.num_literals();
+      }
+      return cost;
+    };
+    bool negated = false;
+    uint32_t cost = isop_cost( cubes );
+    if ( const auto cost_neg = isop_cost( cubes_neg ); cost_neg < cost )
+    {
+      cubes = std::move( cubes_neg );
+      cost = cost_neg + 1u;
+      negated = true;
+    }
+
+    if ( _num_vars <= max_dd_vars )
+    {
+      std::unordered_map<uint64_t, std::pair<uint32_t, uint64_t>> computed;
+      const auto root = compile_dd( *function.cbegin(), _num_vars, computed );
+      if ( 5u * _muxes.size() < cost )
+      {
+        _root = root.first;
+        _output_mask = root.second;
+        _cost = 5u * static_cast<uint32_t>( _muxes.size() );
+        return;
+      }
+      _muxes.clear();
+    }
+
+    _cubes = std::move( cubes );
+    _output_mask = negated ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    _cost = cost;
+  }
+
+  /*! \brief Number of variables of the function. */
+  uint32_t num_vars() const
+  {
+    return _num_vars;
+  }
+
+  /*! \brief Estimated number of word operations per evaluation. */
+  uint32_t cost() const
+  {
+    return _cost;
+  }
+
+  /*! \brief Evaluates one word.
+   *
+   * `inputs[i]` is the word of the `i`-th variable.
+   */
+  uint64_t operator()( uint64_t const* inputs ) const
+  {
+    if ( !_muxes.empty() )
+    {
+      std::array<uint64_t, max_dd_nodes + 1u> values;
+      values[0] = 0u;
+      for ( auto i = 0u; i < _muxes.size(); ++i )
+      {
+        auto const& m = _muxes[i];
+        const auto l = values[m.lo] ^ m.lo_mask;
+        const auto h = values[m.hi] ^ m.hi_mask;
+        values[i + 1u] = l ^ ( ( h ^ l ) & inputs[m.var] );
+      }
+      return values[_root] ^ _output_mask;
+    }
+
+    uint64_t result{0u};
+    for ( auto const& c : _cubes )
+    {
+      uint64_t product = ~UINT64_C( 0 );
+      for ( auto mask = c._mask; mask; mask &= mask - 1u )
+      {
+        const auto v = ctz32( mask );
+        product &= ( ( c._bits >> v ) & 1u ) ? inputs[v] : ~inputs[v];
+      }
+      result |= product;
+    }
+    return result ^ _output_mask;
+  }
+
+  /*! \brief Evaluates blocks of truth tables.
+   *
+   * Computes the blocks `first_block, ...` of `result` from the same blocks
+   * of `fanins` (one pointer to the first word per variable), complemented
+   * if `complement` is true.  The unused bits of the last block are not
+   * masked.
+   */
+  template<typename TT>
+  void evaluate( std::vector<uint64_t const*> const& fanins, TT& result, uint32_t first_block = 0u, bool complement = false ) const
+  {
+    assert( fanins.size() == _num_vars );
+    const auto num_blocks = static_cast<uint32_t>( result.cend() - result.cbegin() );
+    const uint64_t mask = complement ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    std::array<uint64_t, 32u> inputs;
+    auto it = result.begin() + first_block;
+    for ( auto b = first_block; b < num_blocks; ++b, ++it )
+    {
+      for ( auto i = 0u; i < _num_vars; ++i )
+      {
+        inputs[i] = fanins[i][b];
+      }
+      *it = ( *this )( inputs.data() ) ^ mask;
+    }
+  }
+
+private:
+  /* returns the value index and complement mask of a function given as
+   * truth table word over `k` variables */
+  std::pair<uint32_t, uint64_t> compile_dd( uint64_t tt, uint32_t k, std::unordered_map<uint64_t, std::pair<uint32_t, uint64_t>>& computed )
+  {
+    const auto bits = k == 6u ? ~UINT64_C( 0 ) : ( UINT64_C( 1 ) << ( 1u << k ) ) - 1u;
+    tt &= bits;
+
+    /* normalize such that the function maps 0...0 to 0 */
+    const uint64_t compl_mask = ( tt & 1u ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    tt ^= compl_mask & bits;
+    if ( tt == 0u )
+    {
+      return {0u, compl_mask};
+    }
+
+    /* drop variables on which the function does not depend */
+    const auto half = 1u << ( k - 1u );
+    const auto lo = tt & ( ( UINT64_C( 1 ) << half ) - 1u );
+    const auto hi = half == 32u ? ( tt >> 32u ) : ( ( tt >> half ) & ( ( UINT64_C( 1 ) << half ) - 1u ) );
+    if ( lo == hi )
+    {
+      const auto [index, mask] = compile_dd( lo, k - 1u, computed );
+      return {index, mask ^ compl_mask};
+    }
+
+    /* only functions of less than 6 variables can be shared */
+    const auto key = tt | ( static_cast<uint64_t>( k ) << 32u );
+    if ( k < 6u )
+    {
+      if ( const auto it = computed.find( key ); it != computed.end() )
+      {
+        return {it->second.first, it->second.second ^ compl_mask};
+      }
+    }
+
+    const auto l = compile_dd( lo, k - 1u, computed );
+    const auto h = compile_dd( hi, k - 1u, computed );
+    _muxes.push_back( {k - 1u, l.first, h.first, l.second, h.second} );
+    const auto index = static_cast<uint32_t>( _muxes.size() );
+    assert( index <= max_dd_nodes );
+    if ( k < 6u )
+    {
+      computed.emplace( key, std::make_pair( index, UINT64_C( 0 ) ) );
+    }
+    return {index, compl_mask};
+  }
+
+private:
+  uint32_t _num_vars{0u};
+  uint32_t _cost{0u};
+  uint32_t _root{0u};
+  uint64_t _output_mask{0u};
+  std::vector<mux> _muxes;
+  std::vector<kitty::cube> _cubes;
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,405 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file mapped_vector.hpp
+  \brief Vector stored in a memory-mapped file
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MOCKTURTLE_MAPPED_VECTOR_HAS_MMAP
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Vector of trivially copyable elements in a memory-mapped file.
+ *
+ * The elements are stored in a temporary file, which is removed from the
+ * file system when it is created and deleted when the vector is destroyed.
+ * The file is mapped into memory, such that the elements are accessed as
+ * with `std::vector`, but the operating system can write them back to the
+ * file and evict them from memory when memory is scarce.  Hence, the vector
+ * can be larger than the available memory.  Besides, `release` explicitly
+ * drops a range of elements from the memory of the process, which is used
+ * to bound its resident memory when the elements are visited in order.
+ *
+ * As for `std::vector`, growing the vector may invalidate pointers to its
+ * elements.
+ * On systems without `mmap`, the elements are stored in heap memory.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      mapped_vector<uint64_t> v;
+      for ( auto i = 0u; i < 1000000u; ++i )
+      {
+        v.push_back( i );
+      }
+      v.release( 0u, 500000u ); // first half is read back from the file when accessed
+   \endverbatim
+ */
+template<typename T>
+class mapped_vector
+{
+  static_assert( std::is_trivially_copyable_v<T>, "T must be trivially copyable" );
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = T const&;
+  using iterator = T*;
+  using const_iterator = T const*;
+
+public:
+  /*! \brief Creates an empty vector.
+   *
+   * \param directory Directory for the temporary file (default: `$TMPDIR`
+   *                  or `/tmp`)
+   */
+  explicit mapped_vector( std::string const& directory = std::string() )
+      : _directory( directory )
+  {
+  }
+
+  mapped_vector( mapped_vector const& other )
+      : _directory( other._directory )
+  {
+    reserve( other._size );
+    if ( other._size > 0u )
+    {
+      std::memcpy( static_cast<void*>( _data ), other._data, other._size * sizeof( T ) );
+    }
+    _size = other._size;
+  }
+
+  mapped_vector( mapped_vector&& other ) noexcept
+  {
+    swap( other );
+  }
+
+  mapped_vector& operator=( mapped_vector const& other )
+  {
+    if ( this != &other )
+    {
+      mapped_vector copy( other );
+      swap( copy );
+    }
+    return *this;
+  }
+
+  mapped_vector& operator=( mapped_vector&& other ) noexcept
+  {
+    swap( other );
+    return *this;
+  }
+
+  ~mapped_vector()
+  {
+    unmap();
+  }
+
+  void swap( mapped_vector& other ) noexcept
+  {
+    std::swap( _directory, other._directory );
+    std::swap( _data, other._data );
+    std::swap( _size, other._size );
+    std::swap( _capacity, other._capacity );
+    std::swap( _used, other._used );
+    std::swap( _fd, other._fd );
+  }
+
+  /*! \brief Number of elements. */
+  size_type size() const
+  {
+    return _size;
+  }
+
+  /*! \brief Number of elements that fit without growing the file. */
+  size_type capacity() const
+  {
+    return _capacity;
+  }
+
+  bool empty() const
+  {
+    return _size == 0u;
+  }
+
+  T* data()
+  {
+    return _data;
+  }
+
+  T const* data() const
+  {
+    return _data;
+  }
+
+  reference operator[]( size_type i )
+  {
+    assert( i < _size );
+    return _data[i];
+  }
+
+  const_reference operator[]( size_type i ) const
+  {
+    assert( i < _size );
+    return _data[i];
+  }
+
+  reference back()
+  {
+    assert( _size > 0u );
+    return _data[_size - 1u];
+  }
+
+  const_reference back() const
+  {
+    assert( _size > 0u );
+    return _data[_size - 1u];
+  }
+
+  iterator begin()
+  {
+    return _data;
+  }
+
+  iterator end()
+  {
+    return _data + _size;
+  }
+
+  const_iterator begin() const
+  {
+    return _data;
+  }
+
+  const_iterator end() const
+  {
+    return _data + _size;
+  }
+
+  /*! \brief Grows the file such that `n` elements fit. */
+  void reserve( size_type n )
+  {
+    if ( n <= _capacity )
+    {
+      return;
+    }
+    remap( n );
+  }
+
+  /*! \brief Resizes the vector, new elements are value-initialized.
+   *
+   * If the value-initialized `T` has only zero bytes, the new elements that
+   * have never been used are not touched, such that no memory is allocated
+   * for them.
+   */
+  void resize( size_type n )
+  {
+    if ( n < _size )
+    {
+      _used = std::max( _used, _size );
+    }
+    else
+    {
+      if ( n > _capacity )
+      {
+        remap( std::max( n, 2u * _capacity ) );
+      }
+      const T value{};
+      const auto* bytes = reinterpret_cast<unsigned char const*>( &value );
+      if ( std::all_of( bytes, bytes + sizeof( T ), []( auto b ) { return b == 0u; } ) )
+      {
+        if ( const auto last = std::min( n, _used ); _size < last )
+        {
+          std::memset( static_cast<void*>( _data + _size ), 0, ( last - _size ) * sizeof( T ) );
+        }
+      }
+      else
+      {
+        std::fill( _data + _size, _data + n, value );
+      }
+    }
+    _size = n;
+  }
+
+  void clear()
+  {
+    _used = std::max( _used, _size );
+    _size = 0u;
+  }
+
+  void push_back( T const& value )
+  {
+    emplace_back( value );
+  }
+
+  template<typename... Args>
+  reference emplace_back( Args&&... args )
+  {
+    if ( _size == _capacity )
+    {
+      remap( std::max<size_type>( 1024u, 2u * _capacity ) );
+    }
+    return *new ( _data + _size++ ) T( std::forward<Args>( args )... );
+  }
+
+  /*! \brief Drops the elements in `[first, last)` from memory.
+   *
+   * The elements keep their values and are read back from the file when
+   * they are accessed again.  Only the memory pages that are completely
+   * contained in the range are dropped.
+   */
+  void release( size_type first, size_type last ) const
+  {
+#ifdef MOCKTURTLE_MAPPED_VECTOR_HAS_MMAP
+    last = std::min( last, _size );
+    if ( first >= last )
+    {
+      return;
+    }
+    const auto page = static_cast<uintptr_t>( ::sysconf( _SC_PAGESIZE ) );
+    const auto begin = ( reinterpret_cast<uintptr_t>( _data + first ) + page - 1u ) / page * page;
+    const auto end = reinterpret_cast<uintptr_t>( _data + last ) / page * page;
+    if ( begin < end )
+    {
+      ::madvise( reinterpret_cast<void*>( begin ), end - begin, MADV_DONTNEED );
+    }
+#else
+    (void)first;
+    (void)last;
+#endif
+  }
+
+private:
+  void remap( size_type n )
+  {
+#ifdef MOCKTURTLE_MAPPED_VECTOR_HAS_MMAP
+    const auto page = static_cast<size_type>( ::sysconf( _SC_PAGESIZE ) );
+    const auto bytes = ( n * sizeof( T ) + page - 1u ) / page * page;
+    if ( _fd == -1 )
+    {
+      open_file();
+    }
+    if ( ::ftruncate( _fd, static_cast<off_t>( bytes ) ) != 0 )
+    {
+      throw std::bad_alloc();
+    }
+    void* addr = ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0 );
+    if ( addr == MAP_FAILED )
+    {
+      throw std::bad_alloc();
+    }
+    /* no read-ahead or fault-around, which would map unused pages for random accesses */
+    ::madvise( addr, bytes, MADV_RANDOM );
+    if ( _data )
+    {
+      ::munmap( static_cast<void*>( _data ), _capacity * sizeof( T ) );
+    }
+    _data = static_cast<T*>( addr );
+    _capacity = bytes / sizeof( T );
+#else
+    auto* addr = std::realloc( static_cast<void*>( _data ), n * sizeof( T ) );
+    if ( !addr )
+    {
+      throw std::bad_alloc();
+    }
+    std::memset( static_cast<char*>( addr ) + _capacity * sizeof( T ), 0, ( n - _capacity ) * sizeof( T ) );
+    _data = static_cast<T*>( addr );
+    _capacity = n;
+#endif
+  }
+
+#ifdef MOCKTURTLE_MAPPED_VECTOR_HAS_MMAP
+  void open_file()
+  {
+    auto directory = _directory;
+    if ( directory.empty() )
+    {
+      const auto* tmpdir = std::getenv( "TMPDIR" );
+      directory = tmpdir && *tmpdir ? tmpdir : "/tmp";
+    }
+    auto name = directory + "/mockturtle-XXXXXX";
+    _fd = ::mkstemp( &name[0] );
+    if ( _fd == -1 )
+    {
+      throw std::runtime_error( "cannot create file in " + directory );
+    }
+    ::unlink( name.c_str() );
+  }
+#endif
+
+  void unmap()
+  {
+#ifdef MOCKTURTLE_MAPPED_VECTOR_HAS_MMAP
+    if ( _data )
+    {
+      ::munmap( static_cast<void*>( _data ), _capacity * sizeof( T ) );
+    }
+    if ( _fd != -1 )
+    {
+      ::close( _fd );
+    }
+#else
+    std::free( static_cast<void*>( _data ) );
+#endif
+    _data = nullptr;
+    _size = _capacity = _used = 0u;
+    _fd = -1;
+  }
+
+private:
+  std::string _directory;
+  T* _data{nullptr};
+  size_type _size{0u};
+  size_type _capacity{0u};
+  size_type _used{0u}; /* elements beyond max( _size, _used ) are zero */
+  int _fd{-1};
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,535 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file pattern_store.hpp
+  \brief Binary file of simulation patterns keyed by a network signature
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../algorithms/simulation.hpp"
+#include "../traits.hpp"
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MOCKTURTLE_PATTERN_STORE_HAS_MMAP
+#endif
+
+namespace mockturtle
+{
+
+namespace detail
+{
+#if __GNUC__ == 7
+namespace pattern_store_fs = std::experimental::filesystem::v1;
+#else
+namespace pattern_store_fs = std::filesystem;
+#endif
+
+inline void pattern_store_hash( uint64_t& hash, uint64_t value )
+{
+  /* FNV-1a over the bytes of `value` */
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    hash ^= ( value >> ( 8u * i ) ) & 0xff;
+    hash *= 1099511628211ull;
+  }
+}
+
+inline void pattern_store_hash( uint64_t& hash, std::string const& value )
+{
+  pattern_store_hash( hash, value.size() );
+  for ( auto const c : value )
+  {
+    hash ^= static_cast<uint8_t>( c );
+    hash *= 1099511628211ull;
+  }
+}
+} /* namespace detail */
+
+/*! \brief Signature of the interface of a network.
+ *
+ * The signature is a hash of the number of primary inputs and outputs and,
+ * if the network has names (e.g., `names_view`), of the input and output
+ * names.  It does not depend on the gates of the network, such that the
+ * patterns stored for a network remain valid after it has been optimized.
+ */
+template<class Ntk>
+uint64_t network_signature( Ntk const& ntk )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+
+  uint64_t hash = 14695981039346656037ull;
+  detail::pattern_store_hash( hash, ntk.num_pis() );
+  detail::pattern_store_hash( hash, ntk.num_pos() );
+
+  if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
+  {
+    ntk.foreach_pi( [&]( auto const& n ) {
+      auto const s = ntk.make_signal( n );
+      detail::pattern_store_hash( hash, ntk.has_name( s ) ? ntk.get_name( s ) : std::string() );
+    } );
+  }
+  if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
+  {
+    ntk.foreach_po( [&]( auto const&, auto i ) {
+      detail::pattern_store_hash( hash, ntk.has_output_name( i ) ? ntk.get_output_name( i ) : std::string() );
+    } );
+  }
+
+  return hash;
+}
+
+/*! \brief Binary file of simulation patterns.
+ *
+ * The file stores the patterns of one network, identified by the number of
+ * its primary inputs and its `network_signature`, such that patterns that
+ * were generated or collected as counter-examples in one run can be
+ * reloaded and extended by later runs.
+ *
+ * The file consists of a header (magic number, format version, number of
+ * inputs, signature, number of patterns, and capacity) followed by one
+ * column of 64-bit words per primary input.  Each column has room for
+ * `capacity` words, and bit `j` of column `i` is the value of input `i` in
+ * pattern `j`.  A column can therefore be mapped into memory and be used
+ * directly as the simulation value of its input.  Patterns are appended
+ * in place; when a column is full, the file is rewritten with twice the
+ * capacity into a temporary file, which then replaces the old one.
+ *
+ * The number of patterns in the header is updated after the new patterns
+ * have been written, such that an interrupted append leaves the previous
+ * patterns intact.  The file is not locked: only one process should append
+ * to a store at a time.  Words are stored in host byte order.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      pattern_store store( pattern_store::filename_for( aig, "patterns" ) );
+
+      partial_simulator sim( aig.num_pis(), 0 );
+      auto const num_loaded = load_patterns( store, aig, sim );
+      pattern_generation( aig, sim );
+      save_patterns( store, aig, sim, num_loaded );
+   \endverbatim
+ */
+class pattern_store
+{
+public:
+  static constexpr uint32_t magic = 0x5350544du; /* "MTPS" */
+  static constexpr uint32_t version = 1u;
+
+  /*! \brief Opens (or prepares to create) the pattern file `filename`. */
+  explicit pattern_store( std::string const& filename )
+      : _filename( filename )
+  {
+    read_header();
+  }
+
+  /*! \brief File name of the store for the network `ntk` in `directory`.
+   *
+   * The file name is derived from the network signature, such that each
+   * network interface has its own store.
+   */
+  template<class Ntk>
+  static std::string filename_for( Ntk const& ntk, std::string const& directory = "." )
+  {
+    return fmt::format( "{}/{:016x}.patterns", directory, network_signature( ntk ) );
+  }
+
+  /*! \brief Returns false, if the file exists but is not a pattern store. */
+  bool good() const
+  {
+    return _good;
+  }
+
+  /*! \brief Returns the path to the pattern file. */
+  std::string const& filename() const
+  {
+    return _filename;
+  }
+
+  /*! \brief Number of primary inputs (0 for an empty store). */
+  uint32_t num_pis() const
+  {
+    return _num_pis;
+  }
+
+  /*! \brief Signature of the network of the stored patterns. */
+  uint64_t signature() const
+  {
+    return _signature;
+  }
+
+  /*! \brief Number of stored patterns. */
+  uint64_t num_patterns() const
+  {
+    return _num_patterns;
+  }
+
+  /*! \brief Checks whether the stored patterns belong to a network with `num_pis` inputs and signature `signature`. */
+  bool matches( uint32_t num_pis, uint64_t signature ) const
+  {
+    return _good && _num_patterns > 0u && _num_pis == num_pis && _signature == signature;
+  }
+
+  /*! \brief Reads all stored patterns, one partial truth table per primary input. */
+  std::vector<kitty::partial_truth_table> read() const
+  {
+    std::vector<kitty::partial_truth_table> patterns;
+    if ( !_good || _num_patterns == 0u )
+    {
+      return patterns;
+    }
+
+    auto const num_words = words_for( _num_patterns );
+    auto const copy_columns = [&]( uint64_t const* data ) {
+      patterns.reserve( _num_pis );
+      for ( auto i = 0u; i < _num_pis; ++i )
+      {
+        patterns.emplace_back( static_cast<uint32_t>( _num_patterns ) );
+        std::copy( data + i * _capacity, data + i * _capacity + num_words, patterns.back().begin() );
+        patterns.back().mask_bits();
+      }
+    };
+
+#ifdef MOCKTURTLE_PATTERN_STORE_HAS_MMAP
+    auto const fd = ::open( _filename.c_str(), O_RDONLY );
+    if ( fd == -1 )
+    {
+      return patterns;
+    }
+    auto const size = header_size + sizeof( uint64_t ) * _capacity * _num_pis;
+    auto* addr = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+    if ( addr == MAP_FAILED )
+    {
+      return patterns;
+    }
+    copy_columns( reinterpret_cast<uint64_t const*>( static_cast<char const*>( addr ) + header_size ) );
+    ::munmap( addr, size );
+#else
+    std::ifstream is( _filename, std::ios::binary );
+    std::vector<uint64_t> data( _capacity * _num_pis );
+    is.seekg( header_size );
+    is.read( reinterpret_cast<char*>( data.data() ), sizeof( uint64_t ) * data.size() );
+    if ( !is.good() )
+    {
+      return patterns;
+    }
+    copy_columns( data.data() );
+#endif
+
+    return patterns;
+  }
+
+  /*! \brief Appends patterns `begin` to `end` (exclusive) of `patterns`.
+   *
+   * `patterns` contains one partial truth table per primary input.  If the
+   * store contains patterns of a different network, these are replaced.
+   */
+  void append( std::vector<kitty::partial_truth_table> const& patterns, uint64_t signature, uint64_t begin, uint64_t end )
+  {
+    if ( patterns.empty() || begin >= end )
+    {
+      return;
+    }
+    assert( end <= patterns[0].num_bits() );
+
+    auto const num_pis = static_cast<uint32_t>( patterns.size() );
+    if ( !_good || _num_pis != num_pis || _signature != signature )
+    {
+      _good = true;
+      _num_pis = num_pis;
+      _signature = signature;
+      _num_patterns = 0u;
+      _capacity = 0u;
+    }
+
+    auto const total = _num_patterns + ( end - begin );
+    if ( words_for( total ) > _capacity )
+    {
+      rewrite( patterns, begin, end, std::max( words_for( total ), 2u * _capacity ) );
+      return;
+    }
+
+    /* write the affected words of each column, starting with the last (partial) word */
+    std::fstream fs( _filename, std::ios::binary | std::ios::in | std::ios::out );
+    auto const first_word = _num_patterns / 64u;
+    auto const last_word = words_for( total );
+    std::vector<uint64_t> words( last_word - first_word );
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      auto const offset = header_size + sizeof( uint64_t ) * ( i * _capacity + first_word );
+      std::fill( words.begin(), words.end(), 0u );
+      if ( _num_patterns % 64u != 0u )
+      {
+        fs.seekg( offset );
+        fs.read( reinterpret_cast<char*>( words.data() ), sizeof( uint64_t ) );
+      }
+      copy_bits( patterns[i], begin, end, words.data(), _num_patterns % 64u );
+      fs.seekp( offset );
+      fs.write( reinterpret_cast<char const*>( words.data() ), sizeof( uint64_t ) * words.size() );
+    }
+    fs.flush();
+    if ( !fs.good() )
+    {
+      _good = false;
+      return;
+    }
+
+    /* commit */
+    _num_patterns = total;
+    fs.seekp( 0 );
+    write_header( fs );
+    fs.flush();
+    _good = fs.good();
+  }
+
+  /*! \brief Removes all patterns. */
+  void clear()
+  {
+    std::error_code ec;
+    detail::pattern_store_fs::remove( _filename, ec );
+    _good = true;
+    _num_pis = 0u;
+    _signature = 0u;
+    _num_patterns = 0u;
+    _capacity = 0u;
+  }
+
+private:
+  static constexpr uint64_t header_size = 4u * sizeof( uint32_t ) + 3u * sizeof( uint64_t );
+
+  static uint64_t words_for( uint64_t num_patterns )
+  {
+    return ( num_patterns + 63u ) / 64u;
+  }
+
+  /* ORs bits `begin` to `end` of `tt` into `words`, starting at bit `offset` of the first word */
+  static void copy_bits( kitty::partial_truth_table const& tt, uint64_t begin, uint64_t end, uint64_t* words, uint64_t offset )
+  {
+    auto const* src = &*tt.cbegin();
+    while ( begin < end )
+    {
+      auto const count = std::min<uint64_t>( { end - begin, 64u - offset, 64u - begin % 64u } );
+      auto const word = src[begin / 64u] >> ( begin % 64u );
+      auto const mask = count == 64u ? ~uint64_t( 0 ) : ( ( uint64_t( 1 ) << count ) - 1u );
+      *words |= ( word & mask ) << offset;
+      begin += count;
+      offset += count;
+      if ( offset == 64u )
+      {
+        offset = 0u;
+        ++words;
+      }
+    }
+  }
+
+  template<typename Stream>
+  void write_header( Stream& os ) const
+  {
+    uint32_t const values32[] = {magic, version, _num_pis, 0u};
+    uint64_t const values64[] = {_signature, _num_patterns, _capacity};
+    os.write( reinterpret_cast<char const*>( values32 ), sizeof( values32 ) );
+    os.write( reinterpret_cast<char const*>( values64 ), sizeof( values64 ) );
+  }
+
+  void read_header()
+  {
+    std::ifstream is( _filename, std::ios::binary );
+    if ( !is.good() )
+    {
+      /* file does not exist yet */
+      _good = true;
+      return;
+    }
+
+    uint32_t values32[4] = {0u, 0u, 0u, 0u};
+    uint64_t values64[3] = {0u, 0u, 0u};
+    is.read( reinterpret_cast<char*>( values32 ), sizeof( values32 ) );
+    is.read( reinterpret_cast<char*>( values64 ), sizeof( values64 ) );
+    if ( !is.good() || values32[0] != magic || values32[1] != version || words_for( values64[1] ) > values64[2] )
+    {
+      _good = false;
+      return;
+    }
+
+    std::error_code ec;
+    auto const size = detail::pattern_store_fs::file_size( _filename, ec );
+    if ( ec || size < header_size + sizeof( uint64_t ) * values32[2] * values64[2] )
+    {
+      _good = false;
+      return;
+    }
+
+    _good = true;
+    _num_pis = values32[2];
+    _signature = values64[0];
+    _num_patterns = values64[1];
+    _capacity = values64[2];
+  }
+
+  /* writes all patterns with a new capacity into a temporary file, which replaces the store */
+  void rewrite( std::vector<kitty::partial_truth_table> const& patterns, uint64_t begin, uint64_t end, uint64_t capacity )
+  {
+    auto const old_patterns = read();
+    auto const total = _num_patterns + ( end - begin );
+
+    std::vector<uint64_t> column( capacity );
+    auto const tmp_filename = _filename + ".tmp";
+    {
+      std::ofstream os( tmp_filename, std::ios::binary | std::ios::trunc );
+      auto const old_num_patterns = _num_patterns;
+      _num_patterns = total;
+      _capacity = capacity;
+      write_header( os );
+      _num_patterns = old_num_patterns;
+
+      for ( auto i = 0u; i < patterns.size(); ++i )
+      {
+        std::fill( column.begin(), column.end(), 0u );
+        if ( !old_patterns.empty() )
+        {
+          copy_bits( old_patterns[i], 0u, old_patterns[i].num_bits(), column.data(), 0u );
+        }
+        copy_bits( patterns[i], begin, end, column.data() + _num_patterns / 64u, _num_patterns % 64u );
+        os.write( reinterpret_cast<char const*>( column.data() ), sizeof( uint64_t ) * column.size() );
+      }
+      if ( !os.good() )
+      {
+        _good = false;
+        return;
+      }
+    }
+
+    std::error_code ec;
+    detail::pattern_store_fs::rename( tmp_filename, _filename, ec );
+    if ( ec )
+    {
+      _good = false;
+      return;
+    }
+    _num_patterns = total;
+    _capacity = capacity;
+  }
+
+private:
+  std::string _filename;
+  bool _good{false};
+  uint32_t _num_pis{0u};
+  uint64_t _signature{0u};
+  uint64_t _num_patterns{0u};
+  uint64_t _capacity{0u};
+};
+
+/*! \brief Loads the stored patterns of `ntk` into `sim`.
+ *
+ * The patterns are appended to the patterns of `sim`, if the store
+ * contains patterns of a network with the same signature.  Returns the
+ * number of loaded patterns.
+ */
+template<class Ntk, class Simulator>
+uint64_t load_patterns( pattern_store const& store, Ntk const& ntk, Simulator& sim )
+{
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "Simulator should be either partial_simulator or bit_packed_simulator" );
+
+  if ( !store.matches( ntk.num_pis(), network_signature( ntk ) ) )
+  {
+    return 0u;
+  }
+  auto const patterns = store.read();
+  if ( patterns.empty() )
+  {
+    return 0u;
+  }
+
+  if ( sim.num_bits() == 0u )
+  {
+    sim = Simulator( patterns );
+    return store.num_patterns();
+  }
+
+  std::vector<bool> pattern( patterns.size() );
+  std::vector<bool> const care( patterns.size(), true );
+  for ( auto j = 0u; j < patterns[0].num_bits(); ++j )
+  {
+    for ( auto i = 0u; i < patterns.size(); ++i )
+    {
+      pattern[i] = kitty::get_bit( patterns[i], j );
+    }
+    if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
+    {
+      sim.add_pattern( pattern, care );
+    }
+    else
+    {
+      sim.add_pattern( pattern );
+    }
+  }
+  return store.num_patterns();
+}
+
+/*! \brief Appends the patterns of `sim` to the store of `ntk`.
+ *
+ * Patterns `begin` to `end` (exclusive, default: all remaining patterns)
+ * of `sim` are appended.  Use the return value of `load_patterns` as
+ * `begin` to append only the patterns that were added after loading.
+ */
+template<class Ntk, class Simulator>
+void save_patterns( pattern_store& store, Ntk const& ntk, Simulator const& sim, uint64_t begin = 0u, uint64_t end = ~uint64_t( 0 ) )
+{
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "Simulator should be either partial_simulator or bit_packed_simulator" );
+
+  store.append( sim.get_patterns(), network_signature( ntk ), begin, std::min<uint64_t>( end, sim.num_bits() ) );
+}
+
+} /* namespace mockturtle */
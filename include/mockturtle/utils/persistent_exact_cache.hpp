@@ -0,0 +1,402 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file persistent_exact_cache.hpp
+  \brief On-disk cache for exact synthesis results
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+
+#include "append_log.hpp"
+#include "include/percy.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Applies an NPN transformation to a chain.
+ *
+ * The chain `c` computes the function of an NPN class representative,
+ * and `phase` and `perm` are the NPN configuration as returned by the
+ * canonization functions in kitty.  Afterwards, `c` computes the original
+ * function: input `i` of the representative is replaced by input
+ * `perm[i]`, which is complemented if bit `perm[i]` in `phase` is set.
+ * Input complementations are absorbed into the operators; an output
+ * complementation inverts the output literal.
+ */
+inline void npn_transform_chain( percy::chain& c, uint32_t phase, std::vector<uint8_t> const& perm )
+{
+  auto const num_inputs = c.get_nr_inputs();
+
+  for ( auto i = 0; i < c.get_nr_steps(); ++i )
+  {
+    auto fanins = c.get_step( i );
+    auto op = c.get_operator( i );
+    for ( auto j = 0u; j < fanins.size(); ++j )
+    {
+      if ( fanins[j] >= num_inputs )
+      {
+        continue;
+      }
+      auto const input = perm[fanins[j]];
+      if ( ( phase >> input ) & 1 )
+      {
+        kitty::flip_inplace( op, j );
+      }
+      fanins[j] = input;
+    }
+    c.set_step( i, fanins, op );
+  }
+
+  for ( auto& lit : c.get_outputs() )
+  {
+    /* output literals refer to the constant (0), inputs (1 to n), or steps */
+    auto const var = lit >> 1;
+    if ( var > 0 && var <= num_inputs )
+    {
+      auto const input = perm[var - 1];
+      lit = ( ( input + 1 ) << 1 ) | ( ( lit & 1 ) ^ ( ( phase >> input ) & 1 ) );
+    }
+    if ( ( phase >> num_inputs ) & 1 )
+    {
+      lit ^= 1;
+    }
+  }
+}
+
+/*! \brief On-disk cache for exact synthesis results.
+ *
+ * This cache stores the results of SAT-based exact synthesis in a binary,
+ * append-only file (see `append_log`), such that they can be reused by later
+ * runs and by other processes working on the same file at the same time.
+ *
+ * The cache is keyed by the truth table of an NPN class representative
+ * and a 64-bit fingerprint of the synthesis parameters that affect the
+ * result.  Besides optimum chains, the cache also stores failed synthesis
+ * attempts together with the conflict limit that was used.
+ *
+ * New entries are kept in memory and are appended to the file when
+ * `flush` is called, when the number of pending entries reaches the flush
+ * threshold, or when the cache is destroyed.  If a lookup fails and
+ * other processes have appended entries to the file in the meantime,
+ * these entries are read before reporting a miss.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      exact_resynthesis_params ps;
+      ps.persistent_cache = std::make_shared<persistent_exact_cache>( "exact.cache" );
+      exact_resynthesis_stats st;
+      exact_resynthesis<klut_network> resyn( 3, ps, &st );
+      klut = cut_rewriting( klut, resyn );
+      st.report();
+   \endverbatim
+ */
+class persistent_exact_cache
+{
+public:
+  /*! \brief Cache entry. */
+  struct entry
+  {
+    /*! \brief Optimum chain, if synthesis succeeded. */
+    std::optional<percy::chain> chain;
+
+    /*! \brief Conflict limit of a failed attempt (0, if synthesis failed without limit). */
+    int32_t conflict_limit{0};
+  };
+
+public:
+  /*! \brief Opens or creates the cache file.
+   *
+   * \param filename Path to the cache file
+   * \param flush_threshold Number of new entries after which the cache is written to the file
+   */
+  explicit persistent_exact_cache( std::string const& filename, uint32_t flush_threshold = 32u )
+      : _log( filename, magic ),
+        _flush_threshold( flush_threshold )
+  {
+    _log.read( [&]( std::string const& payload ) { load_record( payload ); } );
+  }
+
+  ~persistent_exact_cache()
+  {
+    flush();
+  }
+
+  /*! \brief Returns false, if the cache file cannot be used. */
+  bool good() const
+  {
+    return _log.good();
+  }
+
+  /*! \brief Number of entries (including those not yet written). */
+  uint64_t size() const
+  {
+    return _entries.size();
+  }
+
+  /*! \brief Number of entries that have not been written yet. */
+  uint64_t num_pending() const
+  {
+    return _pending.size();
+  }
+
+  /*! \brief Looks up the entry for an NPN representative. */
+  std::optional<entry> find( kitty::dynamic_truth_table const& repr, uint64_t fingerprint )
+  {
+    auto const key = make_key( repr, fingerprint );
+    if ( auto const it = _entries.find( key ); it != _entries.end() )
+    {
+      return it->second;
+    }
+
+    /* maybe another process has found it */
+    if ( _log.has_new_records() )
+    {
+      _log.read( [&]( std::string const& payload ) { load_record( payload ); } );
+      if ( auto const it = _entries.find( key ); it != _entries.end() )
+      {
+        return it->second;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /*! \brief Stores an optimum chain for an NPN representative. */
+  void insert( kitty::dynamic_truth_table const& repr, uint64_t fingerprint, percy::chain const& chain )
+  {
+    entry e;
+    e.chain = chain;
+    insert_entry( make_key( repr, fingerprint ), e );
+  }
+
+  /*! \brief Stores a failed synthesis attempt for an NPN representative. */
+  void insert_failure( kitty::dynamic_truth_table const& repr, uint64_t fingerprint, int32_t conflict_limit )
+  {
+    entry e;
+    e.conflict_limit = conflict_limit;
+    insert_entry( make_key( repr, fingerprint ), e );
+  }
+
+  /*! \brief Writes all pending entries to the file. */
+  void flush()
+  {
+    if ( _pending.empty() )
+    {
+      return;
+    }
+    _log.append( _pending, [&]( std::string const& payload ) { load_record( payload ); } );
+    _pending.clear();
+  }
+
+private:
+  static constexpr uint32_t magic = 0x4345544d; /* "MTEC" */
+
+  static std::string make_key( kitty::dynamic_truth_table const& repr, uint64_t fingerprint )
+  {
+    std::string key;
+    append_log::write_value( key, fingerprint );
+    append_log::write_value( key, static_cast<uint8_t>( repr.num_vars() ) );
+    for ( auto const& word : repr )
+    {
+      append_log::write_value( key, word );
+    }
+    return key;
+  }
+
+  static void write_chain( std::string& buffer, percy::chain const& c )
+  {
+    append_log::write_value( buffer, static_cast<uint8_t>( c.get_nr_inputs() ) );
+    append_log::write_value( buffer, static_cast<uint8_t>( c.get_fanin() ) );
+    append_log::write_value( buffer, static_cast<uint32_t>( c.get_nr_steps() ) );
+    append_log::write_value( buffer, static_cast<uint32_t>( c.get_nr_outputs() ) );
+    for ( auto i = 0; i < c.get_nr_steps(); ++i )
+    {
+      for ( auto const fanin : c.get_step( i ) )
+      {
+        append_log::write_value( buffer, static_cast<uint32_t>( fanin ) );
+      }
+      for ( auto const& word : c.get_operator( i ) )
+      {
+        append_log::write_value( buffer, word );
+      }
+    }
+    for ( auto const lit : c.get_outputs() )
+    {
+      append_log::write_value( buffer, static_cast<uint32_t>( lit ) );
+    }
+  }
+
+  static bool read_chain( std::string const& buffer, std::size_t& pos, percy::chain& c )
+  {
+    uint8_t num_inputs{0}, fanin{0};
+    uint32_t num_steps{0}, num_outputs{0};
+    if ( !append_log::read_value( buffer, pos, num_inputs ) || !append_log::read_value( buffer, pos, fanin ) ||
+         !append_log::read_value( buffer, pos, num_steps ) || !append_log::read_value( buffer, pos, num_outputs ) )
+    {
+      return false;
+    }
+
+    c.reset( num_inputs, num_outputs, num_steps, fanin );
+    std::vector<int> fanins( fanin );
+    for ( auto i = 0u; i < num_steps; ++i )
+    {
+      for ( auto& f : fanins )
+      {
+        uint32_t value{0};
+        if ( !append_log::read_value( buffer, pos, value ) )
+        {
+          return false;
+        }
+        f = static_cast<int>( value );
+      }
+      kitty::dynamic_truth_table op( fanin );
+      for ( auto& word : op )
+      {
+        if ( !append_log::read_value( buffer, pos, word ) )
+        {
+          return false;
+        }
+      }
+      c.set_step( i, fanins, op );
+    }
+    for ( auto i = 0u; i < num_outputs; ++i )
+    {
+      uint32_t lit{0};
+      if ( !append_log::read_value( buffer, pos, lit ) )
+      {
+        return false;
+      }
+      c.set_output( i, static_cast<int>( lit ) );
+    }
+    return true;
+  }
+
+  /* successful entries replace failed ones; failures with larger limit replace smaller ones */
+  bool merge_entry( std::string const& key, entry const& e )
+  {
+    auto const it = _entries.find( key );
+    if ( it == _entries.end() )
+    {
+      _entries.emplace( key, e );
+      return true;
+    }
+    if ( it->second.chain )
+    {
+      return false;
+    }
+    if ( e.chain || ( it->second.conflict_limit != 0 && ( e.conflict_limit == 0 || e.conflict_limit > it->second.conflict_limit ) ) )
+    {
+      it->second = e;
+      return true;
+    }
+    return false;
+  }
+
+  void insert_entry( std::string const& key, entry const& e )
+  {
+    if ( !merge_entry( key, e ) )
+    {
+      return;
+    }
+
+    std::string payload = key;
+    append_log::write_value( payload, static_cast<uint8_t>( e.chain ? 1u : 0u ) );
+    if ( e.chain )
+    {
+      write_chain( payload, *e.chain );
+    }
+    else
+    {
+      append_log::write_value( payload, e.conflict_limit );
+    }
+    _pending.push_back( payload );
+
+    if ( _pending.size() >= _flush_threshold )
+    {
+      flush();
+    }
+  }
+
+  void load_record( std::string const& payload )
+  {
+    std::size_t pos{0};
+    uint64_t fingerprint{0};
+    uint8_t num_vars{0};
+    if ( !append_log::read_value( payload, pos, fingerprint ) || !append_log::read_value( payload, pos, num_vars ) )
+    {
+      return;
+    }
+    pos += kitty::dynamic_truth_table( num_vars ).num_blocks() * sizeof( uint64_t );
+    if ( pos > payload.size() )
+    {
+      return;
+    }
+    auto const key = payload.substr( 0, pos );
+
+    uint8_t success{0};
+    if ( !append_log::read_value( payload, pos, success ) )
+    {
+      return;
+    }
+
+    entry e;
+    if ( success )
+    {
+      percy::chain c;
+      if ( !read_chain( payload, pos, c ) )
+      {
+        return;
+      }
+      e.chain = c;
+    }
+    else if ( !append_log::read_value( payload, pos, e.conflict_limit ) )
+    {
+      return;
+    }
+    merge_entry( key, e );
+  }
+
+private:
+  append_log _log;
+  uint32_t _flush_threshold;
+  std::unordered_map<std::string, entry> _entries;
+  std::vector<std::string> _pending;
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,151 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file window_index_arena.hpp
+  \brief Reusable dense node-to-index storage for window-like views
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Reusable dense node-to-index storage for window-like views.
+ *
+ * Views such as `cut_view`, `mffc_view`, and `window_view` map nodes
+ * of the original network to local indexes.  Algorithms that
+ * construct millions of such views can pass the same arena to each
+ * of them to avoid building a hash map for every view.
+ *
+ * The arena is a vector indexed by the node index in the original
+ * network.  Each entry is tagged with a timestamp, and starting a new
+ * window increments the timestamp, which invalidates all entries in
+ * constant time.  The vectors only grow if the network grows, so
+ * constructing views is allocation-free after warm-up.
+ *
+ * An arena can only back one live view at a time: constructing a new
+ * view with the same arena invalidates the index of the previous one.
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      window_index_arena arena( aig.size() );
+      aig.foreach_gate( [&]( auto const& n ) {
+        mffc_view mffc{aig, n, &arena};
+        // ...
+      } );
+   \endverbatim
+ */
+class window_index_arena
+{
+public:
+  window_index_arena() = default;
+
+  /*! \brief Constructor pre-allocating entries for `size` nodes. */
+  explicit window_index_arena( uint64_t size )
+      : _stamps( size, 0u ),
+        _indexes( size, 0u )
+  {
+  }
+
+  /*! \brief Starts a new window and returns its timestamp.
+   *
+   * All entries of the previous window are invalidated.
+   */
+  uint32_t new_window()
+  {
+    if ( ++_stamp == 0u )
+    {
+      /* timestamp overflow: clear all entries */
+      std::fill( _stamps.begin(), _stamps.end(), 0u );
+      _stamp = 1u;
+    }
+    return _stamp;
+  }
+
+  /*! \brief Ensures that there is an entry for `size` nodes. */
+  void reserve( uint64_t size )
+  {
+    if ( size > _stamps.size() )
+    {
+      _stamps.resize( size, 0u );
+      _indexes.resize( size, 0u );
+    }
+  }
+
+  /*! \brief Assigns a local `index` to the node with index `key` in the current window. */
+  void insert( uint64_t key, uint32_t index )
+  {
+    if ( key >= _stamps.size() )
+    {
+      reserve( std::max<uint64_t>( key + 1u, 2u * _stamps.size() ) );
+    }
+    _stamps[key] = _stamp;
+    _indexes[key] = index;
+  }
+
+  /*! \brief Checks whether the node with index `key` is in the window `stamp`. */
+  bool has( uint64_t key, uint32_t stamp ) const
+  {
+    return key < _stamps.size() && _stamps[key] == stamp;
+  }
+
+  /*! \brief Returns the local index of the node with index `key` in the window `stamp`. */
+  uint32_t at( uint64_t key, uint32_t stamp ) const
+  {
+    (void)stamp;
+    assert( has( key, stamp ) && "node is not in the window or arena has been reused" );
+    return _indexes[key];
+  }
+
+  /*! \brief Returns the timestamp of the current window. */
+  uint32_t stamp() const
+  {
+    return _stamp;
+  }
+
+  /*! \brief Returns the number of entries. */
+  uint64_t size() const
+  {
+    return _stamps.size();
+  }
+
+private:
+  std::vector<uint32_t> _stamps;
+  std::vector<uint32_t> _indexes;
+  uint32_t _stamp{0u};
+};
+
+} /* namespace mockturtle */
@@ -40,9 +40,11 @@
 #include <vector>
 
 #include "../algorithms/cnf.hpp"
+#include "../algorithms/cnf_map.hpp"
 #include "../networks/events.hpp"
 #include "../utils/include/percy.hpp"
 #include "../traits.hpp"
+#include "mapping_view.hpp"
 
 #include <bill/sat/interface/common.hpp>
 #include <bill/sat/interface/glucose.hpp>
@@ -59,6 +61,13 @@ struct cnf_view_params
   /*! \brief Automatically update clauses when network is modified. 
              Only meaningful when AllowModify = true. */
   bool auto_update{true};
+
+  /*! \brief Encode gates with `cnf_map` when solving instead of when they are created.
+             Only meaningful when AllowModify = false. */
+  bool use_cnf_map{false};
+
+  /*! \brief Parameters for `cnf_map` (if `use_cnf_map` is true). */
+  cnf_map_params cnf_map_ps{};
 };
 
 /* forward declaration */
@@ -192,6 +201,19 @@ private:
  * `AllowModify` template parameter to true.  Then it also updates the CNF when
  * nodes are deleted or modified.  This comes with an addition cost in variable
  * and clause size.
+ *
+ * If `use_cnf_map` is set in the parameters (and `AllowModify` is false),
+ * gates are not encoded when they are created.  Instead, the network is
+ * mapped with `cnf_map` when `solve` or `add_clause` refer to a gate that is
+ * not encoded yet, and the transitive fanin cone of that gate is encoded with
+ * one CNF per cell (gates that are not cell roots are encoded individually
+ * if they are referred to).  This results in fewer variables and clauses
+ * that constrain the model, hence model values are only meaningful for
+ * primary inputs and for nodes in the transitive fanin of the literals in
+ * the assumptions and in custom clauses.  When gates are created after the
+ * first encoding, the network is mapped again only once it has doubled in
+ * size since the last mapping (so that the mapping effort is linear in the
+ * final network size); until then, new gates are encoded individually.
  */
 template<typename Ntk, bool AllowModify, bill::solvers Solver>
 class cnf_view : public detail::cnf_view_impl<cnf_view<Ntk, AllowModify, Solver>, Ntk, AllowModify, Solver>,
@@ -318,6 +340,14 @@ public:
    */
   inline std::optional<bool> solve( bill::result::clause_type const& assumptions, uint32_t limit = 0 )
   {
+    if constexpr ( !AllowModify )
+    {
+      if ( ps_.use_cnf_map )
+      {
+        encode_deferred( assumptions );
+      }
+    }
+
     const auto _write_dimacs = [&]( bill::result::clause_type const& assumps ) {
       if ( ps_.write_dimacs )
       {
@@ -438,16 +468,15 @@ public:
   /*! \brief Adds a clause to the solver. */
   void add_clause( bill::result::clause_type const& clause )
   {
-    if ( ps_.write_dimacs )
+    if constexpr ( !AllowModify )
     {
-      std::vector<int> lits;
-      for ( auto c : clause )
+      if ( ps_.use_cnf_map )
       {
-        lits.push_back( pabc::Abc_Var2Lit( c.variable(), c.is_complemented() ) );
+        encode_deferred( clause );
       }
-      dimacs_.add_clause( &lits[0], &lits[0] + lits.size() );
     }
-    solver_.add_clause( clause );
+
+    add_solver_clause( clause );
   }
 
   /*! \brief Adds a clause from signals to the solver. */
@@ -479,6 +508,117 @@ public:
   }
 
 private:
+  void add_solver_clause( bill::result::clause_type const& clause )
+  {
+    if ( ps_.write_dimacs )
+    {
+      std::vector<int> lits;
+      for ( auto c : clause )
+      {
+        lits.push_back( pabc::Abc_Var2Lit( c.variable(), c.is_complemented() ) );
+      }
+      dimacs_.add_clause( &lits[0], &lits[0] + lits.size() );
+    }
+    solver_.add_clause( clause );
+  }
+
+  /* encodes the transitive fanin cones of the gates in `lits` that are not encoded yet */
+  void encode_deferred( bill::result::clause_type const& lits )
+  {
+    encoded_.resize( Ntk::size(), false );
+    for ( auto const& l : lits )
+    {
+      /* variables of nodes are their indexes */
+      uint32_t const v = l.variable();
+      if ( v < Ntk::size() )
+      {
+        encode_cone( Ntk::index_to_node( v ) );
+      }
+    }
+  }
+
+  bool is_encoded( node const& n ) const
+  {
+    return Ntk::is_constant( n ) || Ntk::is_pi( n ) || encoded_[Ntk::node_to_index( n )];
+  }
+
+  bool is_mapped_cell_root( node const& n ) const
+  {
+    return Ntk::node_to_index( n ) < mapped_size_ && mapping_->is_cell_root( n );
+  }
+
+  void encode_cone( node const& n )
+  {
+    encode_stack_.clear();
+    encode_stack_.emplace_back( n );
+    while ( !encode_stack_.empty() )
+    {
+      auto const m = encode_stack_.back();
+      if ( is_encoded( m ) )
+      {
+        encode_stack_.pop_back();
+        continue;
+      }
+
+      if ( Ntk::node_to_index( m ) >= mapped_size_ && Ntk::size() >= 2u * mapped_size_ )
+      {
+        /* remap only after the network has doubled in size since the last
+         * mapping, such that the total mapping effort stays linear when
+         * creating gates and encoding them alternate; gates created in
+         * between are encoded individually */
+        mapping_.emplace( static_cast<Ntk const&>( *this ) );
+        cnf_map( *mapping_, ps_.cnf_map_ps );
+        mapped_size_ = Ntk::size();
+      }
+
+      auto const size = encode_stack_.size();
+      const auto push = [&]( node const& leaf ) {
+        if ( !is_encoded( leaf ) )
+        {
+          encode_stack_.emplace_back( leaf );
+        }
+      };
+      if ( is_mapped_cell_root( m ) )
+      {
+        mapping_->foreach_cell_fanin( m, push );
+      }
+      else
+      {
+        Ntk::foreach_fanin( m, [&]( signal const& f ) {
+          push( Ntk::get_node( f ) );
+        } );
+      }
+
+      if ( encode_stack_.size() == size )
+      {
+        encode_stack_.pop_back();
+        encode_deferred_node( m );
+      }
+    }
+  }
+
+  void encode_deferred_node( node const& n )
+  {
+    encoded_[Ntk::node_to_index( n )] = true;
+
+    const auto _add_clause = [&]( bill::result::clause_type const& clause ) {
+      add_solver_clause( clause );
+    };
+
+    if ( is_mapped_cell_root( n ) )
+    {
+      bill::result::clause_type leaf_lits;
+      mapping_->foreach_cell_fanin( n, [&]( node const& leaf ) {
+        leaf_lits.push_back( lit( leaf ) );
+      } );
+      detail::on_function( lit( n ), leaf_lits, cnf_cache_( mapping_->cell_function( n ) ), _add_clause );
+    }
+    else
+    {
+      add_gate_clauses( n, lit( n ), _add_clause );
+    }
+  }
+
   void register_events()
   {
     Ntk::events().on_add.emplace_back( event_add_crtp<Ntk, cnf_view>::wp(), []( void *wp, auto const& n ) {
@@ -547,6 +687,11 @@ private:
       assert( v == var( n ) );
       (void)v;
 
+      if ( ps_.use_cnf_map )
+      {
+        return;
+      }
+
       node_lit = lit( Ntk::make_signal( n ) );
     }
 
@@ -559,10 +704,16 @@ private:
       }
       else
       {
-        add_clause( clause );
+        add_solver_clause( clause );
       }
     };
 
+    add_gate_clauses( n, node_lit, _add_clause );
+  }
+
+  template<class ClauseFn>
+  void add_gate_clauses( node const& n, bill::lit_type const& node_lit, ClauseFn const& _add_clause )
+  {
     bill::result::clause_type child_lits;
     Ntk::foreach_fanin( n, [&]( auto const& f ) {
       child_lits.push_back( lit( f ) );
@@ -604,6 +755,15 @@ private:
       }
     }
 
+    if constexpr ( has_is_dmaj_v<Ntk> )
+    {
+      if ( Ntk::is_dmaj( n ) )
+      {
+        detail::on_maj( node_lit, child_lits[0], child_lits[1], child_lits[2], _add_clause );
+        return;
+      }
+    }
+
     if constexpr ( has_is_ite_v<Ntk> )
     {
       if ( Ntk::is_ite( n ) )
@@ -661,6 +821,13 @@ private:
   percy::cnf_formula dimacs_;
 
   cnf_view_params ps_;
+
+  /* deferred encoding with `cnf_map` */
+  std::vector<bool> encoded_;
+  std::optional<mapping_view<Ntk, true>> mapping_;
+  uint32_t mapped_size_{0};
+  std::vector<node> encode_stack_;
+  cnf_cache cnf_cache_;
 };
 
 template<class T>
@@ -41,6 +41,7 @@
 
 #include "../networks/detail/foreach.hpp"
 #include "../traits.hpp"
+#include "../utils/window_index_arena.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -58,6 +59,10 @@ namespace mockturtle
  * the view.  The view guarantees that all the nodes in the view will have a 0
  * visited flag after the construction.
  *
+ * Optionally, a `window_index_arena` can be passed to store the mapping from
+ * nodes to indexes.  This avoids building a hash map for each view, when many
+ * views are constructed one after another.
+ *
  * **Required network functions:**
  * - `set_visited`
  * - `visited`
@@ -76,15 +81,15 @@ public:
   static constexpr bool is_topologically_sorted = true;
 
 public:
-  explicit cut_view( Ntk const& ntk, std::vector<node> const& leaves, signal const& root )
-      : immutable_view<Ntk>( ntk ), _root( root )
+  explicit cut_view( Ntk const& ntk, std::vector<node> const& leaves, signal const& root, window_index_arena* arena = nullptr )
+      : immutable_view<Ntk>( ntk ), _root( root ), _arena( arena )
   {
     construct( leaves );
   }
 
   template<typename _Ntk = Ntk, typename = std::enable_if_t<!std::is_same_v<typename _Ntk::signal, typename _Ntk::node>>>
-  explicit cut_view( Ntk const& ntk, std::vector<signal> const& leaves, signal const& root )
-      : immutable_view<Ntk>( ntk ), _root( root )
+  explicit cut_view( Ntk const& ntk, std::vector<signal> const& leaves, signal const& root, window_index_arena* arena = nullptr )
+      : immutable_view<Ntk>( ntk ), _root( root ), _arena( arena )
   {
     construct( leaves );
   }
@@ -106,6 +111,12 @@ private:
 
     this->incr_trav_id();
 
+    if ( _arena )
+    {
+      _stamp = _arena->new_window();
+      _arena->reserve( Ntk::size() );
+    }
+
     /* constants */
     add_constants();
 
@@ -137,7 +148,10 @@ public:
   inline auto num_pos() const { return 1; }
   inline auto num_gates() const { return _nodes.size() - _num_leaves - _num_constants; }
 
-  inline auto node_to_index( const node& n ) const { return _node_to_index.at( n ); }
+  inline uint32_t node_to_index( const node& n ) const
+  {
+    return _arena ? _arena->at( Ntk::node_to_index( n ), _stamp ) : _node_to_index.at( n );
+  }
   inline auto index_to_node( uint32_t index ) const { return _nodes[index]; }
 
   template<typename Fn>
@@ -196,7 +210,14 @@ private:
 
   inline void add_node( node const& n )
   {
-    _node_to_index[n] = static_cast<uint32_t>( _nodes.size() );
+    if ( _arena )
+    {
+      _arena->insert( Ntk::node_to_index( n ), static_cast<uint32_t>( _nodes.size() ) );
+    }
+    else
+    {
+      _node_to_index[n] = static_cast<uint32_t>( _nodes.size() );
+    }
     _nodes.push_back( n );
   }
 
@@ -219,6 +240,8 @@ public:
   std::vector<node> _nodes;
   phmap::flat_hash_map<node, uint32_t> _node_to_index;
   signal _root;
+  window_index_arena* _arena{nullptr};
+  uint32_t _stamp{0};
 };
 
 template<class T>
@@ -227,4 +250,10 @@ cut_view(T const&, std::vector<node<T>> const&, signal<T> const&) -> cut_view<T>
 template<class T, typename = std::enable_if_t<!std::is_same_v<typename T::signal, typename T::node>>>
 cut_view(T const&, std::vector<signal<T>> const&, signal<T> const&) -> cut_view<T>;
 
+template<class T>
+cut_view(T const&, std::vector<node<T>> const&, signal<T> const&, window_index_arena*) -> cut_view<T>;
+
+template<class T, typename = std::enable_if_t<!std::is_same_v<typename T::signal, typename T::node>>>
+cut_view(T const&, std::vector<signal<T>> const&, signal<T> const&, window_index_arena*) -> cut_view<T>;
+
 } /* namespace mockturtle */
\ No newline at end of file
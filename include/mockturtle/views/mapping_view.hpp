@@ -54,7 +54,8 @@ struct mapping_view_storage;
 template<>
 struct mapping_view_storage<true>
 {
-  std::vector<uint32_t> mappings;
+  std::vector<uint32_t> mappings;  /* per node: position of its cell in `leaves`, 0 if not a cell root */
+  std::vector<uint32_t> leaves{0u}; /* per cell: number of leaves followed by leaf indexes */
   uint32_t mapping_size{0};
   std::vector<uint32_t> functions;
   truth_table_cache<kitty::dynamic_truth_table> cache;
@@ -63,7 +64,8 @@ struct mapping_view_storage<true>
 template<>
 struct mapping_view_storage<false>
 {
-  std::vector<uint32_t> mappings;
+  std::vector<uint32_t> mappings;  /* per node: position of its cell in `leaves`, 0 if not a cell root */
+  std::vector<uint32_t> leaves{0u}; /* per cell: number of leaves followed by leaf indexes */
   uint32_t mapping_size{0};
 };
 
@@ -160,13 +162,15 @@ public:
 
   bool is_cell_root( node const& n ) const
   {
-    return _mapping_storage->mappings[this->node_to_index( n )] != 0;
+    const auto index = this->node_to_index( n );
+    return index < _mapping_storage->mappings.size() && _mapping_storage->mappings[index] != 0;
   }
 
   void clear_mapping()
   {
     _mapping_storage->mappings.clear();
     _mapping_storage->mappings.resize( this->size(), 0 );
+    _mapping_storage->leaves.resize( 1u );
     _mapping_storage->mapping_size = 0;
   }
 
@@ -178,7 +182,17 @@ public:
   template<typename LeavesIterator>
   void add_to_mapping( node const& n, LeavesIterator begin, LeavesIterator end )
   {
-    auto& mindex = _mapping_storage->mappings[this->node_to_index( n )];
+    const auto index = this->node_to_index( n );
+
+    /* nodes may have been added to the network after the view was created */
+    if ( index >= _mapping_storage->mappings.size() )
+    {
+      _mapping_storage->mappings.resize( this->size(), 0 );
+    }
+
+    auto& mindex = _mapping_storage->mappings[index];
+    auto& leaves = _mapping_storage->leaves;
+    const auto num_leaves = static_cast<uint32_t>( std::distance( begin, end ) );
 
     /* increase mapping size? */
     if ( mindex == 0 )
@@ -186,47 +200,58 @@ public:
       _mapping_storage->mapping_size++;
     }
 
-    /* set starting index of leafs */
-    mindex = static_cast<uint32_t>( _mapping_storage->mappings.size() );
+    /* reuse the entry of a previous cell of the node, if the new leaves fit */
+    if ( mindex == 0 || leaves[mindex] < num_leaves )
+    {
+      /* set starting index of leafs */
+      mindex = static_cast<uint32_t>( leaves.size() );
+      leaves.resize( leaves.size() + 1u + num_leaves );
+    }
 
     /* insert number of leafs */
-    _mapping_storage->mappings.push_back( static_cast<uint32_t>( std::distance( begin, end ) ) );
+    auto it = leaves.begin() + mindex;
+    *it++ = num_leaves;
 
     /* insert leaf indexes */
     while ( begin != end )
     {
-      _mapping_storage->mappings.push_back( this->node_to_index( *begin++ ) );
+      *it++ = this->node_to_index( *begin++ );
     }
   }
 
   void remove_from_mapping( node const& n )
   {
-    auto& mindex = _mapping_storage->mappings[this->node_to_index( n )];
-
-    if ( mindex != 0 )
+    if ( !is_cell_root( n ) )
     {
-      _mapping_storage->mapping_size--;
+      return;
     }
 
+    _mapping_storage->mapping_size--;
     _mapping_storage->mappings[this->node_to_index( n )] = 0;
   }
 
   template<bool enabled = StoreFunction, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   kitty::dynamic_truth_table cell_function( node const& n ) const
   {
-    return _mapping_storage->cache[_mapping_storage->functions[this->node_to_index( n )]];
+    const auto index = this->node_to_index( n );
+    return _mapping_storage->cache[index < _mapping_storage->functions.size() ? _mapping_storage->functions[index] : 0u];
   }
 
   template<bool enabled = StoreFunction, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   void set_cell_function( node const& n, kitty::dynamic_truth_table const& function )
   {
-    _mapping_storage->functions[this->node_to_index( n )] = _mapping_storage->cache.insert( function );
+    const auto index = this->node_to_index( n );
+    if ( index >= _mapping_storage->functions.size() )
+    {
+      _mapping_storage->functions.resize( this->size(), 0 );
+    }
+    _mapping_storage->functions[index] = _mapping_storage->cache.insert( function );
   }
 
   template<typename Fn>
   void foreach_cell_fanin( node const& n, Fn&& fn ) const
   {
-    auto it = _mapping_storage->mappings.begin() + _mapping_storage->mappings[this->node_to_index( n )];
+    auto it = _mapping_storage->leaves.cbegin() + _mapping_storage->mappings[this->node_to_index( n )];
     const auto size = *it++;
     using IteratorType = decltype( it );
     detail::foreach_element_transform<IteratorType, typename Ntk::node>( it, it + size,
@@ -40,6 +40,7 @@
 
 #include "../networks/detail/foreach.hpp"
 #include "../traits.hpp"
+#include "../utils/window_index_arena.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -61,6 +62,10 @@ namespace mockturtle
  * i.e., they are assigned their fanout size.  The values are restored by the
  * view.
  *
+ * Optionally, a `window_index_arena` can be passed to store the mapping from
+ * nodes to indexes.  This avoids building a hash map for each view, when many
+ * views are constructed one after another.
+ *
  * **Required network functions:**
  * - `get_node`
  * - `decr_value`
@@ -78,8 +83,8 @@ public:
   using signal = typename Ntk::signal;
 
 public:
-  explicit mffc_view( Ntk const& ntk, node const& root )
-      : immutable_view<Ntk>( ntk ), _root( root )
+  explicit mffc_view( Ntk const& ntk, node const& root, window_index_arena* arena = nullptr )
+      : immutable_view<Ntk>( ntk ), _root( root ), _arena( arena )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
@@ -91,15 +96,21 @@ public:
     static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
     static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
 
+    if ( _arena )
+    {
+      _stamp = _arena->new_window();
+      _arena->reserve( Ntk::size() );
+    }
+
     const auto c0 = this->get_node( this->get_constant( false ));
     _constants.push_back( c0);
-    _node_to_index.emplace( c0, _node_to_index.size());
+    add_index( c0 );
 
     const auto c1 = this->get_node( this->get_constant( true));
     if ( c1 != c0 )
     {
       _constants.push_back( c1);
-      _node_to_index.emplace( c1, _node_to_index.size());
+      add_index( c1 );
       ++_num_constants;
     }
 
@@ -160,7 +171,10 @@ public:
     return _inner[index - _num_constants - _num_leaves];
   }
 
-  inline auto node_to_index( node const& n ) const { return _node_to_index.at( n ); }
+  inline uint32_t node_to_index( node const& n ) const
+  {
+    return _arena ? _arena->at( Ntk::node_to_index( n ), _stamp ) : _node_to_index.at( n );
+  }
 
   void update_mffcs()
   {
@@ -243,22 +257,26 @@ private:
 
     for ( auto const& n : _leaves )
     {
-      _node_to_index.emplace( n, _node_to_index.size() );
+      add_index( n );
     }
     for ( auto const& n : _inner )
     {
-      _node_to_index.emplace( n, _node_to_index.size() );
+      add_index( n );
     }
 
-    _inner.push_back( _root );
-    _node_to_index.emplace( _root, _node_to_index.size() );
+    /* a constant or PI root is not a gate of the view, but it is already indexed */
+    if ( !Ntk::is_constant( _root ) && !Ntk::is_pi( _root ) )
+    {
+      _inner.push_back( _root );
+    }
+    add_index( _root );
 
     /* sort topologically */
     _topo.clear();
     _colors.clear();
     const auto _size = _num_constants + _inner.size() + _leaves.size();
     _colors.resize( _size, 0 );
-    std::for_each( _leaves.begin(), _leaves.end(), [&]( auto& l ) { _colors[_node_to_index[l]] = 2u; } );
+    std::for_each( _leaves.begin(), _leaves.end(), [&]( auto& l ) { _colors[node_to_index( l )] = 2u; } );
     for ( auto i = 0u; i < _num_constants; ++i ) { _colors[i] = 2u; }
     topo_sort_rec( _root );
 
@@ -266,9 +284,25 @@ private:
     _inner = _topo;
   }
 
+  inline void add_index( node const& n )
+  {
+    if ( _arena )
+    {
+      /* keep the first index of a node that is added twice, as the hash map does */
+      if ( !_arena->has( Ntk::node_to_index( n ), _stamp ) )
+      {
+        _arena->insert( Ntk::node_to_index( n ), _num_indexes++ );
+      }
+    }
+    else if ( _node_to_index.emplace( n, _num_indexes ).second )
+    {
+      ++_num_indexes;
+    }
+  }
+
   void topo_sort_rec( node const& n )
   {
-    const auto idx = _node_to_index[n];
+    const auto idx = node_to_index( n );
 
     /* is permanently marked? */
     if ( _colors[idx] == 2u )
@@ -296,10 +330,16 @@ public:
   node _root;
   bool _empty{true};
   uint32_t _limit{100};
+  window_index_arena* _arena{nullptr};
+  uint32_t _stamp{0};
+  uint32_t _num_indexes{0};
 };
 
 template<class T>
 mffc_view(T const&, typename T::node const&) -> mffc_view<T>;
 
+template<class T>
+mffc_view(T const&, typename T::node const&, window_index_arena*) -> mffc_view<T>;
+
 
 } /* namespace mockturtle */
\ No newline at end of file
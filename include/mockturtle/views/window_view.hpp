@@ -34,6 +34,7 @@
 
 #include "../traits.hpp"
 #include "../networks/detail/foreach.hpp"
+#include "../utils/window_index_arena.hpp"
 #include "../utils/window_utils.hpp"
 #include "immutable_view.hpp"
 
@@ -72,6 +73,11 @@ namespace mockturtle
          on all fanout nodes of the node that belong to the window
  *   3.) `foreach_exnteral_fanout`: takes a node and invokes a predicate
          on all fanouts of the node that do not belong to the window
+ *
+ * Optionally, a `window_index_arena` can be passed to store the
+ * mapping from nodes to window indexes.  This avoids building a hash
+ * map for each view, when many windows are constructed one after
+ * another.
  */
 template<typename Ntk>
 class window_view : public immutable_view<Ntk>
@@ -83,17 +89,19 @@ public:
 
 public:
   template<typename _Ntk = Ntk, typename = std::enable_if_t<!std::is_same_v<typename _Ntk::signal, typename _Ntk::node>>>
-  explicit window_view( Ntk const& ntk, std::vector<node> const& inputs, std::vector<signal> const& outputs, std::vector<node> const& gates )
+  explicit window_view( Ntk const& ntk, std::vector<node> const& inputs, std::vector<signal> const& outputs, std::vector<node> const& gates, window_index_arena* arena = nullptr )
     : immutable_view<Ntk>( ntk )
     , _inputs( inputs )
     , _outputs( outputs )
+    , _arena( arena )
   {
     construct( inputs, gates );
   }
 
-  explicit window_view( Ntk const& ntk, std::vector<node> const& inputs, std::vector<node> const& outputs, std::vector<node> const& gates )
+  explicit window_view( Ntk const& ntk, std::vector<node> const& inputs, std::vector<node> const& outputs, std::vector<node> const& gates, window_index_arena* arena = nullptr )
     : immutable_view<Ntk>( ntk )
     , _inputs( inputs )
+    , _arena( arena )
   {
     construct( inputs, gates );
 
@@ -108,12 +116,16 @@ public:
   template<typename _Ntk = Ntk, typename = std::enable_if_t<!std::is_same_v<typename _Ntk::signal, typename _Ntk::node>>>
   inline bool belongs_to( signal const& s ) const
   {
-    return std::find( std::begin( _nodes ), std::end( _nodes ), get_node( s ) ) != std::end( _nodes );
+    return belongs_to( this->get_node( s ) );
   }
 
   inline bool belongs_to( node const& n ) const
   {
-    return std::find( std::begin( _nodes ), std::end( _nodes ), n ) != std::end( _nodes );
+    if ( _arena )
+    {
+      return _arena->has( Ntk::node_to_index( n ), _stamp );
+    }
+    return _node_to_index.find( n ) != _node_to_index.end();
   }
 #pragma endregion
 
@@ -162,7 +174,7 @@ public:
 
   inline uint32_t node_to_index( node const& n ) const
   {
-    return _node_to_index.at( n );
+    return _arena ? _arena->at( Ntk::node_to_index( n ), _stamp ) : _node_to_index.at( n );
   }
 
   inline node index_to_node( uint32_t index ) const
@@ -172,7 +184,13 @@ public:
 
   inline bool is_pi( node const& n ) const
   {
-    return std::find( std::begin( _inputs ), std::end( _inputs ), n ) != std::end( _inputs );
+    /* inputs are stored right after the constant */
+    if ( !belongs_to( n ) )
+    {
+      return false;
+    }
+    auto const index = node_to_index( n );
+    return index > 0u && index <= _inputs.size();
   }
 
   inline bool is_ci( node const& n ) const
@@ -251,14 +269,13 @@ public:
   void foreach_fanin( node const& n, Fn&& fn ) const
   {
     /* constants and inputs do not have fanins */
-    if ( this->is_constant( n ) ||
-         std::find( std::begin( _inputs ), std::end( _inputs ), n ) != std::end( _inputs ) )
+    if ( this->is_constant( n ) || is_pi( n ) )
     {
       return;
     }
 
     /* if it's not a window input, the node has to be a window node */
-    assert( std::find( std::begin( _nodes ) + 1 + _inputs.size(), std::end( _nodes ), n ) != std::end( _nodes ) );
+    assert( belongs_to( n ) );
     immutable_view<Ntk>::foreach_fanin( n, fn );
   }
 
@@ -266,7 +283,7 @@ public:
   void foreach_internal_fanout( node const& n, Fn&& fn ) const
   {
     this->foreach_fanout( n, [&]( node const& fo ){
-      if ( tbelongs_to( fo ) )
+      if ( belongs_to( fo ) )
       {
         fn( fo );
       }
@@ -298,9 +315,21 @@ protected:
     std::copy( std::begin( gates ), std::end( gates ), std::back_inserter( _nodes ) );
 
     /* create a mapping from node id (index in the original network) to window index */
-    for ( uint32_t index = 0; index < _nodes.size(); ++index )
+    if ( _arena )
     {
-      _node_to_index[_nodes.at( index )] = index;
+      _stamp = _arena->new_window();
+      _arena->reserve( Ntk::size() );
+      for ( uint32_t index = 0; index < _nodes.size(); ++index )
+      {
+        _arena->insert( Ntk::node_to_index( _nodes[index] ), index );
+      }
+    }
+    else
+    {
+      for ( uint32_t index = 0; index < _nodes.size(); ++index )
+      {
+        _node_to_index[_nodes.at( index )] = index;
+      }
     }
   }
 
@@ -309,6 +338,8 @@ protected:
   std::vector<signal> _outputs;
   std::vector<node> _nodes;
   std::unordered_map<node, uint32_t> _node_to_index;
+  window_index_arena* _arena{nullptr};
+  uint32_t _stamp{0};
 }; /* window_view */
 
 } /* namespace mockturtle */
\ No newline at end of file
@@ -58,9 +58,9 @@ namespace abc::exorcism {
 ////////////////////////////////////////////////////////////////////////
 
 // information about the cube cover
-cinfo g_CoverInfo;
+thread_local cinfo g_CoverInfo;
 
-extern int s_fDecreaseLiterals;
+extern thread_local int s_fDecreaseLiterals;
 
 ////////////////////////////////////////////////////////////////////////
 ///                       EXTERNAL FUNCTIONS                         ///
@@ -54,7 +54,7 @@ namespace abc::exorcism {
 // the number of cubes is constantly updated when the cube cover is processed
 // in this module, only the number of variables (nVarsIn) and integers (nWordsIn)
 // is used, which do not change
-extern cinfo g_CoverInfo;
+extern thread_local cinfo g_CoverInfo;
 
 ////////////////////////////////////////////////////////////////////////
 ///                  FUNCTIONS OF THIS MODULE                        ///
@@ -141,8 +141,8 @@ static unsigned char GroupLiterals[163][4] = {
 #define FULL16BITS  0x10000
 #define MARKNUMBER  200
 
-static unsigned char BitGroupNumbers[FULL16BITS];
-unsigned char BitCount[FULL16BITS];
+static thread_local unsigned char BitGroupNumbers[FULL16BITS];
+thread_local unsigned char BitCount[FULL16BITS];
 
 ////////////////////////////////////////////////////////////////////////
 ///                      FUNCTION DEFINITIONS                        ///
@@ -213,10 +213,10 @@ void ExorVar( Cube * pC, int Var, varvalue Val )
 ///                      FUNCTION DEFINITIONS                        ///
 ////////////////////////////////////////////////////////////////////////
 
-static int DiffVarCounter, cVars;
-static drow Temp1, Temp2, Temp;
-static drow LastNonZeroWord;
-static int LastNonZeroWordNum;
+static thread_local int DiffVarCounter, cVars;
+static thread_local drow Temp1, Temp2, Temp;
+static thread_local drow LastNonZeroWord;
+static thread_local int LastNonZeroWordNum;
 
 int GetDistance( Cube * pC1, Cube * pC2 )
 // finds and returns the distance between two cubes pC1 and pC2
@@ -245,10 +245,10 @@ int GetDistance( Cube * pC1, Cube * pC2 )
 }
 
 // place to put the number of the different variable and its value in the second cube
-extern int s_DiffVarNum;
-extern int s_DiffVarValueP_old;
-extern int s_DiffVarValueP_new;
-extern int s_DiffVarValueQ;
+extern thread_local int s_DiffVarNum;
+extern thread_local int s_DiffVarValueP_old;
+extern thread_local int s_DiffVarValueP_new;
+extern thread_local int s_DiffVarValueQ;
 
 int GetDistancePlus( Cube * pC1, Cube * pC2 )
 // finds and returns the distance between two cubes pC1 and pC2
@@ -80,14 +80,14 @@ void ExorLinkCubeIteratorCleanUp( int fTakeLastGroup );
 ////////////////////////////////////////////////////////////////////////
 
 // information about the cube cover before
-extern cinfo g_CoverInfo;
+extern thread_local cinfo g_CoverInfo;
 // new IDs are assigned only when it is known that the cubes are useful
 // this is done in ExorLinkCubeIteratorCleanUp();
 
 // the head of the list of free cubes
-extern Cube* g_CubesFree;
+extern thread_local Cube* g_CubesFree;
 
-extern byte BitCount[];
+extern thread_local byte BitCount[];
 
 ////////////////////////////////////////////////////////////////////////
 ///                         EXORLINK INFO                            ///
@@ -310,60 +310,60 @@ static drow s_BitMasks[32] =
 ////////////////////////////////////////////////////////////////////////
 
 // this flag is TRUE as long as the storage is allocated
-static int fWorking;
+static thread_local int fWorking;
 
 // set these flags to have minimum literal groups generated first
-static int fMinLitGroupsFirst[4] = { 0 /*dist2*/, 0 /*dist3*/, 0 /*dist4*/};
+static thread_local int fMinLitGroupsFirst[4] = { 0 /*dist2*/, 0 /*dist3*/, 0 /*dist4*/};
 
-static int nDist;
-static int nCubes;
-static int nCubesInGroup;
-static int nGroups;
-static Cube *pCA, *pCB;
+static thread_local int nDist;
+static thread_local int nCubes;
+static thread_local int nCubesInGroup;
+static thread_local int nGroups;
+static thread_local Cube *pCA, *pCB;
 
 // storage for variable numbers that are different in the cubes
-static int DiffVars[5];
-static int* pDiffVars;
-static int nDifferentVars;
+static thread_local int DiffVars[5];
+static thread_local int* pDiffVars;
+static thread_local int nDifferentVars;
 
 // storage for the bits and words of different input variables
-static int nDiffVarsIn;
-static int DiffVarWords[5];
-static int DiffVarBits[5];
+static thread_local int nDiffVarsIn;
+static thread_local int DiffVarWords[5];
+static thread_local int DiffVarBits[5];
 
 // literal mask used to count the number of literals in the cubes
-static drow MaskLiterals;
+static thread_local drow MaskLiterals;
 // the base for counting literals
-static int StartingLiterals;
+static thread_local int StartingLiterals;
 // the number of literals in each cube
-static int CubeLiterals[32];
-static int BitShift;
-static int DiffVarValues[4][3];
-static int Value;
+static thread_local int CubeLiterals[32];
+static thread_local int BitShift;
+static thread_local int DiffVarValues[4][3];
+static thread_local int Value;
 
 // the sorted array of groups in the increasing order of costs
-static int GroupCosts[32];
-static int GroupCostBest;
-static int GroupCostBestNum;
+static thread_local int GroupCosts[32];
+static thread_local int GroupCostBest;
+static thread_local int GroupCostBestNum;
 
-static int CubeNum;
-static int NewZ;
-static drow Temp;
+static thread_local int CubeNum;
+static thread_local int NewZ;
+static thread_local drow Temp;
 
 // the cubes currently created
-static Cube* ELCubes[32];
+static thread_local Cube* ELCubes[32];
 
 // the bit string with 1's corresponding to cubes in ELCubes[] 
 // that constitute the last group
-static drow LastGroup;
+static thread_local drow LastGroup;
 
-static int  GroupOrder[24];
-static drow VisitedGroups;
-static int  nVisitedGroups;
+static thread_local int  GroupOrder[24];
+static thread_local drow VisitedGroups;
+static thread_local int  nVisitedGroups;
 
 //int RemainderBits = (nVars*2)%(sizeof(drow)*8);
 //int TotalWords    = (nVars*2)/(sizeof(drow)*8) + (RemainderBits > 0);
-static drow DammyBitData[(MAXVARS*2)/(sizeof(drow)*8)+(MAXVARS*2)%(sizeof(drow)*8)];
+static thread_local drow DammyBitData[(MAXVARS*2)/(sizeof(drow)*8)+(MAXVARS*2)%(sizeof(drow)*8)];
 
 ////////////////////////////////////////////////////////////////////////
 ///                       FUNCTION DEFINTIONS                        ///
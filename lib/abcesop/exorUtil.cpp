@@ -51,7 +51,7 @@ namespace abc::exorcism {
 ////////////////////////////////////////////////////////////////////////
 
 // information about the options, the function, and the cover
-extern cinfo g_CoverInfo;
+extern thread_local cinfo g_CoverInfo;
 
 ////////////////////////////////////////////////////////////////////////
 ///                        EXTERNAL FUNCTIONS                        ///
@@ -1,7 +1,10 @@
 #include <catch.hpp>
 
+#include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/algorithms/circuit_validator.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/dmig.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/views/fanout_view.hpp>
@@ -59,6 +62,26 @@ TEST_CASE( "Validating EQ nodes in MIG", "[validator]" )
   CHECK( *( v.validate( mig.get_node( f2 ), !f4 ) ) == true );
 }
 
+TEST_CASE( "Validating EQ and NEQ nodes in D-MIG", "[validator]" )
+{
+  dmig_network dmig;
+  auto const a = dmig.create_pi();
+  auto const b = dmig.create_pi();
+  auto const c = dmig.create_pi();
+
+  auto const f1 = dmig.create_maj( a, !b, c );
+  auto const f2 = dmig.create_or( dmig.create_and( a, !b ), dmig.create_and( c, dmig.create_or( a, !b ) ) );
+  auto const f3 = dmig.create_and( a, c );
+
+  circuit_validator v( dmig );
+
+  CHECK( *( v.validate( f1, f2 ) ) == true );
+  CHECK( *( v.validate( f1, f3 ) ) == false );
+  CHECK( v.cex.size() == 3u );
+  CHECK( v.cex[0] != v.cex[2] );
+  CHECK( v.cex[1] == false );
+}
+
 TEST_CASE( "Validating with non-existing circuit", "[validator]" )
 {
   /* original circuit */
@@ -182,4 +205,125 @@ TEST_CASE( "Validating with ODC", "[validator]" )
   ps.odc_levels = 2;
   CHECK( *( v.validate( f1, false ) ) == true );
   CHECK( *( v.validate( aig.get_node( f1 ), aig.get_constant( false ) ) ) == true );
-}
\ No newline at end of file
+}
+template<bill::solvers Solver>
+void test_validator_recycling()
+{
+  /* pseudo-random network with 8 inputs */
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.emplace_back( aig.create_pi() );
+  }
+  uint32_t seed = 1u;
+  auto const rand = [&]() {
+    seed = seed * 1103515245u + 12345u;
+    return ( seed >> 8 ) % fs.size();
+  };
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    auto const a = fs[rand()];
+    auto const b = fs[rand()];
+    fs.emplace_back( i % 3 == 0 ? aig.create_xor( a, !b ) : aig.create_and( a, ( i & 1 ) ? b : !b ) );
+  }
+
+  auto const tts = simulate_nodes<kitty::dynamic_truth_table>( aig, default_simulator<kitty::dynamic_truth_table>( 8u ) );
+
+  validator_params ps;
+  ps.max_clauses = 100u;
+  ps.recycle_solver = true;
+  circuit_validator<aig_network, Solver> v( aig, ps );
+
+  for ( auto i = 0u; i < 300u; ++i )
+  {
+    auto const n1 = aig.get_node( fs[8u + rand() % 200u] );
+    auto const n2 = aig.get_node( fs[8u + rand() % 200u] );
+    auto const res = v.validate( n1, aig.make_signal( n2 ) );
+    REQUIRE( res );
+    CHECK( *res == ( tts[n1] == tts[n2] ) );
+    if ( !*res )
+    {
+      /* the counter-example distinguishes the nodes */
+      uint32_t minterm{0};
+      for ( auto j = 0u; j < 8u; ++j )
+      {
+        minterm |= v.cex[j] ? ( 1u << j ) : 0u;
+      }
+      CHECK( kitty::get_bit( tts[n1], minterm ) != kitty::get_bit( tts[n2], minterm ) );
+    }
+  }
+
+  auto const& st = v.stats();
+  CHECK( st.num_recycles > 0u );
+  CHECK( st.num_collected > 0u );
+  CHECK( st.num_encoded >= st.num_reencoded );
+}
+
+TEST_CASE( "Validating with solver recycling", "[validator]" )
+{
+  test_validator_recycling<bill::solvers::glucose_41>();
+  test_validator_recycling<bill::solvers::bsat2>();
+}
+
+template<bill::solvers Solver>
+void test_validator_cnf_cuts( bool recycle_solver )
+{
+  /* pseudo-random network with 8 inputs */
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.emplace_back( aig.create_pi() );
+  }
+  uint32_t seed = 3u;
+  auto const rand = [&]() {
+    seed = seed * 1103515245u + 12345u;
+    return ( seed >> 8 ) % fs.size();
+  };
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    auto const a = fs[rand()];
+    auto const b = fs[rand()];
+    fs.emplace_back( i % 3 == 0 ? aig.create_xor( a, !b ) : aig.create_and( a, ( i & 1 ) ? b : !b ) );
+  }
+
+  auto const tts = simulate_nodes<kitty::dynamic_truth_table>( aig, default_simulator<kitty::dynamic_truth_table>( 8u ) );
+
+  validator_params ps;
+  ps.max_clauses = 100u;
+  ps.recycle_solver = recycle_solver;
+  ps.cnf_cut_size = 6u;
+  circuit_validator<aig_network, Solver> v( aig, ps );
+
+  for ( auto i = 0u; i < 300u; ++i )
+  {
+    auto const n1 = aig.get_node( fs[8u + rand() % 200u] );
+    auto const n2 = aig.get_node( fs[8u + rand() % 200u] );
+    auto const res = v.validate( n1, aig.make_signal( n2 ) );
+    REQUIRE( res );
+    CHECK( *res == ( tts[n1] == tts[n2] ) );
+    if ( !*res )
+    {
+      uint32_t minterm{0};
+      for ( auto j = 0u; j < 8u; ++j )
+      {
+        minterm |= v.cex[j] ? ( 1u << j ) : 0u;
+      }
+      CHECK( kitty::get_bit( tts[n1], minterm ) != kitty::get_bit( tts[n2], minterm ) );
+    }
+
+    auto const res_const = v.validate( n1, false );
+    REQUIRE( res_const );
+    CHECK( *res_const == kitty::is_const0( tts[n1] ) );
+  }
+
+  CHECK( v.stats().num_absorbed > 0u );
+}
+
+TEST_CASE( "Validating with CNF cuts", "[validator]" )
+{
+  test_validator_cnf_cuts<bill::solvers::glucose_41>( false );
+  test_validator_cnf_cuts<bill::solvers::glucose_41>( true );
+  test_validator_cnf_cuts<bill::solvers::bsat2>( false );
+}
@@ -1,4 +1,5 @@
 #include <catch.hpp>
+#include <optional>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -224,3 +225,171 @@ TEST_CASE( "cleanup LUT network with nested constant propagation", "[cleanup]" )
     CHECK( ( i == 0 ? ntk.get_constant( false ) : a ) == f );
   });
 }
+
+template<class Ntk>
+void test_cleanup_inplace_network( bool substitute_by_later_node )
+{
+  Ntk ntk;
+  const auto create_gate = [&]( auto const& a, auto const& b, auto const& c, uint32_t i ) {
+    if constexpr ( has_create_xor3_v<Ntk> )
+    {
+      return i % 4u == 0u ? ntk.create_xor3( a, b, c ) : ntk.create_maj( a, b, c );
+    }
+    else if constexpr ( has_create_maj_v<Ntk> )
+    {
+      (void)i;
+      return ntk.create_maj( a, b, c );
+    }
+    else
+    {
+      (void)c;
+      return i % 4u == 0u ? ntk.create_xor( a, b ) : ntk.create_and( a, b );
+    }
+  };
+
+  std::vector<signal<Ntk>> fs;
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+  for ( auto i = 0u; i < 60u; ++i )
+  {
+    const auto a = fs[( 7u * i + 3u ) % fs.size()];
+    const auto b = fs[( 5u * i + 1u ) % fs.size()] ^ ( i % 3u == 0u );
+    const auto c = fs[( 11u * i ) % fs.size()] ^ ( i % 2u == 0u );
+    fs.push_back( create_gate( a, b, c, i ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    ntk.create_po( fs[fs.size() - 1u - 5u * i] ^ ( i % 2u == 0u ) );
+  }
+
+  /* dead nodes in the middle of the network */
+  ntk.substitute_node( ntk.get_node( fs[45] ), !fs[20] );
+  if ( substitute_by_later_node )
+  {
+    /* node indices are no longer a topological order */
+    const auto g = create_gate( create_gate( fs[0], !fs[1], fs[2], 1u ), !fs[3], !fs[4], 2u );
+    CHECK( ntk.get_node( g ) > ntk.get_node( fs.back() ) );
+    std::optional<node<Ntk>> fanin;
+    ntk.foreach_fanin( ntk.get_node( fs.back() ), [&]( auto const& f ) {
+      if ( !ntk.is_pi( ntk.get_node( f ) ) )
+      {
+        fanin = ntk.get_node( f );
+      }
+    } );
+    REQUIRE( fanin );
+    ntk.substitute_node( *fanin, g );
+    ntk.substitute_node( ntk.get_node( fs[30] ), fs[10] );
+  }
+  else
+  {
+    ntk.substitute_node( ntk.get_node( fs[30] ), fs[10] );
+  }
+
+  const auto ref = cleanup_dangling( ntk );
+  const auto old_size = ntk.size();
+  const auto old_to_new = cleanup_dangling_inplace( ntk );
+
+  CHECK( old_to_new.size() == old_size );
+  CHECK( ntk.size() < old_size );
+  CHECK( ntk.size() == ref.size() );
+  CHECK( ntk.num_gates() == ref.num_gates() );
+  CHECK( ntk.num_pis() == 6u );
+  CHECK( ntk.num_pos() == 8u );
+  CHECK( simulate<kitty::static_truth_table<6u>>( ntk ) == simulate<kitty::static_truth_table<6u>>( ref ) );
+
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( ntk.fanout_size( n ) > 0u );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( ntk.get_node( f ) < n );
+    } );
+  } );
+
+  if ( substitute_by_later_node )
+  {
+    /* same nodes in the same order as in the copied network */
+    ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( ref.is_pi( n ) == ntk.is_pi( n ) );
+      CHECK( ref.fanout_size( n ) == ntk.fanout_size( n ) );
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+      {
+        return;
+      }
+      CHECK( ntk.node_function( n ) == ref.node_function( n ) );
+      ntk.foreach_fanin( n, [&]( auto const& f, uint32_t i ) {
+        ref.foreach_fanin( n, [&]( auto const& g, uint32_t j ) {
+          if ( i == j )
+          {
+            CHECK( f == g );
+          }
+        } );
+      } );
+    } );
+    ntk.foreach_po( [&]( auto const& f, auto i ) {
+      CHECK( f == ref.po_at( i ) );
+    } );
+  }
+  else
+  {
+    /* kept nodes keep their order */
+    for ( auto i = 1u, last = 0u; i < old_to_new.size(); ++i )
+    {
+      if ( old_to_new[i] != 0u )
+      {
+        CHECK( old_to_new[i] > last );
+        last = old_to_new[i];
+      }
+    }
+  }
+
+  /* the hash table is rebuilt */
+  if constexpr ( !is_out_of_core_v<Ntk> )
+  {
+    const auto size = ntk.size();
+    ntk.foreach_gate( [&]( auto const& n ) {
+      std::vector<signal<Ntk>> children;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( f );
+      } );
+      CHECK( ntk.get_node( ntk.clone_node( ntk, n, children ) ) == n );
+    } );
+    CHECK( ntk.size() == size );
+  }
+}
+
+TEST_CASE( "cleanup networks in place", "[cleanup]" )
+{
+  test_cleanup_inplace_network<aig_network>( false );
+  test_cleanup_inplace_network<aig_network>( true );
+  test_cleanup_inplace_network<xag_network>( false );
+  test_cleanup_inplace_network<xag_network>( true );
+  test_cleanup_inplace_network<mig_network>( false );
+  test_cleanup_inplace_network<mig_network>( true );
+  test_cleanup_inplace_network<xmg_network>( false );
+  test_cleanup_inplace_network<xmg_network>( true );
+  test_cleanup_inplace_network<mapped_aig_network>( false );
+  test_cleanup_inplace_network<mapped_aig_network>( true );
+}
+
+TEST_CASE( "cleanup network in place returns node mapping", "[cleanup]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( b, c ); /* dangling */
+  const auto f3 = aig.create_and( f1, c );
+  const auto f4 = aig.create_or( a, f3 );
+  aig.create_po( f4 );
+  aig.create_po( f3 );
+
+  const auto old_to_new = cleanup_dangling_inplace( aig );
+  CHECK( aig.size() == 7u );
+  CHECK( old_to_new == std::vector<aig_network::node>{0u, 1u, 2u, 3u, 4u, 0u, 5u, 6u} );
+  CHECK( aig.fanout_size( aig.get_node( f1 ) ) == 1u );
+  CHECK( aig.fanout_size( 5u ) == 2u );
+  (void)f2;
+}
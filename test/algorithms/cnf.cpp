@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/cnf.hpp>
+#include <mockturtle/networks/dmig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/utils/include/percy.hpp>
@@ -67,6 +68,41 @@ TEST_CASE( "Translate k-LUT network into CNF", "[cnf]" )
   CHECK( ( ( solver.var_value( 1u ) == solver.var_value( 2u ) ) && ( solver.var_value( 2u ) == solver.var_value( 3u ) ) ) ); /* input values are the same */
 }
 
+TEST_CASE( "Translate D-MIG into CNF", "[cnf]" )
+{
+  dmig_network dmig;
+
+  const auto a = dmig.create_pi();
+  const auto b = dmig.create_pi();
+  const auto c = dmig.create_pi();
+  dmig.create_po( dmig.create_dmaj( a, !b, c ) );
+
+  /* constant unit clause and 6 majority clauses */
+  std::vector<std::vector<uint32_t>> clauses;
+  const auto output = generate_cnf( dmig, [&]( auto const& clause ) {
+    clauses.push_back( clause );
+  } )[0];
+  CHECK( clauses.size() == 7u );
+
+  /* the output is true iff at least two of a, !b, c are true */
+  for ( auto m = 0u; m < 8u; ++m )
+  {
+    percy::bsat_wrapper solver;
+    for ( auto const& clause : clauses )
+    {
+      solver.add_clause( clause );
+    }
+    std::vector<int> assumptions{static_cast<int>( output )};
+    for ( auto i = 0u; i < 3u; ++i )
+    {
+      assumptions.push_back( static_cast<int>( 2 * ( i + 1 ) + ( ( m >> i ) & 1 ? 0 : 1 ) ) );
+    }
+    const auto res = solver.solve( assumptions.data(), assumptions.data() + assumptions.size(), 0 );
+    const auto num_ones = ( m & 1 ) + ( ( ~m >> 1 ) & 1 ) + ( ( m >> 2 ) & 1 );
+    CHECK( ( res == percy::synth_result::success ) == ( num_ones >= 2u ) );
+  }
+}
+
 TEST_CASE( "Use CNF generation for CEC on XAG", "[cnf]" )
 {
   xag_network xag1, xag2;
@@ -0,0 +1,120 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <mockturtle/algorithms/cnf.hpp>
+#include <mockturtle/algorithms/cnf_map.hpp>
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+Ntk make_assoc_miter( uint32_t bitwidth, bool buggy = false )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> as( bitwidth ), bs( bitwidth ), cs( bitwidth );
+  std::generate( as.begin(), as.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( cs.begin(), cs.end(), [&]() { return ntk.create_pi(); } );
+
+  auto o1 = carry_ripple_multiplier( ntk, carry_ripple_multiplier( ntk, as, bs ), cs );
+  auto o2 = carry_ripple_multiplier( ntk, as, carry_ripple_multiplier( ntk, bs, cs ) );
+  if ( buggy )
+  {
+    o2[1] = ntk.create_xor( o2[1], ntk.create_and( as[0], cs[bitwidth - 1] ) );
+  }
+  std::vector<typename Ntk::signal> xors( o1.size() );
+  std::transform( o1.begin(), o1.end(), o2.begin(), xors.begin(), [&]( auto const& a, auto const& b ) { return ntk.create_xor( a, b ); } );
+  ntk.create_po( ntk.create_nary_or( xors ) );
+  return ntk;
+}
+
+} // namespace
+
+TEST_CASE( "CNF mapping of an AIG", "[cnf_map]" )
+{
+  const auto aig = make_assoc_miter<aig_network>( 3u );
+
+  mapping_view<aig_network, true> mapped{aig};
+  cnf_map_stats st;
+  cnf_map( mapped, {}, &st );
+
+  CHECK( mapped.has_mapping() );
+  CHECK( st.num_cells == mapped.num_cells() );
+  CHECK( st.num_vars == 1u + aig.num_pis() + st.num_cells );
+
+  /* the mapped CNF is smaller than the CNF with one encoding per gate */
+  uint32_t num_gate_clauses{0};
+  generate_cnf( aig, [&]( auto const& ) { ++num_gate_clauses; } );
+
+  std::vector<std::vector<uint32_t>> clauses;
+  const auto node_lits = mapped_node_literals( mapped );
+  const auto outputs = generate_mapped_cnf( mapped, [&]( auto const& clause ) { clauses.push_back( clause ); } );
+  CHECK( clauses.size() == st.num_clauses );
+  CHECK( clauses.size() < num_gate_clauses );
+  REQUIRE( outputs.size() == 1u );
+
+  /* the simulated values of the cell roots satisfy all clauses */
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  const auto tts = simulate_nodes<kitty::dynamic_truth_table>( aig, sim );
+  std::vector<kitty::dynamic_truth_table> var_values( st.num_vars, kitty::dynamic_truth_table( aig.num_pis() ) );
+  aig.foreach_pi( [&]( auto const& n ) {
+    var_values[node_lits[n] / 2] = tts[n];
+  } );
+  aig.foreach_gate( [&]( auto const& n ) {
+    if ( mapped.is_cell_root( n ) )
+    {
+      var_values[node_lits[n] / 2] = tts[n];
+    }
+  } );
+  for ( auto const& clause : clauses )
+  {
+    auto sat = var_values[0].construct();
+    for ( auto const& lit : clause )
+    {
+      sat |= ( lit & 1 ) ? ~var_values[lit / 2] : var_values[lit / 2];
+    }
+    CHECK( kitty::is_const0( ~sat ) );
+  }
+}
+
+TEST_CASE( "Equivalence checking with CNF mapping", "[cnf_map]" )
+{
+  equivalence_checking_params ps;
+  ps.use_cnf_map = true;
+
+  const auto xag = make_assoc_miter<xag_network>( 3u );
+  equivalence_checking_stats st_tseytin, st_cnf_map;
+  const auto result1 = equivalence_checking( xag, {}, &st_tseytin );
+  const auto result2 = equivalence_checking( xag, ps, &st_cnf_map );
+  REQUIRE( result1 );
+  REQUIRE( result2 );
+  CHECK( *result1 );
+  CHECK( *result2 );
+  CHECK( st_cnf_map.num_vars < st_tseytin.num_vars );
+  CHECK( st_cnf_map.num_clauses < st_tseytin.num_clauses );
+
+  /* counter-example for non-equivalent miter */
+  const auto buggy = make_assoc_miter<aig_network>( 3u, true );
+  equivalence_checking_stats st;
+  const auto result3 = equivalence_checking( buggy, ps, &st );
+  REQUIRE( result3 );
+  CHECK( !*result3 );
+  REQUIRE( st.counter_example.size() == buggy.num_pis() );
+
+  default_simulator<bool> sim( st.counter_example );
+  CHECK( simulate<bool>( buggy, sim )[0] );
+}
@@ -1,7 +1,12 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <mockturtle/algorithms/collapse_mapped.hpp>
 #include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/traits.hpp>
@@ -209,3 +214,27 @@ TEST_CASE( "Mapped AIG with constant-1 output", "[collapse_mapped]" )
     CHECK( klut->get_node( f ) == 1 );
   } );
 }
+
+TEST_CASE( "Mapped AIG into k-LUT network with inline fanins", "[collapse_mapped]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  mapping_view<aig_network, true> mapped_aig{aig};
+  lut_mapping<mapping_view<aig_network, true>, true>( mapped_aig );
+
+  const auto klut = *collapse_mapped_network<klut_network>( mapped_aig );
+  const auto klut_inline = *collapse_mapped_network<inline_klut_network<6>>( mapped_aig );
+
+  CHECK( klut_inline.num_gates() == klut.num_gates() );
+  CHECK( klut_inline.num_pos() == klut.num_pos() );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( klut_inline, sim ) == simulate<kitty::dynamic_truth_table>( aig, sim ) );
+}
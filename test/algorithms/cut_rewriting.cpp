@@ -1,6 +1,9 @@
 #include <catch.hpp>
 
+#include <kitty/static_truth_table.hpp>
+
 #include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/algorithms/node_resynthesis/akers.hpp>
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
@@ -461,3 +464,81 @@ TEST_CASE( "Cut rewriting with stacked depth-fanout views", "[cut_rewriting]" )
   CHECK( aig.num_pos() == 2 );
   CHECK( aig.num_gates() == 8 );
 }
+
+TEST_CASE( "Cut rewriting with parallel exact LUT synthesis", "[cut_rewriting]" )
+{
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  const auto d = klut.create_pi();
+  const auto e = klut.create_pi();
+
+  klut.create_po( klut.create_and( a, klut.create_and( b, klut.create_and( c, klut.create_and( d, e ) ) ) ) );
+  klut.create_po( klut.create_xor( a, klut.create_xor( b, klut.create_xor( c, d ) ) ) );
+
+  exact_resynthesis_params ps;
+  ps.num_threads = 4u;
+  exact_resynthesis_stats st;
+  exact_resynthesis resyn( 3u, ps, &st );
+  klut = cut_rewriting( klut, resyn );
+
+  CHECK( klut.num_pis() == 5u );
+  CHECK( klut.num_pos() == 2u );
+  CHECK( klut.num_gates() == 4u );
+
+  /* all functions have been synthesized before rewriting */
+  CHECK( st.num_prefetched > 0u );
+  CHECK( st.num_synthesis == st.num_prefetched );
+}
+
+TEST_CASE( "In-place cut rewriting with partitioned compatibility graph", "[cut_rewriting]" )
+{
+  mig_network mig;
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+  const auto d = mig.create_pi();
+
+  /* several bad MAJ implementations */
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    const auto x = i % 2u ? d : c;
+    const auto f = mig.create_maj( a, mig.create_maj( a, b, x ), x );
+    mig.create_po( mig.create_maj( f, b, mig.create_not( a ) ) );
+  }
+  const auto size_before = mig.num_gates();
+
+  mig_npn_resynthesis resyn;
+
+  cut_rewriting_params ps;
+  ps.cut_enumeration_ps.cut_size = 4;
+  ps.mis_partition_size = 2u;
+  ps.mis_num_threads = 2u;
+  cut_rewriting_stats st;
+  cut_rewriting_with_compatibility_graph( mig, resyn, ps, &st );
+  mig = cleanup_dangling( mig );
+
+  CHECK( st.num_mis_partitions > 1u );
+  CHECK( mig.num_gates() < size_before );
+
+  /* compare with global compatibility graph */
+  mig_network mig2;
+  const auto a2 = mig2.create_pi();
+  const auto b2 = mig2.create_pi();
+  const auto c2 = mig2.create_pi();
+  const auto d2 = mig2.create_pi();
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    const auto x = i % 2u ? d2 : c2;
+    const auto f = mig2.create_maj( a2, mig2.create_maj( a2, b2, x ), x );
+    mig2.create_po( mig2.create_maj( f, b2, mig2.create_not( a2 ) ) );
+  }
+  ps.mis_partition_size = 0u;
+  cut_rewriting_with_compatibility_graph( mig2, resyn, ps );
+  mig2 = cleanup_dangling( mig2 );
+
+  default_simulator<kitty::static_truth_table<4u>> sim;
+  CHECK( simulate<kitty::static_truth_table<4u>>( mig, sim ) == simulate<kitty::static_truth_table<4u>>( mig2, sim ) );
+  CHECK( mig.num_gates() >= mig2.num_gates() );
+}
@@ -1,5 +1,12 @@
 #include <catch.hpp>
 
+#include <memory>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
 #include <mockturtle/algorithms/exorcism.hpp>
 
 using namespace mockturtle;
@@ -20,3 +27,74 @@ TEST_CASE( "Call exorcism on 4-input function", "[exorcism]" )
     CHECK( func == func2 );
   }
 }
+
+TEST_CASE( "Call exorcism on many functions", "[exorcism]" )
+{
+  std::vector<kitty::dynamic_truth_table> functions;
+  for ( auto num_vars = 0u; num_vars <= 7u; ++num_vars )
+  {
+    kitty::dynamic_truth_table func( num_vars );
+    for ( auto i = 0u; i < 30u; ++i )
+    {
+      kitty::create_random( func );
+      functions.push_back( func );
+
+      /* functions in the same NPN class */
+      auto g = ~func;
+      if ( num_vars > 1u )
+      {
+        kitty::swap_inplace( g, 0u, num_vars - 1u );
+        kitty::flip_inplace( g, 1u );
+      }
+      functions.push_back( g );
+    }
+    functions.push_back( func.construct() );
+    functions.push_back( ~func.construct() );
+  }
+
+  for ( auto npn : {false, true} )
+  {
+    exorcism_params ps;
+    ps.npn_deduplication = npn;
+    ps.num_threads = 4u;
+    exorcism_stats st;
+    const auto esops = exorcism( functions, ps, &st );
+
+    REQUIRE( esops.size() == functions.size() );
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      auto func = functions[i].construct();
+      kitty::create_from_cubes( func, esops[i], true );
+      CHECK( func == functions[i] );
+    }
+    CHECK( st.num_functions == functions.size() );
+    CHECK( st.num_minimized == st.num_classes );
+    if ( npn )
+    {
+      CHECK( st.num_classes < functions.size() / 2u + 8u );
+    }
+  }
+}
+
+TEST_CASE( "Share exorcism cache between calls", "[exorcism]" )
+{
+  std::vector<kitty::dynamic_truth_table> functions( 20u, kitty::dynamic_truth_table( 5u ) );
+  for ( auto& func : functions )
+  {
+    kitty::create_random( func );
+  }
+
+  exorcism_params ps;
+  ps.npn_deduplication = false;
+  ps.cache = std::make_shared<exorcism_cache_t>();
+  exorcism_stats st;
+
+  const auto esops1 = exorcism( functions, ps, &st );
+  CHECK( st.num_cache_hits == 0u );
+  CHECK( ps.cache->size() == st.num_classes );
+
+  const auto esops2 = exorcism( functions, ps, &st );
+  CHECK( st.num_cache_hits == st.num_classes );
+  CHECK( st.num_minimized == 0u );
+  CHECK( esops1 == esops2 );
+}
@@ -0,0 +1,225 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/incremental_lut_mapping.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+using mapped_aig_t = mapping_view<fanout_view<aig_network>, true>;
+
+aig_network make_multiplier( uint32_t bitwidth )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+  return aig;
+}
+
+/* every referenced node is a cell root, no other cells exist, and the mapped
+ * network implements the same functions */
+bool is_consistent( aig_network const& aig, mapped_aig_t const& mapped )
+{
+  std::vector<uint8_t> visited( aig.size(), 0u );
+  std::vector<aig_network::node> stack;
+  aig.foreach_po( [&]( auto const& f ) {
+    stack.push_back( aig.get_node( f ) );
+  } );
+
+  uint32_t num_cells{0u};
+  bool consistent{true};
+  while ( !stack.empty() )
+  {
+    const auto n = stack.back();
+    stack.pop_back();
+    if ( visited[n] || aig.is_constant( n ) || aig.is_pi( n ) )
+    {
+      continue;
+    }
+    visited[n] = 1u;
+
+    if ( aig.is_dead( n ) || !mapped.is_cell_root( n ) )
+    {
+      consistent = false;
+      continue;
+    }
+    ++num_cells;
+    mapped.foreach_cell_fanin( n, [&]( auto const& leaf ) {
+      stack.push_back( leaf );
+    } );
+  }
+
+  if ( !consistent || num_cells != mapped.num_cells() )
+  {
+    return false;
+  }
+
+  const auto klut = collapse_mapped_network<klut_network>( mapped );
+  if ( !klut )
+  {
+    return false;
+  }
+
+  /* nodes are not in topological order after substitutions */
+  topo_view topo{aig};
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  return simulate<kitty::dynamic_truth_table>( topo, sim ) == simulate<kitty::dynamic_truth_table>( *klut, sim );
+}
+
+/* replaces a random gate by the AND of two random nodes outside of its
+ * transitive fanout */
+void random_change( aig_network& aig, fanout_view<aig_network> const& fanout, std::mt19937& rng )
+{
+  std::vector<aig_network::node> gates, nodes;
+  aig.foreach_node( [&]( auto const& n ) {
+    if ( aig.is_constant( n ) )
+      return;
+    nodes.push_back( n );
+    if ( !aig.is_pi( n ) )
+      gates.push_back( n );
+  } );
+
+  const auto n = gates[rng() % gates.size()];
+
+  std::vector<uint8_t> in_tfo( aig.size(), 0u );
+  std::vector<aig_network::node> stack{n};
+  while ( !stack.empty() )
+  {
+    const auto m = stack.back();
+    stack.pop_back();
+    if ( in_tfo[m] )
+      continue;
+    in_tfo[m] = 1u;
+    fanout.foreach_fanout( m, [&]( auto const& fo ) { stack.push_back( fo ); } );
+  }
+
+  std::vector<aig_network::signal> divisors;
+  for ( auto const& m : nodes )
+  {
+    if ( !in_tfo[m] )
+      divisors.push_back( aig.make_signal( m ) ^ ( rng() % 2 == 0 ) );
+  }
+
+  const auto f = aig.create_and( divisors[rng() % divisors.size()], divisors[rng() % divisors.size()] );
+  if ( aig.get_node( f ) != n )
+  {
+    aig.substitute_node( n, f );
+  }
+}
+
+} // namespace
+
+TEST_CASE( "Incremental LUT mapping without changes", "[incremental_lut_mapping]" )
+{
+  auto aig = make_multiplier( 4u );
+  fanout_view aig_fanout{aig};
+  mapped_aig_t mapped{aig_fanout};
+
+  lut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = 4u;
+  incremental_lut_mapping<mapped_aig_t, true> mapper( mapped, ps );
+
+  mapping_view<aig_network, true> reference{aig};
+  lut_mapping<decltype( reference ), true>( reference, ps );
+
+  CHECK( mapped.num_cells() == reference.num_cells() );
+  CHECK( is_consistent( aig, mapped ) );
+
+  mapper.update();
+  CHECK( mapped.num_cells() == reference.num_cells() );
+  CHECK( mapper.stats().num_recomputed_cuts == 0u );
+  CHECK( mapper.stats().num_remapped == 0u );
+}
+
+TEST_CASE( "Incremental LUT mapping after local changes", "[incremental_lut_mapping]" )
+{
+  auto aig = make_multiplier( 5u );
+  fanout_view aig_fanout{aig};
+  mapped_aig_t mapped{aig_fanout};
+
+  lut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = 4u;
+  incremental_lut_mapping<mapped_aig_t, true> mapper( mapped, ps );
+
+  std::mt19937 rng( 42u );
+  for ( auto i = 0u; i < 40u; ++i )
+  {
+    /* single changes and batches of changes */
+    const auto num_changes = i % 4u == 3u ? 3u : 1u;
+    for ( auto j = 0u; j < num_changes; ++j )
+    {
+      random_change( aig, aig_fanout, rng );
+    }
+    mapper.update();
+    CHECK( is_consistent( aig, mapped ) );
+  }
+  CHECK( mapper.stats().num_updates == 40u );
+  CHECK( mapper.stats().num_recomputed_cuts > 0u );
+  CHECK( mapper.stats().num_remapped > 0u );
+
+  /* the incremental mapping is close to a complete mapping (of a copy in topological order) */
+  const auto copy = cleanup_dangling( aig );
+  mapping_view<aig_network, true> reference{copy};
+  lut_mapping<decltype( reference ), true>( reference, ps );
+  CHECK( mapped.num_cells() <= reference.num_cells() + reference.num_cells() / 10u + 2u );
+}
+
+TEST_CASE( "Incremental LUT mapping with changed outputs", "[incremental_lut_mapping]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_or( f2, d );
+  aig.create_po( f3 );
+  aig.create_po( f1 );
+
+  fanout_view aig_fanout{aig};
+  mapped_aig_t mapped{aig_fanout};
+
+  lut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = 2u;
+  incremental_lut_mapping<mapped_aig_t, true> mapper( mapped, ps );
+  CHECK( is_consistent( aig, mapped ) );
+
+  /* an output is driven by a new node */
+  aig.substitute_node( aig.get_node( f3 ), aig.create_xor( f2, d ) );
+  mapper.update();
+  CHECK( is_consistent( aig, mapped ) );
+
+  /* an output is driven by a primary input, the cells of its cone are removed */
+  aig.substitute_node( aig.get_node( f1 ), a );
+  mapper.update();
+  CHECK( is_consistent( aig, mapped ) );
+
+  /* an output is driven by a constant */
+  aig.substitute_node( aig.get_node( aig.po_at( 0 ) ), aig.get_constant( true ) );
+  mapper.update();
+  CHECK( is_consistent( aig, mapped ) );
+  CHECK( mapped.num_cells() == 0u );
+}
@@ -1,5 +1,10 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
 #include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/algorithms/linear_resynthesis.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
@@ -168,3 +173,116 @@ TEST_CASE( "Example from SEA'10 Boyar-Peralta paper; cancellation-free", "[linea
   CHECK( get_linear_matrix( xag ) == matrix );
   CHECK( xag.num_gates() == 5u );
 }
+
+TEST_CASE( "Linear resynthesis with Paar algorithm on random matrices", "[linear_resynthesis]" )
+{
+  std::mt19937 rng( 42u );
+  for ( auto const& [num_inputs, num_outputs] : std::vector<std::pair<uint32_t, uint32_t>>{{8u, 8u}, {32u, 20u}, {70u, 130u}} )
+  {
+    std::vector<std::vector<bool>> matrix( num_outputs, std::vector<bool>( num_inputs ) );
+    for ( auto& row : matrix )
+    {
+      std::generate( row.begin(), row.end(), [&]() { return rng() % 2u == 0u; } );
+    }
+
+    xag_network xag;
+    std::vector<xag_network::signal> xs( num_inputs );
+    std::generate( xs.begin(), xs.end(), [&]() { return xag.create_pi(); } );
+    for ( auto const& row : matrix )
+    {
+      std::vector<xag_network::signal> fanins;
+      for ( auto i = 0u; i < num_inputs; ++i )
+      {
+        if ( row[i] )
+        {
+          fanins.push_back( xs[i] );
+        }
+      }
+      xag.create_po( xag.create_nary_xor( fanins ) );
+    }
+    CHECK( get_linear_matrix( xag ) == matrix );
+
+    const auto xag2 = linear_resynthesis_paar( xag );
+    CHECK( get_linear_matrix( xag2 ) == matrix );
+    CHECK( xag2.num_gates() < xag.num_gates() );
+  }
+}
+
+TEST_CASE( "Linear resynthesis with Boyar-Peralta heuristic (example from SEA'10 paper)", "[linear_resynthesis]" )
+{
+  std::vector<std::vector<bool>> matrix = {
+    {true, true, false, false},
+    {true, true, true, false},
+    {true, true, true, true},
+    {false, true, true, true}
+  };
+
+  xag_network xag;
+  std::vector<xag_network::signal> xs( 4u );
+  std::generate( xs.begin(), xs.end(), [&]() { return xag.create_pi(); } );
+  xag.create_po( xag.create_nary_xor( {xs[0], xs[1]} ) );
+  xag.create_po( xag.create_nary_xor( {xs[0], xs[1], xs[2]} ) );
+  xag.create_po( !xag.create_nary_xor( {xs[0], xs[1], xs[2], xs[3]} ) );
+  xag.create_po( xag.create_nary_xor( {xs[1], xs[2], xs[3]} ) );
+
+  /* the last output cancels x0 */
+  linear_resynthesis_boyar_peralta_stats st;
+  const auto xag2 = linear_resynthesis_boyar_peralta( xag, {}, &st );
+  CHECK( get_linear_matrix( xag2 ) == matrix );
+  CHECK( simulate<kitty::static_truth_table<4u>>( xag ) == simulate<kitty::static_truth_table<4u>>( xag2 ) );
+  CHECK( xag2.num_gates() == 4u );
+  CHECK( st.num_xors == 4u );
+
+  /* cancellation-free solution if the last output must not use x0 */
+  linear_resynthesis_boyar_peralta_params ps;
+  ps.ignore_inputs = {{}, {}, {}, {0u}};
+  const auto xag3 = linear_resynthesis_boyar_peralta( xag, ps );
+  CHECK( get_linear_matrix( xag3 ) == matrix );
+  CHECK( xag3.num_gates() == 5u );
+}
+
+TEST_CASE( "Linear resynthesis with Boyar-Peralta heuristic on random matrices", "[linear_resynthesis]" )
+{
+  std::mt19937 rng( 7u );
+  for ( auto const& [num_inputs, num_outputs] : std::vector<std::pair<uint32_t, uint32_t>>{{8u, 8u}, {32u, 20u}, {70u, 130u}} )
+  {
+    std::vector<std::vector<bool>> matrix( num_outputs, std::vector<bool>( num_inputs ) );
+    for ( auto& row : matrix )
+    {
+      std::generate( row.begin(), row.end(), [&]() { return rng() % 3u == 0u; } );
+    }
+
+    xag_network xag;
+    std::vector<xag_network::signal> xs( num_inputs );
+    std::generate( xs.begin(), xs.end(), [&]() { return xag.create_pi(); } );
+    for ( auto const& row : matrix )
+    {
+      std::vector<xag_network::signal> fanins;
+      for ( auto i = 0u; i < num_inputs; ++i )
+      {
+        if ( row[i] )
+        {
+          fanins.push_back( xs[i] );
+        }
+      }
+      xag.create_po( xag.create_nary_xor( fanins ) );
+    }
+
+    linear_resynthesis_boyar_peralta_params ps;
+    ps.num_restarts = 4u;
+    ps.num_threads = 2u;
+    linear_resynthesis_boyar_peralta_stats st;
+    const auto xag2 = linear_resynthesis_boyar_peralta( xag, ps, &st );
+    CHECK( get_linear_matrix( xag2 ) == matrix );
+    CHECK( xag2.num_gates() <= st.num_xors );
+    CHECK( st.best_restart < 4u );
+
+    /* the first run is deterministic */
+    ps.num_restarts = 1u;
+    linear_resynthesis_boyar_peralta_stats st1;
+    const auto xag3 = linear_resynthesis_boyar_peralta( xag, ps, &st1 );
+    CHECK( get_linear_matrix( xag3 ) == matrix );
+    CHECK( st.num_xors <= st1.num_xors );
+    CHECK( st1.num_xors < xag.num_gates() );
+  }
+}
@@ -1,11 +1,24 @@
 #include <catch.hpp>
 
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <nlohmann/json.hpp>
 
 #include <mockturtle/algorithms/node_resynthesis/cached.hpp>
+#include <mockturtle/algorithms/node_resynthesis/composed.hpp>
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/json_utils.hpp>
+#include <mockturtle/utils/network_cache.hpp>
 
 using namespace mockturtle;
 
@@ -49,4 +62,338 @@ TEST_CASE( "Exact XAG for MAJ cached", "[cached]" )
   CHECK( fs::exists( "mockturtle-test-cache.db" ) );
   CHECK( !fs::exists( "mockturtle-test-cache.db.bak" ) );
   fs::remove( "mockturtle-test-cache.db" );
+  fs::remove( "mockturtle-test-cache.db.lock" );
+}
+
+namespace
+{
+
+/* counts the calls to the wrapped resynthesis function */
+template<class Ntk, class ResynthesisFn>
+struct counting_resynthesis
+{
+  template<typename LeavesIterator, typename Fn>
+  void operator()( Ntk& ntk, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
+  {
+    ++( *calls );
+    resyn( ntk, function, begin, end, fn );
+  }
+
+  ResynthesisFn resyn;
+  std::shared_ptr<std::atomic<uint32_t>> calls = std::make_shared<std::atomic<uint32_t>>( 0u );
+};
+
+/* counts calls and accepts existing functions, which it does not use */
+template<class Ntk, class ResynthesisFn>
+struct counting_functions_resynthesis : counting_resynthesis<Ntk, ResynthesisFn>
+{
+  void clear_functions()
+  {
+  }
+
+  void add_function( signal<Ntk> const&, kitty::dynamic_truth_table const& )
+  {
+  }
+};
+
+/* never returns a result */
+template<class Ntk>
+struct failing_resynthesis
+{
+  template<typename LeavesIterator, typename Fn>
+  void operator()( Ntk&, kitty::dynamic_truth_table const&, LeavesIterator, LeavesIterator, Fn&& ) const
+  {
+    ++( *calls );
+  }
+
+  std::shared_ptr<uint32_t> calls = std::make_shared<uint32_t>( 0u );
+};
+
+} // namespace
+
+TEST_CASE( "Reload cached resynthesis from binary file", "[cached]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  const std::string filename = "mockturtle-test-cache-reload.db";
+  fs::remove( filename );
+
+  std::vector<kitty::dynamic_truth_table> functions( 3u, kitty::dynamic_truth_table( 3u ) );
+  kitty::create_from_hex_string( functions[0], "e8" );
+  kitty::create_from_hex_string( functions[1], "96" );
+  kitty::create_from_hex_string( functions[2], "17" );
+
+  using resyn_t = counting_resynthesis<xag_network, exact_aig_resynthesis<xag_network>>;
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    resyn_t counting{exact_aig_resynthesis<xag_network>( true )};
+    cached_resynthesis<xag_network, resyn_t> resyn( counting, 4u, filename );
+
+    xag_network xag;
+    std::vector<xag_network::signal> pis( 3u );
+    std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+    for ( auto const& f : functions )
+    {
+      resyn( xag, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+        xag.create_po( s );
+      } );
+    }
+
+    CHECK( *counting.calls == ( run == 0u ? 3u : 0u ) );
+    CHECK( xag.num_pos() == 3u );
+    default_simulator<kitty::dynamic_truth_table> sim( 3u );
+    const auto tts = simulate<kitty::dynamic_truth_table>( xag, sim );
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      CHECK( tts[i] == functions[i] );
+    }
+  }
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "Share binary cache file between caches with different numbers of PIs", "[cached]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  const std::string filename = "mockturtle-test-cache-shared.db";
+  fs::remove( filename );
+
+  std::vector<kitty::dynamic_truth_table> functions( 3u, kitty::dynamic_truth_table( 3u ) );
+  kitty::create_from_hex_string( functions[0], "e8" );
+  kitty::create_from_hex_string( functions[1], "96" );
+  kitty::create_from_hex_string( functions[2], "17" );
+  kitty::dynamic_truth_table existing( 3u );
+  kitty::create_from_hex_string( existing, "88" );
+
+  /* entries with existing functions depend on the number of PIs and are
+   * skipped by the other cache, but must not be removed when it saves */
+  using resyn_t = counting_functions_resynthesis<xag_network, exact_aig_resynthesis<xag_network>>;
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    for ( auto max_pis : {3u, 4u} )
+    {
+      resyn_t counting{{exact_aig_resynthesis<xag_network>( true )}};
+      cached_resynthesis<xag_network, resyn_t> resyn( counting, max_pis, filename );
+
+      xag_network xag;
+      std::vector<xag_network::signal> pis( 3u );
+      std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+      resyn.add_function( xag.create_and( pis[0], pis[1] ), existing );
+      for ( auto const& f : functions )
+      {
+        resyn( xag, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+          xag.create_po( s );
+        } );
+      }
+
+      CHECK( *counting.calls == ( run == 0u ? 3u : 0u ) );
+      CHECK( xag.num_pos() == 3u );
+      default_simulator<kitty::dynamic_truth_table> sim( 3u );
+      const auto tts = simulate<kitty::dynamic_truth_table>( xag, sim );
+      for ( auto i = 0u; i < functions.size(); ++i )
+      {
+        CHECK( tts[i] == functions[i] );
+      }
+    }
+  }
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "Import JSON cache file of a previous version", "[cached]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  const std::string filename = "mockturtle-test-cache-json.db";
+  fs::remove( filename );
+  fs::remove( filename + ".json.bak" );
+
+  using key_t = std::pair<kitty::dynamic_truth_table, std::vector<kitty::dynamic_truth_table>>;
+  struct key_hash
+  {
+    std::size_t operator()( key_t const& key ) const
+    {
+      return kitty::hash<kitty::dynamic_truth_table>()( key.first );
+    }
+  };
+
+  kitty::dynamic_truth_table maj( 3u ), parity( 3u );
+  kitty::create_majority( maj );
+  kitty::create_parity( parity );
+
+  /* cache file as written by previous versions */
+  {
+    network_cache<xag_network, key_t, key_hash> cache( 4u );
+    xag_network entry;
+    const auto a = entry.create_pi();
+    const auto b = entry.create_pi();
+    const auto c = entry.create_pi();
+    entry.create_po( entry.create_maj( a, b, c ) );
+    cache.insert( {maj, {}}, entry );
+
+    std::ofstream os( filename );
+    os << nlohmann::json{{"cache", cache.to_json()},
+                         {"blacklist_cache", std::vector<std::pair<kitty::dynamic_truth_table, exact_blacklist_cache_info>>{{parity, {100}}}},
+                         {"initial_size", 4u}}
+              .dump()
+       << "\n";
+  }
+
+  using resyn_t = counting_resynthesis<xag_network, exact_aig_resynthesis<xag_network>>;
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    resyn_t counting{exact_aig_resynthesis<xag_network>( true )};
+    cached_resynthesis<xag_network, resyn_t, exact_blacklist_cache_info> resyn( counting, 4u, filename, {100} );
+
+    xag_network xag;
+    std::vector<xag_network::signal> pis( 3u );
+    std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+    for ( auto const& f : {maj, parity} )
+    {
+      resyn( xag, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+        xag.create_po( s );
+      } );
+    }
+
+    /* the entry and the blacklisted function are imported, the JSON file is converted once */
+    CHECK( *counting.calls == 0u );
+    CHECK( xag.num_pos() == 1u );
+    default_simulator<kitty::dynamic_truth_table> sim( 3u );
+    CHECK( simulate<kitty::dynamic_truth_table>( xag, sim )[0] == maj );
+    CHECK( fs::exists( filename + ".json.bak" ) );
+  }
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+  fs::remove( filename + ".json.bak" );
+}
+
+TEST_CASE( "Cached k-LUT resynthesis with blacklist", "[cached]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  const std::string filename = "mockturtle-test-cache-blacklist.db";
+  fs::remove( filename );
+
+  kitty::dynamic_truth_table maj( 5u );
+  kitty::create_majority( maj );
+
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    failing_resynthesis<klut_network> failing;
+    cached_resynthesis<klut_network, failing_resynthesis<klut_network>> resyn( failing, 5u, filename );
+
+    klut_network klut;
+    std::vector<klut_network::signal> pis( 5u );
+    std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+    resyn( klut, maj, pis.begin(), pis.end(), [&]( auto const& s ) {
+      klut.create_po( s );
+    } );
+    resyn( klut, maj, pis.begin(), pis.end(), [&]( auto const& s ) {
+      klut.create_po( s );
+    } );
+
+    CHECK( klut.num_pos() == 0u );
+    CHECK( *failing.calls == ( run == 0u ? 1u : 0u ) );
+  }
+
+  /* k-LUT networks are stored with their LUT functions */
+  {
+    exact_resynthesis<klut_network> exact( 3u );
+    cached_resynthesis<klut_network, exact_resynthesis<klut_network>> resyn( exact, 5u, filename );
+    kitty::dynamic_truth_table f( 4u );
+    kitty::create_from_hex_string( f, "cafe" );
+
+    klut_network klut;
+    std::vector<klut_network::signal> pis( 4u );
+    std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+    resyn( klut, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+      klut.create_po( s );
+    } );
+  }
+  {
+    failing_resynthesis<klut_network> failing;
+    cached_resynthesis<klut_network, failing_resynthesis<klut_network>> resyn( failing, 5u, filename );
+    kitty::dynamic_truth_table f( 4u );
+    kitty::create_from_hex_string( f, "cafe" );
+
+    klut_network klut;
+    std::vector<klut_network::signal> pis( 4u );
+    std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+    resyn( klut, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+      klut.create_po( s );
+    } );
+
+    CHECK( *failing.calls == 0u );
+    CHECK( klut.num_pos() == 1u );
+    default_simulator<kitty::dynamic_truth_table> sim( 4u );
+    CHECK( simulate<kitty::dynamic_truth_table>( klut, sim )[0] == f );
+  }
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "Share cached resynthesis between threads", "[cached]" )
+{
+  std::vector<kitty::dynamic_truth_table> functions;
+  for ( auto word : {0xe8u, 0x96u, 0x17u, 0xcau, 0x80u, 0x7eu} )
+  {
+    kitty::dynamic_truth_table tt( 3u );
+    kitty::create_from_words( tt, &word, &word + 1 );
+    functions.push_back( tt );
+  }
+
+  using resyn_t = counting_resynthesis<xag_network, exact_aig_resynthesis<xag_network>>;
+  resyn_t counting{exact_aig_resynthesis<xag_network>( true )};
+  cached_resynthesis<xag_network, resyn_t> resyn( counting, 4u );
+
+  std::vector<xag_network> xags( 4u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < xags.size(); ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      auto& xag = xags[t];
+      std::vector<xag_network::signal> pis( 3u );
+      std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+      for ( auto i = 0u; i < functions.size(); ++i )
+      {
+        auto const& f = functions[( i + t ) % functions.size()];
+        resyn( xag, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+          xag.create_po( s );
+        } );
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  CHECK( *counting.calls == functions.size() );
+  for ( auto t = 0u; t < xags.size(); ++t )
+  {
+    CHECK( xags[t].num_pos() == functions.size() );
+    default_simulator<kitty::dynamic_truth_table> sim( 3u );
+    const auto tts = simulate<kitty::dynamic_truth_table>( xags[t], sim );
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      CHECK( tts[i] == functions[( i + t ) % functions.size()] );
+    }
+  }
 }
@@ -6,7 +6,9 @@
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/persistent_exact_cache.hpp>
 
 using namespace mockturtle;
 
@@ -170,3 +172,236 @@ TEST_CASE( "Exact XMG for XOR3", "[exact]" )
   CHECK( xmg.num_gates() == 1u );
   CHECK( simulate<kitty::dynamic_truth_table>( xmg, sim )[0] == _xor );
 }
+
+TEST_CASE( "Exact k-LUT resynthesis with persistent cache", "[exact]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  const std::string filename = "mockturtle-test-exact.cache";
+  fs::remove( filename );
+
+  /* two NPN-equivalent functions */
+  kitty::dynamic_truth_table f1( 4u ), f2( 4u );
+  kitty::create_from_hex_string( f1, "6996" );
+  kitty::create_from_hex_string( f2, "9669" );
+  kitty::dynamic_truth_table g( 4u );
+  kitty::create_from_hex_string( g, "cafe" );
+
+  const auto synthesize = [&]( exact_resynthesis_stats& st ) {
+    klut_network klut;
+    std::vector<klut_network::signal> pis( 4u );
+    std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+
+    exact_resynthesis_params ps;
+    ps.persistent_cache = std::make_shared<persistent_exact_cache>( filename );
+    exact_resynthesis<klut_network> resyn( 3u, ps, &st );
+    for ( auto const& f : {f1, f2, g} )
+    {
+      resyn( klut, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+        klut.create_po( s );
+      } );
+    }
+
+    default_simulator<kitty::dynamic_truth_table> sim( 4u );
+    CHECK( klut.num_pos() == 3u );
+    const auto tts = simulate<kitty::dynamic_truth_table>( klut, sim );
+    CHECK( tts[0] == f1 );
+    CHECK( tts[1] == f2 );
+    CHECK( tts[2] == g );
+  };
+
+  exact_resynthesis_stats st1;
+  synthesize( st1 );
+  CHECK( st1.num_synthesis == 2u );
+  CHECK( st1.persistent_hits == 1u );
+  CHECK( st1.persistent_misses == 2u );
+
+  /* second run reads results from file */
+  exact_resynthesis_stats st2;
+  synthesize( st2 );
+  CHECK( st2.num_synthesis == 0u );
+  CHECK( st2.persistent_hits == 3u );
+  CHECK( st2.persistent_misses == 0u );
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "Exact AIG resynthesis with persistent cache", "[exact]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  const std::string filename = "mockturtle-test-exact-aig.cache";
+  fs::remove( filename );
+
+  /* NPN-equivalent functions with different input and output complementations */
+  std::vector<kitty::dynamic_truth_table> functions( 4u, kitty::dynamic_truth_table( 3u ) );
+  kitty::create_from_hex_string( functions[0], "e8" );
+  kitty::create_from_hex_string( functions[1], "d4" );
+  kitty::create_from_hex_string( functions[2], "17" );
+  kitty::create_from_hex_string( functions[3], "80" );
+
+  exact_resynthesis_stats st;
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    aig_network aig;
+    std::vector<aig_network::signal> pis( 3u );
+    std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+
+    exact_resynthesis_params ps;
+    ps.persistent_cache = std::make_shared<persistent_exact_cache>( filename );
+    exact_aig_resynthesis<aig_network> resyn( false, ps, &st );
+    for ( auto const& f : functions )
+    {
+      resyn( aig, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+        aig.create_po( s );
+      } );
+    }
+
+    default_simulator<kitty::dynamic_truth_table> sim( 3u );
+    CHECK( aig.num_pos() == 4u );
+    const auto tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+    for ( auto i = 0u; i < functions.size(); ++i )
+    {
+      CHECK( tts[i] == functions[i] );
+    }
+  }
+
+  CHECK( st.num_synthesis == 2u );
+  CHECK( st.persistent_misses == 2u );
+  CHECK( st.persistent_hits == 6u );
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "Exact AIG resynthesis with bounds and persistent cache", "[exact]" )
+{
+#if __GNUC__ == 7
+  namespace fs = std::experimental::filesystem::v1;
+#else
+  namespace fs = std::filesystem;
+#endif
+  const std::string filename = "mockturtle-test-exact-bounds.cache";
+  fs::remove( filename );
+
+  kitty::dynamic_truth_table maj( 3u );
+  kitty::create_majority( maj );
+
+  /* a lower bound above the optimum (4 gates) yields a larger chain, which
+   * must not be returned for unbounded calls and vice versa */
+  exact_resynthesis_stats st;
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    for ( auto const bounded : {true, false, true} )
+    {
+      aig_network aig;
+      std::vector<aig_network::signal> pis( 3u );
+      std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+
+      exact_resynthesis_params ps;
+      ps.persistent_cache = std::make_shared<persistent_exact_cache>( filename );
+      exact_aig_resynthesis<aig_network> resyn( false, ps, &st );
+      if ( bounded )
+      {
+        resyn.set_bounds( 6u, std::nullopt );
+      }
+      resyn( aig, maj, pis.begin(), pis.end(), [&]( auto const& s ) {
+        aig.create_po( s );
+      } );
+
+      default_simulator<kitty::dynamic_truth_table> sim( 3u );
+      REQUIRE( aig.num_pos() == 1u );
+      CHECK( simulate<kitty::dynamic_truth_table>( aig, sim )[0] == maj );
+      if ( bounded )
+      {
+        CHECK( aig.num_gates() >= 5u );
+      }
+      else
+      {
+        CHECK( aig.num_gates() == 4u );
+      }
+    }
+  }
+
+  CHECK( st.num_synthesis == 2u );
+  CHECK( st.persistent_misses == 2u );
+  CHECK( st.persistent_hits == 4u );
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "Exact AIG resynthesis with parallel prefetch", "[exact]" )
+{
+  std::vector<kitty::dynamic_truth_table> functions( 4u, kitty::dynamic_truth_table( 3u ) );
+  kitty::create_from_hex_string( functions[0], "e8" );
+  kitty::create_from_hex_string( functions[1], "d4" );
+  kitty::create_from_hex_string( functions[2], "96" );
+  kitty::create_from_hex_string( functions[3], "ca" );
+
+  exact_resynthesis_params ps;
+  ps.num_threads = 4u;
+  ps.portfolio = {{percy::ENC_SSV, percy::SYNTH_STD}, {percy::ENC_SSV, percy::SYNTH_STD_CEGAR}};
+  exact_resynthesis_stats st;
+  exact_aig_resynthesis<aig_network> resyn( false, ps, &st );
+  resyn.prefetch( functions );
+
+  /* e8 and d4 are NPN-equivalent */
+  CHECK( st.num_prefetched == 3u );
+  CHECK( st.num_synthesis == 3u );
+
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 3u );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : functions )
+  {
+    resyn( aig, f, pis.begin(), pis.end(), [&]( auto const& s ) {
+      aig.create_po( s );
+    } );
+  }
+
+  CHECK( st.num_synthesis == 3u );
+  CHECK( aig.num_pos() == 4u );
+  default_simulator<kitty::dynamic_truth_table> sim( 3u );
+  const auto tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+  for ( auto i = 0u; i < functions.size(); ++i )
+  {
+    CHECK( tts[i] == functions[i] );
+  }
+}
+
+TEST_CASE( "Exact AIG resynthesis with prefetch timeout", "[exact]" )
+{
+  /* a 5-input function with a large optimum AIG */
+  kitty::dynamic_truth_table function( 5u );
+  kitty::create_from_hex_string( function, "17e8e817" );
+  kitty::dynamic_truth_table maj( 5u );
+  kitty::create_majority( maj );
+
+  exact_resynthesis_params ps;
+  ps.num_threads = 2u;
+  ps.timeout = 0.05;
+  exact_resynthesis_stats st;
+  exact_aig_resynthesis<aig_network> resyn( false, ps, &st );
+  resyn.prefetch( {function, maj} );
+
+  CHECK( st.num_prefetched == 2u );
+  CHECK( st.num_timeouts == 2u );
+
+  /* timed out functions are not resynthesized again */
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 5u );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+  resyn( aig, function, pis.begin(), pis.end(), [&]( auto const& s ) {
+    aig.create_po( s );
+  } );
+  CHECK( aig.num_pos() == 0u );
+  CHECK( st.num_synthesis == 2u );
+}
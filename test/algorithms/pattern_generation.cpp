@@ -3,6 +3,7 @@
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/algorithms/pattern_generation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 
@@ -119,3 +120,62 @@ TEST_CASE( "With observability awareness", "[pattern_generation]" )
   /* the generated pattern should be either 000, 010, or 101 */
   CHECK( ( ( !kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) || ( kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 1 ), 3 ) && kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) ) == true );
 }
+
+template<class Simulator>
+void check_threaded_pattern_generation( uint32_t num_threads, int odc_levels )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto const p = carry_ripple_multiplier( aig, a, b );
+  for ( auto const& f : p )
+  {
+    aig.create_po( f );
+  }
+
+  /* constant node */
+  auto const c = aig.create_and( aig.create_and( a[0], b[0] ), !aig.create_or( a[0], b[1] ) );
+  aig.create_po( aig.create_or( c, p[5] ) );
+  auto const num_gates = aig.num_gates();
+
+  Simulator sim( aig.num_pis(), 0 );
+  pattern_generation_params ps;
+  ps.substitute_const = odc_levels == 0; /* substitution leaves dangling nodes, which have no observable patterns */
+  ps.num_threads = num_threads;
+  ps.sync_interval = 16u;
+  ps.odc_levels = odc_levels;
+  pattern_generation_stats st;
+  pattern_generation( aig, sim, ps, &st );
+
+  CHECK( st.num_constant == 1u );
+  CHECK( ( aig.num_gates() < num_gates ) == ps.substitute_const );
+  CHECK( st.num_generated_patterns > 0u );
+  CHECK( st.coverage.size() >= num_gates / ps.sync_interval );
+  CHECK( std::is_sorted( st.coverage.begin(), st.coverage.end(), []( auto const& x, auto const& y ) { return x.num_checked < y.num_checked; } ) );
+  CHECK( st.coverage.back().num_patterns == st.num_generated_patterns );
+
+  if constexpr ( std::is_same_v<Simulator, partial_simulator> )
+  {
+    /* every non-constant gate takes both values */
+    CHECK( sim.num_bits() == st.num_generated_patterns );
+    auto const tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+    aig.foreach_gate( [&]( auto const& n ) {
+      if ( ps.substitute_const || n != aig.get_node( c ) )
+      {
+        CHECK( !kitty::is_const0( tts[n] ) );
+        CHECK( !kitty::is_const0( ~tts[n] ) );
+      }
+    } );
+  }
+}
+
+TEST_CASE( "Threaded stuck-at pattern generation", "[pattern_generation]" )
+{
+  check_threaded_pattern_generation<partial_simulator>( 1u, 0 );
+  check_threaded_pattern_generation<partial_simulator>( 2u, 0 );
+  check_threaded_pattern_generation<partial_simulator>( 4u, 0 );
+  check_threaded_pattern_generation<partial_simulator>( 3u, -1 );
+  check_threaded_pattern_generation<bit_packed_simulator>( 2u, 0 );
+  check_threaded_pattern_generation<bit_packed_simulator>( 2u, -1 );
+}
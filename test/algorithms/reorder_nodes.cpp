@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/reorder_nodes.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+using namespace mockturtle;
+
+/* creates independent chains alternately, such that the fanins of a gate are far from it */
+template<class Ntk>
+Ntk create_interleaved_chains()
+{
+  Ntk ntk;
+  std::vector<signal<Ntk>> pis, chains;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.push_back( ntk.create_pi() );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    chains.push_back( pis[i] );
+  }
+  for ( auto j = 0u; j < 20u; ++j )
+  {
+    for ( auto i = 0u; i < 8u; ++i )
+    {
+      const auto a = chains[i];
+      const auto b = pis[( i + j + 1u ) % 8u] ^ ( j % 2u == 0u );
+      if constexpr ( has_create_xor3_v<Ntk> )
+      {
+        chains[i] = j % 3u == 0u ? ntk.create_xor3( a, b, pis[( i + 2u * j + 3u ) % 8u] ) : ntk.create_maj( a, b, pis[( i + 2u * j + 3u ) % 8u] );
+      }
+      else if constexpr ( has_create_maj_v<Ntk> )
+      {
+        chains[i] = ntk.create_maj( a, b, !pis[( i + 2u * j + 3u ) % 8u] );
+      }
+      else
+      {
+        chains[i] = j % 3u == 0u ? ntk.create_xor( a, b ) : ntk.create_and( a, b );
+      }
+    }
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    ntk.create_po( chains[i] ^ ( i % 2u == 1u ) );
+  }
+  ntk.create_and( pis[0], pis[7] ); /* dangling */
+  return ntk;
+}
+
+template<class Ntk>
+void test_reorder_nodes()
+{
+  auto ntk = create_interleaved_chains<Ntk>();
+  const auto ref = cleanup_dangling( ntk );
+  const auto size = ntk.size();
+  const auto sim = simulate<kitty::static_truth_table<8u>>( ntk );
+
+  reorder_nodes_params ps;
+  ps.far_distance = 4u;
+  reorder_nodes_stats st;
+  const auto old_to_new = reorder_nodes( ntk, ps, &st );
+
+  CHECK( st.reordered );
+  CHECK( old_to_new.size() == size );
+  CHECK( st.far_fanins_before > 0.25 );
+  CHECK( st.far_fanins_after < st.far_fanins_before );
+  CHECK( ntk.size() == ref.size() );
+  CHECK( ntk.num_gates() == ref.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<8u>>( ntk ) == sim );
+
+  /* depth-first order as in the copied network */
+  ntk.foreach_gate( [&]( auto const& n ) {
+    ntk.foreach_fanin( n, [&]( auto const& f, uint32_t i ) {
+      ref.foreach_fanin( n, [&]( auto const& g, uint32_t j ) {
+        if ( i == j )
+        {
+          CHECK( f == g );
+        }
+      } );
+    } );
+  } );
+
+  /* not reordered again */
+  ps.min_far_fanins = st.far_fanins_before;
+  CHECK( reorder_nodes( ntk, ps, &st ).empty() );
+  CHECK( !st.reordered );
+}
+
+template<class Ntk>
+void test_reorder_nodes_by_level()
+{
+  auto ntk = create_interleaved_chains<Ntk>();
+  const auto sim = simulate<kitty::static_truth_table<8u>>( ntk );
+
+  reorder_nodes_params ps;
+  ps.order = reorder_nodes_params::level;
+  reorder_nodes( ntk, ps );
+
+  CHECK( simulate<kitty::static_truth_table<8u>>( ntk ) == sim );
+
+  depth_view depth_ntk{ntk};
+  uint32_t level{0u};
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( depth_ntk.level( n ) >= level );
+    level = depth_ntk.level( n );
+  } );
+  CHECK( level == depth_ntk.depth() );
+}
+
+TEST_CASE( "reorder nodes in depth-first order", "[reorder_nodes]" )
+{
+  test_reorder_nodes<aig_network>();
+  test_reorder_nodes<xag_network>();
+  test_reorder_nodes<mig_network>();
+  test_reorder_nodes<xmg_network>();
+}
+
+TEST_CASE( "reorder nodes by level", "[reorder_nodes]" )
+{
+  test_reorder_nodes_by_level<mig_network>();
+  test_reorder_nodes_by_level<xmg_network>();
+}
@@ -1,8 +1,18 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
 #include <mockturtle/algorithms/satlut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/views/mapping_view.hpp>
 
 using namespace mockturtle;
@@ -33,3 +43,88 @@ TEST_CASE( "SAT-LUT mapping of AIG", "[satlut_mapping]" )
 
   satlut_mapping( mapped_aig );
 }
+
+namespace
+{
+
+aig_network make_multiplier( uint32_t bitwidth )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+  return aig;
+}
+
+template<class Ntk>
+std::vector<kitty::dynamic_truth_table> mapped_functions( Ntk const& ntk )
+{
+  const auto klut = collapse_mapped_network<klut_network>( ntk );
+  REQUIRE( klut );
+  return simulate<kitty::dynamic_truth_table>( *klut, default_simulator<kitty::dynamic_truth_table>( ntk.num_pis() ) );
+}
+
+} // namespace
+
+TEST_CASE( "Windowed SAT-LUT mapping of AIG", "[satlut_mapping]" )
+{
+  const auto aig = make_multiplier( 6u );
+  const auto functions = simulate<kitty::dynamic_truth_table>( aig, default_simulator<kitty::dynamic_truth_table>( aig.num_pis() ) );
+
+  lut_mapping_params lps;
+  lps.cut_enumeration_ps.cut_size = 4u;
+
+  satlut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = 4u;
+
+  mapping_view<aig_network, true> sequential{aig};
+  lut_mapping<decltype( sequential ), true>( sequential, lps );
+  const auto cells_init = sequential.num_cells();
+
+  satlut_mapping_stats st_seq;
+  satlut_mapping<decltype( sequential ), true>( sequential, 16u, ps, &st_seq );
+  CHECK( sequential.num_cells() <= cells_init );
+  CHECK( st_seq.num_windows > 0u );
+  CHECK( st_seq.num_batches == 0u );
+  CHECK( mapped_functions( sequential ) == functions );
+
+  /* number of threads and windows per batch */
+  for ( auto const& [num_threads, batch_size] : std::vector<std::pair<uint32_t, uint32_t>>{{2u, 1u}, {3u, 0u}, {0u, 0u}} )
+  {
+    mapping_view<aig_network, true> parallel{aig};
+    lut_mapping<decltype( parallel ), true>( parallel, lps );
+
+    ps.num_threads = num_threads;
+    ps.batch_size = batch_size;
+    satlut_mapping_stats st_par;
+    satlut_mapping<decltype( parallel ), true>( parallel, 16u, ps, &st_par );
+    CHECK( parallel.num_cells() <= cells_init );
+    CHECK( st_par.num_windows > 0u );
+    CHECK( st_par.num_batches > 0u );
+    CHECK( st_par.num_improved_windows <= st_par.num_windows );
+    CHECK( mapped_functions( parallel ) == functions );
+  }
+}
+
+TEST_CASE( "Windowed SAT-LUT mapping with time limit", "[satlut_mapping]" )
+{
+  const auto aig = make_multiplier( 5u );
+  const auto functions = simulate<kitty::dynamic_truth_table>( aig, default_simulator<kitty::dynamic_truth_table>( aig.num_pis() ) );
+
+  mapping_view<aig_network, true> mapped{aig};
+  lut_mapping<decltype( mapped ), true>( mapped );
+  const auto cells_init = mapped.num_cells();
+
+  satlut_mapping_params ps;
+  ps.num_threads = 2u;
+  ps.window_timeout = 1e-6;
+  satlut_mapping_stats st;
+  satlut_mapping<decltype( mapped ), true>( mapped, 32u, ps, &st );
+  CHECK( mapped.num_cells() <= cells_init );
+  CHECK( st.num_timeouts <= st.num_windows );
+  CHECK( mapped_functions( mapped ) == functions );
+}
@@ -2,6 +2,7 @@
 
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/dmig.hpp>
 #include <mockturtle/networks/xag.hpp>
 
 #include <kitty/static_truth_table.hpp>
@@ -192,6 +193,49 @@ TEST_CASE( "Incremental simulation with partial_simulator", "[simulation]" )
   CHECK( ( aig.is_complemented( f5 ) ? ~node_to_value[f5] : node_to_value[f5] ) == kitty::partial_truth_table( 65 ) );
 }
 
+TEST_CASE( "Simulate D-MIG full adder with all simulators", "[simulation]" )
+{
+  dmig_network dmig;
+
+  const auto a = dmig.create_pi();
+  const auto b = dmig.create_pi();
+  const auto c = dmig.create_pi();
+  const auto carry = dmig.create_maj( a, !b, c );
+  const auto sum = dmig.create_xor3( a, !b, c );
+  dmig.create_po( carry );
+  dmig.create_po( !sum );
+
+  /* carry = maj( a, !b, c ), sum = xnor3( a, !b, c ) */
+  const auto tts = simulate<kitty::static_truth_table<3u>>( dmig );
+  CHECK( tts[0]._bits == 0xb2 );
+  CHECK( tts[1]._bits == 0x96 );
+
+  default_simulator<kitty::dynamic_truth_table> sim( 3 );
+  const auto dtts = simulate<kitty::dynamic_truth_table>( dmig, sim );
+  CHECK( dtts[0]._bits[0] == 0xb2 );
+  CHECK( dtts[1]._bits[0] == 0x96 );
+
+  CHECK( simulate<bool>( dmig, default_simulator<bool>( {true, false, false} ) ) == std::vector<bool>{true, true} );
+
+  std::vector<kitty::partial_truth_table> pats( 3 );
+  pats[0].add_bits( 0xaa, 8 );
+  pats[1].add_bits( 0xcc, 8 );
+  pats[2].add_bits( 0xf0, 8 );
+  partial_simulator psim( pats );
+
+  unordered_node_map<kitty::partial_truth_table, dmig_network> node_to_value( dmig );
+  simulate_nodes( dmig, node_to_value, psim );
+  CHECK( ( dmig.is_complemented( carry ) ? ~node_to_value[carry] : node_to_value[carry] )._bits[0] == 0xb2 );
+  CHECK( ( dmig.is_complemented( sum ) ? ~node_to_value[sum] : node_to_value[sum] )._bits[0] == 0x69 );
+
+  /* incremental re-simulation of the last block */
+  psim.add_pattern( {true, false, false} );
+  simulate_nodes( dmig, node_to_value, psim, false );
+  CHECK( psim.num_bits() == 9u );
+  CHECK( ( dmig.is_complemented( carry ) ? ~node_to_value[carry] : node_to_value[carry] )._bits[0] == 0x1b2 );
+  CHECK( ( dmig.is_complemented( sum ) ? ~node_to_value[sum] : node_to_value[sum] )._bits[0] == 0x069 );
+}
+
 TEST_CASE( "Bit packing", "[simulation]" )
 {
   std::vector<kitty::partial_truth_table> pats( 5 );
@@ -1,12 +1,14 @@
 #include <catch.hpp>
 
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/algorithms/xag_optimization.hpp>
 #include <mockturtle/io/verilog_reader.hpp>
 #include <lorina/verilog.hpp>
 
 #include <algorithm>
+#include <random>
 #include <vector>
 
 using namespace mockturtle;
@@ -34,6 +36,36 @@ TEST_CASE( "Edge cases for linear resynthesis", "[xag_optimization]" )
   }
 }
 
+TEST_CASE( "Heuristic linear resynthesis of XAGs", "[xag_optimization]" )
+{
+  std::mt19937 rng( 3u );
+  for ( auto k = 0u; k < 20u; ++k )
+  {
+    xag_network xag;
+    std::vector<xag_network::signal> fs( 6u );
+    std::generate( fs.begin(), fs.end(), [&]() { return xag.create_pi(); } );
+    for ( auto i = 0u; i < 40u; ++i )
+    {
+      const auto a = fs[rng() % fs.size()] ^ ( rng() % 2u == 0u );
+      const auto b = fs[rng() % fs.size()] ^ ( rng() % 2u == 0u );
+      fs.push_back( rng() % 4u == 0u ? xag.create_and( a, b ) : xag.create_xor( a, b ) );
+    }
+    xag.create_po( xag.create_nary_xor( {fs[fs.size() - 1u], fs[fs.size() - 2u], fs[fs.size() - 3u]} ) );
+    xag = cleanup_dangling( xag );
+
+    const auto tt = simulate<kitty::static_truth_table<6u>>( xag );
+
+    const auto opt_paar = paar_linear_resynthesis_optimization( xag );
+    CHECK( simulate<kitty::static_truth_table<6u>>( opt_paar ) == tt );
+
+    linear_resynthesis_boyar_peralta_params ps;
+    ps.num_restarts = 3u;
+    const auto opt_bp = boyar_peralta_linear_resynthesis_optimization( xag, ps );
+    CHECK( simulate<kitty::static_truth_table<6u>>( opt_bp ) == tt );
+    CHECK( *multiplicative_complexity( opt_bp ) == *multiplicative_complexity( xag ) );
+  }
+}
+
 TEST_CASE( "Test XAG constant fanin optimization", "[xag_optimization]" )
 {
   /* regression test that leads to a segmentation violation */
@@ -1,5 +1,9 @@
 #include <catch.hpp>
 
+#include <kitty/static_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/io/write_aiger.hpp>
 
@@ -97,3 +101,33 @@ TEST_CASE( "write AIG for XOR into AIGERfile", "[write_aiger]" )
            0x63 // comment
          } );
 }
+
+TEST_CASE( "write and read mapped AIG in AIGER format", "[write_aiger]" )
+{
+  mapped_aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  aig.create_po( aig.create_maj( a, !b, c ) );
+  aig.create_po( aig.create_xor( a, c ) );
+
+  seq_buffer<char> buffer;
+  std::ostream os( &buffer );
+  write_aiger( aig, os );
+  write_aiger( aig, "test_mapped.aig" );
+
+  aig_network ref;
+  CHECK( lorina::read_aiger( "test_mapped.aig", aiger_reader( ref ) ) == lorina::return_code::success );
+  CHECK( ref.num_gates() == aig.num_gates() );
+
+  seq_buffer<char> ref_buffer;
+  std::ostream ref_os( &ref_buffer );
+  write_aiger( ref, ref_os );
+  CHECK( buffer.data() == ref_buffer.data() );
+
+  mapped_aig_network copy;
+  CHECK( lorina::read_aiger( "test_mapped.aig", aiger_reader( copy ) ) == lorina::return_code::success );
+  CHECK( simulate<kitty::static_truth_table<3u>>( copy ) == simulate<kitty::static_truth_table<3u>>( aig ) );
+}
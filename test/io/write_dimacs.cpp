@@ -1,9 +1,21 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <sstream>
+#include <string>
+#include <vector>
 
+#include <mockturtle/algorithms/cut_enumeration/cnf_cut.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/io/write_dimacs.hpp>
+#include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/mapping_view.hpp>
 
 using namespace mockturtle;
 
@@ -40,3 +52,170 @@ TEST_CASE( "write XAG into DIMACS", "[write_dimacs]" )
                       "5 6 7 0\n"
                       "-7 0\n" );
 }
+
+namespace
+{
+
+std::vector<std::vector<int32_t>> read_clauses( std::string const& content, uint64_t& num_vars, uint64_t& num_clauses )
+{
+  std::istringstream in( content );
+  std::string p, cnf;
+  in >> p >> cnf >> num_vars >> num_clauses;
+
+  std::vector<std::vector<int32_t>> clauses( 1u );
+  int32_t lit;
+  while ( in >> lit )
+  {
+    if ( lit == 0 )
+    {
+      clauses.emplace_back();
+    }
+    else
+    {
+      clauses.back().push_back( lit );
+    }
+  }
+  clauses.pop_back();
+  return clauses;
+}
+
+std::string read_file( std::string const& filename )
+{
+  std::ifstream in( filename, std::ios::binary );
+  return std::string( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+}
+
+} // namespace
+
+TEST_CASE( "stream XAG into DIMACS file", "[write_dimacs]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return xag.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return xag.create_pi(); } );
+  auto const p = carry_ripple_multiplier( xag, a, b );
+  std::for_each( p.begin(), p.end(), [&]( auto const& f ) { xag.create_po( f ); } );
+
+  std::ostringstream out;
+  write_dimacs_stats st1;
+  write_dimacs( xag, out, {}, &st1 );
+
+  /* small buffer to test flushing */
+  write_dimacs_params ps;
+  ps.buffer_size = 300u;
+  write_dimacs_stats st2;
+  write_dimacs( xag, "mockturtle-test.cnf", ps, &st2 );
+  CHECK( st1.num_clauses == st2.num_clauses );
+  CHECK( st1.num_vars == st2.num_vars );
+
+  /* same clauses, header with padded fields */
+  uint64_t num_vars1, num_clauses1, num_vars2, num_clauses2;
+  auto const clauses1 = read_clauses( out.str(), num_vars1, num_clauses1 );
+  auto const content = read_file( "mockturtle-test.cnf" );
+  auto const clauses2 = read_clauses( content, num_vars2, num_clauses2 );
+  CHECK( num_vars1 == xag.size() );
+  CHECK( num_vars1 == num_vars2 );
+  CHECK( num_clauses1 == clauses1.size() );
+  CHECK( num_clauses2 == clauses2.size() );
+  CHECK( clauses1 == clauses2 );
+  CHECK( content.find( '\n' ) == 47u );
+  std::remove( "mockturtle-test.cnf" );
+}
+
+TEST_CASE( "report failures when writing DIMACS files", "[write_dimacs]" )
+{
+  xag_network xag;
+  auto const a = xag.create_pi();
+  auto const b = xag.create_pi();
+  xag.create_po( xag.create_xor( a, b ) );
+
+  for ( auto compress : {false, true} )
+  {
+    write_dimacs_params ps;
+    ps.compress = compress;
+    write_dimacs_stats st;
+    CHECK( !write_dimacs( xag, "mockturtle-no-such-directory/test.cnf", ps, &st ) );
+    CHECK( st.num_vars == 0u );
+    CHECK( st.num_clauses == 0u );
+  }
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+  /* the filename is not passed through a shell */
+  std::string const filename = "mockturtle-test-'quote $(false).cnf.gz";
+  write_dimacs_params ps;
+  ps.compress = true;
+  write_dimacs_stats st;
+  CHECK( write_dimacs( xag, filename, ps, &st ) );
+  CHECK( st.num_clauses > 0u );
+  auto const content = read_file( filename );
+  CHECK( content.size() > 2u );
+  CHECK( content.substr( 0u, 2u ) == "\x1f\x8b" );
+  std::remove( filename.c_str() );
+#endif
+}
+
+TEST_CASE( "write mapped AIG into DIMACS", "[write_dimacs]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 3u ), b( 3u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( !carry );
+
+  mapping_view<aig_network, true> mapped{aig};
+  lut_mapping_params lps;
+  lps.cut_enumeration_ps.cut_size = 4u;
+  lut_mapping<decltype( mapped ), true, cut_enumeration_cnf_cut>( mapped, lps );
+
+  write_dimacs_params ps;
+  ps.use_mapping = true;
+  std::ostringstream out;
+  write_dimacs_stats st;
+  write_dimacs( mapped, out, ps, &st );
+  CHECK( st.num_vars == 1u + aig.num_pis() + mapped.num_cells() );
+
+  write_dimacs_stats st_gates;
+  std::ostringstream out_gates;
+  write_dimacs( aig, out_gates, {}, &st_gates );
+  CHECK( st.num_clauses < st_gates.num_clauses );
+
+  /* the clauses, except for the output units, are satisfied by the values of the network */
+  uint64_t num_vars, num_clauses;
+  auto const clauses = read_clauses( out.str(), num_vars, num_clauses );
+  CHECK( num_clauses == clauses.size() );
+
+  std::vector<aig_network::node> var_to_node( num_vars + 1u );
+  var_to_node[1u] = aig.get_node( aig.get_constant( false ) );
+  aig.foreach_pi( [&]( auto const& n, auto i ) { var_to_node[i + 2u] = n; } );
+  auto next_var = aig.num_pis() + 2u;
+  aig.foreach_gate( [&]( auto const& n ) {
+    if ( mapped.is_cell_root( n ) )
+    {
+      var_to_node[next_var++] = n;
+    }
+  } );
+
+  for ( auto m = 0u; m < ( 1u << aig.num_pis() ); ++m )
+  {
+    std::vector<bool> assignment( aig.num_pis() );
+    for ( auto i = 0u; i < aig.num_pis(); ++i )
+    {
+      assignment[i] = ( m >> i ) & 1;
+    }
+    default_simulator<bool> sim( assignment );
+    auto const values = simulate_nodes<bool>( aig, sim );
+
+    auto const satisfied = [&]( auto const& clause ) {
+      return std::any_of( clause.begin(), clause.end(), [&]( auto lit ) { return values[var_to_node[std::abs( lit )]] == ( lit > 0 ); } );
+    };
+    auto const po_values = simulate<bool>( aig, sim );
+    for ( auto j = 0u; j < clauses.size(); ++j )
+    {
+      auto const po = static_cast<int64_t>( j ) - static_cast<int64_t>( clauses.size() - aig.num_pos() );
+      CHECK( satisfied( clauses[j] ) == ( po < 0 || po_values[po] ) );
+    }
+  }
+}
@@ -1,6 +1,9 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <random>
 #include <sstream>
+#include <vector>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/print.hpp>
@@ -93,3 +96,67 @@ TEST_CASE( "Parse GF(2^4) function", "[abstract_xag]" )
   CHECK( xag.num_pis() == 4u );
   CHECK( xag.num_pos() == 4u );
 }
+
+TEST_CASE( "Structural hashing of n-ary XORs in abstract XAG", "[abstract_xag]" )
+{
+  abstract_xag_network axag;
+  xag_network xag;
+
+  std::vector<abstract_xag_network::signal> apis;
+  std::vector<xag_network::signal> pis;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    apis.push_back( axag.create_pi() );
+    pis.push_back( xag.create_pi() );
+  }
+
+  /* the same linear function in a different order and with cancelling terms is hashed */
+  const auto f = axag.create_nary_xor( {apis[0], apis[3], apis[5], apis[7]} );
+  const auto num_gates = axag.num_gates();
+  CHECK( axag.create_nary_xor( {apis[7], apis[5], apis[3], apis[0]} ) == f );
+  CHECK( axag.create_nary_xor( {apis[5], apis[1], apis[0], apis[7], apis[1], apis[3]} ) == f );
+  CHECK( axag.create_nary_xor( {!apis[5], apis[0], apis[7], apis[3]} ) == !f );
+  CHECK( axag.num_gates() == num_gates );
+  CHECK( axag.fanin_size( axag.get_node( f ) ) == 4u );
+
+  /* random linear layer with shared rows */
+  std::mt19937 rng( 7u );
+  std::vector<std::vector<uint32_t>> rows;
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    std::vector<uint32_t> row;
+    for ( auto j = 0u; j < 16u; ++j )
+    {
+      if ( rng() % 2u )
+      {
+        row.push_back( j );
+      }
+    }
+    rows.push_back( row );
+    rows.push_back( row );
+  }
+
+  for ( auto const& row : rows )
+  {
+    std::vector<abstract_xag_network::signal> afs;
+    std::vector<xag_network::signal> fs;
+    for ( auto j : row )
+    {
+      afs.push_back( apis[j] );
+      fs.push_back( pis[j] );
+    }
+    std::shuffle( afs.begin(), afs.end(), rng );
+    axag.create_po( axag.create_nary_xor( afs ) );
+    xag.create_po( xag.create_nary_xor( fs ) );
+  }
+
+  /* one gate per distinct row with at least two terms */
+  std::sort( rows.begin(), rows.end() );
+  rows.erase( std::unique( rows.begin(), rows.end() ), rows.end() );
+  const auto num_rows = std::count_if( rows.begin(), rows.end(), []( auto const& row ) { return row.size() > 1u; } );
+  const auto has_f_row = std::find( rows.begin(), rows.end(), std::vector<uint32_t>{0, 3, 5, 7} ) != rows.end();
+  CHECK( axag.num_gates() == num_rows + ( has_f_row ? 0u : 1u ) );
+
+  default_simulator<kitty::dynamic_truth_table> sim( 16u );
+  CHECK( simulate<kitty::dynamic_truth_table>( axag, sim ) == simulate<kitty::dynamic_truth_table>( xag, sim ) );
+}
@@ -1,5 +1,7 @@
 #include <catch.hpp>
 
+#include <stdexcept>
+
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -259,6 +261,65 @@ TEST_CASE( "hash nodes in AIG network", "[aig]" )
   CHECK( aig.get_node( f ) == aig.get_node( g ) );
 }
 
+TEST_CASE( "create a batch of AND gates in an AIG", "[aig]" )
+{
+  CHECK( has_create_and_batch_v<aig_network> );
+
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f = aig.create_and( a, b );
+
+  /* fanins with index size() + i refer to the i-th gate of the batch */
+  const auto p = []( uint32_t i, bool complement = false ) { return aig_network::signal( 5u + i, complement ); };
+  const auto fs = aig.create_and_batch( {{b, a},                 /* existing gate */
+                                         {f, c},                 /* new gate */
+                                         {p( 0 ), !c},           /* refers to the batch */
+                                         {c, f},                 /* hashed to a gate of the batch */
+                                         {p( 1, true ), p( 2 )}, /* refers to two gates of the batch */
+                                         {a, !a},                /* trivial cases */
+                                         {p( 4 ), aig.get_constant( true )},
+                                         {p( 5 ), c}} );
+
+  CHECK( fs.size() == 8u );
+  CHECK( fs[0] == f );
+  CHECK( aig.get_node( fs[1] ) == 5u );
+  CHECK( aig.get_node( fs[2] ) == 6u );
+  CHECK( fs[3] == fs[1] );
+  CHECK( aig.get_node( fs[4] ) == 7u );
+  CHECK( fs[5] == aig.get_constant( false ) );
+  CHECK( fs[6] == fs[4] );
+  CHECK( fs[7] == aig.get_constant( false ) );
+  CHECK( aig.num_gates() == 4u );
+  CHECK( aig.fanout_size( aig.get_node( f ) ) == 2u );
+
+  /* same gates as with create_and */
+  aig_network ref;
+  const auto ra = ref.create_pi();
+  const auto rb = ref.create_pi();
+  const auto rc = ref.create_pi();
+  const auto rf = ref.create_and( ra, rb );
+  const auto r1 = ref.create_and( rf, rc );
+  const auto r2 = ref.create_and( rf, !rc );
+  ref.create_and( !r1, r2 );
+  CHECK( ref.size() == aig.size() );
+  ref.foreach_gate( [&]( auto const& n ) {
+    ref.foreach_fanin( n, [&]( auto const& fi, uint32_t i ) {
+      CHECK( aig._storage->nodes[n].children[i] == aig_network::signal( fi ) );
+    } );
+  } );
+
+  /* without structural hashing, equal gates are not merged */
+  mapped_aig_network unhashed;
+  const auto x = unhashed.create_pi();
+  const auto y = unhashed.create_pi();
+  const auto gs = unhashed.create_and_batch( {{x, y}, {y, x}, {mapped_aig_network::signal( 3u, false ), x}} );
+  CHECK( unhashed.num_gates() == 3u );
+  CHECK( unhashed.get_node( gs[0] ) != unhashed.get_node( gs[1] ) );
+  CHECK( unhashed.fanout_size( unhashed.get_node( gs[0] ) ) == 1u );
+}
+
 TEST_CASE( "clone a node in AIG network", "[aig]" )
 {
   aig_network aig1, aig2;
@@ -932,3 +993,86 @@ TEST_CASE( "substitute multiple nodes", "[aig]" )
     }
   });
 }
+
+TEST_CASE( "create and use mapped AIG", "[aig]" )
+{
+  CHECK( is_network_type_v<mapped_aig_network> );
+  CHECK( is_out_of_core_v<mapped_aig_network> );
+  CHECK( !is_out_of_core_v<aig_network> );
+
+  mapped_aig_network aig;
+  CHECK( !aig.has_structural_hashing() );
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  /* without structural hashing, equivalent gates are not merged */
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( a, b );
+  CHECK( aig.get_node( f1 ) != aig.get_node( f2 ) );
+  CHECK( aig.create_and( a, a ) == a );
+  CHECK( aig.num_gates() == 2u );
+
+  const auto f3 = aig.create_maj( a, b, c );
+  aig.create_po( f3 );
+  aig.create_po( !f1 );
+
+  aig_network ref;
+  const auto ra = ref.create_pi();
+  const auto rb = ref.create_pi();
+  const auto rc = ref.create_pi();
+  ref.create_po( ref.create_maj( ra, rb, rc ) );
+  ref.create_po( ref.create_nand( ra, rb ) );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig ) == simulate<kitty::static_truth_table<3u>>( ref ) );
+  CHECK( simulate<bool>( aig, default_simulator<bool>( {true, true, false} ) ) == std::vector<bool>{true, false} );
+
+  /* copies between in-memory and out-of-core AIGs */
+  const auto copy = cleanup_dangling<mapped_aig_network, aig_network>( aig );
+  CHECK( copy.num_gates() == ref.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<3u>>( copy ) == simulate<kitty::static_truth_table<3u>>( ref ) );
+
+  mapped_aig_network strashed;
+  strashed.set_structural_hashing( true );
+  const auto x = strashed.create_pi();
+  const auto y = strashed.create_pi();
+  CHECK( strashed.create_and( x, y ) == strashed.create_and( y, x ) );
+  CHECK( strashed.num_gates() == 1u );
+  strashed.set_structural_hashing( false );
+  strashed.create_and( x, y );
+  CHECK( strashed.num_gates() == 2u );
+
+  /* structural hashing cannot be enabled again once there are gates */
+  CHECK_THROWS_AS( strashed.set_structural_hashing( true ), std::logic_error );
+  CHECK( !strashed.has_structural_hashing() );
+  CHECK( strashed.num_gates() == 2u );
+}
+
+TEST_CASE( "simulate large mapped AIG", "[aig]" )
+{
+  mapped_aig_network aig;
+  aig_network ref;
+
+  std::vector<mapped_aig_network::signal> fs;
+  std::vector<aig_network::signal> rs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+    rs.push_back( ref.create_pi() );
+  }
+
+  /* enough gates to release nodes while simulating */
+  for ( auto i = 0u; i < 200000u; ++i )
+  {
+    const auto j = ( 7u * i + 3u ) % fs.size();
+    const auto k = ( 13u * i + 5u ) % fs.size();
+    fs.push_back( aig.create_xor( fs[j], !fs[k] ) );
+    rs.push_back( ref.create_xor( rs[j], !rs[k] ) );
+  }
+  aig.create_po( fs.back() );
+  ref.create_po( rs.back() );
+
+  CHECK( aig.size() > 500000u );
+  CHECK( simulate<kitty::static_truth_table<8u>>( aig ) == simulate<kitty::static_truth_table<8u>>( ref ) );
+}
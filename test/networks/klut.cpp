@@ -1,11 +1,14 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 #include <mockturtle/networks/klut.hpp>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 
@@ -323,6 +326,85 @@ TEST_CASE( "create nodes and compute a function in a k-LUT network", "[klut]" )
   CHECK( sim_xor == ( xs[0] ^ xs[1] ^ xs[2] ) );
 }
 
+TEST_CASE( "compute random LUT functions word-parallel in a k-LUT network", "[klut]" )
+{
+  klut_network klut;
+
+  std::vector<klut_network::signal> pis( 8u );
+  std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+
+  /* simulation values with 4 words, and smaller than a word */
+  for ( auto num_vars : {4u, 8u} )
+  {
+    std::vector<kitty::dynamic_truth_table> xs( 8u, kitty::dynamic_truth_table( num_vars ) );
+    for ( auto& x : xs )
+    {
+      kitty::create_random( x );
+    }
+
+    for ( auto k = 1u; k <= 8u; ++k )
+    {
+      kitty::dynamic_truth_table func( k );
+      for ( auto i = 0u; i < 20u; ++i )
+      {
+        kitty::create_random( func );
+        std::vector<klut_network::signal> children( pis.begin(), pis.begin() + k );
+        const auto f = klut.create_node( children, func );
+        const auto sim = klut.compute( klut.get_node( f ), xs.begin(), xs.begin() + k );
+
+        auto expected = xs[0].construct();
+        for ( auto b = 0u; b < expected.num_bits(); ++b )
+        {
+          uint32_t pattern{0u};
+          for ( auto j = 0u; j < k; ++j )
+          {
+            pattern |= kitty::get_bit( xs[j], b ) << j;
+          }
+          if ( kitty::get_bit( func, pattern ) )
+          {
+            kitty::set_bit( expected, b );
+          }
+        }
+        CHECK( sim == expected );
+      }
+    }
+  }
+}
+
+TEST_CASE( "compute functions incrementally with partial truth tables in a k-LUT network", "[klut]" )
+{
+  klut_network klut;
+
+  CHECK( has_compute_v<klut_network, kitty::partial_truth_table> );
+  CHECK( has_compute_inplace_v<klut_network, kitty::partial_truth_table> );
+
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+
+  kitty::dynamic_truth_table tt_maj( 3u ), tt_xor( 3u );
+  kitty::create_from_hex_string( tt_maj, "e8" );
+  kitty::create_from_hex_string( tt_xor, "96" );
+  const auto n_maj = klut.get_node( klut.create_node( {a, b, c}, tt_maj ) );
+  const auto n_xor = klut.get_node( klut.create_node( {a, b, c}, tt_xor ) );
+
+  std::vector<kitty::partial_truth_table> xs( 3u );
+  kitty::partial_truth_table maj, xor3;
+  for ( auto i = 0u; i < 150u; ++i )
+  {
+    xs[0].add_bit( i % 2 );
+    xs[1].add_bit( ( i / 3 ) % 2 );
+    xs[2].add_bit( ( i / 7 ) % 2 );
+
+    klut.compute( n_maj, maj, xs.begin(), xs.end() );
+    klut.compute( n_xor, xor3, xs.begin(), xs.end() );
+
+    CHECK( maj == kitty::ternary_majority( xs[0], xs[1], xs[2] ) );
+    CHECK( xor3 == ( xs[0] ^ xs[1] ^ xs[2] ) );
+    CHECK( klut.compute( n_maj, xs.begin(), xs.end() ) == maj );
+  }
+}
+
 TEST_CASE( "hash nodes in K-LUT network", "[klut]" )
 {
   klut_network klut;
@@ -573,3 +655,73 @@ TEST_CASE( "visited values in k-LUT networks", "[klut]" )
     CHECK( klut.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "create, hash, and substitute nodes in a k-LUT network with inline fanins", "[klut]" )
+{
+  using ntk_t = inline_klut_network<6>;
+
+  CHECK( is_network_type_v<ntk_t> );
+  CHECK( has_create_node_v<ntk_t> );
+  CHECK( has_compute_v<ntk_t, kitty::dynamic_truth_table> );
+  CHECK( has_compute_inplace_v<ntk_t, kitty::partial_truth_table> );
+  CHECK( ntk_t::max_fanin_size == 6 );
+  CHECK( sizeof( ntk_t::storage::element_type::node_type ) <= 48u );
+
+  ntk_t klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+
+  kitty::dynamic_truth_table tt_maj( 3u ), tt_xor( 3u );
+  kitty::create_from_hex_string( tt_maj, "e8" );
+  kitty::create_from_hex_string( tt_xor, "96" );
+
+  const auto f1 = klut.create_node( {a, b, c}, tt_maj );
+  const auto f2 = klut.create_node( {a, b, c}, tt_xor );
+  CHECK( klut.create_node( {a, b, c}, tt_maj ) == f1 );
+  CHECK( klut.create_node( {a, c, b}, tt_maj ) != f1 );
+  const auto f3 = klut.create_and( f1, f2 );
+  klut.create_po( f3 );
+
+  CHECK( klut.size() == 9 );
+  CHECK( klut.num_gates() == 4 );
+  CHECK( klut.fanin_size( klut.get_node( f1 ) ) == 3 );
+  CHECK( klut.fanout_size( klut.get_node( f1 ) ) == 1 );
+
+  std::vector<ntk_t::node> fanins;
+  klut.foreach_fanin( klut.get_node( f3 ), [&]( auto const& f ) { fanins.push_back( klut.get_node( f ) ); } );
+  CHECK( fanins == std::vector<ntk_t::node>{klut.get_node( f1 ), klut.get_node( f2 )} );
+
+  std::vector<kitty::dynamic_truth_table> xs( 3u, kitty::dynamic_truth_table( 3u ) );
+  kitty::create_nth_var( xs[0], 0 );
+  kitty::create_nth_var( xs[1], 1 );
+  kitty::create_nth_var( xs[2], 2 );
+  CHECK( klut.compute( klut.get_node( f1 ), xs.begin(), xs.end() ) == kitty::ternary_majority( xs[0], xs[1], xs[2] ) );
+
+  klut.substitute_node( klut.get_node( f2 ), a );
+  fanins.clear();
+  klut.foreach_fanin( klut.get_node( f3 ), [&]( auto const& f ) { fanins.push_back( klut.get_node( f ) ); } );
+  CHECK( fanins == std::vector<ntk_t::node>{klut.get_node( f1 ), klut.get_node( a )} );
+}
+
+TEST_CASE( "reject nodes with too many fanins in a k-LUT network with inline fanins", "[klut]" )
+{
+  using ntk_t = inline_klut_network<6>;
+
+  ntk_t klut;
+  std::vector<ntk_t::signal> pis( 8u );
+  std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+
+  kitty::dynamic_truth_table tt_and( 8u );
+  kitty::create_from_hex_string( tt_and, "8000000000000000000000000000000000000000000000000000000000000000" );
+
+  const auto size = klut.size();
+  CHECK_THROWS_AS( klut.create_node( pis, tt_and ), std::invalid_argument );
+  CHECK( klut.size() == size );
+
+  /* at most `MaxFanin` fanins are accepted */
+  kitty::dynamic_truth_table tt_and6( 6u );
+  kitty::create_from_hex_string( tt_and6, "8000000000000000" );
+  const auto f = klut.create_node( std::vector<ntk_t::signal>( pis.begin(), pis.begin() + 6 ), tt_and6 );
+  CHECK( klut.fanin_size( klut.get_node( f ) ) == 6u );
+}
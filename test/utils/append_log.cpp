@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <mockturtle/utils/append_log.hpp>
+
+using namespace mockturtle;
+
+#if __GNUC__ == 7
+namespace fs = std::experimental::filesystem::v1;
+#else
+namespace fs = std::filesystem;
+#endif
+
+TEST_CASE( "append and read records", "[append_log]" )
+{
+  const std::string filename = "mockturtle-test-append.log";
+  fs::remove( filename );
+
+  {
+    append_log log( filename, 0x1234u );
+    CHECK( log.good() );
+    log.append( {"first", "second"} );
+  }
+
+  {
+    append_log log( filename, 0x1234u );
+    std::vector<std::string> records;
+    log.read( [&]( std::string const& r ) { records.push_back( r ); } );
+    CHECK( records == std::vector<std::string>{"first", "second"} );
+
+    /* nothing new to read */
+    log.read( [&]( std::string const& r ) { records.push_back( r ); } );
+    CHECK( records.size() == 2u );
+  }
+
+  /* different magic number */
+  {
+    append_log log( filename, 0x4321u );
+    log.read( []( std::string const& ) {} );
+    CHECK( !log.good() );
+  }
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "share records between two logs", "[append_log]" )
+{
+  const std::string filename = "mockturtle-test-append-shared.log";
+  fs::remove( filename );
+
+  append_log log1( filename, 0x1234u );
+  append_log log2( filename, 0x1234u );
+
+  std::vector<std::string> records1, records2;
+  log1.append( {"a"}, [&]( std::string const& r ) { records1.push_back( r ); } );
+  CHECK( log2.has_new_records() );
+  log2.append( {"b"}, [&]( std::string const& r ) { records2.push_back( r ); } );
+  CHECK( records2 == std::vector<std::string>{"a"} );
+  log1.read( [&]( std::string const& r ) { records1.push_back( r ); } );
+  CHECK( records1 == std::vector<std::string>{"b"} );
+
+  /* after compaction, all records are read again */
+  log1.compact( []( std::string const& ) {}, []() { return std::vector<std::string>{"a", "b", "c"}; } );
+  records2.clear();
+  log2.read( [&]( std::string const& r ) { records2.push_back( r ); } );
+  CHECK( records2 == std::vector<std::string>{"a", "b", "c"} );
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
+
+TEST_CASE( "recover from incomplete record", "[append_log]" )
+{
+  const std::string filename = "mockturtle-test-append-torn.log";
+  fs::remove( filename );
+
+  {
+    append_log log( filename, 0x1234u );
+    log.append( {"complete"} );
+  }
+
+  /* simulate a crash during append */
+  {
+    std::ofstream os( filename, std::ios::binary | std::ios::app );
+    const uint32_t size = 100u;
+    os.write( reinterpret_cast<char const*>( &size ), sizeof( size ) );
+    os.write( "abc", 3 );
+  }
+
+  {
+    append_log log( filename, 0x1234u );
+    std::vector<std::string> records;
+    log.read( [&]( std::string const& r ) { records.push_back( r ); } );
+    CHECK( records == std::vector<std::string>{"complete"} );
+    log.append( {"next"} );
+  }
+
+  {
+    append_log log( filename, 0x1234u );
+    std::vector<std::string> records;
+    log.read( [&]( std::string const& r ) { records.push_back( r ); } );
+    CHECK( records == std::vector<std::string>{"complete", "next"} );
+  }
+
+  fs::remove( filename );
+  fs::remove( filename + ".lock" );
+}
@@ -0,0 +1,29 @@
+#include <catch.hpp>
+
+#include <cstdint>
+
+#include <mockturtle/utils/bit_utils.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "count and find bits in words", "[bit_utils]" )
+{
+  CHECK( popcount64( 0u ) == 0u );
+  CHECK( popcount64( ~UINT64_C( 0 ) ) == 64u );
+  CHECK( popcount64( UINT64_C( 0x8000000100000001 ) ) == 3u );
+
+  CHECK( ctz32( 1u ) == 0u );
+  CHECK( ctz32( 0x80000000u ) == 31u );
+  CHECK( ctz32( 0x00f0u ) == 4u );
+
+  CHECK( ctz64( 1u ) == 0u );
+  CHECK( ctz64( UINT64_C( 1 ) << 63u ) == 63u );
+  CHECK( ctz64( UINT64_C( 0x0000010000000000 ) ) == 40u );
+
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    auto const word = ~UINT64_C( 0 ) << i;
+    CHECK( ctz64( word ) == i );
+    CHECK( popcount64( word ) == 64u - i );
+  }
+}
@@ -0,0 +1,77 @@
+#include <catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <mockturtle/utils/conflict_slices.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "grow conflict limits until the solver terminates", "[conflict_slices]" )
+{
+  std::vector<int32_t> limits;
+  int32_t last_limit{0};
+  auto const result = solve_with_conflict_slices(
+      [&]( int32_t limit ) {
+        limits.push_back( limit );
+        return limit >= 5000 ? percy::success : percy::timeout;
+      },
+      0, false, std::nullopt, []() { return false; }, last_limit );
+  CHECK( result == percy::success );
+  CHECK( limits == std::vector<int32_t>{1024, 2048, 4096, 8192} );
+  CHECK( last_limit == 8192 );
+}
+
+TEST_CASE( "respect the overall conflict limit", "[conflict_slices]" )
+{
+  const auto never = []( int32_t ) { return percy::timeout; };
+  int32_t last_limit{0};
+
+  /* each call starts from scratch, the last one uses the full limit */
+  std::vector<int32_t> limits;
+  auto result = solve_with_conflict_slices(
+      [&]( int32_t limit ) { limits.push_back( limit ); return never( limit ); },
+      3000, false, std::nullopt, []() { return false; }, last_limit );
+  CHECK( result == percy::timeout );
+  CHECK( limits == std::vector<int32_t>{1024, 2048, 3000} );
+  CHECK( last_limit == 3000 );
+
+  /* incremental calls share the limit */
+  limits.clear();
+  result = solve_with_conflict_slices(
+      [&]( int32_t limit ) { limits.push_back( limit ); return never( limit ); },
+      3000, true, std::nullopt, []() { return false; }, last_limit );
+  CHECK( result == percy::timeout );
+  CHECK( limits == std::vector<int32_t>{1024, 1976} );
+
+  /* stop after the first call */
+  limits.clear();
+  result = solve_with_conflict_slices(
+      [&]( int32_t limit ) { limits.push_back( limit ); return never( limit ); },
+      0, false, std::nullopt, []() { return true; }, last_limit );
+  CHECK( result == percy::timeout );
+  CHECK( limits.size() == 1u );
+}
+
+TEST_CASE( "bound conflict limits by the remaining time", "[conflict_slices]" )
+{
+  /* a solver that needs 1us per conflict and never terminates; doubling the
+   * limits alone would end after 1 + 2 + ... + 128 ms = 255 ms */
+  auto const start = std::chrono::steady_clock::now();
+  auto const deadline = start + std::chrono::milliseconds( 200 );
+  int32_t last_limit{0};
+  auto const result = solve_with_conflict_slices(
+      []( int32_t limit ) {
+        std::this_thread::sleep_for( std::chrono::microseconds( limit ) );
+        return percy::timeout;
+      },
+      0, false, deadline, []() { return false; }, last_limit );
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  CHECK( result == percy::timeout );
+  CHECK( elapsed >= std::chrono::milliseconds( 200 ) );
+  CHECK( elapsed < std::chrono::milliseconds( 240 ) );
+}
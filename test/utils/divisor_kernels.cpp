@@ -0,0 +1,173 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <kitty/kitty.hpp>
+#include <mockturtle/utils/divisor_kernels.hpp>
+
+using namespace mockturtle;
+
+template<typename TT>
+void check_kernels( TT const& proto, uint32_t seed )
+{
+  std::vector<TT> tts( 6u, proto );
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    kitty::create_random( tts[i], seed + i );
+  }
+  auto const layout = make_tt_layout( tts[0] );
+
+  auto const implies = []( auto a, auto b ) { return a & ~b; };
+  auto const maj = []( auto a, auto b, auto c ) { return ( a & b ) | ( a & c ) | ( b & c ); };
+
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    for ( auto j = 0u; j < tts.size(); ++j )
+    {
+      auto const& a = tts[i];
+      auto const& b = tts[j];
+      auto const ra = make_tt_ref( a );
+      auto const rb = make_tt_ref( b );
+
+      CHECK( is_const0_words( layout, implies, ra, rb ) == kitty::implies( a, b ) );
+      CHECK( is_const0_words( layout, implies, ~ra, rb ) == kitty::implies( ~a, b ) );
+      CHECK( is_const0_words( layout, []( auto x, auto y ) { return x ^ y; }, ra, make_tt_ref( ~a, true ) ) );
+
+      CHECK( count_ones_words( layout, []( auto x, auto y ) { return x & y; }, ra, rb ) == kitty::count_ones( a & b ) );
+      CHECK( count_ones_words( layout, []( auto x, auto y ) { return x & y; }, ~ra, rb ) == kitty::count_ones( ~a & b ) );
+      CHECK( count_ones_words( layout, []( auto x, auto y ) { return ~( x | y ); }, ra, rb ) == kitty::count_ones( ~( a | b ) ) );
+      CHECK( count_ones_words( layout, [&]( auto x, auto y, auto z ) { return maj( x, y, z ); }, ra, rb, ~ra ) == kitty::count_ones( kitty::ternary_majority( a, b, ~a ) ) );
+    }
+  }
+}
+
+TEST_CASE( "divisor kernels on static and dynamic truth tables", "[divisor_kernels]" )
+{
+  check_kernels( kitty::static_truth_table<3>(), 1u );
+  check_kernels( kitty::static_truth_table<6>(), 2u );
+  check_kernels( kitty::static_truth_table<8>(), 3u );
+  check_kernels( kitty::dynamic_truth_table( 4 ), 4u );
+  check_kernels( kitty::dynamic_truth_table( 11 ), 5u );
+  check_kernels( kitty::dynamic_truth_table( 14 ), 6u );
+}
+
+TEST_CASE( "divisor kernels on partial truth tables", "[divisor_kernels]" )
+{
+  for ( auto const num_bits : {13u, 64u, 200u, 1000u} )
+  {
+    kitty::partial_truth_table a( num_bits ), b( num_bits );
+    kitty::create_random( a, num_bits );
+    kitty::create_random( b, num_bits + 1 );
+    auto const layout = make_tt_layout( a );
+    auto const ra = make_tt_ref( a );
+    auto const rb = make_tt_ref( b );
+
+    /* bits beyond `num_bits` in complemented words are ignored */
+    CHECK( count_ones_words( layout, []( auto x ) { return x; }, ~ra ) == kitty::count_ones( ~a ) );
+    CHECK( count_ones_words( layout, []( auto x, auto y ) { return x | y; }, ~ra, rb ) == kitty::count_ones( ~a | b ) );
+    CHECK( is_const0_words( layout, []( auto x ) { return ~x; }, ~ra ) == kitty::is_const0( a ) );
+    CHECK( is_const0_words( layout, []( auto x, auto y ) { return ~( x | y ); }, ra, ~ra ) );
+  }
+}
+
+TEST_CASE( "find divisor pairs with a batch", "[divisor_kernels]" )
+{
+  std::vector<kitty::dynamic_truth_table> tts( 12u, kitty::dynamic_truth_table( 10 ) );
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    kitty::create_random( tts[i], 7u + i );
+  }
+  auto const target = tts[3] | ~tts[8];
+
+  divisor_batch<1u> batch( make_tt_layout( target ) );
+  for ( auto const& tt : tts )
+  {
+    batch.add( make_tt_ref( tt ) );
+    batch.add( make_tt_ref( tt, true ) );
+  }
+  CHECK( batch.size() == 24u );
+
+  auto const or_fn = []( auto t, auto a, auto b ) { return ( a | b ) ^ t; };
+  auto const t = make_tt_ref( target );
+
+  /* compare against exhaustive search with kitty */
+  for ( auto i = 0u; i < batch.size(); ++i )
+  {
+    auto const& tt_i = ( i & 1 ) ? ~tts[i / 2] : tts[i / 2];
+    std::optional<uint32_t> expected;
+    for ( auto j = i + 1; j < batch.size(); ++j )
+    {
+      auto const& tt_j = ( j & 1 ) ? ~tts[j / 2] : tts[j / 2];
+      CHECK( batch.test( j, or_fn, t, batch[i][0] ) == ( ( tt_i | tt_j ) == target ) );
+      if ( !expected && ( tt_i | tt_j ) == target )
+      {
+        expected = j;
+      }
+    }
+    CHECK( batch.find( i + 1, or_fn, t, batch[i][0] ) == expected );
+  }
+  CHECK( batch.find( 0u, or_fn, t, batch[6][0] ) == 17u );
+
+  /* pairs of divisors */
+  divisor_batch<2u> pairs( make_tt_layout( target ) );
+  pairs.add( make_tt_ref( tts[0] ), make_tt_ref( tts[1] ) );
+  pairs.add( make_tt_ref( tts[8], true ), make_tt_ref( tts[3] ) );
+  auto const pair_or = []( auto t, auto a, auto b ) { return ( a | b ) ^ t; };
+  CHECK( pairs.find( 0u, pair_or, t ) == 1u );
+  CHECK( pairs.count_ones( 1u, []( auto t, auto a, auto b ) { return t & ~( a | b ); }, t ) == 0u );
+
+  pairs.clear();
+  CHECK( pairs.size() == 0u );
+  CHECK( !pairs.find( 0u, pair_or, t ) );
+}
+
+TEST_CASE( "find divisor pairs with an index", "[divisor_kernels]" )
+{
+  for ( auto const num_bits : {50u, 64u, 1000u} )
+  {
+    kitty::partial_truth_table target( num_bits );
+    kitty::create_random( target, num_bits );
+
+    /* positive unate divisors */
+    std::vector<kitty::partial_truth_table> tts( 150u, target );
+    for ( auto i = 0u; i < tts.size(); ++i )
+    {
+      kitty::partial_truth_table tt( num_bits );
+      kitty::create_random( tt, num_bits + i );
+      tts[i] = i % 4 == 0 ? target & ~tts[i - ( i > 0 ? 1 : 0 )] : target & ( tt | ( i % 3 == 0 ? tts[0] : tt ) );
+    }
+
+    auto const layout = make_tt_layout( target );
+    auto const t = make_tt_ref( target );
+    divisor_batch<1u> batch( layout );
+    for ( auto const& tt : tts )
+    {
+      batch.add( make_tt_ref( tt ) );
+    }
+
+    divisor_index index( 64u );
+    index.build( batch, []( auto a ) { return a; }, []( auto t ) { return t; }, t );
+    CHECK( index.num_pivots() > 0u );
+    CHECK( index.num_pivots() <= 32u );
+
+    auto const required = []( auto t, auto a ) { return t & ~a; };
+    auto const or_fn = []( auto t, auto a, auto b ) { return ( a | b ) ^ t; };
+    auto num_found = 0u;
+    for ( auto i = 0u; i < batch.size(); ++i )
+    {
+      auto const expected = batch.find( i + 1, or_fn, t, batch[i][0] );
+      CHECK( index.find( batch, i + 1, required, or_fn, t, batch[i][0] ) == expected );
+      num_found += expected ? 1u : 0u;
+    }
+    CHECK( num_found > 0u );
+
+    /* small batches are not indexed */
+    divisor_batch<1u> small( layout );
+    small.add( make_tt_ref( tts[1] ) );
+    small.add( make_tt_ref( tts[4] ) );
+    index.build( small, []( auto a ) { return a; }, []( auto t ) { return t; }, t );
+    CHECK( index.num_pivots() == 0u );
+    CHECK( index.find( small, 0u, required, or_fn, t, batch[0][0] ) == small.find( 0u, or_fn, t, batch[0][0] ) );
+  }
+}
@@ -0,0 +1,95 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <mockturtle/utils/gf2_matrix.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Set and get entries of GF(2) matrices", "[gf2_matrix]" )
+{
+  gf2_matrix m( 3u, 130u );
+  CHECK( m.num_rows() == 3u );
+  CHECK( m.num_columns() == 130u );
+  CHECK( m.num_blocks() == 3u );
+  CHECK( m.is_zero_row( 0u ) );
+
+  m.set( 0u, 0u );
+  m.set( 0u, 64u );
+  m.set( 0u, 129u );
+  m.flip( 1u, 64u );
+  m.flip( 1u, 65u );
+  m.flip( 1u, 65u );
+  CHECK( m.get( 0u, 0u ) );
+  CHECK( m.get( 0u, 64u ) );
+  CHECK( m.get( 0u, 129u ) );
+  CHECK( !m.get( 0u, 1u ) );
+  CHECK( m.get( 1u, 64u ) );
+  CHECK( !m.get( 1u, 65u ) );
+  CHECK( m.count_ones( 0u ) == 3u );
+  CHECK( m.count_ones( 1u ) == 1u );
+  CHECK( m.count_common( 0u, 1u ) == 1u );
+  CHECK( m.count_ones_of_sum( 0u, 1u ) == 2u );
+
+  m.set( 0u, 64u, false );
+  CHECK( !m.get( 0u, 64u ) );
+
+  std::vector<uint32_t> ones;
+  m.foreach_one( 0u, [&]( auto c ) { ones.push_back( c ); } );
+  CHECK( ones == std::vector<uint32_t>{0u, 129u} );
+}
+
+TEST_CASE( "Row operations of GF(2) matrices", "[gf2_matrix]" )
+{
+  std::mt19937 rng( 1u );
+  std::vector<std::vector<bool>> rows( 5u, std::vector<bool>( 300u ) );
+  for ( auto& row : rows )
+  {
+    for ( auto i = 0u; i < row.size(); ++i )
+    {
+      row[i] = rng() % 2u == 0u;
+    }
+  }
+
+  gf2_matrix m( rows );
+  CHECK( m.to_bool_matrix() == rows );
+
+  uint32_t common{0u}, ones_of_sum{0u}, ones{0u};
+  for ( auto i = 0u; i < 300u; ++i )
+  {
+    ones += rows[0][i] ? 1u : 0u;
+    common += ( rows[0][i] && rows[1][i] ) ? 1u : 0u;
+    ones_of_sum += ( rows[0][i] != rows[1][i] ) ? 1u : 0u;
+  }
+  CHECK( m.count_ones( 0u ) == ones );
+  CHECK( m.count_common( 0u, 1u ) == common );
+  CHECK( m.count_ones_of_sum( 0u, 1u ) == ones_of_sum );
+
+  m.add_row_to( 0u, 1u );
+  CHECK( m.count_ones( 1u ) == ones_of_sum );
+  m.add_row_to( 0u, 1u );
+  CHECK( m.to_bool_matrix() == rows );
+
+  const auto r = m.add_row();
+  CHECK( r == 5u );
+  CHECK( m.num_rows() == 6u );
+  CHECK( m.is_zero_row( r ) );
+  m.set_row_to_sum( 2u, 3u, r );
+  for ( auto i = 0u; i < 300u; ++i )
+  {
+    CHECK( m.get( r, i ) == ( rows[2][i] != rows[3][i] ) );
+  }
+  m.add_row_to( r, r );
+  CHECK( m.is_zero_row( r ) );
+
+  const auto t = m.transpose();
+  CHECK( t.num_rows() == 300u );
+  CHECK( t.num_columns() == 6u );
+  CHECK( t.transpose() == m );
+  for ( auto i = 0u; i < 300u; ++i )
+  {
+    CHECK( t.get( i, 4u ) == rows[4][i] );
+  }
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <mockturtle/utils/lut_evaluator.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* evaluates one word bit by bit */
+uint64_t evaluate_bitwise( kitty::dynamic_truth_table const& func, uint64_t const* inputs )
+{
+  uint64_t result{0u};
+  for ( auto b = 0u; b < 64u; ++b )
+  {
+    uint32_t pattern{0u};
+    for ( auto j = 0u; j < func.num_vars(); ++j )
+    {
+      pattern |= ( ( inputs[j] >> b ) & 1u ) << j;
+    }
+    result |= static_cast<uint64_t>( kitty::get_bit( func, pattern ) ) << b;
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE( "evaluate common functions word-parallel", "[lut_evaluator]" )
+{
+  std::array<uint64_t, 3> inputs{0xaaaaaaaaaaaaaaaa, 0xcccccccccccccccc, 0xf0f0f0f0f0f0f0f0};
+
+  kitty::dynamic_truth_table maj( 3u ), xor3( 3u ), and3( 3u ), const0( 3u );
+  kitty::create_majority( maj );
+  kitty::create_parity( xor3 );
+  kitty::create_from_hex_string( and3, "80" );
+
+  CHECK( lut_evaluator( maj )( inputs.data() ) == 0xe8e8e8e8e8e8e8e8 );
+  CHECK( lut_evaluator( ~maj )( inputs.data() ) == ~UINT64_C( 0xe8e8e8e8e8e8e8e8 ) );
+  CHECK( lut_evaluator( xor3 )( inputs.data() ) == 0x9696969696969696 );
+  CHECK( lut_evaluator( and3 )( inputs.data() ) == 0x8080808080808080 );
+  CHECK( lut_evaluator( const0 )( inputs.data() ) == 0u );
+  CHECK( lut_evaluator( ~const0 )( inputs.data() ) == ~UINT64_C( 0 ) );
+
+  /* parity is cheaper as decision diagram, AND as ISOP */
+  kitty::dynamic_truth_table xor6( 6u ), and6( 6u );
+  kitty::create_parity( xor6 );
+  const uint64_t and6_word = UINT64_C( 1 ) << 63;
+  kitty::create_from_words( and6, &and6_word, &and6_word + 1 );
+  CHECK( lut_evaluator( xor6 ).cost() < 6u * 32u );
+  CHECK( lut_evaluator( and6 ).cost() <= 7u );
+}
+
+TEST_CASE( "evaluate random functions word-parallel", "[lut_evaluator]" )
+{
+  std::array<uint64_t, 10> inputs;
+  for ( auto k = 0u; k <= 10u; ++k )
+  {
+    kitty::dynamic_truth_table func( k );
+    for ( auto i = 0u; i < 50u; ++i )
+    {
+      kitty::create_random( func );
+      for ( auto& w : inputs )
+      {
+        kitty::dynamic_truth_table r( 6u );
+        kitty::create_random( r );
+        w = *r.cbegin();
+      }
+
+      lut_evaluator eval( func );
+      CHECK( eval.num_vars() == k );
+      CHECK( eval( inputs.data() ) == evaluate_bitwise( func, inputs.data() ) );
+    }
+  }
+}
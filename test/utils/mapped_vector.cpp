@@ -0,0 +1,75 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include <mockturtle/utils/mapped_vector.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "append to and access mapped vector", "[mapped_vector]" )
+{
+  mapped_vector<uint64_t> v;
+  CHECK( v.empty() );
+
+  for ( auto i = 0u; i < 100000u; ++i )
+  {
+    v.push_back( 3u * i );
+  }
+  CHECK( v.size() == 100000u );
+  CHECK( v.capacity() >= v.size() );
+  CHECK( v.back() == 3u * 99999u );
+
+  uint64_t sum{0u};
+  for ( auto const& x : v )
+  {
+    sum += x;
+  }
+  CHECK( sum == UINT64_C( 3 ) * 99999u * 100000u / 2u );
+
+  /* released elements are read back from the file */
+  v.release( 0u, v.size() );
+  for ( auto i = 0u; i < v.size(); ++i )
+  {
+    if ( v[i] != 3u * i )
+    {
+      CHECK( false );
+    }
+  }
+
+  v[5] = 7u;
+  CHECK( v[5] == 7u );
+}
+
+TEST_CASE( "resize, copy, and move mapped vector", "[mapped_vector]" )
+{
+  mapped_vector<uint32_t> v;
+  v.resize( 10u );
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    CHECK( v[i] == 0u );
+    v[i] = i + 1u;
+  }
+
+  /* elements are value-initialized after shrinking and growing again */
+  v.resize( 5u );
+  v.resize( 8u );
+  CHECK( v[4] == 5u );
+  CHECK( v[5] == 0u );
+  CHECK( v[7] == 0u );
+  v.clear();
+  v.resize( 10u );
+  CHECK( v[0] == 0u );
+  CHECK( v[9] == 0u );
+  v[9] = 42u;
+
+  auto copy = v;
+  copy[9] = 43u;
+  CHECK( v[9] == 42u );
+  CHECK( copy[9] == 43u );
+  CHECK( copy.size() == 10u );
+
+  auto moved = std::move( copy );
+  CHECK( moved.size() == 10u );
+  CHECK( moved[9] == 43u );
+}
@@ -0,0 +1,209 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#if __GNUC__ == 7
+#include <experimental/filesystem>
+#else
+#include <filesystem>
+#endif
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <kitty/kitty.hpp>
+#include <mockturtle/algorithms/functional_reduction.hpp>
+#include <mockturtle/algorithms/pattern_generation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/pattern_store.hpp>
+#include <mockturtle/views/names_view.hpp>
+
+using namespace mockturtle;
+
+#if __GNUC__ == 7
+namespace fs = std::experimental::filesystem::v1;
+#else
+namespace fs = std::filesystem;
+#endif
+
+namespace
+{
+
+std::vector<kitty::partial_truth_table> random_patterns( uint32_t num_pis, uint32_t num_patterns, uint32_t seed )
+{
+  std::vector<kitty::partial_truth_table> patterns( num_pis, kitty::partial_truth_table( num_patterns ) );
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    kitty::create_random( patterns[i], seed + i );
+  }
+  return patterns;
+}
+
+aig_network make_adder( uint32_t bitwidth )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+  return aig;
+}
+
+} // namespace
+
+TEST_CASE( "append and read patterns", "[pattern_store]" )
+{
+  const std::string filename = "mockturtle-test.patterns";
+  fs::remove( filename );
+
+  auto const patterns = random_patterns( 5u, 1000u, 1u );
+
+  /* appends of different sizes, crossing word boundaries and growing the capacity */
+  uint64_t end = 0u;
+  for ( auto const size : {3u, 61u, 1u, 64u, 200u, 7u, 664u} )
+  {
+    pattern_store store( filename );
+    CHECK( store.good() );
+    CHECK( store.num_patterns() == end );
+    store.append( patterns, 42u, end, end + size );
+    end += size;
+    CHECK( store.num_patterns() == end );
+  }
+  CHECK( end == 1000u );
+
+  pattern_store store( filename );
+  CHECK( store.num_pis() == 5u );
+  CHECK( store.signature() == 42u );
+  CHECK( store.matches( 5u, 42u ) );
+  CHECK( !store.matches( 5u, 43u ) );
+  CHECK( !store.matches( 6u, 42u ) );
+  CHECK( store.read() == patterns );
+
+  /* patterns of a different network replace the stored ones */
+  auto const other = random_patterns( 3u, 100u, 7u );
+  store.append( other, 43u, 10u, 100u );
+  CHECK( store.num_patterns() == 90u );
+
+  pattern_store reopened( filename );
+  CHECK( reopened.matches( 3u, 43u ) );
+  auto const read = reopened.read();
+  REQUIRE( read.size() == 3u );
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    for ( auto j = 0u; j < 90u; ++j )
+    {
+      CHECK( kitty::get_bit( read[i], j ) == kitty::get_bit( other[i], j + 10u ) );
+    }
+  }
+
+  reopened.clear();
+  CHECK( !fs::exists( filename ) );
+  CHECK( pattern_store( filename ).num_patterns() == 0u );
+}
+
+TEST_CASE( "reject files that are not pattern stores", "[pattern_store]" )
+{
+  const std::string filename = "mockturtle-test-invalid.patterns";
+  {
+    std::ofstream os( filename );
+    os << "0 1 0 1\n";
+  }
+
+  pattern_store store( filename );
+  CHECK( !store.good() );
+  CHECK( store.read().empty() );
+  fs::remove( filename );
+}
+
+TEST_CASE( "network signatures", "[pattern_store]" )
+{
+  auto const aig1 = make_adder( 4u );
+  auto const aig2 = make_adder( 4u );
+  auto const aig3 = make_adder( 5u );
+  CHECK( network_signature( aig1 ) == network_signature( aig2 ) );
+  CHECK( network_signature( aig1 ) != network_signature( aig3 ) );
+
+  names_view named1{aig1};
+  names_view named2{aig2};
+  named1.set_output_name( 0u, "sum0" );
+  named2.set_output_name( 0u, "s0" );
+  CHECK( network_signature( named1 ) != network_signature( named2 ) );
+  CHECK( pattern_store::filename_for( named1, "dir" ).find( "dir/" ) == 0u );
+}
+
+TEST_CASE( "load and save patterns of a simulator", "[pattern_store]" )
+{
+  const std::string filename = "mockturtle-test-sim.patterns";
+  fs::remove( filename );
+
+  auto const aig = make_adder( 4u );
+  pattern_store store( filename );
+
+  partial_simulator sim( aig.num_pis(), 100u );
+  CHECK( load_patterns( store, aig, sim ) == 0u );
+  save_patterns( store, aig, sim );
+  CHECK( store.num_patterns() == 100u );
+
+  /* load into an empty simulator */
+  partial_simulator empty_sim( aig.num_pis(), 0u );
+  CHECK( load_patterns( store, aig, empty_sim ) == 100u );
+  CHECK( empty_sim.get_patterns() == sim.get_patterns() );
+
+  /* load behind existing patterns of a bit-packed simulator */
+  bit_packed_simulator packed_sim( aig.num_pis(), 10u, 3u );
+  CHECK( load_patterns( store, aig, packed_sim ) == 100u );
+  CHECK( packed_sim.num_bits() == 110u );
+  for ( auto i = 0u; i < aig.num_pis(); ++i )
+  {
+    for ( auto j = 0u; j < 100u; ++j )
+    {
+      CHECK( kitty::get_bit( packed_sim.get_patterns()[i], 10u + j ) == kitty::get_bit( sim.get_patterns()[i], j ) );
+    }
+  }
+
+  /* a network with a different interface does not use the patterns */
+  auto const aig3 = make_adder( 5u );
+  partial_simulator other_sim( aig3.num_pis(), 0u );
+  CHECK( load_patterns( store, aig3, other_sim ) == 0u );
+
+  fs::remove( filename );
+}
+
+TEST_CASE( "warm-start pattern generation and functional reduction", "[pattern_store]" )
+{
+  const std::string filename = "mockturtle-test-patgen.patterns";
+  fs::remove( filename );
+
+  auto aig = make_adder( 8u );
+
+  pattern_generation_params ps;
+  ps.pattern_store_filename = filename;
+
+  pattern_generation_stats st1;
+  partial_simulator sim1( aig.num_pis(), 0u );
+  pattern_generation( aig, sim1, ps, &st1 );
+  CHECK( st1.num_loaded_patterns == 0u );
+  CHECK( st1.num_generated_patterns > 0u );
+  CHECK( pattern_store( filename ).num_patterns() == st1.num_generated_patterns );
+
+  /* all nodes are covered by the stored patterns */
+  pattern_generation_stats st2;
+  partial_simulator sim2( aig.num_pis(), 0u );
+  pattern_generation( aig, sim2, ps, &st2 );
+  CHECK( st2.num_loaded_patterns == st1.num_generated_patterns );
+  CHECK( st2.num_generated_patterns == 0u );
+  CHECK( sim2.get_patterns() == sim1.get_patterns() );
+  CHECK( pattern_store( filename ).num_patterns() == st1.num_generated_patterns );
+
+  /* functional reduction starts from the stored patterns and appends its counter-examples */
+  functional_reduction_params fps;
+  fps.pattern_store_filename = filename;
+  functional_reduction( aig, fps );
+  CHECK( pattern_store( filename ).num_patterns() >= st1.num_generated_patterns );
+
+  fs::remove( filename );
+}
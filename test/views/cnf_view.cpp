@@ -1,5 +1,9 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
+#include <mockturtle/networks/dmig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
@@ -38,6 +42,42 @@ TEST_CASE( "create a simple miter of non-equivalent functions with cnf_view", "[
   CHECK( xag.pi_model_values() == std::vector<bool>{{true, true}} );
 }
 
+TEST_CASE( "create a miter of D-MIG functions with cnf_view", "[cnf_view]" )
+{
+  {
+    cnf_view<dmig_network> dmig;
+    const auto a = dmig.create_pi();
+    const auto b = dmig.create_pi();
+    const auto c = dmig.create_pi();
+
+    /* create_maj is built from two D-MAJ nodes */
+    const auto f = dmig.create_maj( a, b, c );
+    const auto g = dmig.create_or( dmig.create_and( a, b ), dmig.create_and( c, dmig.create_or( a, b ) ) );
+    dmig.create_po( dmig.create_xor( f, g ) );
+
+    const auto result = dmig.solve();
+    CHECK( result );
+    CHECK( !*result );
+  }
+
+  {
+    cnf_view<dmig_network> dmig;
+    const auto a = dmig.create_pi();
+    const auto b = dmig.create_pi();
+    const auto c = dmig.create_pi();
+
+    const auto f = dmig.create_maj( a, b, c );
+    dmig.create_po( dmig.create_xor( f, dmig.create_and( a, b ) ) );
+
+    const auto result = dmig.solve();
+    CHECK( result );
+    CHECK( *result );
+    const auto values = dmig.pi_model_values();
+    CHECK( values[2] );
+    CHECK( values[0] != values[1] );
+  }
+}
+
 TEST_CASE( "cnf_view with custom clauses", "[cnf_view]" )
 {
   cnf_view<mig_network> mig;
@@ -164,3 +204,109 @@ TEST_CASE( "build cnf_view for k-LUT network", "[cnf_view]" )
   CHECK( result );
   CHECK( !*result );
 }
+
+TEST_CASE( "cnf_view with deferred cnf_map encoding", "[cnf_view]" )
+{
+  cnf_view_params ps;
+  ps.use_cnf_map = true;
+
+  /* equivalent functions */
+  {
+    cnf_view<xag_network> xag( ps );
+    std::vector<xag_network::signal> as( 3u ), bs( 3u );
+    std::generate( as.begin(), as.end(), [&]() { return xag.create_pi(); } );
+    std::generate( bs.begin(), bs.end(), [&]() { return xag.create_pi(); } );
+    const auto num_clauses = xag.num_clauses();
+
+    std::vector<xag_network::signal> xors;
+    for ( auto i = 0u; i < 3u; ++i )
+    {
+      const auto f = xag.create_xor( as[i], bs[i] );
+      const auto g = xag.create_or( xag.create_and( !as[i], bs[i] ), xag.create_and( as[i], !bs[i] ) );
+      xors.push_back( xag.create_xor( f, g ) );
+    }
+    xag.create_po( xag.create_nary_or( xors ) );
+
+    /* no gate is encoded before solving */
+    CHECK( xag.num_clauses() == num_clauses );
+
+    const auto result = xag.solve();
+    CHECK( result );
+    CHECK( !*result );
+  }
+
+  /* non-equivalent functions and custom clauses on an inner node */
+  {
+    cnf_view<xag_network> xag( ps );
+    const auto a = xag.create_pi();
+    const auto b = xag.create_pi();
+    const auto c = xag.create_pi();
+
+    const auto f = xag.create_and( a, b );
+    const auto g = xag.create_or( f, c );
+    const auto h = xag.create_xor( g, xag.create_or( a, c ) );
+    xag.create_po( h );
+
+    /* inner node f must be false */
+    xag.add_clause( !f );
+    const auto result = xag.solve();
+    CHECK( result );
+    CHECK( *result );
+
+    const auto values = xag.pi_model_values();
+    CHECK( ( ( ( values[0] && values[1] ) || values[2] ) != ( values[0] || values[2] ) ) );
+    CHECK( !( values[0] && values[1] ) );
+    CHECK( xag.model_value( f ) == ( values[0] && values[1] ) );
+
+    /* nodes created after solving are encoded as well */
+    const auto k = xag.create_and( a, !b );
+    const auto result2 = xag.solve( {xag.lit( k ), xag.lit( h )} );
+    CHECK( result2 );
+    CHECK( *result2 );
+    const auto values2 = xag.pi_model_values();
+    CHECK( values2[0] );
+    CHECK( !values2[1] );
+    CHECK( !values2[2] );
+  }
+}
+
+TEST_CASE( "cnf_view with deferred cnf_map encoding and interleaved gate creation", "[cnf_view]" )
+{
+  cnf_view_params ps;
+  ps.use_cnf_map = true;
+
+  cnf_view<xag_network> xag( ps );
+  std::vector<xag_network::signal> pis( 4u );
+  std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+
+  /* acc_{i+1} = acc_i XOR (pi_{i % 4} AND pi_{(i + 1) % 4}), encoded after each step */
+  const auto evaluate = []( std::vector<bool> const& values, uint32_t steps ) {
+    auto value = false;
+    for ( auto j = 0u; j < steps; ++j )
+    {
+      value ^= values[j % 4u] && values[( j + 1u ) % 4u];
+    }
+    return value;
+  };
+
+  auto acc = xag.get_constant( false );
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    acc = xag.create_xor( acc, xag.create_and( pis[i % 4u], pis[( i + 1u ) % 4u] ) );
+
+    auto satisfiable = false;
+    for ( auto m = 0u; m < 16u; ++m )
+    {
+      satisfiable |= evaluate( {( m & 1u ) != 0u, ( m & 2u ) != 0u, ( m & 4u ) != 0u, ( m & 8u ) != 0u}, i + 1u );
+    }
+
+    const auto result = xag.solve( {xag.lit( acc )} );
+    REQUIRE( result );
+    CHECK( *result == satisfiable );
+    if ( *result )
+    {
+      CHECK( evaluate( xag.pi_model_values(), i + 1u ) );
+      CHECK( xag.model_value( acc ) );
+    }
+  }
+}
@@ -54,3 +54,36 @@ TEST_CASE( "create cut view on AIG for XOR", "[cut_view]" )
   CHECK( cut3.node_to_index( aig.get_node( f3 ) ) == 2 );
   CHECK( cut3.node_to_index( aig.get_node( f4 ) ) == 3 );
 }
+
+TEST_CASE( "create cut views with a shared index arena", "[cut_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto f1 = aig.create_nand( a, b );
+  const auto f2 = aig.create_nand( a, f1 );
+  const auto f3 = aig.create_nand( b, f1 );
+  const auto f4 = aig.create_nand( f2, f3 );
+  aig.create_po( f4 );
+
+  window_index_arena arena;
+
+  cut_view cut1{aig, {aig.get_node( a ), aig.get_node( b )}, f4, &arena};
+  CHECK( cut1.size() == 7 );
+  CHECK( cut1.num_pis() == 2 );
+  CHECK( cut1.num_gates() == 4 );
+  cut1.foreach_node( [&]( auto const& n, auto i ) {
+    CHECK( cut1.node_to_index( n ) == i );
+  } );
+  CHECK( arena.size() >= aig.size() );
+
+  cut_view cut2{aig, {aig.get_node( f2 ), aig.get_node( f3 )}, f4, &arena};
+  CHECK( cut2.size() == 4 );
+  CHECK( cut2.num_pis() == 2 );
+  CHECK( cut2.num_gates() == 1 );
+  CHECK( cut2.node_to_index( aig.get_node( aig.get_constant( false ) ) ) == 0 );
+  CHECK( cut2.node_to_index( aig.get_node( f2 ) ) == 1 );
+  CHECK( cut2.node_to_index( aig.get_node( f3 ) ) == 2 );
+  CHECK( cut2.node_to_index( aig.get_node( f4 ) ) == 3 );
+  CHECK( !arena.has( aig.node_to_index( aig.get_node( a ) ), arena.stamp() ) );
+}
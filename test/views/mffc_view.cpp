@@ -316,3 +316,61 @@ TEST_CASE( "create a MFFC view", "[mffc_view]" )
   } );
   mffc5.foreach_po( [&]( auto const& f ) { CHECK( mffc5.get_node( f ) == aig.get_node( f8 ) ); } );
 }
+
+TEST_CASE( "create MFFC views with a shared index arena", "[mffc_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( c, d );
+  const auto f3 = aig.create_and( f1, f2 );
+  const auto f4 = aig.create_and( f1, c );
+  aig.create_po( f3 );
+  aig.create_po( f4 );
+  initialize_refs( aig );
+
+  window_index_arena arena( aig.size() );
+  aig.foreach_gate( [&]( auto const& n ) {
+    mffc_view mffc1{aig, n};
+    mffc_view mffc2{aig, n, &arena};
+
+    CHECK( mffc1.size() == mffc2.size() );
+    CHECK( mffc1.num_pis() == mffc2.num_pis() );
+    CHECK( mffc1.num_gates() == mffc2.num_gates() );
+    mffc2.foreach_node( [&]( auto const& m, auto i ) {
+      CHECK( mffc1.index_to_node( i ) == m );
+      CHECK( mffc2.node_to_index( m ) == i );
+      CHECK( mffc1.node_to_index( m ) == i );
+    } );
+  } );
+}
+
+TEST_CASE( "MFFC views with and without index arena agree on nodes indexed twice", "[mffc_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  aig.create_po( aig.create_and( a, b ) );
+  initialize_refs( aig );
+
+  /* the root is indexed as a constant or a leaf before it is indexed as the root */
+  window_index_arena arena( aig.size() );
+  for ( auto const& root : {aig.get_node( aig.get_constant( false ) ), aig.get_node( a )} )
+  {
+    mffc_view mffc1{aig, root};
+    mffc_view mffc2{aig, root, &arena};
+
+    CHECK( mffc1.size() == mffc2.size() );
+    CHECK( mffc1.num_gates() == 0u );
+    CHECK( mffc2.num_gates() == 0u );
+    CHECK( mffc1.node_to_index( root ) == mffc2.node_to_index( root ) );
+    mffc2.foreach_node( [&]( auto const& m, auto i ) {
+      CHECK( mffc1.node_to_index( m ) == i );
+      CHECK( mffc2.node_to_index( m ) == i );
+    } );
+  }
+}
@@ -197,6 +197,61 @@ TEST_CASE( "create window view on AIG", "[window_view]" )
   }
 }
 
+TEST_CASE( "create window views with a shared index arena", "[window_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto f1 = aig.create_nand( a, b );
+  const auto f2 = aig.create_nand( a, f1 );
+  const auto f3 = aig.create_nand( b, f1 );
+  const auto f4 = aig.create_nand( f2, f3 );
+  aig.create_po( f4 );
+
+  window_index_arena arena( aig.size() );
+
+  {
+    window_view view( aig,
+                      /* inputs = */ { aig.get_node( a ), aig.get_node( b ) },
+                      /* outputs = */ { f3 },
+                      /* nodes = */ { aig.get_node( f1 ), aig.get_node( f3 ) },
+                      &arena );
+    CHECK( view.size() == 5 );
+    CHECK( view.num_gates() == 2 );
+    CHECK( view.num_pis() == 2 );
+
+    CHECK(  view.is_pi( view.get_node( a ) ) );
+    CHECK(  view.is_pi( view.get_node( b ) ) );
+    CHECK( !view.is_pi( view.get_node( f1 ) ) );
+    CHECK(  view.belongs_to( view.get_node( f1 ) ) );
+    CHECK( !view.belongs_to( view.get_node( f2 ) ) );
+    CHECK(  view.belongs_to( f3 ) );
+    CHECK( !view.belongs_to( view.get_node( f4 ) ) );
+    CHECK( view.node_to_index( view.get_node( f3 ) ) == 4u );
+    CHECK( window_is_well_formed( view ) );
+  }
+
+  {
+    window_view view( aig,
+                      /* inputs = */ { aig.get_node( f1 ), aig.get_node( b ) },
+                      /* outputs = */ { f3 },
+                      /* nodes = */ { aig.get_node( f3 ) },
+                      &arena );
+    CHECK( view.size() == 4 );
+    CHECK( view.num_gates() == 1 );
+
+    CHECK(  view.is_pi( view.get_node( f1 ) ) );
+    CHECK( !view.is_pi( view.get_node( a ) ) );
+    CHECK( !view.belongs_to( view.get_node( a ) ) );
+    CHECK(  view.belongs_to( view.get_node( f3 ) ) );
+    CHECK( view.node_to_index( view.get_node( f1 ) ) == 1u );
+    CHECK( view.node_to_index( view.get_node( f3 ) ) == 3u );
+    CHECK( collect_fanin_nodes( view, view.get_node( f1 ) ).size() == 0 );
+    CHECK( collect_fanin_nodes( view, view.get_node( f3 ) ).size() == 2 );
+    CHECK( window_is_well_formed( view ) );
+  }
+}
+
 TEST_CASE( "collect nodes", "[window_view]" )
 {
   aig_network _aig;